@@ -0,0 +1,536 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file compressed_csr_matrix.h
+ *  \brief Compressed Sparse Row matrix format with compressed column indices.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/memory.h>
+
+#include <cusp/detail/format.h>
+#include <cusp/detail/matrix_base.h>
+#include <cusp/detail/type_traits.h>
+
+namespace cusp
+{
+
+// forward definition
+template <typename ArrayType1, typename ArrayType2, typename ArrayType3, typename IndexType, typename ValueType, typename MemorySpace> class compressed_csr_matrix_view;
+
+/*! \addtogroup sparse_matrices Sparse Matrices
+ */
+
+/*! \addtogroup sparse_matrix_containers Sparse Matrix Containers
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief Compressed sparse row representation a sparse matrix with
+ * compressed column indices
+ *
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ *  A \p compressed_csr_matrix stores the row offsets and values of a
+ *  matrix like a \p csr_matrix, but replaces the column index of every
+ *  entry by a \c delta_width byte offset from a base column of its row.
+ *  The deltas are stored little-endian in \c column_deltas, the delta of
+ *  entry \c n occupies the bytes <tt>[n * delta_width, (n + 1) *
+ *  delta_width)</tt>. The base column of row \c i is
+ *  <tt>column_bases[i]</tt>, the smallest column of the row.
+ *
+ *  A row whose columns span more than a \c delta_width byte offset can
+ *  represent keeps its full column indices in \c column_indices instead.
+ *  Such a row is marked by a base of at least \c num_cols, its indices
+ *  start at position <tt>column_bases[i] - num_cols</tt> of
+ *  \c column_indices and the delta bytes of its entries are unused.
+ *
+ *  For banded and bandwidth-reduced (e.g. RCM ordered) matrices almost
+ *  every row fits into 8 or 16 bit deltas, which cuts the bytes of column
+ *  indices streamed by a SpMV to a quarter or a half. The host SpMV
+ *  decodes the column indices on the fly. When a \p compressed_csr_matrix
+ *  is converted from another matrix, the \c delta_width of 1 or 2 bytes
+ *  giving the smallest storage is chosen.
+ *
+ * \note The matrix entries must be sorted by row index.
+ * \note \c num_cols plus the number of entries stored in \c column_indices
+ * must be representable by \c IndexType.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to convert a \p csr_matrix
+ *  to a \p compressed_csr_matrix and multiply it by a vector.
+ *
+ *  \code
+ *  // include the compressed_csr_matrix header file
+ *  #include <cusp/compressed_csr_matrix.h>
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/multiply.h>
+ *  #include <cusp/print.h>
+ *
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main()
+ *  {
+ *    // 5-point stencil on a 100x100 grid, the columns of a row span 201 columns
+ *    cusp::csr_matrix<int,float,cusp::host_memory> A;
+ *    cusp::gallery::poisson5pt(A, 100, 100);
+ *
+ *    // B stores a single byte instead of a 4 byte column index per entry
+ *    cusp::compressed_csr_matrix<int,float,cusp::host_memory> B(A);
+ *
+ *    cusp::array1d<float,cusp::host_memory> x(B.num_cols, 1);
+ *    cusp::array1d<float,cusp::host_memory> y(B.num_rows);
+ *
+ *    cusp::multiply(B, x, y);
+ *  }
+ *  \endcode
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+class compressed_csr_matrix : public cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::compressed_csr_format>
+{
+private:
+
+    typedef cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::compressed_csr_format> Parent;
+
+public:
+
+    /*! \cond */
+    typedef typename cusp::array1d<IndexType, MemorySpace>     row_offsets_array_type;
+    typedef typename cusp::array1d<IndexType, MemorySpace>     column_indices_array_type;
+    typedef typename cusp::array1d<unsigned char, MemorySpace> column_deltas_array_type;
+    typedef typename cusp::array1d<ValueType, MemorySpace>     values_array_type;
+
+    typedef typename cusp::compressed_csr_matrix<IndexType, ValueType, MemorySpace> container;
+
+    typedef typename cusp::compressed_csr_matrix_view<typename row_offsets_array_type::view,
+            typename column_deltas_array_type::view,
+            typename values_array_type::view,
+            IndexType, ValueType, MemorySpace> view;
+
+    typedef typename cusp::compressed_csr_matrix_view<typename row_offsets_array_type::const_view,
+            typename column_deltas_array_type::const_view,
+            typename values_array_type::const_view,
+            IndexType, ValueType, MemorySpace> const_view;
+
+    typedef typename cusp::detail::coo_view_type<row_offsets_array_type,
+                                                 column_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::compressed_csr_format>::view coo_view_type;
+    typedef typename cusp::detail::coo_view_type<row_offsets_array_type,
+                                                 column_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::compressed_csr_format>::view const_coo_view_type;
+
+    template<typename MemorySpace2>
+    struct rebind
+    {
+        typedef cusp::compressed_csr_matrix<IndexType, ValueType, MemorySpace2> type;
+    };
+    /*! \endcond */
+
+    /*! Number of bytes of the column delta of every entry, 1 or 2.
+     */
+    size_t delta_width;
+
+    /*! Storage for the row offsets of the CSR data structure.
+     */
+    row_offsets_array_type row_offsets;
+
+    /*! Storage for the base column of every row.
+     */
+    column_indices_array_type column_bases;
+
+    /*! Storage for the full column indices of the rows without deltas.
+     */
+    column_indices_array_type column_indices;
+
+    /*! Storage for the column deltas of the entries.
+     */
+    column_deltas_array_type column_deltas;
+
+    /*! Storage for the nonzero entries of the CSR data structure.
+     */
+    values_array_type values;
+
+    /*! Construct an empty \p compressed_csr_matrix with 8 bit deltas.
+     */
+    compressed_csr_matrix(void)
+        : delta_width(1) {}
+
+    /*! Construct a \p compressed_csr_matrix with a specific shape, number of
+     *  nonzero entries and number of full column indices.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param num_indices Number of entries stored with a full column index.
+     *  \param delta_width Number of bytes of every column delta (default 1).
+     */
+    compressed_csr_matrix(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+                          const size_t num_indices, const size_t delta_width = 1)
+        : Parent(num_rows, num_cols, num_entries),
+          delta_width(delta_width),
+          row_offsets(num_rows + 1),
+          column_bases(num_rows),
+          column_indices(num_indices),
+          column_deltas(num_entries * delta_width),
+          values(num_entries) {}
+
+    /*! Construct a \p compressed_csr_matrix from another matrix.
+     *
+     *  \tparam MatrixType Type of input matrix used to create this \p
+     *  compressed_csr_matrix.
+     *
+     *  \param matrix Another sparse or dense matrix.
+     */
+    template <typename MatrixType>
+    compressed_csr_matrix(const MatrixType& matrix);
+
+    /*! Resize matrix dimensions and underlying storage
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param num_indices Number of entries stored with a full column index.
+     */
+    void resize(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+                const size_t num_indices);
+
+    /*! Resize matrix dimensions and underlying storage
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param num_indices Number of entries stored with a full column index.
+     *  \param delta_width Number of bytes of every column delta.
+     */
+    void resize(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+                const size_t num_indices, const size_t delta_width);
+
+    /*! Swap the contents of two \p compressed_csr_matrix objects.
+     *
+     *  \param matrix Another \p compressed_csr_matrix with the same IndexType and ValueType.
+     */
+    void swap(compressed_csr_matrix& matrix);
+
+    /*! Assignment from another matrix.
+     *
+     *  \tparam MatrixType Type of input matrix to copy into this \p
+     *  compressed_csr_matrix.
+     *
+     *  \param matrix Another sparse or dense matrix.
+     */
+    template <typename MatrixType>
+    compressed_csr_matrix& operator=(const MatrixType& matrix);
+
+}; // class compressed_csr_matrix
+/*! \}
+ */
+
+/**
+ * \addtogroup sparse_matrix_views Sparse Matrix Views
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief View of a \p compressed_csr_matrix
+ *
+ * \tparam ArrayType1 Type of \c row_offsets, \c column_bases and \c column_indices array views
+ * \tparam ArrayType2 Type of \c column_deltas array view
+ * \tparam ArrayType3 Type of \c values array view
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ *  A \p compressed_csr_matrix_view is a sparse matrix view of a matrix in
+ *  CSR format with compressed column indices constructed from existing
+ *  data or iterators. See \p compressed_csr_matrix for the layout of the
+ *  arrays.
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename IndexType   = typename ArrayType1::value_type,
+          typename ValueType   = typename ArrayType3::value_type,
+          typename MemorySpace = typename cusp::minimum_space<
+                                    typename ArrayType1::memory_space,
+                                    typename ArrayType2::memory_space,
+                                    typename ArrayType3::memory_space>::type >
+class compressed_csr_matrix_view : public cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::compressed_csr_format>
+{
+private:
+
+    typedef cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::compressed_csr_format> Parent;
+
+public:
+
+    /*! \cond */
+    typedef ArrayType1 row_offsets_array_type;
+    typedef ArrayType1 column_indices_array_type;
+    typedef ArrayType2 column_deltas_array_type;
+    typedef ArrayType3 values_array_type;
+
+    typedef typename cusp::compressed_csr_matrix<IndexType, ValueType, MemorySpace> container;
+    typedef typename cusp::compressed_csr_matrix_view<ArrayType1, ArrayType2, ArrayType3, IndexType, ValueType, MemorySpace> view;
+    typedef typename cusp::compressed_csr_matrix_view<ArrayType1, ArrayType2, ArrayType3, IndexType, ValueType, MemorySpace> const_view;
+
+    typedef typename cusp::detail::coo_view_type<row_offsets_array_type,
+                                                 column_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::compressed_csr_format>::view coo_view_type;
+    typedef typename cusp::detail::coo_view_type<row_offsets_array_type,
+                                                 column_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::compressed_csr_format>::view const_coo_view_type;
+    /*! \endcond */
+
+    /**
+     * Number of bytes of the column delta of every entry, 1 or 2.
+     */
+    size_t delta_width;
+
+    /**
+     * View of the row offsets of the CSR data structure.
+     */
+    row_offsets_array_type row_offsets;
+
+    /**
+     * View of the base column of every row.
+     */
+    column_indices_array_type column_bases;
+
+    /**
+     * View of the full column indices of the rows without deltas.
+     */
+    column_indices_array_type column_indices;
+
+    /**
+     * View of the column deltas of the entries.
+     */
+    column_deltas_array_type column_deltas;
+
+    /**
+     * View of the nonzero entries of the CSR data structure.
+     */
+    values_array_type values;
+
+    /**
+     * Construct an empty \p compressed_csr_matrix_view.
+     */
+    compressed_csr_matrix_view(void)
+        : Parent(), delta_width(1) {}
+
+    /*! Construct a \p compressed_csr_matrix_view with a specific shape and
+     *  number of nonzero entries from existing arrays denoting the row
+     *  offsets, base columns, full column indices, column deltas and values.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param delta_width Number of bytes of every column delta.
+     *  \param row_offsets Array containing the row offsets.
+     *  \param column_bases Array containing the base column of every row.
+     *  \param column_indices Array containing the full column indices.
+     *  \param column_deltas Array containing the column deltas.
+     *  \param values Array containing the values.
+     */
+    compressed_csr_matrix_view(const size_t num_rows,
+                               const size_t num_cols,
+                               const size_t num_entries,
+                               const size_t delta_width,
+                               ArrayType1 row_offsets,
+                               ArrayType1 column_bases,
+                               ArrayType1 column_indices,
+                               ArrayType2 column_deltas,
+                               ArrayType3 values)
+        : Parent(num_rows, num_cols, num_entries),
+          delta_width(delta_width),
+          row_offsets(row_offsets),
+          column_bases(column_bases),
+          column_indices(column_indices),
+          column_deltas(column_deltas),
+          values(values) {}
+
+    /*! Construct a \p compressed_csr_matrix_view from a existing \p compressed_csr_matrix.
+     *
+     *  \param matrix \p compressed_csr_matrix used to create view.
+     */
+    compressed_csr_matrix_view(compressed_csr_matrix<IndexType,ValueType,MemorySpace>& matrix)
+        : Parent(matrix),
+          delta_width(matrix.delta_width),
+          row_offsets(matrix.row_offsets),
+          column_bases(matrix.column_bases),
+          column_indices(matrix.column_indices),
+          column_deltas(matrix.column_deltas),
+          values(matrix.values) {}
+
+    /*! Construct a \p compressed_csr_matrix_view from a existing const \p compressed_csr_matrix.
+     *
+     *  \param matrix \p compressed_csr_matrix used to create view.
+     */
+    compressed_csr_matrix_view(const compressed_csr_matrix<IndexType,ValueType,MemorySpace>& matrix)
+        : Parent(matrix),
+          delta_width(matrix.delta_width),
+          row_offsets(matrix.row_offsets),
+          column_bases(matrix.column_bases),
+          column_indices(matrix.column_indices),
+          column_deltas(matrix.column_deltas),
+          values(matrix.values) {}
+
+    /*! Construct a \p compressed_csr_matrix_view from a existing \p compressed_csr_matrix_view.
+     *
+     *  \param matrix \p compressed_csr_matrix_view used to create view.
+     */
+    compressed_csr_matrix_view(compressed_csr_matrix_view& matrix)
+        : Parent(matrix),
+          delta_width(matrix.delta_width),
+          row_offsets(matrix.row_offsets),
+          column_bases(matrix.column_bases),
+          column_indices(matrix.column_indices),
+          column_deltas(matrix.column_deltas),
+          values(matrix.values) {}
+
+    /*! Construct a \p compressed_csr_matrix_view from a existing const \p compressed_csr_matrix_view.
+     *
+     *  \param matrix \p compressed_csr_matrix_view used to create view.
+     */
+    compressed_csr_matrix_view(const compressed_csr_matrix_view& matrix)
+        : Parent(matrix),
+          delta_width(matrix.delta_width),
+          row_offsets(matrix.row_offsets),
+          column_bases(matrix.column_bases),
+          column_indices(matrix.column_indices),
+          column_deltas(matrix.column_deltas),
+          values(matrix.values) {}
+
+    /*! Resize matrix dimensions and underlying storage
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param num_indices Number of entries stored with a full column index.
+     */
+    void resize(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+                const size_t num_indices);
+};
+
+/* Convenience functions */
+
+/**
+ *  This is a convenience function for generating an \p compressed_csr_matrix_view
+ *  using individual arrays
+ *  \tparam ArrayType1 row offsets, base columns and column indices array type
+ *  \tparam ArrayType2 column deltas array type
+ *  \tparam ArrayType3 values array type
+ *
+ *  \param num_rows Number of rows.
+ *  \param num_cols Number of columns.
+ *  \param num_entries Number of nonzero matrix entries.
+ *  \param delta_width Number of bytes of every column delta.
+ *  \param row_offsets Array containing the row offsets.
+ *  \param column_bases Array containing the base column of every row.
+ *  \param column_indices Array containing the full column indices.
+ *  \param column_deltas Array containing the column deltas.
+ *  \param values Array containing the values.
+ *
+ *  \return \p compressed_csr_matrix_view constructed using input arrays
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3>
+compressed_csr_matrix_view<ArrayType1,ArrayType2,ArrayType3>
+make_compressed_csr_matrix_view(size_t num_rows,
+                                size_t num_cols,
+                                size_t num_entries,
+                                size_t delta_width,
+                                ArrayType1 row_offsets,
+                                ArrayType1 column_bases,
+                                ArrayType1 column_indices,
+                                ArrayType2 column_deltas,
+                                ArrayType3 values)
+{
+    compressed_csr_matrix_view<ArrayType1,ArrayType2,ArrayType3>
+           view(num_rows, num_cols, num_entries, delta_width,
+                row_offsets, column_bases, column_indices, column_deltas, values);
+
+    return view;
+}
+
+/**
+ *  This is a convenience function for generating an \p compressed_csr_matrix_view
+ *  using an existing \p compressed_csr_matrix.
+ *
+ *  \tparam IndexType  indices type
+ *  \tparam ValueType  values type
+ *  \tparam MemorySpace memory space of the arrays
+ *
+ *  \param m Exemplar \p compressed_csr_matrix matrix to copy.
+ *
+ *  \return \p compressed_csr_matrix_view constructed using input arrays.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename compressed_csr_matrix<IndexType,ValueType,MemorySpace>::view
+make_compressed_csr_matrix_view(compressed_csr_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_compressed_csr_matrix_view
+           (m.num_rows, m.num_cols, m.num_entries, m.delta_width,
+            make_array1d_view(m.row_offsets),
+            make_array1d_view(m.column_bases),
+            make_array1d_view(m.column_indices),
+            make_array1d_view(m.column_deltas),
+            make_array1d_view(m.values));
+}
+
+/**
+ *  This is a convenience function for generating an const \p compressed_csr_matrix_view
+ *  using an existing \p compressed_csr_matrix.
+ *
+ *  \tparam IndexType  indices type
+ *  \tparam ValueType  values type
+ *  \tparam MemorySpace memory space of the arrays
+ *
+ *  \param m Exemplar \p compressed_csr_matrix matrix to copy.
+ *
+ *  \return \p compressed_csr_matrix_view constructed using input arrays.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename compressed_csr_matrix<IndexType,ValueType,MemorySpace>::const_view
+make_compressed_csr_matrix_view(const compressed_csr_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_compressed_csr_matrix_view
+           (m.num_rows, m.num_cols, m.num_entries, m.delta_width,
+            make_array1d_view(m.row_offsets),
+            make_array1d_view(m.column_bases),
+            make_array1d_view(m.column_indices),
+            make_array1d_view(m.column_deltas),
+            make_array1d_view(m.values));
+}
+/*! \}
+ */
+
+} // end namespace cusp
+
+#include <cusp/detail/compressed_csr_matrix.inl>
@@ -477,6 +477,13 @@ protected:
     template<typename MatrixType>
     void construct_from(MatrixType& matrix, csr_format);
 
+    /*! Construct \p coo_matrix_view from  \p csc_matrix.
+     *
+     *  \param matrix Another matrix in csc_format.
+     */
+    template<typename MatrixType>
+    void construct_from(MatrixType& matrix, csc_format);
+
     /*! Construct \p coo_matrix_view from  \p dia_matrix.
      *
      *  \param matrix Another matrix in dia_format.
@@ -497,6 +504,34 @@ protected:
      */
     template<typename MatrixType>
     void construct_from(MatrixType& matrix, hyb_format);
+
+    /*! Construct \p coo_matrix_view from  \p bsr_matrix.
+     *
+     *  \param matrix Another matrix in bsr_format.
+     */
+    template<typename MatrixType>
+    void construct_from(MatrixType& matrix, bsr_format);
+
+    /*! Construct \p coo_matrix_view from  \p sell_matrix.
+     *
+     *  \param matrix Another matrix in sell_format.
+     */
+    template<typename MatrixType>
+    void construct_from(MatrixType& matrix, sell_format);
+
+    /*! Construct \p coo_matrix_view from  \p symmetric_csr_matrix.
+     *
+     *  \param matrix Another matrix in symmetric_csr_format.
+     */
+    template<typename MatrixType>
+    void construct_from(MatrixType& matrix, symmetric_csr_format);
+
+    /*! Construct \p coo_matrix_view from  \p compressed_csr_matrix.
+     *
+     *  \param matrix Another matrix in compressed_csr_format.
+     */
+    template<typename MatrixType>
+    void construct_from(MatrixType& matrix, compressed_csr_format);
 };
 
 /* Convenience functions */
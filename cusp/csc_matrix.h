@@ -0,0 +1,610 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file csc_matrix.h
+ *  \brief Compressed Sparse Column matrix format.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/memory.h>
+
+#include <cusp/detail/format.h>
+#include <cusp/detail/matrix_base.h>
+#include <cusp/detail/type_traits.h>
+
+namespace cusp
+{
+
+// forward definition
+template <typename ArrayType1, typename ArrayType2, typename ArrayType3, typename IndexType, typename ValueType, typename MemorySpace> class csc_matrix_view;
+
+/*! \addtogroup sparse_matrices Sparse Matrices
+ */
+
+/*! \addtogroup sparse_matrix_containers Sparse Matrix Containers
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief Compressed sparse column (CSC) representation a sparse matrix
+ *
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ *  A \p csc_matrix is a sparse matrix container that stores an offset to the
+ *  first entry of each column in matrix and one row entry per nonzero.
+ *  The matrix may reside in either "host" or "device" memory depending on
+ *  the MemorySpace. All entries in the \p csc_matrix are sorted according
+ *  to column and internally sorted within each column by row index.
+ *
+ *  The arrays of a \p csc_matrix are the arrays of a \p csr_matrix holding
+ *  the transpose of the matrix, \p make_transpose_view reinterprets one as
+ *  the other without copying. The SpMV of a \p csc_matrix scatters every
+ *  column into the output, so multiplying by the transpose of a \p
+ *  csr_matrix needs no explicit transpose.
+ *
+ * \note The matrix entries within the same column must be sorted by row index.
+ * \note The matrix should not contain duplicate entries.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to create a 4-by-3
+ *  \p csc_matrix on the host with 6 nonzeros and then copies the
+ *  matrix to the device.
+ *
+ *  \code
+ *  // include the csc_matrix header file
+ *  #include <cusp/csc_matrix.h>
+ *  #include <cusp/print.h>
+ *
+ *  int main()
+ *  {
+ *    // allocate storage for (4,3) matrix with 6 nonzeros
+ *    cusp::csc_matrix<int,float,cusp::host_memory> A(4,3,6);
+ *
+ *    // initialize matrix entries on host
+ *    A.column_offsets[0] = 0;  // first offset is always zero
+ *    A.column_offsets[1] = 2;
+ *    A.column_offsets[2] = 3;
+ *    A.column_offsets[3] = 6;  // last offset is always num_entries
+ *
+ *    A.row_indices[0] = 0; A.values[0] = 10;
+ *    A.row_indices[1] = 3; A.values[1] = 40;
+ *    A.row_indices[2] = 3; A.values[2] = 50;
+ *    A.row_indices[3] = 0; A.values[3] = 20;
+ *    A.row_indices[4] = 2; A.values[4] = 30;
+ *    A.row_indices[5] = 3; A.values[5] = 60;
+ *
+ *    // A now represents the following matrix
+ *    //    [10  0 20]
+ *    //    [ 0  0  0]
+ *    //    [ 0  0 30]
+ *    //    [40 50 60]
+ *
+ *    // copy to the device
+ *    cusp::csc_matrix<int,float,cusp::device_memory> B(A);
+ *
+ *    cusp::print(B);
+ *  }
+ *  \endcode
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+class csc_matrix : public cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::csc_format>
+{
+private:
+
+    typedef cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::csc_format> Parent;
+
+public:
+
+    /*! \cond */
+    typedef typename cusp::array1d<IndexType, MemorySpace> column_offsets_array_type;
+    typedef typename cusp::array1d<IndexType, MemorySpace> row_indices_array_type;
+    typedef typename cusp::array1d<ValueType, MemorySpace> values_array_type;
+
+    typedef typename cusp::csc_matrix<IndexType, ValueType, MemorySpace> container;
+
+    typedef typename cusp::csc_matrix_view<typename column_offsets_array_type::view,
+            typename row_indices_array_type::view,
+            typename values_array_type::view,
+            IndexType, ValueType, MemorySpace> view;
+
+    typedef typename cusp::csc_matrix_view<typename column_offsets_array_type::const_view,
+            typename row_indices_array_type::const_view,
+            typename values_array_type::const_view,
+            IndexType, ValueType, MemorySpace> const_view;
+
+    typedef typename cusp::detail::coo_view_type<column_offsets_array_type,
+                                                 row_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::csc_format>::view coo_view_type;
+    typedef typename cusp::detail::coo_view_type<column_offsets_array_type,
+                                                 row_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::csc_format>::view const_coo_view_type;
+
+    template<typename MemorySpace2>
+    struct rebind
+    {
+        typedef cusp::csc_matrix<IndexType, ValueType, MemorySpace2> type;
+    };
+    /*! \endcond */
+
+    /*! Storage for the column offsets of the CSC data structure.  Also called the "column pointer" array.
+     */
+    column_offsets_array_type column_offsets;
+
+    /*! Storage for the row indices of the CSC data structure.
+     */
+    row_indices_array_type row_indices;
+
+    /*! Storage for the nonzero entries of the CSC data structure.
+     */
+    values_array_type values;
+
+    /*! Construct an empty \p csc_matrix.
+     */
+    csc_matrix(void) {}
+
+    /*! Construct a \p csc_matrix with a specific shape and number of nonzero entries.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     */
+    csc_matrix(size_t num_rows, size_t num_cols, size_t num_entries)
+        : Parent(num_rows, num_cols, num_entries),
+          column_offsets(num_cols + 1),
+          row_indices(num_entries),
+          values(num_entries) {}
+
+    /*! Construct a \p csc_matrix from another matrix.
+     *
+     *  \tparam MatrixType Type of input matrix used to create this \p
+     *  csc_matrix.
+     *
+     *  \param matrix Another sparse or dense matrix.
+     */
+    template <typename MatrixType>
+    csc_matrix(const MatrixType& matrix);
+
+    /*! Resize matrix dimensions and underlying storage
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     */
+    void resize(const size_t num_rows, const size_t num_cols, const size_t num_entries);
+
+    /*! Swap the contents of two \p csc_matrix objects.
+     *
+     *  \param matrix Another \p csc_matrix with the same IndexType and ValueType.
+     */
+    void swap(csc_matrix& matrix);
+
+    /*! Assignment from another matrix.
+     *
+     *  \tparam MatrixType Type of input matrix to copy into this \p
+     *  csc_matrix.
+     *
+     *  \param matrix Another sparse or dense matrix.
+     */
+    template <typename MatrixType>
+    csc_matrix& operator=(const MatrixType& matrix);
+
+}; // class csc_matrix
+/*! \}
+ */
+
+/**
+ * \addtogroup sparse_matrix_views Sparse Matrix Views
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief View of a \p csc_matrix
+ *
+ * \tparam ArrayType1 Type of \c column_offsets array view
+ * \tparam ArrayType2 Type of \c row_indices array view
+ * \tparam ArrayType3 Type of \c values array view
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ *  A \p csc_matrix_view is a sparse matrix view of a matrix in CSC format
+ *  constructed from existing data or iterators. All entries in the \p
+ *  csc_matrix_view are sorted according to columns and internally within
+ *  each column sorted by row indices.
+ *
+ * \note The matrix entries must be sorted by column index.
+ * \note The matrix should not contain duplicate entries.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to multiply by the
+ *  transpose of a \p csr_matrix through a \p csc_matrix_view of its
+ *  arrays.
+ *
+ *  \code
+ * #include <cusp/csc_matrix.h>
+ * #include <cusp/multiply.h>
+ * #include <cusp/gallery/poisson.h>
+ *
+ * int main()
+ * {
+ *    cusp::csr_matrix<int,float,cusp::host_memory> A;
+ *    cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *    cusp::array1d<float,cusp::host_memory> x(A.num_rows, 1);
+ *    cusp::array1d<float,cusp::host_memory> y(A.num_cols);
+ *
+ *    // y = A^T x without forming A^T
+ *    cusp::multiply(cusp::make_transpose_view(A), x, y);
+ *  }
+ *  \endcode
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename IndexType   = typename ArrayType1::value_type,
+          typename ValueType   = typename ArrayType3::value_type,
+          typename MemorySpace = typename cusp::minimum_space<
+                                    typename ArrayType1::memory_space,
+                                    typename ArrayType2::memory_space,
+                                    typename ArrayType3::memory_space>::type >
+class csc_matrix_view : public cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::csc_format>
+{
+private:
+
+    typedef cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::csc_format> Parent;
+
+public:
+
+    /*! \cond */
+    typedef ArrayType1 column_offsets_array_type;
+    typedef ArrayType2 row_indices_array_type;
+    typedef ArrayType3 values_array_type;
+
+    typedef typename cusp::csc_matrix<IndexType, ValueType, MemorySpace> container;
+    typedef typename cusp::csc_matrix_view<ArrayType1, ArrayType2, ArrayType3, IndexType, ValueType, MemorySpace> view;
+    typedef typename cusp::csc_matrix_view<ArrayType1, ArrayType2, ArrayType3, IndexType, ValueType, MemorySpace> const_view;
+
+    typedef typename cusp::detail::coo_view_type<column_offsets_array_type,
+                                                 row_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::csc_format>::view coo_view_type;
+    typedef typename cusp::detail::coo_view_type<column_offsets_array_type,
+                                                 row_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::csc_format>::view const_coo_view_type;
+    /*! \endcond */
+
+    /**
+     * View of the column offsets of the CSC data structure.
+     */
+    column_offsets_array_type column_offsets;
+
+    /**
+     * View of the row indices of the CSC data structure.
+     */
+    row_indices_array_type row_indices;
+
+    /**
+     * View for the nonzero entries of the CSC data structure.
+     */
+    values_array_type values;
+
+    /**
+     * Construct an empty \p csc_matrix_view.
+     */
+    csc_matrix_view(void)
+        : Parent() {}
+
+    /*! Construct a \p csc_matrix_view with a specific shape and number of nonzero entries
+     *  from existing arrays denoting the column offsets, row indices, and
+     *  values.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param column_offsets Array containing the column offsets.
+     *  \param row_indices Array containing the row indices.
+     *  \param values Array containing the values.
+     */
+    csc_matrix_view(const size_t num_rows,
+                    const size_t num_cols,
+                    const size_t num_entries,
+                    ArrayType1 column_offsets,
+                    ArrayType2 row_indices,
+                    ArrayType3 values)
+        : Parent(num_rows, num_cols, num_entries),
+          column_offsets(column_offsets),
+          row_indices(row_indices),
+          values(values) {}
+
+    /*! Construct a \p csc_matrix_view from a existing \p csc_matrix.
+     *
+     *  \param matrix \p csc_matrix used to create view.
+     */
+    csc_matrix_view(csc_matrix<IndexType,ValueType,MemorySpace>& matrix)
+        : Parent(matrix),
+          column_offsets(matrix.column_offsets),
+          row_indices(matrix.row_indices),
+          values(matrix.values) {}
+
+    /*! Construct a \p csc_matrix_view from a existing const \p csc_matrix.
+     *
+     *  \param matrix \p csc_matrix used to create view.
+     */
+    csc_matrix_view(const csc_matrix<IndexType,ValueType,MemorySpace>& matrix)
+        : Parent(matrix),
+          column_offsets(matrix.column_offsets),
+          row_indices(matrix.row_indices),
+          values(matrix.values) {}
+
+    /*! Construct a \p csc_matrix_view from a existing \p csc_matrix_view.
+     *
+     *  \param matrix \p csc_matrix_view used to create view.
+     */
+    csc_matrix_view(csc_matrix_view& matrix)
+        : Parent(matrix),
+          column_offsets(matrix.column_offsets),
+          row_indices(matrix.row_indices),
+          values(matrix.values) {}
+
+    /*! Construct a \p csc_matrix_view from a existing const \p csc_matrix_view.
+     *
+     *  \param matrix \p csc_matrix_view used to create view.
+     */
+    csc_matrix_view(const csc_matrix_view& matrix)
+        : Parent(matrix),
+          column_offsets(matrix.column_offsets),
+          row_indices(matrix.row_indices),
+          values(matrix.values) {}
+
+    /*! Resize matrix dimensions and underlying storage
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     */
+    void resize(const size_t num_rows, const size_t num_cols, const size_t num_entries);
+};
+
+/* Convenience functions */
+
+/**
+ *  This is a convenience function for generating an \p csc_matrix_view
+ *  using individual arrays
+ *  \tparam ArrayType1 column offsets array type
+ *  \tparam ArrayType2 row indices array type
+ *  \tparam ArrayType3 values array type
+ *
+ *  \param num_rows Number of rows.
+ *  \param num_cols Number of columns.
+ *  \param num_entries Number of nonzero matrix entries.
+ *  \param column_offsets Array containing the column offsets.
+ *  \param row_indices Array containing the row indices.
+ *  \param values Array containing the values.
+ *
+ *  \return \p csc_matrix_view constructed using input arrays
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3>
+csc_matrix_view<ArrayType1,ArrayType2,ArrayType3>
+make_csc_matrix_view(size_t num_rows,
+                     size_t num_cols,
+                     size_t num_entries,
+                     ArrayType1 column_offsets,
+                     ArrayType2 row_indices,
+                     ArrayType3 values)
+{
+    csc_matrix_view<ArrayType1,ArrayType2,ArrayType3>
+           view(num_rows, num_cols, num_entries, column_offsets, row_indices, values);
+
+    return view;
+}
+
+/**
+ *  This is a convenience function for generating an \p csc_matrix_view
+ *  using individual arrays with explicit index, value, and memory space
+ *  annotations.
+ *
+ *  \tparam ArrayType1 column offsets array type
+ *  \tparam ArrayType2 row indices array type
+ *  \tparam ArrayType3 values array type
+ *  \tparam IndexType  indices type
+ *  \tparam ValueType  values type
+ *  \tparam MemorySpace memory space of the arrays
+ *
+ *  \param m Exemplar \p csc_matrix_view matrix to copy.
+ *
+ *  \return \p csc_matrix_view constructed using input arrays.
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename IndexType,
+          typename ValueType,
+          typename MemorySpace>
+csc_matrix_view<ArrayType1,ArrayType2,ArrayType3,IndexType,ValueType,MemorySpace>
+make_csc_matrix_view(const csc_matrix_view<ArrayType1,ArrayType2,ArrayType3,IndexType,ValueType,MemorySpace>& m)
+{
+    return csc_matrix_view<ArrayType1,ArrayType2,ArrayType3,IndexType,ValueType,MemorySpace>(m);
+}
+
+/**
+ *  This is a convenience function for generating an \p csc_matrix_view
+ *  using an existing \p csc_matrix.
+ *
+ *  \tparam IndexType  indices type
+ *  \tparam ValueType  values type
+ *  \tparam MemorySpace memory space of the arrays
+ *
+ *  \param m Exemplar \p csc_matrix matrix to copy.
+ *
+ *  \return \p csc_matrix_view constructed using input arrays.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename csc_matrix<IndexType,ValueType,MemorySpace>::view
+make_csc_matrix_view(csc_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_csc_matrix_view
+           (m.num_rows, m.num_cols, m.num_entries,
+            make_array1d_view(m.column_offsets),
+            make_array1d_view(m.row_indices),
+            make_array1d_view(m.values));
+}
+
+/**
+ *  This is a convenience function for generating an const \p csc_matrix_view
+ *  using an existing \p csc_matrix.
+ *
+ *  \tparam IndexType  indices type
+ *  \tparam ValueType  values type
+ *  \tparam MemorySpace memory space of the arrays
+ *
+ *  \param m Exemplar \p csc_matrix matrix to copy.
+ *
+ *  \return \p csc_matrix_view constructed using input arrays.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename csc_matrix<IndexType,ValueType,MemorySpace>::const_view
+make_csc_matrix_view(const csc_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_csc_matrix_view
+           (m.num_rows, m.num_cols, m.num_entries,
+            make_array1d_view(m.column_offsets),
+            make_array1d_view(m.row_indices),
+            make_array1d_view(m.values));
+}
+
+/**
+ *  Views the arrays of a \p csr_matrix_view as the \p csc_matrix_view of
+ *  the transposed matrix, no entries are copied.
+ *
+ *  \param m \p csr_matrix_view of a <tt>M</tt>-by-<tt>N</tt> matrix.
+ *
+ *  \return <tt>N</tt>-by-<tt>M</tt> \p csc_matrix_view sharing the arrays of \p m.
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename IndexType,
+          typename ValueType,
+          typename MemorySpace>
+csc_matrix_view<ArrayType1,ArrayType2,ArrayType3,IndexType,ValueType,MemorySpace>
+make_transpose_view(const csr_matrix_view<ArrayType1,ArrayType2,ArrayType3,IndexType,ValueType,MemorySpace>& m)
+{
+    return csc_matrix_view<ArrayType1,ArrayType2,ArrayType3,IndexType,ValueType,MemorySpace>
+           (m.num_cols, m.num_rows, m.num_entries, m.row_offsets, m.column_indices, m.values);
+}
+
+/**
+ *  Views the arrays of a \p csr_matrix as the \p csc_matrix_view of the
+ *  transposed matrix, no entries are copied.
+ *
+ *  \param m \p csr_matrix of a <tt>M</tt>-by-<tt>N</tt> matrix.
+ *
+ *  \return <tt>N</tt>-by-<tt>M</tt> \p csc_matrix_view sharing the arrays of \p m.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename csc_matrix<IndexType,ValueType,MemorySpace>::view
+make_transpose_view(csr_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_transpose_view(make_csr_matrix_view(m));
+}
+
+/**
+ *  Views the arrays of a const \p csr_matrix as the const \p
+ *  csc_matrix_view of the transposed matrix, no entries are copied.
+ *
+ *  \param m \p csr_matrix of a <tt>M</tt>-by-<tt>N</tt> matrix.
+ *
+ *  \return <tt>N</tt>-by-<tt>M</tt> \p csc_matrix_view sharing the arrays of \p m.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename csc_matrix<IndexType,ValueType,MemorySpace>::const_view
+make_transpose_view(const csr_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_transpose_view(make_csr_matrix_view(m));
+}
+
+/**
+ *  Views the arrays of a \p csc_matrix_view as the \p csr_matrix_view of
+ *  the transposed matrix, no entries are copied.
+ *
+ *  \param m \p csc_matrix_view of a <tt>M</tt>-by-<tt>N</tt> matrix.
+ *
+ *  \return <tt>N</tt>-by-<tt>M</tt> \p csr_matrix_view sharing the arrays of \p m.
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename IndexType,
+          typename ValueType,
+          typename MemorySpace>
+csr_matrix_view<ArrayType1,ArrayType2,ArrayType3,IndexType,ValueType,MemorySpace>
+make_transpose_view(const csc_matrix_view<ArrayType1,ArrayType2,ArrayType3,IndexType,ValueType,MemorySpace>& m)
+{
+    return csr_matrix_view<ArrayType1,ArrayType2,ArrayType3,IndexType,ValueType,MemorySpace>
+           (m.num_cols, m.num_rows, m.num_entries, m.column_offsets, m.row_indices, m.values);
+}
+
+/**
+ *  Views the arrays of a \p csc_matrix as the \p csr_matrix_view of the
+ *  transposed matrix, no entries are copied.
+ *
+ *  \param m \p csc_matrix of a <tt>M</tt>-by-<tt>N</tt> matrix.
+ *
+ *  \return <tt>N</tt>-by-<tt>M</tt> \p csr_matrix_view sharing the arrays of \p m.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename csr_matrix<IndexType,ValueType,MemorySpace>::view
+make_transpose_view(csc_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_transpose_view(make_csc_matrix_view(m));
+}
+
+/**
+ *  Views the arrays of a const \p csc_matrix as the const \p
+ *  csr_matrix_view of the transposed matrix, no entries are copied.
+ *
+ *  \param m \p csc_matrix of a <tt>M</tt>-by-<tt>N</tt> matrix.
+ *
+ *  \return <tt>N</tt>-by-<tt>M</tt> \p csr_matrix_view sharing the arrays of \p m.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename csr_matrix<IndexType,ValueType,MemorySpace>::const_view
+make_transpose_view(const csc_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_transpose_view(make_csc_matrix_view(m));
+}
+/*! \}
+ */
+
+} // end namespace cusp
+
+#include <cusp/detail/csc_matrix.inl>
@@ -0,0 +1,127 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file bsr_format_utils.h
+ *  \brief Block sparse row indexing routines
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <thrust/functional.h>
+#include <thrust/tuple.h>
+
+namespace cusp
+{
+namespace detail
+{
+
+// maps the n-th entry of a bsr_matrix, in row-major order, to its row,
+// column and position in the values array. The blocks of block row i
+// cover the positions [row_offsets[i], row_offsets[i + 1]) * block_size,
+// so block_row_indices[n / block_size] is the block row of entry n.
+template <typename IndexType>
+struct bsr_entry_functor
+    : public thrust::unary_function< IndexType, thrust::tuple<IndexType,IndexType,IndexType> >
+{
+    const IndexType block_rows;
+    const IndexType block_cols;
+    const IndexType * row_offsets;
+    const IndexType * column_indices;
+    const IndexType * block_row_indices;
+
+    bsr_entry_functor(const IndexType block_rows, const IndexType block_cols,
+                      const IndexType * row_offsets,
+                      const IndexType * column_indices,
+                      const IndexType * block_row_indices)
+        : block_rows(block_rows), block_cols(block_cols),
+          row_offsets(row_offsets), column_indices(column_indices),
+          block_row_indices(block_row_indices) {}
+
+    __host__ __device__
+    thrust::tuple<IndexType,IndexType,IndexType> operator()(const IndexType n) const
+    {
+        const IndexType block_size = block_rows * block_cols;
+
+        const IndexType i     = block_row_indices[n / block_size];
+        const IndexType start = row_offsets[i];
+        const IndexType width = (row_offsets[i + 1] - start) * block_cols;
+
+        // offset of the entry within the block row
+        const IndexType local = n - start * block_size;
+        const IndexType bi    = local / width;
+        const IndexType k     = start + (local % width) / block_cols;
+        const IndexType bj    = local % block_cols;
+
+        return thrust::make_tuple(i * block_rows + bi,
+                                  column_indices[k] * block_cols + bj,
+                                  k * block_size + bi * block_cols + bj);
+    }
+};
+
+// position in the values array of entry (row, column) of the given block
+template <typename IndexType>
+struct bsr_value_index_functor
+    : public thrust::unary_function< thrust::tuple<IndexType,IndexType,IndexType>, IndexType >
+{
+    const IndexType block_rows;
+    const IndexType block_cols;
+
+    bsr_value_index_functor(const IndexType block_rows, const IndexType block_cols)
+        : block_rows(block_rows), block_cols(block_cols) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    IndexType operator()(const Tuple& t) const
+    {
+        const IndexType block = thrust::get<0>(t);
+        const IndexType row   = thrust::get<1>(t);
+        const IndexType col   = thrust::get<2>(t);
+
+        return block * block_rows * block_cols + (row % block_rows) * block_cols + col % block_cols;
+    }
+};
+
+// position in the values array of A of the n-th value of the transpose of
+// A, the blocks of the transpose have block_cols rows and block_rows
+// columns and block b of the transpose is block permutation[b] of A
+template <typename IndexType>
+struct bsr_transpose_index_functor : public thrust::unary_function<IndexType,IndexType>
+{
+    const IndexType block_rows;
+    const IndexType block_cols;
+    const IndexType * permutation;
+
+    bsr_transpose_index_functor(const IndexType block_rows, const IndexType block_cols,
+                                const IndexType * permutation)
+        : block_rows(block_rows), block_cols(block_cols), permutation(permutation) {}
+
+    __host__ __device__
+    IndexType operator()(const IndexType n) const
+    {
+        const IndexType block_size = block_rows * block_cols;
+
+        const IndexType b  = n / block_size;
+        const IndexType bj = (n % block_size) / block_rows;
+        const IndexType bi = (n % block_size) % block_rows;
+
+        return permutation[b] * block_size + bi * block_cols + bj;
+    }
+};
+
+} // end namespace detail
+} // end namespace cusp
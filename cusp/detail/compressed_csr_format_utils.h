@@ -0,0 +1,213 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file compressed_csr_format_utils.h
+ *  \brief Compressed column index encoding routines
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <thrust/functional.h>
+#include <thrust/tuple.h>
+
+namespace cusp
+{
+namespace detail
+{
+
+// delta of Width bytes stored little-endian at p
+template <int Width, typename IndexType>
+__host__ __device__
+IndexType compressed_csr_delta(const unsigned char * p)
+{
+    IndexType delta = 0;
+
+    for(int k = Width - 1; k >= 0; k--)
+        delta = (delta << 8) | IndexType(p[k]);
+
+    return delta;
+}
+
+// smallest column and column span of a row of a csr matrix, empty rows
+// have base column 0 and span 0
+template <typename IndexType>
+struct compressed_csr_row_range_functor
+    : public thrust::unary_function< IndexType, thrust::tuple<IndexType,IndexType> >
+{
+    const IndexType * row_offsets;
+    const IndexType * column_indices;
+
+    compressed_csr_row_range_functor(const IndexType * row_offsets,
+                                     const IndexType * column_indices)
+        : row_offsets(row_offsets), column_indices(column_indices) {}
+
+    __host__ __device__
+    thrust::tuple<IndexType,IndexType> operator()(const IndexType i) const
+    {
+        const IndexType row_start = row_offsets[i];
+        const IndexType row_end   = row_offsets[i + 1];
+
+        if(row_start == row_end)
+            return thrust::make_tuple(IndexType(0), IndexType(0));
+
+        IndexType first = column_indices[row_start];
+        IndexType last  = first;
+
+        for(IndexType jj = row_start + 1; jj < row_end; jj++)
+        {
+            const IndexType j = column_indices[jj];
+
+            first = j < first ? j : first;
+            last  = j > last  ? j : last;
+        }
+
+        return thrust::make_tuple(first, last - first);
+    }
+};
+
+// number of entries of a row whose span exceeds the largest delta, these
+// rows keep their full column indices
+template <typename IndexType>
+struct compressed_csr_full_length_functor
+    : public thrust::unary_function< thrust::tuple<IndexType,IndexType,IndexType>, size_t >
+{
+    const IndexType max_delta;
+
+    compressed_csr_full_length_functor(const IndexType max_delta)
+        : max_delta(max_delta) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    size_t operator()(const Tuple& t) const
+    {
+        return thrust::get<2>(t) > max_delta ? size_t(thrust::get<1>(t) - thrust::get<0>(t)) : size_t(0);
+    }
+};
+
+// base column of a row, or num_cols plus the position of the first full
+// column index of a row without deltas
+template <typename IndexType>
+struct compressed_csr_base_functor
+    : public thrust::unary_function< thrust::tuple<IndexType,IndexType,IndexType>, IndexType >
+{
+    const IndexType num_cols;
+    const IndexType max_delta;
+
+    compressed_csr_base_functor(const IndexType num_cols, const IndexType max_delta)
+        : num_cols(num_cols), max_delta(max_delta) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    IndexType operator()(const Tuple& t) const
+    {
+        return thrust::get<1>(t) > max_delta ? num_cols + thrust::get<2>(t) : thrust::get<0>(t);
+    }
+};
+
+// stores the column indices of a row of a csr matrix as deltas from the
+// base column, or copies them to the full column indices
+template <typename IndexType>
+struct compressed_csr_encode_functor : public thrust::unary_function<IndexType,void>
+{
+    const IndexType num_cols;
+    const IndexType delta_width;
+    const IndexType * row_offsets;
+    const IndexType * column_indices;
+    const IndexType * column_bases;
+    IndexType * full_column_indices;
+    unsigned char * column_deltas;
+
+    compressed_csr_encode_functor(const IndexType num_cols, const IndexType delta_width,
+                                  const IndexType * row_offsets,
+                                  const IndexType * column_indices,
+                                  const IndexType * column_bases,
+                                  IndexType * full_column_indices,
+                                  unsigned char * column_deltas)
+        : num_cols(num_cols), delta_width(delta_width),
+          row_offsets(row_offsets), column_indices(column_indices), column_bases(column_bases),
+          full_column_indices(full_column_indices), column_deltas(column_deltas) {}
+
+    __host__ __device__
+    void operator()(const IndexType i) const
+    {
+        const IndexType row_start = row_offsets[i];
+        const IndexType row_end   = row_offsets[i + 1];
+        const IndexType base      = column_bases[i];
+
+        if(base >= num_cols)
+        {
+            for(IndexType jj = row_start; jj < row_end; jj++)
+                full_column_indices[base - num_cols + jj - row_start] = column_indices[jj];
+
+            return;
+        }
+
+        for(IndexType jj = row_start; jj < row_end; jj++)
+        {
+            IndexType delta = column_indices[jj] - base;
+
+            for(IndexType k = 0; k < delta_width; k++)
+            {
+                column_deltas[size_t(jj) * delta_width + k] = static_cast<unsigned char>(delta & 0xff);
+                delta >>= 8;
+            }
+        }
+    }
+};
+
+// column index of entry n in row i of a compressed_csr_matrix
+template <typename IndexType>
+struct compressed_csr_column_functor
+    : public thrust::unary_function< thrust::tuple<IndexType,IndexType>, IndexType >
+{
+    const IndexType num_cols;
+    const IndexType delta_width;
+    const IndexType * row_offsets;
+    const IndexType * column_bases;
+    const IndexType * column_indices;
+    const unsigned char * column_deltas;
+
+    compressed_csr_column_functor(const IndexType num_cols, const IndexType delta_width,
+                                  const IndexType * row_offsets,
+                                  const IndexType * column_bases,
+                                  const IndexType * column_indices,
+                                  const unsigned char * column_deltas)
+        : num_cols(num_cols), delta_width(delta_width),
+          row_offsets(row_offsets), column_bases(column_bases),
+          column_indices(column_indices), column_deltas(column_deltas) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    IndexType operator()(const Tuple& t) const
+    {
+        const IndexType n    = thrust::get<0>(t);
+        const IndexType i    = thrust::get<1>(t);
+        const IndexType base = column_bases[i];
+
+        if(base >= num_cols)
+            return column_indices[base - num_cols + n - row_offsets[i]];
+
+        const unsigned char * p = column_deltas + size_t(n) * delta_width;
+
+        return base + (delta_width == 1 ? compressed_csr_delta<1,IndexType>(p) :
+                                          compressed_csr_delta<2,IndexType>(p));
+    }
+};
+
+} // end namespace detail
+} // end namespace cusp
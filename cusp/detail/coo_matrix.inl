@@ -23,12 +23,18 @@
 #include <cusp/iterator/join_iterator.h>
 
 #include <cusp/detail/array2d_format_utils.h>
+#include <cusp/detail/bsr_format_utils.h>
+#include <cusp/detail/compressed_csr_format_utils.h>
+#include <cusp/detail/sell_format_utils.h>
 
 #include <thrust/copy.h>
+#include <thrust/gather.h>
+#include <thrust/inner_product.h>
 #include <thrust/merge.h>
 #include <thrust/remove.h>
 #include <thrust/sequence.h>
 #include <thrust/sort.h>
+#include <thrust/transform.h>
 
 #include <thrust/iterator/counting_iterator.h>
 #include <thrust/iterator/discard_iterator.h>
@@ -163,6 +169,48 @@ void coo_matrix_view<Array1,Array2,Array3,IndexType,ValueType,MemorySpace>
     values         = values_array_type(matrix.values.begin(), matrix.values.end());
 }
 
+template <typename Array1, typename Array2, typename Array3, typename IndexType, typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+void coo_matrix_view<Array1,Array2,Array3,IndexType,ValueType,MemorySpace>
+::construct_from(MatrixType& matrix, cusp::csc_format)
+{
+    typedef cusp::detail::coo_view_type<typename MatrixType::column_offsets_array_type,
+                                        typename MatrixType::row_indices_array_type,
+                                        typename MatrixType::values_array_type,
+                                        cusp::csc_format>       csc_view_type;
+
+    typedef typename csc_view_type::ValuePermIterator        ValuePermIterator;
+
+    const size_t num_entries = matrix.num_entries;
+
+    Parent::resize(matrix.num_rows, matrix.num_cols, num_entries);
+
+    // rows, columns and value positions of the entries
+    indices.resize(3 * num_entries);
+
+    row_indices_array_type    rows_array(indices.begin(), indices.begin() + num_entries);
+    column_indices_array_type cols_array(indices.begin() + num_entries, indices.begin() + 2 * num_entries);
+    row_indices_array_type    perm_array(indices.begin() + 2 * num_entries, indices.end());
+
+    if(num_entries > 0)
+    {
+        thrust::copy(matrix.row_indices.begin(), matrix.row_indices.end(), rows_array.begin());
+        cusp::offsets_to_indices(matrix.column_offsets, cols_array);
+        thrust::sequence(perm_array.begin(), perm_array.end());
+
+        // the stable sort keeps the columns of every row in order
+        cusp::sort_by_row(rows_array, cols_array, perm_array,
+                          IndexType(0), IndexType(matrix.num_rows));
+    }
+
+    ValuePermIterator         vals_iter(matrix.values.begin(), indices.begin() + 2 * num_entries);
+    values_array_type         vals_array(vals_iter, vals_iter + num_entries);
+
+    row_indices    = rows_array;
+    column_indices = cols_array;
+    values         = vals_array;
+}
+
 template <typename Array1, typename Array2, typename Array3, typename IndexType, typename ValueType, typename MemorySpace>
 template <typename MatrixType>
 void coo_matrix_view<Array1,Array2,Array3,IndexType,ValueType,MemorySpace>
@@ -351,6 +399,222 @@ void coo_matrix_view<Array1,Array2,Array3,IndexType,ValueType,MemorySpace>
     values         = vals_array;
 }
 
+template <typename Array1, typename Array2, typename Array3, typename IndexType, typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+void coo_matrix_view<Array1,Array2,Array3,IndexType,ValueType,MemorySpace>
+::construct_from(MatrixType& matrix, cusp::bsr_format)
+{
+    typedef cusp::detail::coo_view_type<typename MatrixType::row_offsets_array_type,
+                                        typename MatrixType::column_indices_array_type,
+                                        typename MatrixType::values_array_type,
+                                        cusp::bsr_format>       bsr_view_type;
+
+    typedef typename bsr_view_type::CountingIterator         CountingIterator;
+    typedef typename bsr_view_type::ValuePermIterator        ValuePermIterator;
+
+    const size_t num_entries = matrix.num_entries;
+
+    Parent::resize(matrix.num_rows, matrix.num_cols, num_entries);
+
+    // rows, columns and value positions of the entries in row-major order
+    indices.resize(3 * num_entries);
+
+    if(num_entries > 0)
+    {
+        cusp::array1d<IndexType,MemorySpace> block_row_indices(matrix.num_blocks());
+        cusp::offsets_to_indices(matrix.row_offsets, block_row_indices);
+
+        cusp::detail::bsr_entry_functor<IndexType> entry_functor(matrix.block_rows, matrix.block_cols,
+                                                                 thrust::raw_pointer_cast(&matrix.row_offsets[0]),
+                                                                 thrust::raw_pointer_cast(&matrix.column_indices[0]),
+                                                                 thrust::raw_pointer_cast(&block_row_indices[0]));
+
+        thrust::transform(CountingIterator(0), CountingIterator(num_entries),
+                          thrust::make_zip_iterator(thrust::make_tuple(indices.begin(),
+                                                                       indices.begin() + num_entries,
+                                                                       indices.begin() + 2 * num_entries)),
+                          entry_functor);
+    }
+
+    ValuePermIterator         vals_iter(matrix.values.begin(), indices.begin() + 2 * num_entries);
+
+    row_indices_array_type    rows_array(indices.begin(), indices.begin() + num_entries);
+    column_indices_array_type cols_array(indices.begin() + num_entries, indices.begin() + 2 * num_entries);
+    values_array_type         vals_array(vals_iter, vals_iter + num_entries);
+
+    row_indices    = rows_array;
+    column_indices = cols_array;
+    values         = vals_array;
+}
+
+template <typename Array1, typename Array2, typename Array3, typename IndexType, typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+void coo_matrix_view<Array1,Array2,Array3,IndexType,ValueType,MemorySpace>
+::construct_from(MatrixType& matrix, cusp::sell_format)
+{
+    typedef cusp::detail::coo_view_type<typename MatrixType::chunk_offsets_array_type,
+                                        typename MatrixType::column_indices_array_type,
+                                        typename MatrixType::values_array_type,
+                                        cusp::sell_format>      sell_view_type;
+
+    typedef typename sell_view_type::CountingIterator        CountingIterator;
+    typedef typename sell_view_type::ValuePermIterator       ValuePermIterator;
+
+    const IndexType X           = MatrixType::invalid_index;
+    const size_t    num_entries = matrix.num_entries;
+    const size_t    num_slots   = matrix.column_indices.size();
+
+    Parent::resize(matrix.num_rows, matrix.num_cols, num_entries);
+
+    // rows, columns and value positions of the entries
+    indices.resize(3 * num_entries);
+
+    row_indices_array_type    rows_array(indices.begin(), indices.begin() + num_entries);
+    column_indices_array_type cols_array(indices.begin() + num_entries, indices.begin() + 2 * num_entries);
+    row_indices_array_type    perm_array(indices.begin() + 2 * num_entries, indices.end());
+
+    if(num_entries > 0)
+    {
+        cusp::detail::sell_slot_row_functor<IndexType> row_functor(matrix.chunk_size, matrix.num_chunks(),
+                                                                   thrust::raw_pointer_cast(&matrix.chunk_offsets[0]),
+                                                                   thrust::raw_pointer_cast(&matrix.row_permutation[0]));
+
+        thrust::remove_copy_if(CountingIterator(0), CountingIterator(num_slots), matrix.column_indices.begin(),
+                               perm_array.begin(), thrust::placeholders::_1 == X);
+        thrust::transform(perm_array.begin(), perm_array.end(), rows_array.begin(), row_functor);
+        thrust::gather(perm_array.begin(), perm_array.end(), matrix.column_indices.begin(), cols_array.begin());
+
+        // the lanes hold the rows in permuted order
+        cusp::sort_by_row_and_column(rows_array, cols_array, perm_array,
+                                     IndexType(0), IndexType(matrix.num_rows),
+                                     IndexType(0), IndexType(matrix.num_cols));
+    }
+
+    ValuePermIterator         vals_iter(matrix.values.begin(), indices.begin() + 2 * num_entries);
+    values_array_type         vals_array(vals_iter, vals_iter + num_entries);
+
+    row_indices    = rows_array;
+    column_indices = cols_array;
+    values         = vals_array;
+}
+
+template <typename Array1, typename Array2, typename Array3, typename IndexType, typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+void coo_matrix_view<Array1,Array2,Array3,IndexType,ValueType,MemorySpace>
+::construct_from(MatrixType& matrix, cusp::symmetric_csr_format)
+{
+    typedef cusp::detail::coo_view_type<typename MatrixType::row_offsets_array_type,
+                                        typename MatrixType::column_indices_array_type,
+                                        typename MatrixType::values_array_type,
+                                        cusp::symmetric_csr_format> symmetric_view_type;
+
+    typedef typename symmetric_view_type::CountingIterator   CountingIterator;
+    typedef typename symmetric_view_type::ValuePermIterator  ValuePermIterator;
+
+    const size_t num_stored = matrix.num_entries;
+
+    cusp::array1d<IndexType,MemorySpace> upper_rows(num_stored);
+
+    if(num_stored > 0)
+        cusp::offsets_to_indices(matrix.row_offsets, upper_rows);
+
+    const size_t num_off_diagonals =
+        thrust::inner_product(upper_rows.begin(), upper_rows.end(), matrix.column_indices.begin(),
+                              size_t(0), thrust::plus<size_t>(), thrust::not_equal_to<IndexType>());
+
+    const size_t num_entries = num_stored + num_off_diagonals;
+
+    Parent::resize(matrix.num_rows, matrix.num_cols, num_entries);
+
+    // rows, columns and value positions of the entries of both triangles
+    indices.resize(3 * num_entries);
+
+    row_indices_array_type    rows_array(indices.begin(), indices.begin() + num_entries);
+    column_indices_array_type cols_array(indices.begin() + num_entries, indices.begin() + 2 * num_entries);
+    row_indices_array_type    perm_array(indices.begin() + 2 * num_entries, indices.end());
+
+    if(num_entries > 0)
+    {
+        // the stored entries followed by the mirror images of the off-diagonal entries
+        thrust::copy(upper_rows.begin(), upper_rows.end(), rows_array.begin());
+        thrust::copy(matrix.column_indices.begin(), matrix.column_indices.end(), cols_array.begin());
+        thrust::sequence(perm_array.begin(), perm_array.begin() + num_stored);
+
+        thrust::copy_if(CountingIterator(0), CountingIterator(num_stored),
+                        thrust::make_zip_iterator(thrust::make_tuple(upper_rows.begin(), matrix.column_indices.begin())),
+                        perm_array.begin() + num_stored,
+                        cusp::not_equal_pair_functor<IndexType>());
+        thrust::gather(perm_array.begin() + num_stored, perm_array.end(),
+                       matrix.column_indices.begin(), rows_array.begin() + num_stored);
+        thrust::gather(perm_array.begin() + num_stored, perm_array.end(),
+                       upper_rows.begin(), cols_array.begin() + num_stored);
+
+        cusp::sort_by_row_and_column(rows_array, cols_array, perm_array,
+                                     IndexType(0), IndexType(matrix.num_rows),
+                                     IndexType(0), IndexType(matrix.num_cols));
+    }
+
+    ValuePermIterator         vals_iter(matrix.values.begin(), indices.begin() + 2 * num_entries);
+    values_array_type         vals_array(vals_iter, vals_iter + num_entries);
+
+    row_indices    = rows_array;
+    column_indices = cols_array;
+    values         = vals_array;
+}
+
+template <typename Array1, typename Array2, typename Array3, typename IndexType, typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+void coo_matrix_view<Array1,Array2,Array3,IndexType,ValueType,MemorySpace>
+::construct_from(MatrixType& matrix, cusp::compressed_csr_format)
+{
+    typedef cusp::detail::coo_view_type<typename MatrixType::row_offsets_array_type,
+                                        typename MatrixType::column_indices_array_type,
+                                        typename MatrixType::values_array_type,
+                                        cusp::compressed_csr_format> compressed_view_type;
+
+    typedef typename compressed_view_type::CountingIterator  CountingIterator;
+    typedef typename compressed_view_type::ValuePermIterator ValuePermIterator;
+
+    const size_t num_entries = matrix.num_entries;
+
+    Parent::resize(matrix.num_rows, matrix.num_cols, num_entries);
+
+    // rows, columns and value positions of the entries
+    indices.resize(3 * num_entries);
+
+    row_indices_array_type    rows_array(indices.begin(), indices.begin() + num_entries);
+    column_indices_array_type cols_array(indices.begin() + num_entries, indices.begin() + 2 * num_entries);
+    row_indices_array_type    perm_array(indices.begin() + 2 * num_entries, indices.end());
+
+    if(num_entries > 0)
+    {
+        // the full column indices are empty when every row has deltas
+        const IndexType * full_indices = matrix.column_indices.size() == 0 ? NULL :
+                                         thrust::raw_pointer_cast(&matrix.column_indices[0]);
+
+        cusp::detail::compressed_csr_column_functor<IndexType>
+            column_functor(matrix.num_cols, matrix.delta_width,
+                           thrust::raw_pointer_cast(&matrix.row_offsets[0]),
+                           thrust::raw_pointer_cast(&matrix.column_bases[0]),
+                           full_indices,
+                           thrust::raw_pointer_cast(&matrix.column_deltas[0]));
+
+        // the entries are stored in row-major order, only the columns are decoded
+        cusp::offsets_to_indices(matrix.row_offsets, rows_array);
+        thrust::sequence(perm_array.begin(), perm_array.end());
+        thrust::transform(thrust::make_zip_iterator(thrust::make_tuple(CountingIterator(0), rows_array.begin())),
+                          thrust::make_zip_iterator(thrust::make_tuple(CountingIterator(num_entries), rows_array.end())),
+                          cols_array.begin(), column_functor);
+    }
+
+    ValuePermIterator         vals_iter(matrix.values.begin(), indices.begin() + 2 * num_entries);
+    values_array_type         vals_array(vals_iter, vals_iter + num_entries);
+
+    row_indices    = rows_array;
+    column_indices = cols_array;
+    values         = vals_array;
+}
+
 template <typename Array1, typename Array2, typename Array3, typename IndexType, typename ValueType, typename MemorySpace>
 void
 coo_matrix_view<Array1,Array2,Array3,IndexType,ValueType,MemorySpace>
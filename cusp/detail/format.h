@@ -39,9 +39,16 @@ struct array2d_format     : public dense_format  {};
 struct sparse_format      : public known_format  {};
 struct coo_format         : public sparse_format {};
 struct csr_format         : public sparse_format {};
+struct csc_format         : public sparse_format {};
 struct dia_format         : public sparse_format {};
 struct ell_format         : public sparse_format {};
 struct hyb_format         : public sparse_format {};
+struct bsr_format         : public sparse_format {};
+struct sell_format        : public sparse_format {};
+struct symmetric_csr_format : public sparse_format {};
+struct compressed_csr_format : public sparse_format {};
+
+struct sparse_vector_format : public known_format {};
 
 template<typename is_transpose>
 struct orientation {
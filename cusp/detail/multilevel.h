@@ -52,6 +52,18 @@ namespace detail
       >::type type;
   };
 
+  // only the finest level keeps a block format, the operators of the
+  // coarse levels are stored in CSR
+  template <typename FormatType>
+  struct select_level_format_type
+  {
+    typedef typename thrust::detail::eval_if<
+          thrust::detail::is_same<FormatType, cusp::bsr_format>::value
+        , thrust::detail::identity_<cusp::csr_format>
+        , thrust::detail::identity_<FormatType>
+      >::type type;
+  };
+
   template <typename SmootherType, typename ValueType, typename MemorySpace>
   struct select_smoother_type
   {
@@ -101,6 +113,8 @@ private:
 
     typedef typename detail::select_format_type<FormatType,MemorySpace>::type					        MatrixFormat;
     typedef typename detail::matrix_type<IndexType,ValueType,MemorySpace,MatrixFormat>::type	SolveMatrixType;
+    typedef typename detail::select_level_format_type<MatrixFormat>::type                    LevelFormat;
+    typedef typename detail::matrix_type<IndexType,ValueType,MemorySpace,LevelFormat>::type  LevelMatrixType;
     typedef typename detail::select_smoother_type<SmootherType,ValueType,MemorySpace>::type		Smoother;
     typedef typename detail::select_solver_type<SolverType,ValueType,MemorySpace>::type			  Solver;
 
@@ -111,9 +125,9 @@ public:
     /* \cond */
     struct level
     {
-        SolveMatrixType R;  // restriction operator
-        SolveMatrixType A;  // matrix
-        SolveMatrixType P;  // prolongation operator
+        LevelMatrixType R;  // restriction operator
+        LevelMatrixType A;  // matrix
+        LevelMatrixType P;  // prolongation operator
         cusp::array1d<ValueType,MemorySpace> x;               // per-level solution
         cusp::array1d<ValueType,MemorySpace> b;               // per-level rhs
         cusp::array1d<ValueType,MemorySpace> residual;        // per-level residual
@@ -184,10 +198,10 @@ protected:
     template <typename SolveMatrixType2, typename Level>
     void set_multilevel_matrix(const SolveMatrixType2& A, const Level& L);
 
-    void copy_or_swap_matrix(SolveMatrixType& dst, SolveMatrixType& src);
+    void copy_or_swap_matrix(LevelMatrixType& dst, LevelMatrixType& src);
 
     template <typename SolveMatrixType2>
-    void copy_or_swap_matrix(SolveMatrixType& dst, SolveMatrixType2& src);
+    void copy_or_swap_matrix(LevelMatrixType& dst, SolveMatrixType2& src);
 
     void initialize_coarse_solver(void);
 };
@@ -30,8 +30,8 @@ multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
     for( size_t lvl = 0; lvl < M.levels.size(); lvl++ )
         levels.push_back(M.levels[lvl]);
 
-    levels[0].A = *M.A_ptr;
-    A_ptr = &levels[0].A;
+    A = *M.A_ptr;
+    A_ptr = &A;
 
     residual.resize(A_ptr->num_rows);
     update.resize(A_ptr->num_rows);
@@ -67,7 +67,7 @@ void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
 
 template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
 void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
-::copy_or_swap_matrix(SolveMatrixType& dst, SolveMatrixType& src)
+::copy_or_swap_matrix(LevelMatrixType& dst, LevelMatrixType& src)
 {
     dst.swap(src);
 }
@@ -75,7 +75,7 @@ void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
 template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
 template <typename SolveMatrixType2>
 void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
-::copy_or_swap_matrix(SolveMatrixType& dst, SolveMatrixType2& src)
+::copy_or_swap_matrix(LevelMatrixType& dst, SolveMatrixType2& src)
 {
     dst = src;
 }
@@ -198,5 +198,84 @@ void generalized_spmv(const LinearOperator&  A,
     return cusp::generalized_spmv(select_system(system1,system2,system3,system4), A, x, y, z, combine, reduce);
 }
 
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Vector1,
+          typename Vector2,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void generalized_spmspv(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                        const LinearOperator&  A,
+                        const Vector1& x,
+                        Vector2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce)
+{
+    using cusp::system::detail::generic::generalized_spmspv;
+
+    return generalized_spmspv(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, x, y, combine, reduce, cusp::default_accumulator());
+}
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Vector1,
+          typename Vector2,
+          typename BinaryFunction1,
+          typename BinaryFunction2,
+          typename Accumulator>
+void generalized_spmspv(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                        const LinearOperator&  A,
+                        const Vector1& x,
+                        Vector2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        Accumulator accumulator)
+{
+    using cusp::system::detail::generic::generalized_spmspv;
+
+    return generalized_spmspv(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, x, y, combine, reduce, accumulator);
+}
+
+template <typename LinearOperator,
+          typename Vector1,
+          typename Vector2,
+          typename BinaryFunction1,
+          typename BinaryFunction2,
+          typename Accumulator>
+typename thrust::detail::enable_if_convertible<Accumulator,cusp::spmspv_accumulator>::type
+generalized_spmspv(const LinearOperator&  A,
+                   const Vector1& x,
+                   Vector2& y,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce,
+                   Accumulator accumulator)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename Vector1::memory_space        System2;
+    typedef typename Vector2::memory_space        System3;
+
+    System1 system1;
+    System2 system2;
+    System3 system3;
+
+    cusp::generalized_spmspv(select_system(system1,system2,system3), A, x, y, combine, reduce, accumulator);
+}
+
+template <typename LinearOperator,
+          typename Vector1,
+          typename Vector2,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void generalized_spmspv(const LinearOperator&  A,
+                        const Vector1& x,
+                        Vector2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce)
+{
+    cusp::generalized_spmspv(A, x, y, combine, reduce, cusp::default_accumulator());
+}
+
 } // end namespace cusp
 
@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file sell_format_utils.h
+ *  \brief Sliced ELL indexing routines
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <thrust/functional.h>
+#include <thrust/tuple.h>
+
+namespace cusp
+{
+namespace detail
+{
+
+// maps a position in the column_indices and values arrays of a sell_matrix
+// to the matrix row of the lane storing it
+template <typename IndexType>
+struct sell_slot_row_functor : public thrust::unary_function<IndexType,IndexType>
+{
+    const IndexType chunk_size;
+    const IndexType num_chunks;
+    const IndexType * chunk_offsets;
+    const IndexType * row_permutation;
+
+    sell_slot_row_functor(const IndexType chunk_size, const IndexType num_chunks,
+                          const IndexType * chunk_offsets,
+                          const IndexType * row_permutation)
+        : chunk_size(chunk_size), num_chunks(num_chunks),
+          chunk_offsets(chunk_offsets), row_permutation(row_permutation) {}
+
+    __host__ __device__
+    IndexType operator()(const IndexType n) const
+    {
+        // last chunk starting at or before n, empty chunks start after n
+        IndexType first = 0;
+        IndexType last  = num_chunks;
+
+        while(last - first > 1)
+        {
+            const IndexType middle = first + (last - first) / 2;
+
+            if(chunk_offsets[middle] <= n)
+                first = middle;
+            else
+                last = middle;
+        }
+
+        const IndexType lane = (n - chunk_offsets[first]) % chunk_size;
+
+        return row_permutation[first * chunk_size + lane];
+    }
+};
+
+// position in the column_indices and values arrays of a sell_matrix of
+// entry n of a matrix sorted by row, lane_indices is the inverse of the
+// row permutation
+template <typename IndexType>
+struct sell_entry_slot_functor
+    : public thrust::unary_function< thrust::tuple<IndexType,IndexType>, IndexType >
+{
+    const IndexType chunk_size;
+    const IndexType * row_offsets;
+    const IndexType * lane_indices;
+    const IndexType * chunk_offsets;
+
+    sell_entry_slot_functor(const IndexType chunk_size,
+                            const IndexType * row_offsets,
+                            const IndexType * lane_indices,
+                            const IndexType * chunk_offsets)
+        : chunk_size(chunk_size), row_offsets(row_offsets),
+          lane_indices(lane_indices), chunk_offsets(chunk_offsets) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    IndexType operator()(const Tuple& t) const
+    {
+        const IndexType n   = thrust::get<0>(t);
+        const IndexType row = thrust::get<1>(t);
+        const IndexType p   = lane_indices[row];
+
+        return chunk_offsets[p / chunk_size] + (n - row_offsets[row]) * chunk_size + p % chunk_size;
+    }
+};
+
+} // end namespace detail
+} // end namespace cusp
@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <cusp/array1d.h>
+
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/functional.h>
+#include <thrust/swap.h>
+
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+
+namespace cusp
+{
+namespace detail
+{
+
+template <typename T>
+struct sparse_vector_nonzero_functor : public thrust::unary_function<T,bool>
+{
+    __host__ __device__
+    bool operator()(const T& value) const
+    {
+        return value != T(0);
+    }
+};
+
+} // end namespace detail
+
+//////////////////
+// Constructors //
+//////////////////
+
+// construct from another sparse or dense vector
+template <typename IndexType, typename ValueType, class MemorySpace>
+template <typename VectorType>
+sparse_vector<IndexType,ValueType,MemorySpace>
+::sparse_vector(const VectorType& vector)
+    : length(0), num_entries(0)
+{
+    assign(vector, typename VectorType::format());
+}
+
+////////////////////////////////
+// Container Member Functions //
+////////////////////////////////
+
+template <typename IndexType, typename ValueType, class MemorySpace>
+void
+sparse_vector<IndexType,ValueType,MemorySpace>
+::resize(const size_t length, const size_t num_entries)
+{
+    this->length      = length;
+    this->num_entries = num_entries;
+    indices.resize(num_entries);
+    values.resize(num_entries);
+}
+
+template <typename IndexType, typename ValueType, class MemorySpace>
+void
+sparse_vector<IndexType,ValueType,MemorySpace>
+::swap(sparse_vector& vector)
+{
+    thrust::swap(length,      vector.length);
+    thrust::swap(num_entries, vector.num_entries);
+    indices.swap(vector.indices);
+    values.swap(vector.values);
+}
+
+// assignment from another sparse or dense vector
+template <typename IndexType, typename ValueType, class MemorySpace>
+template <typename VectorType>
+sparse_vector<IndexType,ValueType,MemorySpace>&
+sparse_vector<IndexType,ValueType,MemorySpace>
+::operator=(const VectorType& vector)
+{
+    assign(vector, typename VectorType::format());
+
+    return *this;
+}
+
+template <typename IndexType, typename ValueType, class MemorySpace>
+template <typename VectorType>
+void
+sparse_vector<IndexType,ValueType,MemorySpace>
+::assign(const VectorType& vector, cusp::sparse_vector_format)
+{
+    length      = vector.length;
+    num_entries = vector.num_entries;
+    indices     = vector.indices;
+    values      = vector.values;
+}
+
+// keep the nonzero entries of a dense vector
+template <typename IndexType, typename ValueType, class MemorySpace>
+template <typename VectorType>
+void
+sparse_vector<IndexType,ValueType,MemorySpace>
+::assign(const VectorType& vector, cusp::array1d_format)
+{
+    cusp::array1d<ValueType,MemorySpace> dense(vector);
+
+    cusp::detail::sparse_vector_nonzero_functor<ValueType> nonzero;
+
+    resize(dense.size(), thrust::count_if(dense.begin(), dense.end(), nonzero));
+
+    thrust::copy_if(thrust::make_zip_iterator(thrust::make_tuple(thrust::counting_iterator<IndexType>(0), dense.begin())),
+                    thrust::make_zip_iterator(thrust::make_tuple(thrust::counting_iterator<IndexType>(dense.size()), dense.end())),
+                    dense.begin(),
+                    thrust::make_zip_iterator(thrust::make_tuple(indices.begin(), values.begin())),
+                    nonzero);
+}
+
+///////////////////////////
+// View Member Functions //
+///////////////////////////
+
+template <typename ArrayType1, typename ArrayType2, typename IndexType, typename ValueType, typename MemorySpace>
+void
+sparse_vector_view<ArrayType1,ArrayType2,IndexType,ValueType,MemorySpace>
+::resize(const size_t length, const size_t num_entries)
+{
+    this->length      = length;
+    this->num_entries = num_entries;
+    indices.resize(num_entries);
+    values.resize(num_entries);
+}
+
+} // end namespace cusp
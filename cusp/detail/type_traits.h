@@ -41,8 +41,13 @@ namespace cusp
 template <typename, typename, typename> class array2d;
 template <typename, typename, typename> class dia_matrix;
 template <typename, typename, typename> class csr_matrix;
+template <typename, typename, typename> class csc_matrix;
 template <typename, typename, typename> class ell_matrix;
 template <typename, typename, typename> class hyb_matrix;
+template <typename, typename, typename> class bsr_matrix;
+template <typename, typename, typename> class sell_matrix;
+template <typename, typename, typename> class symmetric_csr_matrix;
+template <typename, typename, typename> class compressed_csr_matrix;
 
 namespace detail
 {
@@ -57,9 +62,14 @@ struct is_matrix_type
 template<typename MatrixType> struct is_array2d : is_matrix_type<MatrixType,cusp::array2d_format> {};
 template<typename MatrixType> struct is_coo     : is_matrix_type<MatrixType,cusp::coo_format> {};
 template<typename MatrixType> struct is_csr     : is_matrix_type<MatrixType,cusp::csr_format> {};
+template<typename MatrixType> struct is_csc     : is_matrix_type<MatrixType,cusp::csc_format> {};
 template<typename MatrixType> struct is_dia     : is_matrix_type<MatrixType,cusp::dia_format> {};
 template<typename MatrixType> struct is_ell     : is_matrix_type<MatrixType,cusp::ell_format> {};
 template<typename MatrixType> struct is_hyb     : is_matrix_type<MatrixType,cusp::hyb_format> {};
+template<typename MatrixType> struct is_bsr     : is_matrix_type<MatrixType,cusp::bsr_format> {};
+template<typename MatrixType> struct is_sell    : is_matrix_type<MatrixType,cusp::sell_format> {};
+template<typename MatrixType> struct is_symmetric_csr : is_matrix_type<MatrixType,cusp::symmetric_csr_format> {};
+template<typename MatrixType> struct is_compressed_csr : is_matrix_type<MatrixType,cusp::compressed_csr_format> {};
 
 template<typename IndexType, typename ValueType, typename MemorySpace, typename FormatTag> struct matrix_type {};
 
@@ -93,6 +103,12 @@ struct matrix_type<IndexType,ValueType,MemorySpace,cusp::csr_format>
     typedef cusp::csr_matrix<IndexType,ValueType,MemorySpace> type;
 };
 
+template<typename IndexType, typename ValueType, typename MemorySpace>
+struct matrix_type<IndexType,ValueType,MemorySpace,cusp::csc_format>
+{
+    typedef cusp::csc_matrix<IndexType,ValueType,MemorySpace> type;
+};
+
 template<typename IndexType, typename ValueType, typename MemorySpace>
 struct matrix_type<IndexType,ValueType,MemorySpace,cusp::ell_format>
 {
@@ -105,6 +121,30 @@ struct matrix_type<IndexType,ValueType,MemorySpace,cusp::hyb_format>
     typedef cusp::hyb_matrix<IndexType,ValueType,MemorySpace> type;
 };
 
+template<typename IndexType, typename ValueType, typename MemorySpace>
+struct matrix_type<IndexType,ValueType,MemorySpace,cusp::bsr_format>
+{
+    typedef cusp::bsr_matrix<IndexType,ValueType,MemorySpace> type;
+};
+
+template<typename IndexType, typename ValueType, typename MemorySpace>
+struct matrix_type<IndexType,ValueType,MemorySpace,cusp::sell_format>
+{
+    typedef cusp::sell_matrix<IndexType,ValueType,MemorySpace> type;
+};
+
+template<typename IndexType, typename ValueType, typename MemorySpace>
+struct matrix_type<IndexType,ValueType,MemorySpace,cusp::symmetric_csr_format>
+{
+    typedef cusp::symmetric_csr_matrix<IndexType,ValueType,MemorySpace> type;
+};
+
+template<typename IndexType, typename ValueType, typename MemorySpace>
+struct matrix_type<IndexType,ValueType,MemorySpace,cusp::compressed_csr_format>
+{
+    typedef cusp::compressed_csr_matrix<IndexType,ValueType,MemorySpace> type;
+};
+
 template<typename MatrixType, typename Format = typename MatrixType::format>
 struct get_index_type
 {
@@ -138,12 +178,27 @@ struct as_coo_type : as_matrix_type<MatrixType,MemorySpace,coo_format> {};
 template<typename MatrixType,typename MemorySpace=typename MatrixType::memory_space>
 struct as_csr_type : as_matrix_type<MatrixType,MemorySpace,csr_format> {};
 
+template<typename MatrixType,typename MemorySpace=typename MatrixType::memory_space>
+struct as_csc_type : as_matrix_type<MatrixType,MemorySpace,csc_format> {};
+
 template<typename MatrixType,typename MemorySpace=typename MatrixType::memory_space>
 struct as_ell_type : as_matrix_type<MatrixType,MemorySpace,ell_format> {};
 
 template<typename MatrixType,typename MemorySpace=typename MatrixType::memory_space>
 struct as_hyb_type : as_matrix_type<MatrixType,MemorySpace,hyb_format> {};
 
+template<typename MatrixType,typename MemorySpace=typename MatrixType::memory_space>
+struct as_bsr_type : as_matrix_type<MatrixType,MemorySpace,bsr_format> {};
+
+template<typename MatrixType,typename MemorySpace=typename MatrixType::memory_space>
+struct as_sell_type : as_matrix_type<MatrixType,MemorySpace,sell_format> {};
+
+template<typename MatrixType,typename MemorySpace=typename MatrixType::memory_space>
+struct as_symmetric_csr_type : as_matrix_type<MatrixType,MemorySpace,symmetric_csr_format> {};
+
+template<typename MatrixType,typename MemorySpace=typename MatrixType::memory_space>
+struct as_compressed_csr_type : as_matrix_type<MatrixType,MemorySpace,compressed_csr_format> {};
+
 template<typename RowArray, typename ColumnArray, typename ValueArray>
 struct coo_view_type<RowArray,ColumnArray,ValueArray,cusp::csr_format>
 {
@@ -261,6 +316,55 @@ struct coo_view_type<RowArray,ColumnArray,ValueArray,cusp::hyb_format>
     typedef cusp::coo_matrix_view<Array1,Array2,Array3,IndexType,ValueType,MemorySpace>                  view;
 };
 
+// COO view of a format whose entries are not stored in row-major order.
+// The view stores the value positions, rows and columns of the nonzero
+// entries back to back in its index array.
+template<typename RowArray, typename ColumnArray, typename ValueArray>
+struct permuted_coo_view_type
+{
+    typedef typename RowArray::value_type     IndexType;
+    typedef typename ValueArray::value_type   ValueType;
+    typedef typename ValueArray::memory_space MemorySpace;
+
+    typedef typename thrust::detail::remove_const<IndexType>::type                                       TempType;
+    typedef typename thrust::counting_iterator<TempType>                                                 CountingIterator;
+    typedef typename cusp::array1d<TempType,MemorySpace>::iterator                                       IndexIterator;
+    typedef typename ValueArray::iterator                                                                ValueIterator;
+    typedef thrust::permutation_iterator<ValueIterator, IndexIterator>                                   ValuePermIterator;
+
+    typedef cusp::array1d_view<IndexIterator>                                                            Array1;
+    typedef cusp::array1d_view<IndexIterator>                                                            Array2;
+    typedef cusp::array1d_view<ValuePermIterator>                                                        Array3;
+
+    typedef cusp::coo_matrix_view<Array1,Array2,Array3,IndexType,ValueType,MemorySpace>                  view;
+};
+
+// the entries of every block are spread over the rows of the block
+template<typename RowArray, typename ColumnArray, typename ValueArray>
+struct coo_view_type<RowArray,ColumnArray,ValueArray,cusp::bsr_format>
+    : permuted_coo_view_type<RowArray,ColumnArray,ValueArray> {};
+
+// the entries are reordered from column-major to row-major order
+template<typename RowArray, typename ColumnArray, typename ValueArray>
+struct coo_view_type<RowArray,ColumnArray,ValueArray,cusp::csc_format>
+    : permuted_coo_view_type<RowArray,ColumnArray,ValueArray> {};
+
+// the entries of the view are sorted by row and column
+template<typename RowArray, typename ColumnArray, typename ValueArray>
+struct coo_view_type<RowArray,ColumnArray,ValueArray,cusp::sell_format>
+    : permuted_coo_view_type<RowArray,ColumnArray,ValueArray> {};
+
+// the view holds both triangles, the value positions of an off-diagonal
+// entry and its mirror image are equal
+template<typename RowArray, typename ColumnArray, typename ValueArray>
+struct coo_view_type<RowArray,ColumnArray,ValueArray,cusp::symmetric_csr_format>
+    : permuted_coo_view_type<RowArray,ColumnArray,ValueArray> {};
+
+// the view holds the decoded column indices
+template<typename RowArray, typename ColumnArray, typename ValueArray>
+struct coo_view_type<RowArray,ColumnArray,ValueArray,cusp::compressed_csr_format>
+    : permuted_coo_view_type<RowArray,ColumnArray,ValueArray> {};
+
 } // end detail
 } // end cusp
 
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace cusp
 {
 namespace detail
@@ -27,6 +29,37 @@ IntegralType round_up(IntegralType n, IntegralType k)
     return k * ((n + k - 1) / k);
 }
 
+// Locate the intersection of the given diagonal with the merge path
+// of the row end offsets (row_offsets[1:]) and the nonzero indices
+// [0, num_entries). On return row is the number of rows that have been
+// completed before the diagonal and entry is the number of nonzeros
+// that have been consumed. Diagonals range up to num_rows + num_entries,
+// which may exceed IndexType, so the search is carried out in size_t.
+template <typename Array, typename IndexType>
+void merge_path_search(const size_t diagonal,
+                       const Array& row_offsets,
+                       const IndexType num_rows,
+                       const IndexType num_entries,
+                       IndexType& row,
+                       IndexType& entry)
+{
+    size_t lo = diagonal > size_t(num_entries) ? diagonal - size_t(num_entries) : size_t(0);
+    size_t hi = diagonal < size_t(num_rows) ? diagonal : size_t(num_rows);
+
+    while(lo < hi)
+    {
+        const size_t pivot = lo + (hi - lo) / 2;
+
+        if(size_t(row_offsets[pivot + 1]) <= diagonal - pivot - 1)
+            lo = pivot + 1;
+        else
+            hi = pivot;
+    }
+
+    row   = IndexType(lo);
+    entry = IndexType(diagonal - lo);
+}
+
 } // end namespace detail
 } // end namespace cusp
 
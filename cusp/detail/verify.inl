@@ -14,11 +14,14 @@
  *  limitations under the License.
  */
 
+#include <cusp/array1d.h>
+#include <cusp/format_utils.h>
 #include <cusp/detail/format.h>
 #include <cusp/exception.h>
 
 #include <thrust/sort.h>
 #include <thrust/count.h>
+#include <thrust/equal.h>
 #include <thrust/extrema.h>
 #include <thrust/functional.h>
 
@@ -88,6 +91,57 @@ struct is_ell_entry_in_bounds
     }
 };
 
+template <typename IndexType>
+struct is_sell_entry_in_bounds
+{
+    IndexType num_cols;
+    IndexType invalid_index;
+
+    is_sell_entry_in_bounds(IndexType num_cols, IndexType invalid_index)
+        : num_cols(num_cols), invalid_index(invalid_index) {}
+
+    __host__ __device__
+    bool operator()(const IndexType j) const
+    {
+        return (j != invalid_index) && (j >= 0) && (j < num_cols);
+    }
+};
+
+template <typename IndexType>
+struct is_sell_chunk_padded
+{
+    IndexType chunk_size;
+
+    is_sell_chunk_padded(IndexType chunk_size)
+        : chunk_size(chunk_size) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    bool operator()(const Tuple& t) const
+    {
+        return (thrust::get<1>(t) - thrust::get<0>(t)) % chunk_size == 0;
+    }
+};
+
+template <typename IndexType>
+struct is_compressed_csr_row_out_of_range
+{
+    IndexType num_cols;
+    IndexType num_indices;
+
+    is_compressed_csr_row_out_of_range(IndexType num_cols, IndexType num_indices)
+        : num_cols(num_cols), num_indices(num_indices) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    bool operator()(const Tuple& t) const
+    {
+        const IndexType base = thrust::get<2>(t);
+
+        return base >= num_cols && base - num_cols + thrust::get<1>(t) - thrust::get<0>(t) > num_indices;
+    }
+};
+
 
 ///////////////////////////////
 // Matrix-Specific Functions //
@@ -234,6 +288,164 @@ bool is_valid_matrix(const MatrixType& A,
     return true;
 }
 
+template <typename MatrixType, typename OutputStream>
+bool is_valid_matrix(const MatrixType& A,
+                     OutputStream& ostream,
+                     cusp::csc_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    // we could relax some of these conditions if necessary
+
+    if (A.column_offsets.size() != A.num_cols + 1)
+    {
+        ostream << "size of column_offsets (" << A.column_offsets.size() << ") "
+                << "should be equal to num_cols + 1 (" << (A.num_cols + 1) << ")";
+        return false;
+    }
+
+    if (A.column_offsets.front() != IndexType(0))
+    {
+        ostream << "first value in column_offsets (" << A.column_offsets.front() << ") "
+                << "should be equal to 0";
+        return false;
+    }
+
+    // TODO is this overly strict?
+    if (static_cast<size_t>(A.column_offsets.back()) != A.num_entries)
+    {
+        ostream << "last value in column_offsets (" << A.column_offsets.back() << ") "
+                << "should be equal to num_entries (" << A.num_entries << ")";
+        return false;
+    }
+
+    if (A.row_indices.size() != A.num_entries)
+    {
+        ostream << "size of row_indices (" << A.row_indices.size() << ") "
+                << "should be equal to num_entries (" << A.num_entries << ")";
+        return false;
+    }
+
+    if (A.values.size() != A.num_entries)
+    {
+        ostream << "size of values (" << A.values.size() << ") "
+                << "should be equal to num_entries (" << A.num_entries << ")";
+        return false;
+    }
+
+    // check that column_offsets is a non-decreasing sequence
+    if (!thrust::is_sorted(A.column_offsets.begin(), A.column_offsets.end()))
+    {
+        ostream << "column offsets should form a non-decreasing sequence";
+        return false;
+    }
+
+    if (A.num_entries > 0)
+    {
+        // check that row indices are within [0, num_rows)
+        thrust::pair<IndexType,IndexType> min_max = index_range(A.row_indices);
+
+        if (min_max.first < 0)
+        {
+            ostream << "row indices should be non-negative";
+            return false;
+        }
+        if (static_cast<size_t>(min_max.second) >= A.num_rows)
+        {
+            ostream << "row indices should be less than num_rows (" << A.num_rows << ")";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename MatrixType, typename OutputStream>
+bool is_valid_matrix(const MatrixType& A,
+                     OutputStream& ostream,
+                     cusp::bsr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    if (A.block_rows == 0 || A.block_cols == 0)
+    {
+        ostream << "block dimensions should be positive";
+        return false;
+    }
+
+    if (A.num_rows % A.block_rows != 0 || A.num_cols % A.block_cols != 0)
+    {
+        ostream << "matrix dimensions (" << A.num_rows << "," << A.num_cols << ") "
+                << "should be multiples of the block dimensions (" << A.block_rows << "," << A.block_cols << ")";
+        return false;
+    }
+
+    const size_t num_block_rows = A.num_rows / A.block_rows;
+    const size_t num_block_cols = A.num_cols / A.block_cols;
+    const size_t num_blocks     = A.column_indices.size();
+
+    if (A.row_offsets.size() != num_block_rows + 1)
+    {
+        ostream << "size of row_offsets (" << A.row_offsets.size() << ") "
+                << "should be equal to num_rows / block_rows + 1 (" << (num_block_rows + 1) << ")";
+        return false;
+    }
+
+    if (A.row_offsets.front() != IndexType(0))
+    {
+        ostream << "first value in row_offsets (" << A.row_offsets.front() << ") "
+                << "should be equal to 0";
+        return false;
+    }
+
+    if (static_cast<size_t>(A.row_offsets.back()) != num_blocks)
+    {
+        ostream << "last value in row_offsets (" << A.row_offsets.back() << ") "
+                << "should be equal to the number of blocks (" << num_blocks << ")";
+        return false;
+    }
+
+    if (num_blocks * A.block_rows * A.block_cols != A.num_entries)
+    {
+        ostream << "number of blocks (" << num_blocks << ") times the block size "
+                << "should be equal to num_entries (" << A.num_entries << ")";
+        return false;
+    }
+
+    if (A.values.size() != A.num_entries)
+    {
+        ostream << "size of values (" << A.values.size() << ") "
+                << "should be equal to num_entries (" << A.num_entries << ")";
+        return false;
+    }
+
+    // check that row_offsets is a non-decreasing sequence
+    if (!thrust::is_sorted(A.row_offsets.begin(), A.row_offsets.end()))
+    {
+        ostream << "row offsets should form a non-decreasing sequence";
+        return false;
+    }
+
+    if (num_blocks > 0)
+    {
+        // check that block column indices are within [0, num_cols / block_cols)
+        thrust::pair<IndexType,IndexType> min_max = index_range(A.column_indices);
+
+        if (min_max.first < 0)
+        {
+            ostream << "column indices should be non-negative";
+            return false;
+        }
+        if (static_cast<size_t>(min_max.second) >= num_block_cols)
+        {
+            ostream << "column indices should be less than num_cols / block_cols (" << num_block_cols << ")";
+            return false;
+        }
+    }
+
+    return true;
+}
+
 
 template <typename MatrixType, typename OutputStream>
 bool is_valid_matrix(const MatrixType& A,
@@ -327,6 +539,237 @@ bool is_valid_matrix(const MatrixType& A,
     return true;
 }
 
+template <typename MatrixType, typename OutputStream>
+bool is_valid_matrix(const MatrixType& A,
+                     OutputStream& ostream,
+                     cusp::sell_format)
+{
+    typedef typename MatrixType::index_type   IndexType;
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    const IndexType invalid_index = MatrixType::invalid_index;
+
+    if (A.chunk_size == 0)
+    {
+        ostream << "chunk size should be positive";
+        return false;
+    }
+
+    const size_t num_chunks = (A.num_rows + A.chunk_size - 1) / A.chunk_size;
+    const size_t num_slots  = A.column_indices.size();
+
+    if (A.chunk_offsets.size() != num_chunks + 1)
+    {
+        ostream << "size of chunk_offsets (" << A.chunk_offsets.size() << ") "
+                << "should be equal to the number of chunks + 1 (" << (num_chunks + 1) << ")";
+        return false;
+    }
+
+    if (A.row_permutation.size() != A.num_rows)
+    {
+        ostream << "size of row_permutation (" << A.row_permutation.size() << ") "
+                << "should be equal to num_rows (" << A.num_rows << ")";
+        return false;
+    }
+
+    if (A.values.size() != num_slots)
+    {
+        ostream << "size of values (" << A.values.size() << ") "
+                << "should be equal to the size of column_indices (" << num_slots << ")";
+        return false;
+    }
+
+    if (A.chunk_offsets.front() != IndexType(0))
+    {
+        ostream << "first value in chunk_offsets (" << A.chunk_offsets.front() << ") "
+                << "should be equal to 0";
+        return false;
+    }
+
+    if (static_cast<size_t>(A.chunk_offsets.back()) != num_slots)
+    {
+        ostream << "last value in chunk_offsets (" << A.chunk_offsets.back() << ") "
+                << "should be equal to the size of column_indices (" << num_slots << ")";
+        return false;
+    }
+
+    // check that every chunk stores the same number of entries per lane
+    size_t num_padded_chunks =
+        thrust::count_if(thrust::make_zip_iterator(thrust::make_tuple(A.chunk_offsets.begin(), A.chunk_offsets.begin() + 1)),
+                         thrust::make_zip_iterator(thrust::make_tuple(A.chunk_offsets.begin(), A.chunk_offsets.begin() + 1)) + num_chunks,
+                         is_sell_chunk_padded<IndexType>(A.chunk_size));
+
+    if (!thrust::is_sorted(A.chunk_offsets.begin(), A.chunk_offsets.end()) || num_padded_chunks != num_chunks)
+    {
+        ostream << "chunk offsets should form a non-decreasing sequence of multiples of the chunk size";
+        return false;
+    }
+
+    // check that row_permutation is a permutation of [0, num_rows)
+    cusp::array1d<IndexType,MemorySpace> rows(A.row_permutation.begin(), A.row_permutation.end());
+    thrust::sort(rows.begin(), rows.end());
+
+    if (!thrust::equal(rows.begin(), rows.end(), thrust::counting_iterator<IndexType>(0)))
+    {
+        ostream << "row_permutation should be a permutation of the rows";
+        return false;
+    }
+
+    // count true number of entries in sell structure
+    size_t true_num_entries = num_slots - thrust::count(A.column_indices.begin(), A.column_indices.end(), invalid_index);
+
+    if (A.num_entries != true_num_entries)
+    {
+        ostream << "number of valid column indices (" << true_num_entries << ") ";
+        ostream << "should be == num_entries (" << A.num_entries << ")";
+        return false;
+    }
+
+    // check that column indices are in [0, num_cols)
+    size_t num_entries_in_bounds =
+        thrust::count_if(A.column_indices.begin(), A.column_indices.end(),
+                         is_sell_entry_in_bounds<IndexType>(A.num_cols, invalid_index));
+
+    if (num_entries_in_bounds != true_num_entries)
+    {
+        ostream << "matrix contains (" << (true_num_entries - num_entries_in_bounds) << ") out-of-bounds column indices";
+        return false;
+    }
+
+    return true;
+}
+
+template <typename MatrixType, typename OutputStream>
+bool is_valid_matrix(const MatrixType& A,
+                     OutputStream& ostream,
+                     cusp::symmetric_csr_format)
+{
+    typedef typename MatrixType::index_type   IndexType;
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    if (A.num_rows != A.num_cols)
+    {
+        ostream << "symmetric matrix should be square";
+        return false;
+    }
+
+    if (!is_valid_matrix(A, ostream, cusp::csr_format()))
+        return false;
+
+    // check that no entry is stored below the diagonal
+    if (A.num_entries > 0)
+    {
+        cusp::array1d<IndexType,MemorySpace> row_indices(A.num_entries);
+        cusp::offsets_to_indices(A.row_offsets, row_indices);
+
+        if (!thrust::equal(row_indices.begin(), row_indices.end(), A.column_indices.begin(), thrust::less_equal<IndexType>()))
+        {
+            ostream << "column indices should not be less than the row index";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename MatrixType, typename OutputStream>
+bool is_valid_matrix(const MatrixType& A,
+                     OutputStream& ostream,
+                     cusp::compressed_csr_format)
+{
+    typedef typename MatrixType::index_type          IndexType;
+    typedef typename MatrixType::const_coo_view_type CooViewType;
+
+    if (A.delta_width != 1 && A.delta_width != 2)
+    {
+        ostream << "delta width (" << A.delta_width << ") should be 1 or 2";
+        return false;
+    }
+
+    if (A.row_offsets.size() != A.num_rows + 1)
+    {
+        ostream << "size of row_offsets (" << A.row_offsets.size() << ") "
+                << "should be equal to num_rows + 1 (" << (A.num_rows + 1) << ")";
+        return false;
+    }
+
+    if (A.column_bases.size() != A.num_rows)
+    {
+        ostream << "size of column_bases (" << A.column_bases.size() << ") "
+                << "should be equal to num_rows (" << A.num_rows << ")";
+        return false;
+    }
+
+    if (A.column_deltas.size() != A.num_entries * A.delta_width)
+    {
+        ostream << "size of column_deltas (" << A.column_deltas.size() << ") "
+                << "should be equal to num_entries * delta_width (" << (A.num_entries * A.delta_width) << ")";
+        return false;
+    }
+
+    if (A.values.size() != A.num_entries)
+    {
+        ostream << "size of values (" << A.values.size() << ") "
+                << "should be equal to num_entries (" << A.num_entries << ")";
+        return false;
+    }
+
+    if (A.row_offsets.front() != IndexType(0))
+    {
+        ostream << "first value in row_offsets (" << A.row_offsets.front() << ") "
+                << "should be equal to 0";
+        return false;
+    }
+
+    if (static_cast<size_t>(A.row_offsets.back()) != A.num_entries)
+    {
+        ostream << "last value in row_offsets (" << A.row_offsets.back() << ") "
+                << "should be equal to num_entries (" << A.num_entries << ")";
+        return false;
+    }
+
+    // check that row_offsets is a non-decreasing sequence
+    if (!thrust::is_sorted(A.row_offsets.begin(), A.row_offsets.end()))
+    {
+        ostream << "row offsets should form a non-decreasing sequence";
+        return false;
+    }
+
+    if (A.num_entries > 0)
+    {
+        // check that the rows without deltas lie within column_indices
+        size_t num_invalid_rows =
+            thrust::count_if(thrust::make_zip_iterator(thrust::make_tuple(A.row_offsets.begin(), A.row_offsets.begin() + 1, A.column_bases.begin())),
+                             thrust::make_zip_iterator(thrust::make_tuple(A.row_offsets.begin(), A.row_offsets.begin() + 1, A.column_bases.begin())) + A.num_rows,
+                             is_compressed_csr_row_out_of_range<IndexType>(A.num_cols, A.column_indices.size()));
+
+        if (num_invalid_rows > 0)
+        {
+            ostream << "full column indices of " << num_invalid_rows << " rows exceed the size of column_indices ("
+                    << A.column_indices.size() << ")";
+            return false;
+        }
+
+        // check that the decoded column indices are within [0, num_cols)
+        CooViewType A_coo(A);
+
+        thrust::pair<IndexType,IndexType> min_max = index_range(A_coo.column_indices);
+
+        if (min_max.first < 0)
+        {
+            ostream << "column indices should be non-negative";
+            return false;
+        }
+        if (static_cast<size_t>(min_max.second) >= A.num_cols)
+        {
+            ostream << "column indices should be less than num_cols (" << A.num_cols << ")";
+            return false;
+        }
+    }
+
+    return true;
+}
+
 template <typename MatrixType, typename OutputStream>
 bool is_valid_matrix(const MatrixType& A,
                      OutputStream& ostream,
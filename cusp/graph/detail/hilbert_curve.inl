@@ -58,6 +58,42 @@ void hilbert_curve(const Array2dType& G,
     cusp::graph::hilbert_curve(select_system(system1,system2), G, num_parts, parts);
 }
 
+template <typename DerivedPolicy,
+          typename Array2dType,
+          typename ArrayType,
+          typename PermutationType>
+void hilbert_curve(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                   const Array2dType& G,
+                   const size_t num_parts,
+                   ArrayType& parts,
+                   PermutationType& P)
+{
+    using cusp::system::detail::generic::hilbert_curve;
+
+    hilbert_curve(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, num_parts, parts, P);
+}
+
+template<typename Array2dType,
+         typename ArrayType,
+         typename PermutationType>
+void hilbert_curve(const Array2dType& G,
+                   const size_t num_parts,
+                   ArrayType& parts,
+                   PermutationType& P)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename Array2dType::memory_space     System1;
+    typedef typename ArrayType::memory_space       System2;
+    typedef typename PermutationType::memory_space System3;
+
+    System1 system1;
+    System2 system2;
+    System3 system3;
+
+    cusp::graph::hilbert_curve(select_system(system1,system2,system3), G, num_parts, parts, P);
+}
+
 } // end namespace graph
 } // end namespace cusp
 
@@ -52,6 +52,38 @@ pseudo_peripheral_vertex(const MatrixType& G, ArrayType& levels)
     return cusp::graph::pseudo_peripheral_vertex(select_system(system1,system2), G, levels);
 }
 
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+typename MatrixType::index_type
+pseudo_peripheral_vertex(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                         const MatrixType& G,
+                         ArrayType& levels,
+                         const size_t max_sweeps,
+                         const size_t max_candidates)
+{
+    using cusp::system::detail::generic::pseudo_peripheral_vertex;
+
+    return pseudo_peripheral_vertex(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, levels,
+                                    max_sweeps, max_candidates);
+}
+
+template<typename MatrixType, typename ArrayType>
+typename MatrixType::index_type
+pseudo_peripheral_vertex(const MatrixType& G, ArrayType& levels,
+                         const size_t max_sweeps, const size_t max_candidates)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System1;
+    typedef typename ArrayType::memory_space  System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::graph::pseudo_peripheral_vertex(select_system(system1,system2), G, levels, max_sweeps, max_candidates);
+}
+
 template<typename DerivedPolicy,
          typename MatrixType>
 typename MatrixType::index_type
@@ -17,7 +17,14 @@
 #include <cusp/detail/config.h>
 #include <thrust/system/detail/generic/select_system.h>
 
+#include <thrust/adjacent_difference.h>
+#include <thrust/binary_search.h>
+#include <thrust/sort.h>
+
+#include <thrust/iterator/counting_iterator.h>
+
 #include <cusp/exception.h>
+#include <cusp/detail/temporary_array.h>
 #include <cusp/graph/vertex_coloring.h>
 
 #include <cusp/system/detail/adl/graph/vertex_coloring.h>
@@ -56,6 +63,79 @@ size_t vertex_coloring(const MatrixType& G,
     return cusp::graph::vertex_coloring(select_system(system1,system2), G, colors);
 }
 
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                             ArrayType& colors,
+                       const bool balance)
+{
+    using cusp::system::detail::generic::vertex_coloring;
+
+    return vertex_coloring(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, colors, balance);
+}
+
+template<typename MatrixType,
+         typename ArrayType>
+size_t vertex_coloring(const MatrixType& G,
+                             ArrayType& colors,
+                       const bool balance)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System1;
+    typedef typename ArrayType::memory_space  System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::graph::vertex_coloring(select_system(system1,system2), G, colors, balance);
+}
+
+template <typename DerivedPolicy,
+          typename ArrayType1,
+          typename ArrayType2>
+void color_class_sizes(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                       const ArrayType1& colors,
+                       const size_t num_colors,
+                             ArrayType2& sizes)
+{
+    typedef typename ArrayType1::value_type IndexType;
+
+    DerivedPolicy& policy = thrust::detail::derived_cast(thrust::detail::strip_const(exec));
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> sorted_colors(policy, colors.begin(), colors.end());
+    thrust::sort(policy, sorted_colors.begin(), sorted_colors.end());
+
+    // the number of vertices with a color up to c, then of color c
+    sizes.resize(num_colors);
+
+    thrust::upper_bound(policy,
+                        sorted_colors.begin(), sorted_colors.end(),
+                        thrust::counting_iterator<IndexType>(0),
+                        thrust::counting_iterator<IndexType>(num_colors),
+                        sizes.begin());
+    thrust::adjacent_difference(policy, sizes.begin(), sizes.end(), sizes.begin());
+}
+
+template<typename ArrayType1,
+         typename ArrayType2>
+void color_class_sizes(const ArrayType1& colors,
+                       const size_t num_colors,
+                             ArrayType2& sizes)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename ArrayType1::memory_space System1;
+    typedef typename ArrayType2::memory_space System2;
+
+    System1 system1;
+    System2 system2;
+
+    cusp::graph::color_class_sizes(select_system(system1,system2), colors, num_colors, sizes);
+}
+
 } // end namespace graph
 } // end namespace cusp
 
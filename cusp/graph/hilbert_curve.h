@@ -108,6 +108,87 @@ template <class Array2dType,
 void hilbert_curve(const Array2dType& coord,
                    const size_t num_parts,
                          ArrayType& parts);
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename Array2dType,
+          typename ArrayType,
+          typename PermutationType>
+void hilbert_curve(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                   const Array2dType& coord,
+                   const size_t num_parts,
+                         ArrayType& parts,
+                         PermutationType& P);
+/*! \endcond */
+
+/**
+ * \brief Partition a graph using Hilbert curve and return the curve order
+ *
+ * \param coord Set of points in 2 or 3-D space
+ * \param num_parts Number of partitions to construct
+ * \param parts Partition assigned to each point
+ * \param P Permutation moving every point to its position along the curve
+ *
+ * \tparam Array2dType Type of input coordinates array
+ * \tparam ArrayType Type of output partition indicator array, parts
+ * \tparam PermutationType Type of output permutation matrix
+ *
+ * \par Overview
+ * Partitions the points like the overload above and also returns the
+ * order of the points along the curve as a permutation matrix, so a
+ * matrix can be reordered for locality with \p P.symmetric_permute. The
+ * coordinates are not reordered by this function. Point \p i moves to
+ * position \p P.permutation[i], so each coordinate column can be reordered
+ * by scattering it through \p P.permutation.
+ *
+ * \par Example
+ * \code
+ * #include <cusp/array1d.h>
+ * #include <cusp/array2d.h>
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/permutation_matrix.h>
+ * #include <cusp/gallery/grid.h>
+ *
+ * #include <thrust/scatter.h>
+ *
+ * //include Hilbert curve header file
+ * #include <cusp/graph/hilbert_curve.h>
+ *
+ * int main()
+ * {
+ *    // Build a 2D grid on the device
+ *    cusp::csr_matrix<int,float,cusp::device_memory> G;
+ *    cusp::gallery::grid2d(G, 4, 4);
+ *
+ *    // Generate random coordinates
+ *    cusp::array2d<float,cusp::device_memory> coords(G.num_rows, 2);
+ *    cusp::copy(cusp::random_array<float>(coords.num_entries, rand()), coords.values);
+ *
+ *    // Partition the points into 2 parts and order them along the curve
+ *    cusp::array1d<int,cusp::device_memory> parts(G.num_rows);
+ *    cusp::permutation_matrix<int,cusp::device_memory> P(G.num_rows);
+ *    cusp::graph::hilbert_curve(coords, 2, parts, P);
+ *
+ *    // Reorder the rows and columns of the graph
+ *    P.symmetric_permute(G);
+ *
+ *    // Reorder the coordinates the same way
+ *    cusp::array2d<float,cusp::device_memory> sorted_coords(G.num_rows, 2);
+ *    for(int d = 0; d < 2; d++)
+ *      thrust::scatter(coords.column(d).begin(), coords.column(d).end(),
+ *                      P.permutation.begin(), sorted_coords.column(d).begin());
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template <class Array2dType,
+          class ArrayType,
+          class PermutationType>
+void hilbert_curve(const Array2dType& coord,
+                   const size_t num_parts,
+                         ArrayType& parts,
+                         PermutationType& P);
 /*! \}
  */
 
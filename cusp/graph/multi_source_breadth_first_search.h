@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file multi_source_breadth_first_search.h
+ *  \brief Breadth-first traversals of a graph from many source vertices
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+
+namespace cusp
+{
+namespace graph
+{
+/*! \addtogroup algorithms Algorithms
+ *  \addtogroup graph_algorithms Graph Algorithms
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType,
+          typename Array2dType>
+void multi_source_breadth_first_search(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                                       const MatrixType& G,
+                                       const ArrayType& sources,
+                                             Array2dType& levels);
+/*! \endcond */
+
+/**
+ * \brief Performs a Breadth-first traversal of a graph from every vertex
+ * in a list of sources.
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of sources array
+ * \tparam Array2dType Type of levels array
+ *
+ * \param G A matrix that represents the graph (symmetric or unsymmetric)
+ * \param sources The source vertices of the traversals
+ * \param levels Resized to one row per vertex and one column per source,
+ * entry (i,s) is the level of vertex i in the traversal from sources[s] or
+ * -1 if the traversal does not reach i
+ *
+ * \par Overview
+ * The traversals run in batches of 64 sources. Every vertex keeps a 64 bit
+ * set of the traversals that reached it, and one SpMV over the (or,and)
+ * semiring advances all traversals of a batch by one level. Small
+ * frontiers are expanded with a sparse vector product.
+ *
+ *  \see http://en.wikipedia.org/wiki/Breadth-first_search
+ *
+ *  \par Example
+ *
+ *  \code
+ *  #include <cusp/array2d.h>
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/print.h>
+ *  #include <cusp/gallery/grid.h>
+ *
+ *  //include multi-source bfs header file
+ *  #include <cusp/graph/multi_source_breadth_first_search.h>
+ *
+ *  int main()
+ *  {
+ *     // Build a 2D grid on the device
+ *     cusp::csr_matrix<int,float,cusp::device_memory> G;
+ *     cusp::gallery::grid2d(G, 4, 4);
+ *
+ *     // Traverse the grid from two opposite corners
+ *     cusp::array1d<int,cusp::device_memory> sources(2);
+ *     sources[0] = 0;
+ *     sources[1] = 15;
+ *
+ *     cusp::array2d<int,cusp::device_memory> levels;
+ *     cusp::graph::multi_source_breadth_first_search(G, sources, levels);
+ *
+ *     // Print the level of every vertex from both sources
+ *     cusp::print(levels);
+ *
+ *     return 0;
+ *  }
+ *  \endcode
+ */
+template <typename MatrixType,
+          typename ArrayType,
+          typename Array2dType>
+void multi_source_breadth_first_search(const MatrixType& G,
+                                       const ArrayType& sources,
+                                             Array2dType& levels);
+/*! \}
+ */
+
+} // end namespace graph
+} // end namespace cusp
+
+#include <cusp/graph/detail/multi_source_breadth_first_search.inl>
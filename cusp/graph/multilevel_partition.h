@@ -0,0 +1,179 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file multilevel_partition.h
+ *  \brief Multilevel partitioning of a graph
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace graph
+{
+/*! \addtogroup algorithms Algorithms
+ *  \addtogroup graph_algorithms Graph Algorithms
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t multilevel_partition(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                            const MatrixType& G,
+                            const size_t num_parts,
+                                  ArrayType& parts);
+/*! \endcond */
+
+/**
+ * \brief Partition a graph with multilevel recursive bisection
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of parts array
+ *
+ * \param G A symmetric matrix that represents the graph
+ * \param num_parts Number of partitions to construct
+ * \param parts Partition assigned to each vertex
+ *
+ * \return Number of entries of G that connect different parts
+ *
+ * \par Overview
+ * Splits the vertices of G into \p num_parts parts of nearly equal size
+ * while keeping few edges between the parts, without requiring
+ * coordinates. Every bisection coarsens the graph by heavy-edge
+ * matching, bisects the coarsest graph by greedy graph growing and
+ * Fiduccia-Mattheyses refinement, and refines the bisection again on
+ * every finer graph. The values of G are ignored.
+ *
+ * \par Example
+ * \code
+ * #include <cusp/array1d.h>
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/print.h>
+ * #include <cusp/gallery/poisson.h>
+ *
+ * //include multilevel partition header file
+ * #include <cusp/graph/multilevel_partition.h>
+ *
+ * #include <iostream>
+ *
+ * int main()
+ * {
+ *    // Build a 2D Poisson matrix on the device
+ *    cusp::csr_matrix<int,float,cusp::device_memory> G;
+ *    cusp::gallery::poisson5pt(G, 16, 16);
+ *
+ *    // Array that indicates partition each vertex belongs
+ *    cusp::array1d<int,cusp::device_memory> parts(G.num_rows);
+ *
+ *    // Partition the graph into 4 parts
+ *    size_t edge_cut = cusp::graph::multilevel_partition(G, 4, parts);
+ *
+ *    // Print the number of cut entries and the per vertex membership
+ *    std::cout << "Cut entries : " << edge_cut << std::endl;
+ *    cusp::print(parts);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template <typename MatrixType,
+          typename ArrayType>
+size_t multilevel_partition(const MatrixType& G,
+                            const size_t num_parts,
+                                  ArrayType& parts);
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType,
+          typename PermutationType>
+size_t multilevel_partition(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                            const MatrixType& G,
+                            const size_t num_parts,
+                                  ArrayType& parts,
+                                  PermutationType& P);
+/*! \endcond */
+
+/**
+ * \brief Partition a graph and order its vertices by part
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of parts array
+ * \tparam PermutationType Type of permutation matrix
+ *
+ * \param G A symmetric matrix that represents the graph
+ * \param num_parts Number of partitions to construct
+ * \param parts Partition assigned to each vertex
+ * \param P Permutation that numbers the vertices part by part
+ *
+ * \return Number of entries of G that connect different parts
+ *
+ * \par Overview
+ * Partitions G like the overload above and also returns a permutation
+ * that keeps the vertices of every part contiguous and in their original
+ * order. Applying it with \p symmetric_permute groups the rows of G into
+ * blocks, e.g. blocks that fit in cache before a SpMV.
+ *
+ * \par Example
+ * \code
+ * #include <cusp/array1d.h>
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/permutation_matrix.h>
+ * #include <cusp/gallery/poisson.h>
+ *
+ * //include multilevel partition header file
+ * #include <cusp/graph/multilevel_partition.h>
+ *
+ * int main()
+ * {
+ *    // Build a 2D Poisson matrix on the device
+ *    cusp::csr_matrix<int,float,cusp::device_memory> A;
+ *    cusp::gallery::poisson5pt(A, 256, 256);
+ *
+ *    // Split the rows into 64 blocks
+ *    cusp::array1d<int,cusp::device_memory> parts(A.num_rows);
+ *    cusp::permutation_matrix<int,cusp::device_memory> P(A.num_rows);
+ *    cusp::graph::multilevel_partition(A, 64, parts, P);
+ *
+ *    // Number the rows block by block
+ *    P.symmetric_permute(A);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template <typename MatrixType,
+          typename ArrayType,
+          typename PermutationType>
+size_t multilevel_partition(const MatrixType& G,
+                            const size_t num_parts,
+                                  ArrayType& parts,
+                                  PermutationType& P);
+/*! \}
+ */
+
+} // end namespace graph
+} // end namespace cusp
+
+#include <cusp/graph/detail/multilevel_partition.inl>
@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file pagerank.h
+ *  \brief PageRank of the vertices of a graph
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace graph
+{
+/*! \addtogroup algorithms Algorithms
+ *  \addtogroup graph_algorithms Graph Algorithms
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t pagerank(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                const MatrixType& G,
+                      ArrayType& ranks,
+                const typename ArrayType::value_type damping = 0.85,
+                const typename ArrayType::value_type tolerance = 1e-6,
+                const size_t max_iterations = 100);
+/*! \endcond */
+
+/**
+ * \brief Computes the PageRank of every vertex of a graph
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of ranks array
+ *
+ * \param G A matrix that represents the graph, entry (i,j) is an edge from i to j
+ * \param ranks PageRank of each vertex, the ranks sum to one
+ * \param damping Probability of following an edge instead of jumping to a
+ * random vertex
+ * \param tolerance The iteration stops once the ranks change by less than
+ * \p tolerance in the 1-norm
+ * \param max_iterations Maximum number of iterations
+ *
+ * \return Number of iterations performed
+ *
+ * \par Overview
+ * Every iteration is one SpMV with the transpose of G over the (+,second)
+ * semiring, so the values of G are ignored. The rank of vertices without
+ * outgoing edges is spread over all vertices.
+ *
+ *  \see http://en.wikipedia.org/wiki/PageRank
+ *
+ *  \par Example
+ *
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/print.h>
+ *  #include <cusp/gallery/grid.h>
+ *
+ *  //include pagerank header file
+ *  #include <cusp/graph/pagerank.h>
+ *
+ *  int main()
+ *  {
+ *     // Build a 2D grid on the device
+ *     cusp::csr_matrix<int,float,cusp::device_memory> G;
+ *     cusp::gallery::grid2d(G, 4, 4);
+ *
+ *     cusp::array1d<float,cusp::device_memory> ranks(G.num_rows);
+ *
+ *     // Compute the PageRank of every vertex on the device
+ *     cusp::graph::pagerank(G, ranks);
+ *
+ *     // Print the ranks
+ *     cusp::print(ranks);
+ *
+ *     return 0;
+ *  }
+ *  \endcode
+ */
+template <typename MatrixType,
+          typename ArrayType>
+size_t pagerank(const MatrixType& G,
+                      ArrayType& ranks,
+                const typename ArrayType::value_type damping = 0.85,
+                const typename ArrayType::value_type tolerance = 1e-6,
+                const size_t max_iterations = 100);
+/*! \}
+ */
+
+} // end namespace graph
+} // end namespace cusp
+
+#include <cusp/graph/detail/pagerank.inl>
@@ -23,6 +23,8 @@
 #include <cusp/detail/config.h>
 #include <cusp/detail/execution_policy.h>
 
+#include <cstddef>
+
 namespace cusp
 {
 namespace graph
@@ -112,6 +114,78 @@ typename MatrixType::index_type
 pseudo_peripheral_vertex(const MatrixType& G,
                                ArrayType& levels);
 
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+typename MatrixType::index_type
+pseudo_peripheral_vertex(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                         const MatrixType& G,
+                               ArrayType& levels,
+                         const size_t max_sweeps,
+                         const size_t max_candidates);
+/*! \endcond */
+
+/**
+ * \brief Compute the pseudo-peripheral vertex of a graph with a bounded
+ * search
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of components array
+ *
+ * \param G A symmetric matrix that represents the graph
+ * \param levels Array containing the level set of all vertices from the
+ * computed pseudo-peripheral vertex.
+ * \param max_sweeps Maximum number of times the search moves to a vertex
+ * of larger eccentricity
+ * \param max_candidates Maximum number of vertices of the last level tried
+ * in every sweep
+ *
+ * \return The computed pseudo-peripheral vertex
+ *
+ * \par Overview
+ * Every sweep of the search builds the level structure of the current
+ * vertex and tries the vertices of its last level in order of increasing
+ * degree, keeping one vertex per degree (the shrinking strategy of George
+ * and Liu). The search moves to the first candidate with a deeper level
+ * structure and otherwise returns the candidate whose level structure has
+ * the smallest width. On the host, a candidate is abandoned as soon as its
+ * level structure grows wider than the narrowest one found in the sweep.
+ * With \p max_candidates equal to 1 and no limit on the sweeps this is the
+ * search performed by the overloads above. Once \p max_sweeps sweeps have
+ * moved the search, the last vertex reached is returned.
+ *
+ * \par Example
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/gallery/grid.h>
+ *
+ * //include pseudo_peripheral header file
+ * #include <cusp/graph/pseudo_peripheral.h>
+ *
+ * int main()
+ * {
+ *    // Build a 2D grid on the host
+ *    cusp::csr_matrix<int,float,cusp::host_memory> G;
+ *    cusp::gallery::grid2d(G, 64, 64);
+ *
+ *    cusp::array1d<int,cusp::host_memory> levels(G.num_rows);
+ *
+ *    // At most 3 sweeps trying up to 5 candidates each
+ *    int pseudo_vertex = cusp::graph::pseudo_peripheral_vertex(G, levels, 3, 5);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template<typename MatrixType,
+         typename ArrayType>
+typename MatrixType::index_type
+pseudo_peripheral_vertex(const MatrixType& G,
+                               ArrayType& levels,
+                         const size_t max_sweeps,
+                         const size_t max_candidates);
+
 /*! \}
  */
 
@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file single_source_shortest_path.h
+ *  \brief Shortest paths from one vertex of a weighted graph
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+
+namespace cusp
+{
+namespace graph
+{
+/*! \addtogroup algorithms Algorithms
+ *  \addtogroup graph_algorithms Graph Algorithms
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+void single_source_shortest_path(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                                 const MatrixType& G,
+                                 const typename MatrixType::index_type src,
+                                       ArrayType& distances,
+                                 const typename ArrayType::value_type delta = 0);
+/*! \endcond */
+
+/**
+ * \brief Computes the length of the shortest path from a source vertex to
+ * every vertex of a weighted graph.
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of distances array
+ *
+ * \param G A matrix that represents the graph, entry (i,j) is an edge from
+ * i to j whose weight is the value of the entry
+ * \param src The source vertex of the paths
+ * \param distances Length of the shortest path to each vertex, vertices
+ * that cannot be reached get the largest value of the distance type
+ * \param delta Bucket width of delta-stepping, if \p delta is not positive
+ * the paths are found with Bellman-Ford
+ *
+ * \par Overview
+ * The distances are relaxed by SpMVs over the (min,+) semiring. Each round
+ * only relaxes the edges of the vertices whose distance changed in the
+ * previous round, so small frontiers are expanded with a sparse vector
+ * product and the search stops as soon as no distance changes.
+ * Bellman-Ford accepts negative weights and throws \p runtime_exception if
+ * G contains a negative cycle. Delta-stepping requires non-negative
+ * weights and throws \p invalid_input_exception otherwise.
+ *
+ *  \see http://en.wikipedia.org/wiki/Bellman-Ford_algorithm
+ *
+ *  \par Example
+ *
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/print.h>
+ *  #include <cusp/gallery/grid.h>
+ *
+ *  //include shortest path header file
+ *  #include <cusp/graph/single_source_shortest_path.h>
+ *
+ *  int main()
+ *  {
+ *     // Build a 2D grid on the device
+ *     cusp::csr_matrix<int,float,cusp::device_memory> G;
+ *     cusp::gallery::grid2d(G, 4, 4);
+ *
+ *     cusp::array1d<float,cusp::device_memory> distances(G.num_rows);
+ *
+ *     // Compute the distances from vertex 0 with buckets of width 2
+ *     cusp::graph::single_source_shortest_path(G, 0, distances, 2.0f);
+ *
+ *     // Print the distances
+ *     cusp::print(distances);
+ *
+ *     return 0;
+ *  }
+ *  \endcode
+ */
+template <typename MatrixType,
+          typename ArrayType>
+void single_source_shortest_path(const MatrixType& G,
+                                 const typename MatrixType::index_type src,
+                                       ArrayType& distances,
+                                 const typename ArrayType::value_type delta = 0);
+/*! \}
+ */
+
+} // end namespace graph
+} // end namespace cusp
+
+#include <cusp/graph/detail/single_source_shortest_path.inl>
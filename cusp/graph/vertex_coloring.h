@@ -54,6 +54,7 @@ size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy
  * \param G A symmetric matrix that represents the graph
  * \param colors Contains to the color associated with each vertex
  * computed during the coloring routine
+ * \return The number of colors used
  *
  *  \see http://en.wikipedia.org/wiki/Graph_coloring
  *
@@ -89,6 +90,84 @@ template<typename MatrixType,
          typename ArrayType>
 size_t vertex_coloring(const MatrixType& G,
                              ArrayType& colors);
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                             ArrayType& colors,
+                       const bool balance);
+/*! \endcond */
+
+/**
+ * \brief Performs a vertex coloring a graph and optionally rebalances the
+ * color classes.
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of colors array
+ *
+ * \param G A symmetric matrix that represents the graph
+ * \param colors Contains to the color associated with each vertex
+ * computed during the coloring routine
+ * \param balance If true, vertices of color classes larger than the average
+ * size are afterwards moved to smaller classes that none of their neighbors
+ * uses. The number of colors does not grow and the largest class does not
+ * grow, but the classes are not guaranteed to have equal sizes.
+ * \return The number of colors used
+ *
+ *  \see http://en.wikipedia.org/wiki/Graph_coloring
+ */
+template<typename MatrixType,
+         typename ArrayType>
+size_t vertex_coloring(const MatrixType& G,
+                             ArrayType& colors,
+                       const bool balance);
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename ArrayType1,
+          typename ArrayType2>
+void color_class_sizes(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                       const ArrayType1& colors,
+                       const size_t num_colors,
+                             ArrayType2& sizes);
+/*! \endcond */
+
+/**
+ * \brief Counts the vertices of every color of a vertex coloring.
+ * \tparam ArrayType1 Type of colors array
+ * \tparam ArrayType2 Type of sizes array
+ * \param colors The color of each vertex, as computed by \p vertex_coloring
+ * \param num_colors The number of colors, as returned by \p vertex_coloring
+ * \param sizes Contains the number of vertices of each color
+ *  \par Example
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/print.h>
+ *  #include <cusp/gallery/poisson.h>
+ *  #include <cusp/graph/vertex_coloring.h>
+ *  int main()
+ *  {
+ *     cusp::csr_matrix<int,float,cusp::host_memory> G;
+ *     cusp::gallery::poisson5pt(G, 10, 10);
+ *     cusp::array1d<int,cusp::host_memory> colors(G.num_rows);
+ *     // color the graph with classes of similar sizes
+ *     size_t num_colors = cusp::graph::vertex_coloring(G, colors, true);
+ *     // print the size of each color class
+ *     cusp::array1d<int,cusp::host_memory> sizes;
+ *     cusp::graph::color_class_sizes(colors, num_colors, sizes);
+ *     cusp::print(sizes);
+ *     return 0;
+ *  }
+ *  \endcode
+ */
+template<typename ArrayType1,
+         typename ArrayType2>
+void color_class_sizes(const ArrayType1& colors,
+                       const size_t num_colors,
+                             ArrayType2& sizes);
 /*! \}
  */
 
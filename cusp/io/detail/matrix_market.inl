@@ -22,6 +22,7 @@
 #include <cusp/complex.h>
 #include <cusp/convert.h>
 #include <cusp/exception.h>
+#include <cusp/symmetric_csr_matrix.h>
 
 #include <thrust/sort.h>
 
@@ -152,19 +153,14 @@ read_input_size(Stream& input)
     return thrust::tie(num_rows, num_cols, num_entries);
 }
 
+// read the entries as stored in the file, with base-0 indices
 template <typename MatrixType, typename Stream>
-void read_coordinate_stream(MatrixType& coo,
-                            Stream& input,
-                            const matrix_market_banner& banner,
-                            cusp::host_memory,
-                            cusp::coo_format)
+void read_coordinate_entries(MatrixType& coo,
+                             Stream& input,
+                             const matrix_market_banner& banner)
 {
-    typedef typename MatrixType::index_type IndexType;
     typedef typename MatrixType::value_type ValueType;
 
-    size_t num_rows = coo.num_rows;
-    size_t num_cols = coo.num_cols;
-
     size_t num_entries_read = 0;
 
     // read file contents
@@ -240,6 +236,22 @@ void read_coordinate_stream(MatrixType& coo,
         coo.row_indices[n]    -= 1;
         coo.column_indices[n] -= 1;
     }
+}
+
+template <typename MatrixType, typename Stream>
+void read_coordinate_stream(MatrixType& coo,
+                            Stream& input,
+                            const matrix_market_banner& banner,
+                            cusp::host_memory,
+                            cusp::coo_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    size_t num_rows = coo.num_rows;
+    size_t num_cols = coo.num_cols;
+
+    read_coordinate_entries(coo, input, banner);
 
     // expand symmetric formats to "general" format
     if (banner.symmetry != "general")
@@ -327,6 +339,37 @@ void read_coordinate_stream(cusp::coo_matrix<IndexType,ValueType,cusp::host_memo
     read_coordinate_stream(coo, input, banner, cusp::host_memory(), cusp::coo_format());
 }
 
+// symmetric files are not expanded, only the stored triangle is kept
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Stream>
+void read_coordinate_stream(cusp::symmetric_csr_matrix<IndexType,ValueType,MemorySpace>& mtx, Stream& input, const matrix_market_banner& banner)
+{
+    if (banner.symmetry != "symmetric")
+    {
+        cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> temp;
+
+        read_coordinate_stream(temp, input, banner);
+
+        cusp::convert(temp, mtx);
+        return;
+    }
+
+    size_t num_rows, num_cols, num_entries;
+    thrust::tie(num_rows, num_cols, num_entries) = read_input_size(input);
+
+    cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> temp(num_rows, num_cols, num_entries);
+
+    read_coordinate_entries(temp, input, banner);
+
+    // the file stores the lower triangle, move the entries to the upper triangle
+    for(size_t n = 0; n < temp.num_entries; n++)
+        if(temp.row_indices[n] > temp.column_indices[n])
+            std::swap(temp.row_indices[n], temp.column_indices[n]);
+
+    temp.sort_by_row_and_column();
+
+    cusp::convert(temp, mtx);
+}
+
 template <typename Matrix, typename Stream>
 void read_coordinate_stream(Matrix& mtx, Stream& input, const matrix_market_banner& banner)
 {
@@ -491,6 +534,37 @@ void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::sparse_
     cusp::io::detail::write_coordinate_stream(coo, output);
 }
 
+template <typename Matrix, typename Stream>
+void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::symmetric_csr_format)
+{
+    // the stored triangle is written with a symmetric banner
+    typedef typename Matrix::index_type IndexType;
+    typedef typename Matrix::value_type ValueType;
+
+    cusp::symmetric_csr_matrix<IndexType,ValueType,cusp::host_memory> csr(mtx);
+
+    bool is_complex = thrust::detail::is_same<ValueType, cusp::complex<typename cusp::norm_type<ValueType>::type> >::value;
+
+    if (is_complex)
+        output << "%%MatrixMarket matrix coordinate complex symmetric\n";
+    else
+        output << "%%MatrixMarket matrix coordinate real symmetric\n";
+
+    output << "\t" << csr.num_rows << "\t" << csr.num_cols << "\t" << csr.num_entries << "\n";
+
+    // entry (i,j) of the upper triangle is written as entry (j,i) of the lower triangle
+    for(size_t i = 0; i < csr.num_rows; i++)
+    {
+        for(IndexType jj = csr.row_offsets[i]; jj < csr.row_offsets[i + 1]; jj++)
+        {
+            output << (csr.column_indices[jj] + 1) << " ";
+            output << (i + 1) << " ";
+            cusp::io::detail::write_value(output, csr.values[jj]);
+            output << "\n";
+        }
+    }
+}
+
 template <typename Matrix, typename Stream>
 void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::array1d_format)
 {
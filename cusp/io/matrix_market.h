@@ -46,6 +46,8 @@ namespace io
  *
  * \par Overview
  * \note any contents of \p mtx will be overwritten
+ * \note symmetric files are expanded to both triangles, except when \p mtx
+ * is a \p symmetric_csr_matrix, which keeps only the stored triangle
  *
  * \par Example
  * \code
@@ -79,6 +81,8 @@ void read_matrix_market_file(Matrix& mtx, const std::string& filename);
  *
  * \par Overview
  * \note any contents of \p mtx will be overwritten
+ * \note symmetric files are expanded to both triangles, except when \p mtx
+ * is a \p symmetric_csr_matrix, which keeps only the stored triangle
  *
  * \par Example
  * \code
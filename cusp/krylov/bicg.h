@@ -37,13 +37,14 @@ namespace krylov
 
 template <typename DerivedPolicy,
           typename LinearOperator,
+          typename LinearOperator2,
           typename VectorType1,
           typename VectorType2,
           typename Monitor,
           typename Preconditioner>
 void bicg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
           const LinearOperator& A,
-          const LinearOperator& At,
+          const LinearOperator2& At,
                 VectorType1& x,
           const VectorType2& b,
                 Monitor& monitor,
@@ -51,20 +52,22 @@ void bicg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
                 Preconditioner& Mt);
 
 template <typename LinearOperator,
+          typename LinearOperator2,
           typename VectorType1,
           typename VectorType2,
           typename Monitor>
 void bicg(const LinearOperator& A,
-          const LinearOperator& At,
+          const LinearOperator2& At,
                 VectorType1& x,
           const VectorType2& b,
                 Monitor& monitor);
 
 template <typename LinearOperator,
+          typename LinearOperator2,
           typename VectorType1,
           typename VectorType2>
 void bicg(const LinearOperator& A,
-          const LinearOperator& At,
+          const LinearOperator2& At,
                 VectorType1& x,
           const VectorType2& b);
 
@@ -74,6 +77,7 @@ void bicg(const LinearOperator& A,
  * \brief Biconjugate Gradient method
  *
  * \tparam LinearOperator is a matrix or subclass of \p linear_operator
+ * \tparam LinearOperator2 is a matrix or subclass of \p linear_operator
  * \tparam VectorType1 vector
  * \tparam Monitor is a \p monitor
  * \tparam Preconditioner is a matrix or subclass of \p linear_operator
@@ -89,6 +93,10 @@ void bicg(const LinearOperator& A,
  * \par Overview
  * Solves the linear system A x = b with preconditioner \p M.
  *
+ * \p At may have a different type than \p A, for a real \p csr_matrix
+ * \p A the \p csc_matrix_view returned by <tt>cusp::make_transpose_view(A)</tt>
+ * multiplies by the transpose without copying the matrix.
+ *
  * \par Example
  *
  *  The following code snippet demonstrates how to use \p bicg to
@@ -134,12 +142,13 @@ void bicg(const LinearOperator& A,
  *  \see \p monitor
  */
 template <typename LinearOperator,
+          typename LinearOperator2,
           typename VectorType1,
           typename VectorType2,
           typename Monitor,
           typename Preconditioner>
 void bicg(const LinearOperator& A,
-          const LinearOperator& At,
+          const LinearOperator2& At,
                 VectorType1& x,
           const VectorType2& b,
                 Monitor& monitor,
@@ -35,13 +35,14 @@ namespace bicg_detail
 
 template <typename DerivedPolicy,
           typename LinearOperator,
+          typename LinearOperator2,
           typename VectorType1,
           typename VectorType2,
           typename Monitor,
           typename Preconditioner>
 void bicg(thrust::execution_policy<DerivedPolicy> &exec,
           const LinearOperator& A,
-          const LinearOperator& At,
+          const LinearOperator2& At,
                 VectorType1& x,
           const VectorType2& b,
                 Monitor& monitor,
@@ -151,13 +152,14 @@ void bicg(thrust::execution_policy<DerivedPolicy> &exec,
 
 template <typename DerivedPolicy,
           typename LinearOperator,
+          typename LinearOperator2,
           typename VectorType1,
           typename VectorType2,
           typename Monitor,
           typename Preconditioner>
 void bicg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
           const LinearOperator& A,
-          const LinearOperator& At,
+          const LinearOperator2& At,
                 VectorType1& x,
           const VectorType2& b,
                 Monitor& monitor,
@@ -170,12 +172,13 @@ void bicg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
 }
 
 template <typename LinearOperator,
+          typename LinearOperator2,
           typename VectorType1,
           typename VectorType2,
           typename Monitor,
           typename Preconditioner>
 void bicg(const LinearOperator& A,
-          const LinearOperator& At,
+          const LinearOperator2& At,
                 VectorType1& x,
           const VectorType2& b,
                 Monitor& monitor,
@@ -194,11 +197,12 @@ void bicg(const LinearOperator& A,
 }
 
 template <typename LinearOperator,
+          typename LinearOperator2,
           typename VectorType1,
           typename VectorType2,
           typename Monitor>
 void bicg(const LinearOperator& A,
-          const LinearOperator& At,
+          const LinearOperator2& At,
                 VectorType1& x,
           const VectorType2& b,
                 Monitor& monitor)
@@ -212,10 +216,11 @@ void bicg(const LinearOperator& A,
 }
 
 template <typename LinearOperator,
+          typename LinearOperator2,
           typename VectorType1,
           typename VectorType2>
 void bicg(const LinearOperator& A,
-          const LinearOperator& At,
+          const LinearOperator2& At,
                 VectorType1& x,
           const VectorType2& b)
 {
@@ -23,6 +23,8 @@
 #include <cusp/detail/config.h>
 #include <cusp/detail/execution_policy.h>
 
+#include <thrust/detail/type_traits.h>
+
 namespace cusp
 {
 
@@ -380,6 +382,176 @@ void generalized_spmv(const LinearOperator&  A,
                             Vector3& z,
                             BinaryFunction1 combine,
                             BinaryFunction2 reduce);
+
+/**
+ * \brief Accumulation strategies of \p generalized_spmspv
+ *
+ * \par Overview
+ *  The products of a sparse matrix-sparse vector multiplication are merged
+ *  into the entries of the output by one of the following accumulators.
+ *
+ *  - \p default_accumulator lets the system choose.
+ *  - \p sort_accumulator sorts the products by output index and reduces
+ *    runs of equal indices, it is available on every system.
+ *  - \p bucket_accumulator distributes the products into buckets of
+ *    consecutive output indices and reduces every bucket in a small dense
+ *    array that stays in cache.
+ *  - \p dense_accumulator reduces the products in a dense array spanning the
+ *    whole output, which pays off once the output is no longer sparse.
+ *
+ *  Systems without a specialized bucket or dense accumulator, such as the
+ *  CUDA system, sort the products instead.
+ */
+struct spmspv_accumulator {};
+struct default_accumulator : public spmspv_accumulator {};
+struct sort_accumulator    : public spmspv_accumulator {};
+struct bucket_accumulator  : public spmspv_accumulator {};
+struct dense_accumulator   : public spmspv_accumulator {};
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Vector1,
+          typename Vector2,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void generalized_spmspv(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                        const LinearOperator&  A,
+                        const Vector1& x,
+                              Vector2& y,
+                              BinaryFunction1 combine,
+                              BinaryFunction2 reduce);
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Vector1,
+          typename Vector2,
+          typename BinaryFunction1,
+          typename BinaryFunction2,
+          typename Accumulator>
+void generalized_spmspv(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                        const LinearOperator&  A,
+                        const Vector1& x,
+                              Vector2& y,
+                              BinaryFunction1 combine,
+                              BinaryFunction2 reduce,
+                              Accumulator accumulator);
+/*! \endcond */
+
+/**
+ * \brief Implements generalized sparse matrix-sparse vector multiplication
+ *
+ * \par Overview
+ *
+ * \p generalized_spmspv multiplies a sparse matrix and a \p sparse_vector
+ * over the semiring given by \p combine and \p reduce, with the same functor
+ * interface as \p generalized_spmv. Every stored entry \c A(i,j) meeting a
+ * nonzero \c x[k] contributes <tt>combine(A(i,j), x[k])</tt> and the
+ * contributions to each output entry are merged with \p reduce. The output
+ * \p sparse_vector holds one entry for every index reached by at least one
+ * contribution, sorted by index.
+ *
+ * Both <tt>y = A * x</tt> and <tt>y = x * A</tt> are supported, the order
+ * of the arguments selects the product. With CSR storage <tt>y = A * x</tt>
+ * visits every entry of \p A once and looks up its column in \p x, so its
+ * cost does not depend on the sparsity of \p x. Only <tt>y = x * A</tt> is
+ * output sensitive: it visits just the rows of \p A selected by the entries
+ * of \p x and merges their products with the chosen accumulator. With CSC
+ * storage the roles are swapped: <tt>y = A * x</tt> visits just the columns
+ * selected by \p x, and <tt>y = x * A</tt> visits every entry. To apply a
+ * matrix to very sparse vectors, store it in CSC or store its transpose in
+ * CSR. Matrices in other formats are converted to CSR.
+ *
+ * \tparam LinearOperator  Type of matrix, or of sparse vector for <tt>x * A</tt>
+ * \tparam Vector1         Type of sparse vector, or of matrix for <tt>x * A</tt>
+ * \tparam Vector2         Type of output sparse vector
+ * \tparam BinaryFunction1 Type of binary function to combine entries
+ * \tparam BinaryFunction2 Type of binary function to reduce entries
+ * \tparam Accumulator     Type of accumulation strategy
+ *
+ * \param A input matrix (or sparse vector)
+ * \param x input sparse vector (or matrix)
+ * \param y output sparse vector
+ * \param combine binary function combining matrix and vector entries
+ * \param reduce binary function reducing the combined entries
+ * \param accumulator accumulation strategy, see \p spmspv_accumulator
+ *
+ * \par Example
+ *
+ *  The following code snippet demonstrates how to use \p generalized_spmspv
+ *  to expand a set of vertices along the edges of a graph.
+ *
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/multiply.h>
+ *  #include <cusp/sparse_vector.h>
+ *
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      // define multiply functors
+ *      thrust::multiplies<float> combine;
+ *      thrust::plus<float>       reduce;
+ *
+ *      // initialize matrix
+ *      cusp::csr_matrix<int,float,cusp::host_memory> A;
+ *      cusp::gallery::poisson5pt(A, 4, 4);
+ *
+ *      // initialize sparse vector with two nonzeros
+ *      cusp::sparse_vector<int,float,cusp::host_memory> x(16, 2);
+ *      x.indices[0] = 0;  x.values[0] = 1;
+ *      x.indices[1] = 15; x.values[1] = 2;
+ *
+ *      cusp::sparse_vector<int,float,cusp::host_memory> y;
+ *
+ *      // compute y = x * A accumulating in buckets
+ *      cusp::generalized_spmspv(x, A, y, combine, reduce, cusp::bucket_accumulator());
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ */
+template <typename LinearOperator,
+          typename Vector1,
+          typename Vector2,
+          typename BinaryFunction1,
+          typename BinaryFunction2,
+          typename Accumulator>
+typename thrust::detail::enable_if_convertible<Accumulator,cusp::spmspv_accumulator>::type
+generalized_spmspv(const LinearOperator&  A,
+                   const Vector1& x,
+                         Vector2& y,
+                         BinaryFunction1 combine,
+                         BinaryFunction2 reduce,
+                         Accumulator accumulator);
+
+/**
+ * \brief Implements generalized sparse matrix-sparse vector multiplication
+ * with the default accumulator
+ *
+ * \tparam LinearOperator  Type of matrix, or of sparse vector for <tt>x * A</tt>
+ * \tparam Vector1         Type of sparse vector, or of matrix for <tt>x * A</tt>
+ * \tparam Vector2         Type of output sparse vector
+ * \tparam BinaryFunction1 Type of binary function to combine entries
+ * \tparam BinaryFunction2 Type of binary function to reduce entries
+ *
+ * \param A input matrix (or sparse vector)
+ * \param x input sparse vector (or matrix)
+ * \param y output sparse vector
+ * \param combine binary function combining matrix and vector entries
+ * \param reduce binary function reducing the combined entries
+ */
+template <typename LinearOperator,
+          typename Vector1,
+          typename Vector2,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void generalized_spmspv(const LinearOperator&  A,
+                        const Vector1& x,
+                              Vector2& y,
+                              BinaryFunction1 combine,
+                              BinaryFunction2 reduce);
 /*! \}
  */
 
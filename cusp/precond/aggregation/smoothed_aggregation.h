@@ -98,6 +98,10 @@ struct sa_level
  *  on each level of hierarchy and LU to solve the coarse matrix in host
  *  memory.
  *
+ *  With \c cusp::bsr_format as the level format the finest matrix keeps its
+ *  block size, while the aggregation works on the scalar unknowns and the
+ *  operators of the coarse levels are stored in CSR.
+ *
  *  \par Example
  *  The following code snippet demonstrates how to use a
  *  \p smoothed_aggregation preconditioner to solve a linear system.
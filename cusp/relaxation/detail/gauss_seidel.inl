@@ -14,15 +14,20 @@
  *  limitations under the License.
  */
 
+#include <cusp/coo_matrix.h>
 #include <cusp/multiply.h>
 #include <cusp/format_utils.h>
+#include <cusp/sort.h>
 #include <cusp/graph/vertex_coloring.h>
 
 #include <cusp/system/detail/generic/relaxation/gauss_seidel.h>
 #include <cusp/system/detail/adl/relaxation/gauss_seidel.h>
 
+#include <thrust/gather.h>
 #include <thrust/reduce.h>
+#include <thrust/scatter.h>
 #include <thrust/sequence.h>
+#include <thrust/iterator/counting_iterator.h>
 #include <thrust/sort.h>
 
 namespace cusp
@@ -33,9 +38,9 @@ namespace relaxation
 template <typename ValueType, typename MemorySpace>
 template<typename MatrixType>
 gauss_seidel<ValueType,MemorySpace>
-::gauss_seidel(const MatrixType& A, sweep default_direction,
+::gauss_seidel(const MatrixType& A, sweep default_direction, bool reorder_rows,
                typename thrust::detail::enable_if_convertible<typename MatrixType::format,cusp::csr_format>::type*)
-    : ordering(A.num_rows), default_direction(default_direction)
+    : ordering(A.num_rows), default_direction(default_direction), reorder_rows(reorder_rows)
 {
     cusp::array1d<int,MemorySpace> colors(A.num_rows);
     int max_colors = cusp::graph::vertex_coloring(A, colors);
@@ -53,6 +58,24 @@ gauss_seidel<ValueType,MemorySpace>
     color_offsets = temp;
 
     cusp::extract_diagonal(A, diagonal);
+
+    if(reorder_rows)
+    {
+        // row i of the reordered matrix is row ordering[i] of A
+        cusp::array1d<int,MemorySpace> permutation(A.num_rows);
+        thrust::scatter(thrust::counting_iterator<int>(0),
+                        thrust::counting_iterator<int>(A.num_rows),
+                        ordering.begin(),
+                        permutation.begin());
+
+        cusp::coo_matrix<int,ValueType,MemorySpace> C(A);
+        cusp::array1d<int,MemorySpace> row_indices(C.num_entries);
+        thrust::gather(C.row_indices.begin(), C.row_indices.end(), permutation.begin(), row_indices.begin());
+        C.row_indices.swap(row_indices);
+
+        cusp::sort_by_row_and_column(C.row_indices, C.column_indices, C.values);
+        reordered_matrix = C;
+    }
 }
 
 // linear_operator
@@ -71,10 +94,29 @@ void gauss_seidel<ValueType,MemorySpace>
 ::operator()(const MatrixType& A, const VectorType1& b, VectorType2& x, sweep direction)
 {
     using thrust::system::detail::generic::select_system;
+    using cusp::system::detail::generic::gauss_seidel_reordered;
 
     MemorySpace system;
 
-    if(direction == FORWARD)
+    if(reorder_rows && (direction == FORWARD || direction == BACKWARD))
+    {
+        // the sweep relaxes the stored copy, so A must be the matrix the
+        // smoother was constructed with
+        if(A.num_rows != reordered_matrix.num_rows || A.num_cols != reordered_matrix.num_cols ||
+           A.num_entries != reordered_matrix.num_entries)
+            throw cusp::invalid_input_exception("matrix does not match the reordered Gauss-Seidel smoother");
+
+        const int num_colors = color_offsets.size() - 1;
+
+        for(int n = 0; n < num_colors; n++)
+        {
+            const int i = (direction == FORWARD) ? n : num_colors - 1 - n;
+
+            gauss_seidel_reordered(thrust::detail::derived_cast(system),
+                reordered_matrix, x, b, ordering, color_offsets[i], color_offsets[i+1]);
+        }
+    }
+    else if(direction == FORWARD)
     {
         for(size_t i = 0; i < color_offsets.size()-1; i++)
             gauss_seidel_indexed(thrust::detail::derived_cast(system),
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/csr_matrix.h>
 #include <cusp/linear_operator.h>
 
 namespace cusp
@@ -51,7 +52,10 @@ typedef enum
  * \tparam MemorySpace memory space of the array (\c cusp::host_memory or \c cusp::device_memory)
  *
  * \par Overview
- * Computes vertex coloring and performs indexed Gauss-Seidel relaxation
+ * Computes vertex coloring and performs indexed Gauss-Seidel relaxation.
+ * The rows of each color are relaxed in parallel. Optionally the rows of
+ * the matrix are copied in color order during construction, so each color
+ * is relaxed from a contiguous block of rows.
  *
  * \par Example
  * \code
@@ -109,12 +113,14 @@ public:
     cusp::array1d<int,MemorySpace> ordering;
     cusp::array1d<int,cusp::host_memory> color_offsets;
     cusp::array1d<ValueType,MemorySpace> diagonal;
+    cusp::csr_matrix<int,ValueType,MemorySpace> reordered_matrix;
     sweep default_direction;
+    bool reorder_rows;
     /* \endcond */
 
     /*! This constructor creates an empty \p gauss_seidel smoother.
      */
-    gauss_seidel(void) {}
+    gauss_seidel(void) : reorder_rows(false) {}
 
     /*! This constructor creates a \p gauss_seidel smoother using a given
      *  matrix and sweeping strategy (FORWARD, BACKWARD, SYMMETRIC).
@@ -125,9 +131,14 @@ public:
      *  \param A Input matrix used to create smoother.
      *  \param default_direction Sweep strategy used to perform Gauss-Seidel
      *  smoothing.
+     *  \param reorder_rows If true, a copy of \p A with its rows permuted by
+     *  color is stored and relaxed in place of the matrix passed to each
+     *  sweep. The copy is not refreshed, so the smoother must be rebuilt
+     *  when the entries of \p A change, and sweeps with a matrix of another
+     *  shape throw \p cusp::invalid_input_exception.
      */
     template <typename MatrixType>
-    gauss_seidel(const MatrixType& A, sweep default_direction=SYMMETRIC,
+    gauss_seidel(const MatrixType& A, sweep default_direction=SYMMETRIC, bool reorder_rows=false,
                  typename thrust::detail::enable_if_convertible<typename MatrixType::format,cusp::csr_format>::type* = 0);
 
     /*! Copy constructor for \p gauss_seidel smoother.
@@ -138,7 +149,8 @@ public:
      */
     template<typename MemorySpace2>
     gauss_seidel(const gauss_seidel<ValueType,MemorySpace2>& A)
-        : ordering(A.ordering), color_offsets(A.color_offsets), default_direction(A.default_direction) {}
+        : ordering(A.ordering), color_offsets(A.color_offsets), reordered_matrix(A.reordered_matrix),
+          default_direction(A.default_direction), reorder_rows(A.reorder_rows) {}
 
     /*! Perform Gauss-Seidel relaxation using default sweep specified during
      * construction of this \p gauss_seidel smoother
@@ -119,10 +119,13 @@ public:
      *  \param omega Damping factor used in SOR smoother.
      *  \param default_direction Sweep strategy used to perform Gauss-Seidel
      *  smoothing.
+     *  \param reorder_rows If true, the Gauss-Seidel sweeps relax a copy of
+     *  \p A with its rows permuted by color, which is not refreshed when the
+     *  entries of \p A change.
      */
     template <typename MatrixType>
-    sor(const MatrixType& A, const ValueType omega, sweep default_direction=SYMMETRIC)
-      : default_omega(omega), temp(A.num_cols), gs(A, default_direction) {}
+    sor(const MatrixType& A, const ValueType omega, sweep default_direction=SYMMETRIC, bool reorder_rows=false)
+      : default_omega(omega), temp(A.num_cols), gs(A, default_direction, reorder_rows) {}
 
     /*! Copy constructor for \p sor smoother.
      *
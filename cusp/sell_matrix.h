@@ -0,0 +1,592 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file sell_matrix.h
+ *  \brief Sliced ELLPACK (SELL-C-sigma) matrix format.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/memory.h>
+
+#include <cusp/detail/format.h>
+#include <cusp/detail/matrix_base.h>
+#include <cusp/detail/type_traits.h>
+
+namespace cusp
+{
+
+// forward definition
+template <typename ArrayType1, typename ArrayType2, typename ArrayType3, typename ArrayType4, typename IndexType, typename ValueType, typename MemorySpace> class sell_matrix_view;
+
+/*! \addtogroup sparse_matrices Sparse Matrices
+ */
+
+/*! \addtogroup sparse_matrix_containers Sparse Matrix Containers
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief Sliced ELLPACK (SELL-C-sigma) representation a sparse matrix
+ *
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ *  A \p sell_matrix groups the rows of the matrix into chunks of
+ *  \c chunk_size rows and stores every chunk as a small ELL matrix: the
+ *  rows of a chunk are padded to the longest row of that chunk only and
+ *  the entries are stored in column-major order, so the n-th entries of
+ *  the rows of a chunk are contiguous. Unlike \p ell_matrix a few long
+ *  rows only increase the storage of their own chunk.
+ *
+ *  Before the rows are chunked they are sorted by decreasing length
+ *  within windows of \c sort_window consecutive rows, so rows of similar
+ *  length end up in the same chunk. Row \c row_permutation[p] of the
+ *  matrix is stored in lane <tt>p % chunk_size</tt> of chunk
+ *  <tt>p / chunk_size</tt>, and the entries of chunk \c k occupy the
+ *  positions <tt>[chunk_offsets[k], chunk_offsets[k + 1])</tt> of the
+ *  \c column_indices and \c values arrays.
+ *
+ *  The host SpMV computes all rows of a chunk together, with unrolled
+ *  kernels for chunks of 4, 8, 16 and 32 rows.
+ *
+ *  When a \p sell_matrix is constructed or assigned from a matrix in
+ *  another format, the current chunk size and sort window of the
+ *  \p sell_matrix are used.
+ *
+ * \note Padded entries are marked by \c invalid_index in \c column_indices.
+ * \note A \c sort_window of 1 keeps the original row order.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to convert a \p csr_matrix
+ *  with one dense row to a \p sell_matrix with chunks of 2 rows.
+ *
+ *  \code
+ *  // include the sell_matrix header file
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/sell_matrix.h>
+ *  #include <cusp/print.h>
+ *
+ *  int main()
+ *  {
+ *    // allocate storage for (4,4) matrix with 7 nonzeros
+ *    cusp::csr_matrix<int,float,cusp::host_memory> A(4,4,7);
+ *
+ *    A.row_offsets[0] = 0;  A.row_offsets[1] = 1;
+ *    A.row_offsets[2] = 5;  A.row_offsets[3] = 6;
+ *    A.row_offsets[4] = 7;
+ *
+ *    A.column_indices[0] = 0; A.values[0] = 10;
+ *    A.column_indices[1] = 0; A.values[1] = 20;
+ *    A.column_indices[2] = 1; A.values[2] = 30;
+ *    A.column_indices[3] = 2; A.values[3] = 40;
+ *    A.column_indices[4] = 3; A.values[4] = 50;
+ *    A.column_indices[5] = 2; A.values[5] = 60;
+ *    A.column_indices[6] = 3; A.values[6] = 70;
+ *
+ *    // A now represents the following matrix
+ *    //    [10  0  0  0]
+ *    //    [20 30 40 50]
+ *    //    [ 0  0 60  0]
+ *    //    [ 0  0  0 70]
+ *
+ *    // chunks of 2 rows, sort rows within windows of 4 rows
+ *    cusp::sell_matrix<int,float,cusp::host_memory> B(A, 2, 4);
+ *
+ *    // row 1 shares its chunk with a row of length 1, the other chunk
+ *    // has width 1: B stores 2 * 4 + 2 * 1 = 10 entries instead of the
+ *    // 4 * 4 = 16 entries of an ell_matrix
+ *    cusp::print(B);
+ *  }
+ *  \endcode
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+class sell_matrix : public cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::sell_format>
+{
+private:
+
+    typedef cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::sell_format> Parent;
+
+public:
+
+    /*! Value used to pad the rows of the column_indices array.
+     */
+    const static IndexType invalid_index = static_cast<IndexType>(-1);
+
+    /*! \cond */
+    typedef typename cusp::array1d<IndexType, MemorySpace> chunk_offsets_array_type;
+    typedef typename cusp::array1d<IndexType, MemorySpace> row_permutation_array_type;
+    typedef typename cusp::array1d<IndexType, MemorySpace> column_indices_array_type;
+    typedef typename cusp::array1d<ValueType, MemorySpace> values_array_type;
+
+    typedef typename cusp::sell_matrix<IndexType, ValueType, MemorySpace> container;
+
+    typedef typename cusp::sell_matrix_view<typename chunk_offsets_array_type::view,
+            typename row_permutation_array_type::view,
+            typename column_indices_array_type::view,
+            typename values_array_type::view,
+            IndexType, ValueType, MemorySpace> view;
+
+    typedef typename cusp::sell_matrix_view<typename chunk_offsets_array_type::const_view,
+            typename row_permutation_array_type::const_view,
+            typename column_indices_array_type::const_view,
+            typename values_array_type::const_view,
+            IndexType, ValueType, MemorySpace> const_view;
+
+    typedef typename cusp::detail::coo_view_type<chunk_offsets_array_type,
+                                                 column_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::sell_format>::view coo_view_type;
+    typedef typename cusp::detail::coo_view_type<chunk_offsets_array_type,
+                                                 column_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::sell_format>::view const_coo_view_type;
+
+    template<typename MemorySpace2>
+    struct rebind
+    {
+        typedef cusp::sell_matrix<IndexType, ValueType, MemorySpace2> type;
+    };
+    /*! \endcond */
+
+    /*! Number of rows in each chunk.
+     */
+    size_t chunk_size;
+
+    /*! Number of consecutive rows sorted by length before chunking.
+     */
+    size_t sort_window;
+
+    /*! Storage for the offsets to the first entry of each chunk.
+     */
+    chunk_offsets_array_type chunk_offsets;
+
+    /*! Storage for the matrix row stored in each lane.
+     */
+    row_permutation_array_type row_permutation;
+
+    /*! Storage for the column indices of the chunks.
+     */
+    column_indices_array_type column_indices;
+
+    /*! Storage for the entries of the chunks.
+     */
+    values_array_type values;
+
+    /*! Construct an empty \p sell_matrix with chunks of 8 rows sorted
+     *  within windows of 256 rows.
+     */
+    sell_matrix(void)
+        : chunk_size(8), sort_window(256) {}
+
+    /*! Construct a \p sell_matrix with a specific shape, number of nonzero
+     *  entries and number of stored entries.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param num_slots Number of stored entries, including padding.
+     *  \param chunk_size Number of rows in each chunk (default 8).
+     *  \param sort_window Number of rows sorted by length (default 256).
+     */
+    sell_matrix(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+                const size_t num_slots, const size_t chunk_size = 8, const size_t sort_window = 256)
+        : Parent(num_rows, num_cols, num_entries),
+          chunk_size(chunk_size),
+          sort_window(sort_window),
+          chunk_offsets((num_rows + chunk_size - 1) / chunk_size + 1),
+          row_permutation(num_rows),
+          column_indices(num_slots),
+          values(num_slots) {}
+
+    /*! Construct a \p sell_matrix from another matrix.
+     *
+     *  \tparam MatrixType Type of input matrix used to create this \p
+     *  sell_matrix.
+     *
+     *  \param matrix Another sparse or dense matrix.
+     */
+    template <typename MatrixType>
+    sell_matrix(const MatrixType& matrix);
+
+    /*! Construct a \p sell_matrix with a specific chunk size and sort
+     *  window from another matrix.
+     *
+     *  \tparam MatrixType Type of input matrix used to create this \p
+     *  sell_matrix.
+     *
+     *  \param matrix Another sparse or dense matrix.
+     *  \param chunk_size Number of rows in each chunk.
+     *  \param sort_window Number of rows sorted by length.
+     */
+    template <typename MatrixType>
+    sell_matrix(const MatrixType& matrix, const size_t chunk_size, const size_t sort_window);
+
+    /*! Number of chunks.
+     */
+    size_t num_chunks(void) const
+    {
+        return chunk_offsets.size() - 1;
+    }
+
+    /*! Resize matrix dimensions and underlying storage
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param num_slots Number of stored entries, including padding.
+     */
+    void resize(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+                const size_t num_slots);
+
+    /*! Resize matrix dimensions and underlying storage
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param num_slots Number of stored entries, including padding.
+     *  \param chunk_size Number of rows in each chunk.
+     */
+    void resize(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+                const size_t num_slots, const size_t chunk_size);
+
+    /*! Swap the contents of two \p sell_matrix objects.
+     *
+     *  \param matrix Another \p sell_matrix with the same IndexType and ValueType.
+     */
+    void swap(sell_matrix& matrix);
+
+    /*! Assignment from another matrix, a matrix in another format is
+     *  converted with the current chunk size and sort window.
+     *
+     *  \tparam MatrixType Type of input matrix to copy into this \p
+     *  sell_matrix.
+     *
+     *  \param matrix Another sparse or dense matrix.
+     */
+    template <typename MatrixType>
+    sell_matrix& operator=(const MatrixType& matrix);
+
+}; // class sell_matrix
+/*! \}
+ */
+
+/**
+ * \addtogroup sparse_matrix_views Sparse Matrix Views
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief View of a \p sell_matrix
+ *
+ * \tparam ArrayType1 Type of \c chunk_offsets array view
+ * \tparam ArrayType2 Type of \c row_permutation array view
+ * \tparam ArrayType3 Type of \c column_indices array view
+ * \tparam ArrayType4 Type of \c values array view
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ *  A \p sell_matrix_view is a sparse matrix view of a matrix in SELL-C-sigma
+ *  format constructed from existing data or iterators. See \p sell_matrix
+ *  for the layout of the arrays.
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename ArrayType4,
+          typename IndexType   = typename ArrayType1::value_type,
+          typename ValueType   = typename ArrayType4::value_type,
+          typename MemorySpace = typename cusp::minimum_space<
+                                    typename ArrayType1::memory_space,
+                                    typename ArrayType2::memory_space,
+                                    typename ArrayType3::memory_space,
+                                    typename ArrayType4::memory_space>::type >
+class sell_matrix_view : public cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::sell_format>
+{
+private:
+
+    typedef cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::sell_format> Parent;
+
+public:
+
+    /*! \cond */
+    typedef ArrayType1 chunk_offsets_array_type;
+    typedef ArrayType2 row_permutation_array_type;
+    typedef ArrayType3 column_indices_array_type;
+    typedef ArrayType4 values_array_type;
+
+    typedef typename cusp::sell_matrix<IndexType, ValueType, MemorySpace> container;
+    typedef typename cusp::sell_matrix_view<ArrayType1, ArrayType2, ArrayType3, ArrayType4, IndexType, ValueType, MemorySpace> view;
+    typedef typename cusp::sell_matrix_view<ArrayType1, ArrayType2, ArrayType3, ArrayType4, IndexType, ValueType, MemorySpace> const_view;
+
+    typedef typename cusp::detail::coo_view_type<chunk_offsets_array_type,
+                                                 column_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::sell_format>::view coo_view_type;
+    typedef typename cusp::detail::coo_view_type<chunk_offsets_array_type,
+                                                 column_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::sell_format>::view const_coo_view_type;
+    /*! \endcond */
+
+    /**
+     * Value used to pad the rows of the column_indices array.
+     */
+    const static IndexType invalid_index = container::invalid_index;
+
+    /**
+     * Number of rows in each chunk.
+     */
+    size_t chunk_size;
+
+    /**
+     * Number of consecutive rows sorted by length before chunking.
+     */
+    size_t sort_window;
+
+    /**
+     * View of the offsets to the first entry of each chunk.
+     */
+    chunk_offsets_array_type chunk_offsets;
+
+    /**
+     * View of the matrix row stored in each lane.
+     */
+    row_permutation_array_type row_permutation;
+
+    /**
+     * View of the column indices of the chunks.
+     */
+    column_indices_array_type column_indices;
+
+    /**
+     * View of the entries of the chunks.
+     */
+    values_array_type values;
+
+    /**
+     * Construct an empty \p sell_matrix_view.
+     */
+    sell_matrix_view(void)
+        : Parent(), chunk_size(8), sort_window(256) {}
+
+    /*! Construct a \p sell_matrix_view with a specific shape and number of
+     *  nonzero entries from existing arrays denoting the chunk offsets, row
+     *  permutation, column indices and values.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param chunk_size Number of rows in each chunk.
+     *  \param sort_window Number of rows sorted by length.
+     *  \param chunk_offsets Array containing the chunk offsets.
+     *  \param row_permutation Array containing the row stored in each lane.
+     *  \param column_indices Array containing the column indices.
+     *  \param values Array containing the values.
+     */
+    sell_matrix_view(const size_t num_rows,
+                     const size_t num_cols,
+                     const size_t num_entries,
+                     const size_t chunk_size,
+                     const size_t sort_window,
+                     ArrayType1 chunk_offsets,
+                     ArrayType2 row_permutation,
+                     ArrayType3 column_indices,
+                     ArrayType4 values)
+        : Parent(num_rows, num_cols, num_entries),
+          chunk_size(chunk_size),
+          sort_window(sort_window),
+          chunk_offsets(chunk_offsets),
+          row_permutation(row_permutation),
+          column_indices(column_indices),
+          values(values) {}
+
+    /*! Construct a \p sell_matrix_view from a existing \p sell_matrix.
+     *
+     *  \param matrix \p sell_matrix used to create view.
+     */
+    sell_matrix_view(sell_matrix<IndexType,ValueType,MemorySpace>& matrix)
+        : Parent(matrix),
+          chunk_size(matrix.chunk_size),
+          sort_window(matrix.sort_window),
+          chunk_offsets(matrix.chunk_offsets),
+          row_permutation(matrix.row_permutation),
+          column_indices(matrix.column_indices),
+          values(matrix.values) {}
+
+    /*! Construct a \p sell_matrix_view from a existing const \p sell_matrix.
+     *
+     *  \param matrix \p sell_matrix used to create view.
+     */
+    sell_matrix_view(const sell_matrix<IndexType,ValueType,MemorySpace>& matrix)
+        : Parent(matrix),
+          chunk_size(matrix.chunk_size),
+          sort_window(matrix.sort_window),
+          chunk_offsets(matrix.chunk_offsets),
+          row_permutation(matrix.row_permutation),
+          column_indices(matrix.column_indices),
+          values(matrix.values) {}
+
+    /*! Construct a \p sell_matrix_view from a existing \p sell_matrix_view.
+     *
+     *  \param matrix \p sell_matrix_view used to create view.
+     */
+    sell_matrix_view(sell_matrix_view& matrix)
+        : Parent(matrix),
+          chunk_size(matrix.chunk_size),
+          sort_window(matrix.sort_window),
+          chunk_offsets(matrix.chunk_offsets),
+          row_permutation(matrix.row_permutation),
+          column_indices(matrix.column_indices),
+          values(matrix.values) {}
+
+    /*! Construct a \p sell_matrix_view from a existing const \p sell_matrix_view.
+     *
+     *  \param matrix \p sell_matrix_view used to create view.
+     */
+    sell_matrix_view(const sell_matrix_view& matrix)
+        : Parent(matrix),
+          chunk_size(matrix.chunk_size),
+          sort_window(matrix.sort_window),
+          chunk_offsets(matrix.chunk_offsets),
+          row_permutation(matrix.row_permutation),
+          column_indices(matrix.column_indices),
+          values(matrix.values) {}
+
+    /*! Number of chunks.
+     */
+    size_t num_chunks(void) const
+    {
+        return chunk_offsets.size() - 1;
+    }
+
+    /*! Resize matrix dimensions and underlying storage
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param num_slots Number of stored entries, including padding.
+     */
+    void resize(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+                const size_t num_slots);
+};
+
+/* Convenience functions */
+
+/**
+ *  This is a convenience function for generating an \p sell_matrix_view
+ *  using individual arrays
+ *  \tparam ArrayType1 chunk offsets array type
+ *  \tparam ArrayType2 row permutation array type
+ *  \tparam ArrayType3 column indices array type
+ *  \tparam ArrayType4 values array type
+ *
+ *  \param num_rows Number of rows.
+ *  \param num_cols Number of columns.
+ *  \param num_entries Number of nonzero matrix entries.
+ *  \param chunk_size Number of rows in each chunk.
+ *  \param sort_window Number of rows sorted by length.
+ *  \param chunk_offsets Array containing the chunk offsets.
+ *  \param row_permutation Array containing the row stored in each lane.
+ *  \param column_indices Array containing the column indices.
+ *  \param values Array containing the values.
+ *
+ *  \return \p sell_matrix_view constructed using input arrays
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename ArrayType4>
+sell_matrix_view<ArrayType1,ArrayType2,ArrayType3,ArrayType4>
+make_sell_matrix_view(size_t num_rows,
+                      size_t num_cols,
+                      size_t num_entries,
+                      size_t chunk_size,
+                      size_t sort_window,
+                      ArrayType1 chunk_offsets,
+                      ArrayType2 row_permutation,
+                      ArrayType3 column_indices,
+                      ArrayType4 values)
+{
+    sell_matrix_view<ArrayType1,ArrayType2,ArrayType3,ArrayType4>
+           view(num_rows, num_cols, num_entries, chunk_size, sort_window,
+                chunk_offsets, row_permutation, column_indices, values);
+
+    return view;
+}
+
+/**
+ *  This is a convenience function for generating an \p sell_matrix_view
+ *  using an existing \p sell_matrix.
+ *
+ *  \tparam IndexType  indices type
+ *  \tparam ValueType  values type
+ *  \tparam MemorySpace memory space of the arrays
+ *
+ *  \param m Exemplar \p sell_matrix matrix to copy.
+ *
+ *  \return \p sell_matrix_view constructed using input arrays.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename sell_matrix<IndexType,ValueType,MemorySpace>::view
+make_sell_matrix_view(sell_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_sell_matrix_view
+           (m.num_rows, m.num_cols, m.num_entries, m.chunk_size, m.sort_window,
+            make_array1d_view(m.chunk_offsets),
+            make_array1d_view(m.row_permutation),
+            make_array1d_view(m.column_indices),
+            make_array1d_view(m.values));
+}
+
+/**
+ *  This is a convenience function for generating an const \p sell_matrix_view
+ *  using an existing \p sell_matrix.
+ *
+ *  \tparam IndexType  indices type
+ *  \tparam ValueType  values type
+ *  \tparam MemorySpace memory space of the arrays
+ *
+ *  \param m Exemplar \p sell_matrix matrix to copy.
+ *
+ *  \return \p sell_matrix_view constructed using input arrays.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename sell_matrix<IndexType,ValueType,MemorySpace>::const_view
+make_sell_matrix_view(const sell_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_sell_matrix_view
+           (m.num_rows, m.num_cols, m.num_entries, m.chunk_size, m.sort_window,
+            make_array1d_view(m.chunk_offsets),
+            make_array1d_view(m.row_permutation),
+            make_array1d_view(m.column_indices),
+            make_array1d_view(m.values));
+}
+/*! \}
+ */
+
+} // end namespace cusp
+
+#include <cusp/detail/sell_matrix.inl>
@@ -0,0 +1,367 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file sparse_vector.h
+ *  \brief Sparse vector container
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/detail/format.h>
+
+#include <cusp/array1d.h>
+
+namespace cusp
+{
+
+/*! \cond */
+// forward definition
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename IndexType,
+          typename ValueType,
+          typename MemorySpace> class sparse_vector_view;
+/*! \endcond */
+
+/**
+ *  \addtogroup array_containers Array Containers
+ *  \ingroup arrays
+ *  \{
+ */
+
+/**
+ * \brief Sparse vector stored as sorted indices and values
+ *
+ * \tparam IndexType Type used for vector indices (e.g. \c int).
+ * \tparam ValueType Type used for vector values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ *  A \p sparse_vector stores the index and the value of every nonzero entry
+ *  of a vector of a given length. The entries are sorted by index and the
+ *  vector should not contain duplicate indices. Sparse vectors are the
+ *  inputs and outputs of \p generalized_spmspv.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to create a sparse vector of
+ *  length 10 with 3 nonzeros.
+ *
+ *  \code
+ * #include <cusp/sparse_vector.h>
+ *
+ * int main()
+ * {
+ *      // allocate storage for a vector of length 10 with 3 nonzeros
+ *      cusp::sparse_vector<int,float,cusp::host_memory> x(10,3);
+ *
+ *      x.indices[0] = 1; x.values[0] = 10;
+ *      x.indices[1] = 4; x.values[1] = 20;
+ *      x.indices[2] = 7; x.values[2] = 30;
+ *
+ *      // x now represents the vector
+ *      // [0 10 0 0 20 0 0 30 0 0]
+ *
+ *      // copy to the device
+ *      cusp::sparse_vector<int,float,cusp::device_memory> y(x);
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+class sparse_vector
+{
+public:
+
+    /*! \cond */
+    typedef IndexType                  index_type;
+    typedef ValueType                  value_type;
+    typedef MemorySpace                memory_space;
+    typedef cusp::sparse_vector_format format;
+
+    typedef typename cusp::array1d<IndexType, MemorySpace> indices_array_type;
+    typedef typename cusp::array1d<ValueType, MemorySpace> values_array_type;
+
+    typedef typename cusp::sparse_vector<IndexType, ValueType, MemorySpace> container;
+
+    typedef typename cusp::sparse_vector_view<
+            typename indices_array_type::view,
+            typename values_array_type::view,
+            IndexType, ValueType, MemorySpace> view;
+
+    typedef typename cusp::sparse_vector_view<
+            typename indices_array_type::const_view,
+            typename values_array_type::const_view,
+            IndexType, ValueType, MemorySpace> const_view;
+
+    template<typename MemorySpace2>
+    struct rebind
+    {
+        typedef cusp::sparse_vector<IndexType, ValueType, MemorySpace2> type;
+    };
+    /*! \endcond */
+
+    /*! Length of the vector.
+     */
+    size_t length;
+
+    /*! Number of stored entries.
+     */
+    size_t num_entries;
+
+    /*! Storage for the indices of the nonzero entries.
+     */
+    indices_array_type indices;
+
+    /*! Storage for the values of the nonzero entries.
+     */
+    values_array_type values;
+
+    /*! Construct an empty \p sparse_vector.
+     */
+    sparse_vector(void)
+        : length(0), num_entries(0) {}
+
+    /*! Construct a \p sparse_vector with a specific length and number of nonzero entries.
+     *
+     *  \param length Length of the vector.
+     *  \param num_entries Number of nonzero entries.
+     */
+    sparse_vector(const size_t length, const size_t num_entries)
+        : length(length), num_entries(num_entries),
+          indices(num_entries), values(num_entries) {}
+
+    /*! Construct a \p sparse_vector from another sparse vector or from a
+     *  dense \p array1d, in which case only the nonzero entries are kept.
+     *
+     *  \param vector Another sparse or dense vector.
+     */
+    template <typename VectorType>
+    sparse_vector(const VectorType& vector);
+
+    /*! Resize the vector length and underlying storage
+     *
+     *  \param length Length of the vector.
+     *  \param num_entries Number of nonzero entries.
+     */
+    void resize(const size_t length, const size_t num_entries);
+
+    /*! Swap the contents of two \p sparse_vector objects.
+     *
+     *  \param vector Another \p sparse_vector with the same IndexType and ValueType.
+     */
+    void swap(sparse_vector& vector);
+
+    /*! Assignment from another sparse or dense vector.
+     *
+     *  \param vector Another sparse or dense vector.
+     *  \return \p sparse_vector constructed from existing vector.
+     */
+    template <typename VectorType>
+    sparse_vector& operator=(const VectorType& vector);
+
+protected:
+    /*! \cond */
+    template <typename VectorType>
+    void assign(const VectorType& vector, cusp::sparse_vector_format);
+
+    template <typename VectorType>
+    void assign(const VectorType& vector, cusp::array1d_format);
+    /*! \endcond */
+}; // class sparse_vector
+
+/**
+ * \brief View of a \p sparse_vector
+ *
+ * \tparam ArrayType1 Type of \c indices array view
+ * \tparam ArrayType2 Type of \c values array view
+ * \tparam IndexType Type used for vector indices (e.g. \c int).
+ * \tparam ValueType Type used for vector values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ *  A \p sparse_vector_view wraps existing index and value arrays. As with
+ *  \p sparse_vector the entries must be sorted by index.
+ *
+ * \par Example
+ *  \code
+ * #include <cusp/sparse_vector.h>
+ *
+ * int main()
+ * {
+ *    cusp::array1d<int,cusp::host_memory>   indices(2);
+ *    cusp::array1d<float,cusp::host_memory> values(2);
+ *
+ *    indices[0] = 2; values[0] = 1.0f;
+ *    indices[1] = 5; values[1] = 3.0f;
+ *
+ *    // view the arrays as a vector of length 8 with 2 nonzeros
+ *    cusp::make_sparse_vector_view(8, 2,
+ *                                  cusp::make_array1d_view(indices),
+ *                                  cusp::make_array1d_view(values));
+ *  }
+ *  \endcode
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename IndexType   = typename ArrayType1::value_type,
+          typename ValueType   = typename ArrayType2::value_type,
+          typename MemorySpace = typename cusp::minimum_space<
+                                    typename ArrayType1::memory_space,
+                                    typename ArrayType2::memory_space>::type >
+class sparse_vector_view
+{
+public:
+
+    /*! \cond */
+    typedef IndexType                  index_type;
+    typedef ValueType                  value_type;
+    typedef MemorySpace                memory_space;
+    typedef cusp::sparse_vector_format format;
+
+    typedef ArrayType1 indices_array_type;
+    typedef ArrayType2 values_array_type;
+
+    typedef typename cusp::sparse_vector<IndexType, ValueType, MemorySpace> container;
+    typedef typename cusp::sparse_vector_view<ArrayType1, ArrayType2, IndexType, ValueType, MemorySpace> view;
+    typedef typename cusp::sparse_vector_view<ArrayType1, ArrayType2, IndexType, ValueType, MemorySpace> const_view;
+    /*! \endcond */
+
+    /*! Length of the vector.
+     */
+    size_t length;
+
+    /*! Number of stored entries.
+     */
+    size_t num_entries;
+
+    /*! View of the indices of the nonzero entries.
+     */
+    indices_array_type indices;
+
+    /*! View of the values of the nonzero entries.
+     */
+    values_array_type values;
+
+    /*! Construct an empty \p sparse_vector_view.
+     */
+    sparse_vector_view(void)
+        : length(0), num_entries(0) {}
+
+    /*! Construct a \p sparse_vector_view from existing index and value arrays.
+     *
+     *  \param length Length of the vector.
+     *  \param num_entries Number of nonzero entries.
+     *  \param indices Array containing the indices.
+     *  \param values Array containing the values.
+     */
+    sparse_vector_view(const size_t length,
+                       const size_t num_entries,
+                       ArrayType1 indices,
+                       ArrayType2 values)
+        : length(length), num_entries(num_entries),
+          indices(indices), values(values) {}
+
+    /*! Construct a \p sparse_vector_view from an existing \p sparse_vector.
+     *
+     *  \param vector \p sparse_vector used to create view.
+     */
+    sparse_vector_view(sparse_vector<IndexType,ValueType,MemorySpace>& vector)
+        : length(vector.length), num_entries(vector.num_entries),
+          indices(vector.indices), values(vector.values) {}
+
+    /*! Construct a \p sparse_vector_view from an existing const \p sparse_vector.
+     *
+     *  \param vector \p sparse_vector used to create view.
+     */
+    sparse_vector_view(const sparse_vector<IndexType,ValueType,MemorySpace>& vector)
+        : length(vector.length), num_entries(vector.num_entries),
+          indices(vector.indices), values(vector.values) {}
+
+    /*! Resize the vector length and the viewed arrays, the number of
+     *  entries may not exceed the capacity of the views.
+     *
+     *  \param length Length of the vector.
+     *  \param num_entries Number of nonzero entries.
+     */
+    void resize(const size_t length, const size_t num_entries);
+}; // class sparse_vector_view
+
+/* Convenience functions */
+
+/**
+ *  This is a convenience function for generating a \p sparse_vector_view
+ *  using individual arrays
+ *
+ *  \tparam ArrayType1 indices array type
+ *  \tparam ArrayType2 values array type
+ *
+ *  \param length Length of the vector.
+ *  \param num_entries Number of nonzero entries.
+ *  \param indices Array containing the indices.
+ *  \param values Array containing the values.
+ *
+ *  \return \p sparse_vector_view constructed using input arrays
+ */
+template <typename ArrayType1,
+          typename ArrayType2>
+sparse_vector_view<ArrayType1,ArrayType2>
+make_sparse_vector_view(const size_t length,
+                        const size_t num_entries,
+                        ArrayType1 indices,
+                        ArrayType2 values)
+{
+    return sparse_vector_view<ArrayType1,ArrayType2>(length, num_entries, indices, values);
+}
+
+/**
+ *  This is a convenience function for generating a \p sparse_vector_view
+ *  using an existing \p sparse_vector.
+ *
+ *  \param v Exemplar \p sparse_vector to view.
+ *
+ *  \return \p sparse_vector_view constructed using input vector.
+ */
+template <typename IndexType, typename ValueType, typename MemorySpace>
+typename sparse_vector<IndexType,ValueType,MemorySpace>::view
+make_sparse_vector_view(sparse_vector<IndexType,ValueType,MemorySpace>& v)
+{
+    return typename sparse_vector<IndexType,ValueType,MemorySpace>::view(v);
+}
+
+/**
+ *  This is a convenience function for generating a const \p sparse_vector_view
+ *  using an existing \p sparse_vector.
+ *
+ *  \param v Exemplar \p sparse_vector to view.
+ *
+ *  \return \p sparse_vector_view constructed using input vector.
+ */
+template <typename IndexType, typename ValueType, typename MemorySpace>
+typename sparse_vector<IndexType,ValueType,MemorySpace>::const_view
+make_sparse_vector_view(const sparse_vector<IndexType,ValueType,MemorySpace>& v)
+{
+    return typename sparse_vector<IndexType,ValueType,MemorySpace>::const_view(v);
+}
+/*! \}
+ */
+
+} // end namespace cusp
+
+#include <cusp/detail/sparse_vector.inl>
@@ -0,0 +1,465 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file symmetric_csr_matrix.h
+ *  \brief Symmetric Compressed Sparse Row matrix format.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/memory.h>
+
+#include <cusp/detail/format.h>
+#include <cusp/detail/matrix_base.h>
+#include <cusp/detail/type_traits.h>
+
+namespace cusp
+{
+
+// forward definition
+template <typename ArrayType1, typename ArrayType2, typename ArrayType3, typename IndexType, typename ValueType, typename MemorySpace> class symmetric_csr_matrix_view;
+
+/*! \addtogroup sparse_matrices Sparse Matrices
+ */
+
+/*! \addtogroup sparse_matrix_containers Sparse Matrix Containers
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief Symmetric compressed sparse row representation a sparse matrix
+ *
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ *  A \p symmetric_csr_matrix is a sparse matrix container for square
+ *  symmetric matrices that stores the diagonal and the upper triangle of
+ *  the matrix in CSR format, each off-diagonal entry <tt>A(i,j)</tt> with
+ *  <tt>i < j</tt> also represents the entry <tt>A(j,i)</tt>. Compared to a
+ *  \p csr_matrix this needs about half the storage and half the memory
+ *  traffic of a SpMV.
+ *
+ *  The host SpMV applies every off-diagonal entry twice, once to its row
+ *  and once to its column. Matrices in other formats are expanded to both
+ *  triangles when they are converted from a \p symmetric_csr_matrix, when
+ *  a \p symmetric_csr_matrix is constructed from another matrix the
+ *  entries below the diagonal are dropped.
+ *
+ * \note \c num_entries is the number of stored entries, the matrix
+ * represents <tt>2 * num_entries</tt> minus the number of diagonal
+ * entries nonzeros.
+ * \note The matrix entries must be sorted by row index and internally
+ * within each row sorted by column index.
+ * \note The matrix should not contain duplicate entries.
+ * \note Complex matrices are treated as symmetric, not Hermitian.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to store a 3-by-3
+ *  symmetric matrix on the host with 4 stored entries and multiply it by
+ *  a vector.
+ *
+ *  \code
+ *  // include the symmetric_csr_matrix header file
+ *  #include <cusp/symmetric_csr_matrix.h>
+ *  #include <cusp/multiply.h>
+ *  #include <cusp/print.h>
+ *
+ *  int main()
+ *  {
+ *    // allocate storage for (3,3) matrix with 4 stored entries
+ *    cusp::symmetric_csr_matrix<int,float,cusp::host_memory> A(3,3,4);
+ *
+ *    // initialize the diagonal and upper triangle
+ *    A.row_offsets[0] = 0;  // first offset is always zero
+ *    A.row_offsets[1] = 2;
+ *    A.row_offsets[2] = 3;
+ *    A.row_offsets[3] = 4;  // last offset is always num_entries
+ *
+ *    A.column_indices[0] = 0; A.values[0] = 10;
+ *    A.column_indices[1] = 2; A.values[1] = 20;
+ *    A.column_indices[2] = 1; A.values[2] = 30;
+ *    A.column_indices[3] = 2; A.values[3] = 40;
+ *
+ *    // A now represents the following matrix
+ *    //    [10  0 20]
+ *    //    [ 0 30  0]
+ *    //    [20  0 40]
+ *
+ *    cusp::array1d<float,cusp::host_memory> x(3, 1);
+ *    cusp::array1d<float,cusp::host_memory> y(3);
+ *
+ *    // y = [30, 30, 60]
+ *    cusp::multiply(A, x, y);
+ *
+ *    cusp::print(y);
+ *  }
+ *  \endcode
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+class symmetric_csr_matrix : public cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::symmetric_csr_format>
+{
+private:
+
+    typedef cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::symmetric_csr_format> Parent;
+
+public:
+
+    /*! \cond */
+    typedef typename cusp::array1d<IndexType, MemorySpace> row_offsets_array_type;
+    typedef typename cusp::array1d<IndexType, MemorySpace> column_indices_array_type;
+    typedef typename cusp::array1d<ValueType, MemorySpace> values_array_type;
+
+    typedef typename cusp::symmetric_csr_matrix<IndexType, ValueType, MemorySpace> container;
+
+    typedef typename cusp::symmetric_csr_matrix_view<typename row_offsets_array_type::view,
+            typename column_indices_array_type::view,
+            typename values_array_type::view,
+            IndexType, ValueType, MemorySpace> view;
+
+    typedef typename cusp::symmetric_csr_matrix_view<typename row_offsets_array_type::const_view,
+            typename column_indices_array_type::const_view,
+            typename values_array_type::const_view,
+            IndexType, ValueType, MemorySpace> const_view;
+
+    typedef typename cusp::detail::coo_view_type<row_offsets_array_type,
+                                                 column_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::symmetric_csr_format>::view coo_view_type;
+    typedef typename cusp::detail::coo_view_type<row_offsets_array_type,
+                                                 column_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::symmetric_csr_format>::view const_coo_view_type;
+
+    template<typename MemorySpace2>
+    struct rebind
+    {
+        typedef cusp::symmetric_csr_matrix<IndexType, ValueType, MemorySpace2> type;
+    };
+    /*! \endcond */
+
+    /*! Storage for the row offsets of the upper triangle.
+     */
+    row_offsets_array_type row_offsets;
+
+    /*! Storage for the column indices of the upper triangle.
+     */
+    column_indices_array_type column_indices;
+
+    /*! Storage for the entries of the upper triangle.
+     */
+    values_array_type values;
+
+    /*! Construct an empty \p symmetric_csr_matrix.
+     */
+    symmetric_csr_matrix(void) {}
+
+    /*! Construct a \p symmetric_csr_matrix with a specific shape and number
+     *  of stored entries.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of entries on and above the diagonal.
+     */
+    symmetric_csr_matrix(const size_t num_rows, const size_t num_cols, const size_t num_entries)
+        : Parent(num_rows, num_cols, num_entries),
+          row_offsets(num_rows + 1),
+          column_indices(num_entries),
+          values(num_entries) {}
+
+    /*! Construct a \p symmetric_csr_matrix from another matrix, only the
+     *  diagonal and the upper triangle of the matrix are kept.
+     *
+     *  \tparam MatrixType Type of input matrix used to create this \p
+     *  symmetric_csr_matrix.
+     *
+     *  \param matrix Another sparse or dense square matrix.
+     */
+    template <typename MatrixType>
+    symmetric_csr_matrix(const MatrixType& matrix);
+
+    /*! Resize matrix dimensions and underlying storage
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of entries on and above the diagonal.
+     */
+    void resize(const size_t num_rows, const size_t num_cols, const size_t num_entries);
+
+    /*! Swap the contents of two \p symmetric_csr_matrix objects.
+     *
+     *  \param matrix Another \p symmetric_csr_matrix with the same IndexType and ValueType.
+     */
+    void swap(symmetric_csr_matrix& matrix);
+
+    /*! Assignment from another matrix, only the diagonal and the upper
+     *  triangle of the matrix are kept.
+     *
+     *  \tparam MatrixType Type of input matrix to copy into this \p
+     *  symmetric_csr_matrix.
+     *
+     *  \param matrix Another sparse or dense square matrix.
+     */
+    template <typename MatrixType>
+    symmetric_csr_matrix& operator=(const MatrixType& matrix);
+
+}; // class symmetric_csr_matrix
+/*! \}
+ */
+
+/**
+ * \addtogroup sparse_matrix_views Sparse Matrix Views
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief View of a \p symmetric_csr_matrix
+ *
+ * \tparam ArrayType1 Type of \c row_offsets array view
+ * \tparam ArrayType2 Type of \c column_indices array view
+ * \tparam ArrayType3 Type of \c values array view
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ *  A \p symmetric_csr_matrix_view is a sparse matrix view of the diagonal
+ *  and upper triangle of a symmetric matrix in CSR format constructed from
+ *  existing data or iterators.
+ *
+ * \note The matrix entries must be sorted by row index.
+ * \note The matrix should not contain entries below the diagonal.
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename IndexType   = typename ArrayType1::value_type,
+          typename ValueType   = typename ArrayType3::value_type,
+          typename MemorySpace = typename cusp::minimum_space<
+                                    typename ArrayType1::memory_space,
+                                    typename ArrayType2::memory_space,
+                                    typename ArrayType3::memory_space>::type >
+class symmetric_csr_matrix_view : public cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::symmetric_csr_format>
+{
+private:
+
+    typedef cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::symmetric_csr_format> Parent;
+
+public:
+
+    /*! \cond */
+    typedef ArrayType1 row_offsets_array_type;
+    typedef ArrayType2 column_indices_array_type;
+    typedef ArrayType3 values_array_type;
+
+    typedef typename cusp::symmetric_csr_matrix<IndexType, ValueType, MemorySpace> container;
+    typedef typename cusp::symmetric_csr_matrix_view<ArrayType1, ArrayType2, ArrayType3, IndexType, ValueType, MemorySpace> view;
+    typedef typename cusp::symmetric_csr_matrix_view<ArrayType1, ArrayType2, ArrayType3, IndexType, ValueType, MemorySpace> const_view;
+
+    typedef typename cusp::detail::coo_view_type<row_offsets_array_type,
+                                                 column_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::symmetric_csr_format>::view coo_view_type;
+    typedef typename cusp::detail::coo_view_type<row_offsets_array_type,
+                                                 column_indices_array_type,
+                                                 values_array_type,
+                                                 cusp::symmetric_csr_format>::view const_coo_view_type;
+    /*! \endcond */
+
+    /**
+     * View of the row offsets of the upper triangle.
+     */
+    row_offsets_array_type row_offsets;
+
+    /**
+     * View of the column indices of the upper triangle.
+     */
+    column_indices_array_type column_indices;
+
+    /**
+     * View of the entries of the upper triangle.
+     */
+    values_array_type values;
+
+    /**
+     * Construct an empty \p symmetric_csr_matrix_view.
+     */
+    symmetric_csr_matrix_view(void)
+        : Parent() {}
+
+    /*! Construct a \p symmetric_csr_matrix_view with a specific shape and
+     *  number of stored entries from existing arrays denoting the row
+     *  offsets, column indices and values of the upper triangle.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of entries on and above the diagonal.
+     *  \param row_offsets Array containing the row offsets.
+     *  \param column_indices Array containing the column indices.
+     *  \param values Array containing the values.
+     */
+    symmetric_csr_matrix_view(const size_t num_rows,
+                              const size_t num_cols,
+                              const size_t num_entries,
+                              ArrayType1 row_offsets,
+                              ArrayType2 column_indices,
+                              ArrayType3 values)
+        : Parent(num_rows, num_cols, num_entries),
+          row_offsets(row_offsets),
+          column_indices(column_indices),
+          values(values) {}
+
+    /*! Construct a \p symmetric_csr_matrix_view from a existing \p symmetric_csr_matrix.
+     *
+     *  \param matrix \p symmetric_csr_matrix used to create view.
+     */
+    symmetric_csr_matrix_view(symmetric_csr_matrix<IndexType,ValueType,MemorySpace>& matrix)
+        : Parent(matrix),
+          row_offsets(matrix.row_offsets),
+          column_indices(matrix.column_indices),
+          values(matrix.values) {}
+
+    /*! Construct a \p symmetric_csr_matrix_view from a existing const \p symmetric_csr_matrix.
+     *
+     *  \param matrix \p symmetric_csr_matrix used to create view.
+     */
+    symmetric_csr_matrix_view(const symmetric_csr_matrix<IndexType,ValueType,MemorySpace>& matrix)
+        : Parent(matrix),
+          row_offsets(matrix.row_offsets),
+          column_indices(matrix.column_indices),
+          values(matrix.values) {}
+
+    /*! Construct a \p symmetric_csr_matrix_view from a existing \p symmetric_csr_matrix_view.
+     *
+     *  \param matrix \p symmetric_csr_matrix_view used to create view.
+     */
+    symmetric_csr_matrix_view(symmetric_csr_matrix_view& matrix)
+        : Parent(matrix),
+          row_offsets(matrix.row_offsets),
+          column_indices(matrix.column_indices),
+          values(matrix.values) {}
+
+    /*! Construct a \p symmetric_csr_matrix_view from a existing const \p symmetric_csr_matrix_view.
+     *
+     *  \param matrix \p symmetric_csr_matrix_view used to create view.
+     */
+    symmetric_csr_matrix_view(const symmetric_csr_matrix_view& matrix)
+        : Parent(matrix),
+          row_offsets(matrix.row_offsets),
+          column_indices(matrix.column_indices),
+          values(matrix.values) {}
+
+    /*! Resize matrix dimensions and underlying storage
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of entries on and above the diagonal.
+     */
+    void resize(const size_t num_rows, const size_t num_cols, const size_t num_entries);
+};
+
+/* Convenience functions */
+
+/**
+ *  This is a convenience function for generating an \p symmetric_csr_matrix_view
+ *  using individual arrays
+ *  \tparam ArrayType1 row offset array type
+ *  \tparam ArrayType2 column index array type
+ *  \tparam ArrayType3 value array type
+ *
+ *  \param num_rows Number of rows.
+ *  \param num_cols Number of columns.
+ *  \param num_entries Number of entries on and above the diagonal.
+ *  \param row_offsets Array containing the row offsets.
+ *  \param column_indices Array containing the column indices.
+ *  \param values Array containing the values.
+ *
+ *  \return \p symmetric_csr_matrix_view constructed using input arrays
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3>
+symmetric_csr_matrix_view<ArrayType1,ArrayType2,ArrayType3>
+make_symmetric_csr_matrix_view(size_t num_rows,
+                               size_t num_cols,
+                               size_t num_entries,
+                               ArrayType1 row_offsets,
+                               ArrayType2 column_indices,
+                               ArrayType3 values)
+{
+    symmetric_csr_matrix_view<ArrayType1,ArrayType2,ArrayType3>
+           view(num_rows, num_cols, num_entries, row_offsets, column_indices, values);
+
+    return view;
+}
+
+/**
+ *  This is a convenience function for generating an \p symmetric_csr_matrix_view
+ *  using an existing \p symmetric_csr_matrix.
+ *
+ *  \tparam IndexType  indices type
+ *  \tparam ValueType  values type
+ *  \tparam MemorySpace memory space of the arrays
+ *
+ *  \param m Exemplar \p symmetric_csr_matrix matrix to copy.
+ *
+ *  \return \p symmetric_csr_matrix_view constructed using input arrays.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename symmetric_csr_matrix<IndexType,ValueType,MemorySpace>::view
+make_symmetric_csr_matrix_view(symmetric_csr_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_symmetric_csr_matrix_view
+           (m.num_rows, m.num_cols, m.num_entries,
+            make_array1d_view(m.row_offsets),
+            make_array1d_view(m.column_indices),
+            make_array1d_view(m.values));
+}
+
+/**
+ *  This is a convenience function for generating an const \p symmetric_csr_matrix_view
+ *  using an existing \p symmetric_csr_matrix.
+ *
+ *  \tparam IndexType  indices type
+ *  \tparam ValueType  values type
+ *  \tparam MemorySpace memory space of the arrays
+ *
+ *  \param m Exemplar \p symmetric_csr_matrix matrix to copy.
+ *
+ *  \return \p symmetric_csr_matrix_view constructed using input arrays.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename symmetric_csr_matrix<IndexType,ValueType,MemorySpace>::const_view
+make_symmetric_csr_matrix_view(const symmetric_csr_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_symmetric_csr_matrix_view
+           (m.num_rows, m.num_cols, m.num_entries,
+            make_array1d_view(m.row_offsets),
+            make_array1d_view(m.column_indices),
+            make_array1d_view(m.values));
+}
+/*! \}
+ */
+
+} // end namespace cusp
+
+#include <cusp/detail/symmetric_csr_matrix.inl>
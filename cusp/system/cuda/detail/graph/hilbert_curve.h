@@ -21,11 +21,12 @@
 #include <cusp/array1d.h>
 #include <cusp/exception.h>
 
-#include <thrust/extrema.h>
-#include <thrust/gather.h>
+#include <thrust/sequence.h>
 #include <thrust/sort.h>
 #include <thrust/transform.h>
 
+#include <thrust/iterator/zip_iterator.h>
+
 namespace cusp
 {
 namespace system
@@ -202,37 +203,15 @@ struct hilbert_transform_3d : public thrust::unary_function<double,double>
     }
 };
 
-template <typename DerivedPolicy, typename Array2d, typename Array1d>
-void hilbert_curve(cuda::execution_policy<DerivedPolicy>& exec,
+// sorts the points along the Hilbert curve
+template <typename DerivedPolicy, typename Array2d, typename ArrayType>
+void hilbert_order(cuda::execution_policy<DerivedPolicy>& exec,
                    const Array2d& coord,
-                   size_t num_parts,
-                   Array1d& parts)
+                   ArrayType& order)
 {
-    typedef typename Array1d::value_type PartType;
-    typedef typename Array2d::const_column_view::iterator Iterator;
-    typedef typename Array2d::value_type ValueType;
-    typedef typename Array2d::memory_space MemorySpace;
-
-    size_t num_points = coord.num_rows;
-    size_t dims = coord.num_cols;
-
-    if( (dims != 2) && (dims != 3) )
-        throw cusp::invalid_input_exception("Hilbert curve partitioning only implemented for 2D or 3D data.");
-
-    thrust::pair<Iterator,Iterator> x_iter = thrust::minmax_element(exec, coord.column(0).begin(), coord.column(0).end());
-    thrust::pair<Iterator,Iterator> y_iter = thrust::minmax_element(exec, coord.column(1).begin(), coord.column(1).end());
-
-    ValueType xmin = *x_iter.first;
-    ValueType xmax = *x_iter.second;
-    ValueType ymin = *y_iter.first;
-    ValueType ymax = *y_iter.second;
-
-    if( xmin < ValueType(0) || xmax > ValueType(1) || ymin < ValueType(0) || ymax > ValueType(1) )
-        throw cusp::invalid_input_exception("Hilbert coordinates should be in the range [0,1]");
-
     cusp::detail::temporary_array<double, DerivedPolicy> hilbert_keys(exec, coord.num_rows);
 
-    if( dims == 2 )
+    if( coord.num_cols == 2 )
     {
         thrust::transform(exec,
                           thrust::make_zip_iterator(thrust::make_tuple(coord.column(0).begin(), coord.column(1).begin())),
@@ -241,28 +220,14 @@ void hilbert_curve(cuda::execution_policy<DerivedPolicy>& exec,
     }
     else
     {
-        thrust::pair<Iterator,Iterator> z_iter = thrust::minmax_element(exec, coord.column(2).begin(), coord.column(2).end());
-        ValueType zmin = *z_iter.first;
-        ValueType zmax = *z_iter.second;
-
-        if( zmin < ValueType(0) || zmax > ValueType(1) )
-            throw cusp::invalid_input_exception("Hilbert coordinates should be in the range [0,1]");
-
         thrust::transform(exec,
                           thrust::make_zip_iterator(thrust::make_tuple(coord.column(0).begin(), coord.column(1).begin(), coord.column(2).begin())),
                           thrust::make_zip_iterator(thrust::make_tuple(coord.column(0).end(), coord.column(1).end(), coord.column(2).end())),
                           hilbert_keys.begin(), hilbert_transform_3d());
     }
 
-    cusp::detail::temporary_array<PartType, DerivedPolicy> perm(exec, num_points);
-    thrust::sequence(exec, perm.begin(), perm.end());
-    thrust::sort_by_key(exec, hilbert_keys.begin(), hilbert_keys.end(), perm.begin());
-
-    cusp::detail::temporary_array<PartType, DerivedPolicy> uniform_parts(exec, num_points);
-    thrust::transform(exec,
-                      thrust::counting_iterator<PartType>(0), thrust::counting_iterator<PartType>(num_points),
-                      thrust::constant_iterator<PartType>(num_points/num_parts), uniform_parts.begin(), thrust::divides<PartType>());
-    thrust::gather(exec, perm.begin(), perm.end(), uniform_parts.begin(), parts.begin());
+    thrust::sequence(exec, order.begin(), order.end());
+    thrust::sort_by_key(exec, hilbert_keys.begin(), hilbert_keys.end(), order.begin());
 }
 
 } // end namespace detail
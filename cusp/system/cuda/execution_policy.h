@@ -47,7 +47,11 @@
 #include <cusp/system/cuda/detail/graph/connected_components.h>
 #include <cusp/system/cuda/detail/graph/hilbert_curve.h>
 #include <cusp/system/cuda/detail/graph/maximal_independent_set.h>
+#include <cusp/system/cuda/detail/graph/multi_source_breadth_first_search.h>
+#include <cusp/system/cuda/detail/graph/multilevel_partition.h>
+#include <cusp/system/cuda/detail/graph/pagerank.h>
 #include <cusp/system/cuda/detail/graph/pseudo_peripheral.h>
+#include <cusp/system/cuda/detail/graph/single_source_shortest_path.h>
 #include <cusp/system/cuda/detail/graph/symmetric_rcm.h>
 #include <cusp/system/cuda/detail/graph/vertex_coloring.h>
 
@@ -0,0 +1,87 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/bsr_matrix.h>
+#include <cusp/copy.h>
+#include <cusp/format_utils.h>
+
+#include <cusp/detail/format.h>
+
+#include <thrust/fill.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+// the entries of the COO view of a bsr_matrix are sorted by row and column,
+// the explicit zeros of the blocks are kept
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::bsr_format&,
+        cusp::coo_format&)
+{
+    typedef typename SourceType::const_coo_view_type CooViewType;
+
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if(src.num_entries == 0) return;
+
+    CooViewType src_coo(src);
+
+    cusp::copy(exec, src_coo.row_indices,    dst.row_indices);
+    cusp::copy(exec, src_coo.column_indices, dst.column_indices);
+    cusp::copy(exec, src_coo.values,         dst.values);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::bsr_format&,
+        cusp::csr_format&)
+{
+    typedef typename SourceType::const_coo_view_type CooViewType;
+
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if(src.num_entries == 0)
+    {
+        thrust::fill(exec, dst.row_offsets.begin(), dst.row_offsets.end(), 0);
+        return;
+    }
+
+    CooViewType src_coo(src);
+
+    cusp::indices_to_offsets(exec, src_coo.row_indices, dst.row_offsets);
+    cusp::copy(exec, src_coo.column_indices, dst.column_indices);
+    cusp::copy(exec, src_coo.values,         dst.values);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
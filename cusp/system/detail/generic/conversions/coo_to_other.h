@@ -19,24 +19,38 @@
 
 #include <cusp/copy.h>
 #include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
 #include <cusp/format_utils.h>
+#include <cusp/functional.h>
+#include <cusp/sort.h>
 
 #include <cusp/blas/blas.h>
 
+#include <cusp/detail/bsr_format_utils.h>
 #include <cusp/detail/format.h>
+#include <cusp/detail/sell_format_utils.h>
 #include <cusp/detail/temporary_array.h>
 
+#include <thrust/copy.h>
 #include <thrust/count.h>
+#include <thrust/fill.h>
+#include <thrust/functional.h>
 #include <thrust/gather.h>
 #include <thrust/inner_product.h>
+#include <thrust/reduce.h>
 #include <thrust/replace.h>
 #include <thrust/scan.h>
 #include <thrust/scatter.h>
 #include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
 #include <thrust/tuple.h>
 
 #include <thrust/iterator/constant_iterator.h>
 #include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
 #include <thrust/iterator/zip_iterator.h>
 
 #include <algorithm>
@@ -71,6 +85,18 @@ struct array2d_map_functor : public thrust::unary_function<IndexType,IndexType>
     }
 };
 
+// true for the entries on and above the diagonal
+template <typename IndexType>
+struct upper_triangle_functor
+{
+    template<typename Tuple>
+    __host__ __device__
+    bool operator()(const Tuple& t) const
+    {
+        return thrust::get<0>(t) <= thrust::get<1>(t);
+    }
+};
+
 template <typename DerivedPolicy, typename SourceType, typename DestinationType>
 void
 convert(thrust::execution_policy<DerivedPolicy>& exec,
@@ -130,6 +156,36 @@ convert(thrust::execution_policy<DerivedPolicy>& exec,
     cusp::copy(exec, src.values,         dst.values);
 }
 
+// the stable sort by column keeps the rows of every column in order
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::coo_format&,
+        cusp::csc_format&)
+{
+    typedef typename DestinationType::index_type IndexType;
+
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if(src.num_entries == 0)
+    {
+        thrust::fill(exec, dst.column_offsets.begin(), dst.column_offsets.end(), IndexType(0));
+        return;
+    }
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> column_indices(exec, src.column_indices);
+
+    cusp::copy(exec, src.row_indices, dst.row_indices);
+    cusp::copy(exec, src.values,      dst.values);
+
+    cusp::sort_by_row(exec, column_indices, dst.row_indices, dst.values,
+                      IndexType(0), IndexType(src.num_cols));
+
+    cusp::indices_to_offsets(exec, column_indices, dst.column_offsets);
+}
+
 template <typename DerivedPolicy, typename SourceType, typename DestinationType>
 void
 convert(thrust::execution_policy<DerivedPolicy>& exec,
@@ -377,6 +433,272 @@ convert(thrust::execution_policy<DerivedPolicy>& exec,
 //                     less_than<size_t>(dst.ell.column_indices.values.size()));
 }
 
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::coo_format&,
+        cusp::bsr_format&)
+{
+    typedef typename DestinationType::index_type   IndexType;
+    typedef typename DestinationType::value_type   ValueType;
+
+    // the block size of dst is kept
+    const size_t block_rows = dst.block_rows;
+    const size_t block_cols = dst.block_cols;
+
+    if(block_rows == 0 || block_cols == 0 ||
+       src.num_rows % block_rows != 0 || src.num_cols % block_cols != 0)
+        throw cusp::format_conversion_exception("bsr_matrix dimensions must be multiples of the block size");
+
+    if(src.num_entries == 0)
+    {
+        dst.resize(src.num_rows, src.num_cols, 0, block_rows, block_cols);
+        thrust::fill(exec, dst.row_offsets.begin(), dst.row_offsets.end(), IndexType(0));
+        return;
+    }
+
+    // sort the entries by block row and block column
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> block_row_indices(exec, src.num_entries);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> block_column_indices(exec, src.num_entries);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> permutation(exec, src.num_entries);
+
+    thrust::transform(exec,
+                      src.row_indices.begin(), src.row_indices.end(),
+                      block_row_indices.begin(),
+                      cusp::divide_value<IndexType>(block_rows));
+    thrust::transform(exec,
+                      src.column_indices.begin(), src.column_indices.end(),
+                      block_column_indices.begin(),
+                      cusp::divide_value<IndexType>(block_cols));
+    thrust::sequence(exec, permutation.begin(), permutation.end());
+
+    cusp::sort_by_row_and_column(exec, block_row_indices, block_column_indices, permutation,
+                                 IndexType(0), IndexType(src.num_rows / block_rows),
+                                 IndexType(0), IndexType(src.num_cols / block_cols));
+
+    // number the blocks, the entries of a block get the same number
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> block_ids(exec, src.num_entries, IndexType(0));
+
+    thrust::transform(exec,
+                      thrust::make_zip_iterator(thrust::make_tuple(block_row_indices.begin(), block_column_indices.begin())) + 1,
+                      thrust::make_zip_iterator(thrust::make_tuple(block_row_indices.end(),   block_column_indices.end())),
+                      thrust::make_zip_iterator(thrust::make_tuple(block_row_indices.begin(), block_column_indices.begin())),
+                      block_ids.begin() + 1,
+                      thrust::not_equal_to< thrust::tuple<IndexType,IndexType> >());
+    thrust::inclusive_scan(exec, block_ids.begin(), block_ids.end(), block_ids.begin());
+
+    const size_t num_blocks = block_ids[src.num_entries - 1] + 1;
+
+    // allocate output storage
+    dst.resize(src.num_rows, src.num_cols, num_blocks, block_rows, block_cols);
+
+    // all entries of a block write the same block row and column
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> block_rows_per_block(exec, num_blocks);
+
+    thrust::scatter(exec,
+                    block_row_indices.begin(), block_row_indices.end(),
+                    block_ids.begin(),
+                    block_rows_per_block.begin());
+    thrust::scatter(exec,
+                    block_column_indices.begin(), block_column_indices.end(),
+                    block_ids.begin(),
+                    dst.column_indices.begin());
+
+    cusp::indices_to_offsets(exec, block_rows_per_block, dst.row_offsets);
+
+    // scatter the values into the blocks, missing entries are explicit zeros
+    thrust::fill(exec, dst.values.begin(), dst.values.end(), ValueType(0));
+
+    thrust::scatter(exec,
+                    thrust::make_permutation_iterator(src.values.begin(), permutation.begin()),
+                    thrust::make_permutation_iterator(src.values.begin(), permutation.begin()) + src.num_entries,
+                    thrust::make_transform_iterator(
+                        thrust::make_zip_iterator(
+                            thrust::make_tuple(block_ids.begin(),
+                                               thrust::make_permutation_iterator(src.row_indices.begin(),    permutation.begin()),
+                                               thrust::make_permutation_iterator(src.column_indices.begin(), permutation.begin()))),
+                        cusp::detail::bsr_value_index_functor<IndexType>(block_rows, block_cols)),
+                    dst.values.begin());
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::coo_format&,
+        cusp::sell_format&)
+{
+    typedef typename DestinationType::index_type   IndexType;
+    typedef typename DestinationType::value_type   ValueType;
+
+    // the chunk size and sort window of dst are kept
+    const size_t chunk_size  = dst.chunk_size;
+    const size_t sort_window = dst.sort_window;
+
+    if(chunk_size == 0 || sort_window == 0)
+        throw cusp::format_conversion_exception("sell_matrix chunk size and sort window must be positive");
+
+    const size_t num_rows   = src.num_rows;
+    const size_t num_chunks = (num_rows + chunk_size - 1) / chunk_size;
+
+    dst.resize(src.num_rows, src.num_cols, src.num_entries, 0);
+
+    // compute the length of every row
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_offsets(exec, num_rows + 1);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_lengths(exec, num_rows);
+
+    cusp::indices_to_offsets(exec, src.row_indices, row_offsets);
+    thrust::transform(exec,
+                      row_offsets.begin() + 1, row_offsets.end(),
+                      row_offsets.begin(),
+                      row_lengths.begin(),
+                      thrust::minus<IndexType>());
+
+    // sort the rows by decreasing length within each window, the second
+    // sort is stable so the rows of a window stay ordered by length
+    thrust::sequence(exec, dst.row_permutation.begin(), dst.row_permutation.end());
+
+    if(sort_window > 1)
+    {
+        cusp::detail::temporary_array<IndexType, DerivedPolicy> keys(exec, num_rows);
+
+        thrust::copy(exec, row_lengths.begin(), row_lengths.end(), keys.begin());
+        thrust::stable_sort_by_key(exec, keys.begin(), keys.end(), dst.row_permutation.begin(), thrust::greater<IndexType>());
+
+        thrust::transform(exec,
+                          dst.row_permutation.begin(), dst.row_permutation.end(),
+                          keys.begin(),
+                          cusp::divide_value<IndexType>(sort_window));
+        thrust::stable_sort_by_key(exec, keys.begin(), keys.end(), dst.row_permutation.begin());
+    }
+
+    // pad every chunk to its longest row
+    thrust::fill(exec, dst.chunk_offsets.begin(), dst.chunk_offsets.end(), IndexType(0));
+
+    thrust::reduce_by_key(exec,
+                          thrust::make_transform_iterator(thrust::counting_iterator<IndexType>(0), cusp::divide_value<IndexType>(chunk_size)),
+                          thrust::make_transform_iterator(thrust::counting_iterator<IndexType>(num_rows), cusp::divide_value<IndexType>(chunk_size)),
+                          thrust::make_permutation_iterator(row_lengths.begin(), dst.row_permutation.begin()),
+                          thrust::make_discard_iterator(),
+                          dst.chunk_offsets.begin(),
+                          thrust::equal_to<IndexType>(),
+                          thrust::maximum<IndexType>());
+    thrust::transform(exec,
+                      dst.chunk_offsets.begin(), dst.chunk_offsets.begin() + num_chunks,
+                      dst.chunk_offsets.begin(),
+                      cusp::multiplies_value<IndexType>(chunk_size));
+    thrust::exclusive_scan(exec, dst.chunk_offsets.begin(), dst.chunk_offsets.end(), dst.chunk_offsets.begin());
+
+    const size_t num_slots = dst.chunk_offsets[num_chunks];
+
+    // allocate output storage, the padded entries are marked invalid
+    dst.resize(src.num_rows, src.num_cols, src.num_entries, num_slots);
+
+    thrust::fill(exec, dst.column_indices.begin(), dst.column_indices.end(), IndexType(DestinationType::invalid_index));
+    thrust::fill(exec, dst.values.begin(), dst.values.end(), ValueType(0));
+
+    if(src.num_entries == 0)
+        return;
+
+    // lane of every row
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> lane_indices(exec, num_rows);
+
+    thrust::scatter(exec,
+                    thrust::counting_iterator<IndexType>(0),
+                    thrust::counting_iterator<IndexType>(num_rows),
+                    dst.row_permutation.begin(),
+                    lane_indices.begin());
+
+    cusp::detail::sell_entry_slot_functor<IndexType> slot_functor(chunk_size,
+                                                                  thrust::raw_pointer_cast(&row_offsets[0]),
+                                                                  thrust::raw_pointer_cast(&lane_indices[0]),
+                                                                  thrust::raw_pointer_cast(&dst.chunk_offsets[0]));
+
+    thrust::scatter(exec,
+                    src.column_indices.begin(), src.column_indices.end(),
+                    thrust::make_transform_iterator(
+                        thrust::make_zip_iterator(thrust::make_tuple(thrust::counting_iterator<IndexType>(0), src.row_indices.begin())),
+                        slot_functor),
+                    dst.column_indices.begin());
+    thrust::scatter(exec,
+                    src.values.begin(), src.values.end(),
+                    thrust::make_transform_iterator(
+                        thrust::make_zip_iterator(thrust::make_tuple(thrust::counting_iterator<IndexType>(0), src.row_indices.begin())),
+                        slot_functor),
+                    dst.values.begin());
+}
+
+// only the entries on and above the diagonal are stored, the entries
+// below the diagonal are assumed to mirror them and are dropped
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::coo_format&,
+        cusp::symmetric_csr_format&)
+{
+    typedef typename DestinationType::index_type IndexType;
+
+    if(src.num_rows != src.num_cols)
+        throw cusp::format_conversion_exception("symmetric_csr_matrix must be square");
+
+    const size_t num_entries =
+        thrust::count_if(exec,
+                         thrust::make_zip_iterator(thrust::make_tuple(src.row_indices.begin(), src.column_indices.begin())),
+                         thrust::make_zip_iterator(thrust::make_tuple(src.row_indices.end(), src.column_indices.end())),
+                         upper_triangle_functor<IndexType>());
+
+    dst.resize(src.num_rows, src.num_cols, num_entries);
+
+    if(num_entries == 0)
+    {
+        thrust::fill(exec, dst.row_offsets.begin(), dst.row_offsets.end(), IndexType(0));
+        return;
+    }
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_indices(exec, num_entries);
+
+    thrust::copy_if(exec,
+                    thrust::make_zip_iterator(thrust::make_tuple(src.row_indices.begin(), src.column_indices.begin(), src.values.begin())),
+                    thrust::make_zip_iterator(thrust::make_tuple(src.row_indices.end(),   src.column_indices.end(),   src.values.end())),
+                    thrust::make_zip_iterator(thrust::make_tuple(src.row_indices.begin(), src.column_indices.begin())),
+                    thrust::make_zip_iterator(thrust::make_tuple(row_indices.begin(), dst.column_indices.begin(), dst.values.begin())),
+                    upper_triangle_functor<IndexType>());
+
+    cusp::indices_to_offsets(exec, row_indices, dst.row_offsets);
+}
+
+// the column indices are compressed row by row from a csr view of the matrix
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::coo_format&,
+        cusp::compressed_csr_format&)
+{
+    typedef typename SourceType::index_type IndexType;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy>     TempArray;
+
+    typedef typename TempArray::view                                    RowView;
+    typedef typename SourceType::column_indices_array_type::const_view  ColView;
+    typedef typename SourceType::values_array_type::const_view          ValView;
+
+    TempArray row_offsets(exec, src.num_rows + 1);
+    cusp::indices_to_offsets(exec, src.row_indices, row_offsets);
+
+    cusp::csr_matrix_view<RowView,ColView,ValView> src_csr(src.num_rows, src.num_cols, src.num_entries,
+                                                           cusp::make_array1d_view(row_offsets),
+                                                           cusp::make_array1d_view(src.column_indices),
+                                                           cusp::make_array1d_view(src.values));
+
+    cusp::convert(exec, src_csr, dst);
+}
+
 } // end namespace generic
 } // end namespace detail
 } // end namespace system
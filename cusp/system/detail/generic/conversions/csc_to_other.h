@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/copy.h>
+#include <cusp/csc_matrix.h>
+#include <cusp/format_utils.h>
+#include <cusp/sort.h>
+
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <thrust/fill.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csc_format&,
+        cusp::coo_format&)
+{
+    typedef typename DestinationType::index_type IndexType;
+
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if(src.num_entries == 0) return;
+
+    cusp::copy(exec, src.row_indices, dst.row_indices);
+    cusp::offsets_to_indices(exec, src.column_offsets, dst.column_indices);
+    cusp::copy(exec, src.values, dst.values);
+
+    // the stable sort by row keeps the columns of every row in order
+    cusp::sort_by_row(exec, dst.row_indices, dst.column_indices, dst.values,
+                      IndexType(0), IndexType(src.num_rows));
+}
+
+// the CSR arrays of a matrix are the CSC arrays of its transpose
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csc_format&,
+        cusp::csr_format&)
+{
+    typedef typename DestinationType::index_type IndexType;
+
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if(src.num_entries == 0)
+    {
+        thrust::fill(exec, dst.row_offsets.begin(), dst.row_offsets.end(), IndexType(0));
+        return;
+    }
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_indices(exec, src.row_indices);
+
+    cusp::offsets_to_indices(exec, src.column_offsets, dst.column_indices);
+    cusp::copy(exec, src.values, dst.values);
+
+    cusp::sort_by_row(exec, row_indices, dst.column_indices, dst.values,
+                      IndexType(0), IndexType(src.num_rows));
+
+    cusp::indices_to_offsets(exec, row_indices, dst.row_offsets);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -17,23 +17,30 @@
 
 #pragma once
 
+#include <cusp/coo_matrix.h>
 #include <cusp/copy.h>
 #include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
 #include <cusp/format_utils.h>
 #include <cusp/sort.h>
 
 #include <cusp/blas/blas.h>
 
+#include <cusp/detail/compressed_csr_format_utils.h>
 #include <cusp/detail/format.h>
 #include <cusp/detail/temporary_array.h>
 
 #include <thrust/count.h>
+#include <thrust/fill.h>
+#include <thrust/for_each.h>
 #include <thrust/gather.h>
 #include <thrust/inner_product.h>
 #include <thrust/replace.h>
 #include <thrust/scan.h>
 #include <thrust/scatter.h>
 #include <thrust/sequence.h>
+#include <thrust/transform.h>
+#include <thrust/transform_reduce.h>
 #include <thrust/tuple.h>
 
 #include <thrust/iterator/constant_iterator.h>
@@ -42,6 +49,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 
 namespace cusp
 {
@@ -69,6 +77,36 @@ convert(thrust::execution_policy<DerivedPolicy>& exec,
     cusp::copy(exec, src.values,         dst.values);
 }
 
+// the CSC arrays of a matrix are the CSR arrays of its transpose
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::csc_format&)
+{
+    typedef typename DestinationType::index_type IndexType;
+
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if(src.num_entries == 0)
+    {
+        thrust::fill(exec, dst.column_offsets.begin(), dst.column_offsets.end(), IndexType(0));
+        return;
+    }
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> column_indices(exec, src.column_indices);
+
+    cusp::offsets_to_indices(exec, src.row_offsets, dst.row_indices);
+    cusp::copy(exec, src.values, dst.values);
+
+    cusp::sort_by_row(exec, column_indices, dst.row_indices, dst.values,
+                      IndexType(0), IndexType(src.num_cols));
+
+    cusp::indices_to_offsets(exec, column_indices, dst.column_offsets);
+}
+
 
 template <typename DerivedPolicy, typename SourceType, typename DestinationType>
 void
@@ -305,6 +343,184 @@ convert(thrust::execution_policy<DerivedPolicy>& exec,
                        cusp::less_value<size_t>(dst.ell.values.values.size()));
 }
 
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::bsr_format& format2)
+{
+    typedef typename SourceType::index_type IndexType;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy>     TempArray;
+
+    typedef typename TempArray::view                                    RowView;
+    typedef typename SourceType::column_indices_array_type::const_view  ColView;
+    typedef typename SourceType::values_array_type::const_view          ValView;
+
+    TempArray row_indices(exec, src.num_entries);
+    cusp::offsets_to_indices(exec, src.row_offsets, row_indices);
+
+    cusp::coo_matrix_view<RowView,ColView,ValView> src_coo(src.num_rows, src.num_cols, src.num_entries,
+                                                           cusp::make_array1d_view(row_indices),
+                                                           cusp::make_array1d_view(src.column_indices),
+                                                           cusp::make_array1d_view(src.values));
+
+    cusp::coo_format format1;
+
+    convert(exec, src_coo, dst, format1, format2);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::sell_format& format2)
+{
+    typedef typename SourceType::index_type IndexType;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy>     TempArray;
+
+    typedef typename TempArray::view                                    RowView;
+    typedef typename SourceType::column_indices_array_type::const_view  ColView;
+    typedef typename SourceType::values_array_type::const_view          ValView;
+
+    TempArray row_indices(exec, src.num_entries);
+    cusp::offsets_to_indices(exec, src.row_offsets, row_indices);
+
+    cusp::coo_matrix_view<RowView,ColView,ValView> src_coo(src.num_rows, src.num_cols, src.num_entries,
+                                                           cusp::make_array1d_view(row_indices),
+                                                           cusp::make_array1d_view(src.column_indices),
+                                                           cusp::make_array1d_view(src.values));
+
+    cusp::coo_format format1;
+
+    convert(exec, src_coo, dst, format1, format2);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::symmetric_csr_format& format2)
+{
+    typedef typename SourceType::index_type IndexType;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy>     TempArray;
+
+    typedef typename TempArray::view                                    RowView;
+    typedef typename SourceType::column_indices_array_type::const_view  ColView;
+    typedef typename SourceType::values_array_type::const_view          ValView;
+
+    TempArray row_indices(exec, src.num_entries);
+    cusp::offsets_to_indices(exec, src.row_offsets, row_indices);
+
+    cusp::coo_matrix_view<RowView,ColView,ValView> src_coo(src.num_rows, src.num_cols, src.num_entries,
+                                                           cusp::make_array1d_view(row_indices),
+                                                           cusp::make_array1d_view(src.column_indices),
+                                                           cusp::make_array1d_view(src.values));
+
+    cusp::coo_format format1;
+
+    convert(exec, src_coo, dst, format1, format2);
+}
+
+// Every row stores its column indices as offsets from its smallest column,
+// rows spanning more columns than the deltas can represent keep their full
+// column indices. Of 8 and 16 bit deltas the width giving fewer bytes of
+// column indices is used.
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::compressed_csr_format&)
+{
+    typedef typename SourceType::index_type                         IndexType;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy> TempArray;
+    typedef thrust::counting_iterator<IndexType>                    CountingIterator;
+
+    const size_t num_rows    = src.num_rows;
+    const size_t num_entries = src.num_entries;
+
+    if(num_entries == 0)
+    {
+        dst.resize(src.num_rows, src.num_cols, 0, 0, 1);
+        thrust::fill(exec, dst.row_offsets.begin(), dst.row_offsets.end(), IndexType(0));
+        thrust::fill(exec, dst.column_bases.begin(), dst.column_bases.end(), IndexType(0));
+        return;
+    }
+
+    // smallest column and column span of every row
+    TempArray first_columns(exec, num_rows);
+    TempArray column_spans(exec, num_rows);
+
+    thrust::transform(exec, CountingIterator(0), CountingIterator(num_rows),
+                      thrust::make_zip_iterator(thrust::make_tuple(first_columns.begin(), column_spans.begin())),
+                      cusp::detail::compressed_csr_row_range_functor<IndexType>(
+                          thrust::raw_pointer_cast(&src.row_offsets[0]),
+                          thrust::raw_pointer_cast(&src.column_indices[0])));
+
+    // number of full column indices needed with 8 and 16 bit deltas
+    const size_t num_indices8 =
+        thrust::transform_reduce(exec,
+                                 thrust::make_zip_iterator(thrust::make_tuple(src.row_offsets.begin(), src.row_offsets.begin() + 1, column_spans.begin())),
+                                 thrust::make_zip_iterator(thrust::make_tuple(src.row_offsets.begin(), src.row_offsets.begin() + 1, column_spans.begin())) + num_rows,
+                                 cusp::detail::compressed_csr_full_length_functor<IndexType>(0xff),
+                                 size_t(0), thrust::plus<size_t>());
+    const size_t num_indices16 =
+        thrust::transform_reduce(exec,
+                                 thrust::make_zip_iterator(thrust::make_tuple(src.row_offsets.begin(), src.row_offsets.begin() + 1, column_spans.begin())),
+                                 thrust::make_zip_iterator(thrust::make_tuple(src.row_offsets.begin(), src.row_offsets.begin() + 1, column_spans.begin())) + num_rows,
+                                 cusp::detail::compressed_csr_full_length_functor<IndexType>(0xffff),
+                                 size_t(0), thrust::plus<size_t>());
+
+    const size_t delta_width = num_entries     + sizeof(IndexType) * num_indices8 <=
+                               2 * num_entries + sizeof(IndexType) * num_indices16 ? 1 : 2;
+    const size_t num_indices = delta_width == 1 ? num_indices8 : num_indices16;
+    const IndexType max_delta = delta_width == 1 ? 0xff : 0xffff;
+
+    // the rows with full column indices are marked by bases beyond num_cols
+    if(src.num_cols + num_indices > size_t(std::numeric_limits<IndexType>::max()))
+        throw cusp::format_conversion_exception("compressed_csr_matrix column bases would exceed the range of the index type");
+
+    dst.resize(src.num_rows, src.num_cols, num_entries, num_indices, delta_width);
+
+    // position of the first full column index of every row
+    TempArray full_offsets(exec, num_rows);
+
+    thrust::transform(exec,
+                      thrust::make_zip_iterator(thrust::make_tuple(src.row_offsets.begin(), src.row_offsets.begin() + 1, column_spans.begin())),
+                      thrust::make_zip_iterator(thrust::make_tuple(src.row_offsets.begin(), src.row_offsets.begin() + 1, column_spans.begin())) + num_rows,
+                      full_offsets.begin(),
+                      cusp::detail::compressed_csr_full_length_functor<IndexType>(max_delta));
+    thrust::exclusive_scan(exec, full_offsets.begin(), full_offsets.end(), full_offsets.begin());
+
+    thrust::transform(exec,
+                      thrust::make_zip_iterator(thrust::make_tuple(first_columns.begin(), column_spans.begin(), full_offsets.begin())),
+                      thrust::make_zip_iterator(thrust::make_tuple(first_columns.end(),   column_spans.end(),   full_offsets.end())),
+                      dst.column_bases.begin(),
+                      cusp::detail::compressed_csr_base_functor<IndexType>(src.num_cols, max_delta));
+
+    // the deltas of the rows with full column indices are unused
+    thrust::fill(exec, dst.column_deltas.begin(), dst.column_deltas.end(), 0);
+
+    thrust::for_each(exec, CountingIterator(0), CountingIterator(num_rows),
+                     cusp::detail::compressed_csr_encode_functor<IndexType>(
+                         src.num_cols, delta_width,
+                         thrust::raw_pointer_cast(&src.row_offsets[0]),
+                         thrust::raw_pointer_cast(&src.column_indices[0]),
+                         thrust::raw_pointer_cast(&dst.column_bases[0]),
+                         num_indices == 0 ? NULL : thrust::raw_pointer_cast(&dst.column_indices[0]),
+                         thrust::raw_pointer_cast(&dst.column_deltas[0])));
+
+    cusp::copy(exec, src.row_offsets, dst.row_offsets);
+    cusp::copy(exec, src.values,      dst.values);
+}
+
 } // end namespace generic
 } // end namespace detail
 } // end namespace system
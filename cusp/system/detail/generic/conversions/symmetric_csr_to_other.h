@@ -0,0 +1,87 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/copy.h>
+#include <cusp/format_utils.h>
+#include <cusp/symmetric_csr_matrix.h>
+
+#include <cusp/detail/format.h>
+
+#include <thrust/fill.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+// the COO view of a symmetric_csr_matrix expands the stored entries to both
+// triangles, the converted matrix holds every nonzero of the matrix
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::symmetric_csr_format&,
+        cusp::coo_format&)
+{
+    typedef typename SourceType::const_coo_view_type CooViewType;
+
+    CooViewType src_coo(src);
+
+    dst.resize(src_coo.num_rows, src_coo.num_cols, src_coo.num_entries);
+
+    if(src_coo.num_entries == 0) return;
+
+    cusp::copy(exec, src_coo.row_indices,    dst.row_indices);
+    cusp::copy(exec, src_coo.column_indices, dst.column_indices);
+    cusp::copy(exec, src_coo.values,         dst.values);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::symmetric_csr_format&,
+        cusp::csr_format&)
+{
+    typedef typename SourceType::const_coo_view_type CooViewType;
+
+    CooViewType src_coo(src);
+
+    dst.resize(src_coo.num_rows, src_coo.num_cols, src_coo.num_entries);
+
+    if(src_coo.num_entries == 0)
+    {
+        thrust::fill(exec, dst.row_offsets.begin(), dst.row_offsets.end(), 0);
+        return;
+    }
+
+    cusp::indices_to_offsets(exec, src_coo.row_indices, dst.row_offsets);
+    cusp::copy(exec, src_coo.column_indices, dst.column_indices);
+    cusp::copy(exec, src_coo.values,         dst.values);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -21,12 +21,17 @@
 #include <cusp/detail/type_traits.h>
 
 #include <cusp/system/detail/generic/conversions/array_to_other.h>
+#include <cusp/system/detail/generic/conversions/bsr_to_other.h>
+#include <cusp/system/detail/generic/conversions/compressed_csr_to_other.h>
 #include <cusp/system/detail/generic/conversions/coo_to_other.h>
+#include <cusp/system/detail/generic/conversions/csc_to_other.h>
 #include <cusp/system/detail/generic/conversions/csr_to_other.h>
 #include <cusp/system/detail/generic/conversions/dia_to_other.h>
 #include <cusp/system/detail/generic/conversions/ell_to_other.h>
 #include <cusp/system/detail/generic/conversions/hyb_to_other.h>
 #include <cusp/system/detail/generic/conversions/permutation_to_other.h>
+#include <cusp/system/detail/generic/conversions/sell_to_other.h>
+#include <cusp/system/detail/generic/conversions/symmetric_csr_to_other.h>
 
 namespace cusp
 {
@@ -82,7 +87,7 @@ void convert(thrust::execution_policy<DerivedPolicy>& exec,
     Format1 format1;
     Format2 format2;
 
-    convert(exec, src, dst, format1, format2);
+    convert(thrust::detail::derived_cast(exec), src, dst, format1, format2);
 }
 
 } // end namespace generic
@@ -64,6 +64,18 @@ void copy(thrust::execution_policy<DerivedPolicy>& exec,
     cusp::copy(exec, src.values,         dst.values);
 }
 
+template <typename DerivedPolicy, typename T1, typename T2>
+void copy(thrust::execution_policy<DerivedPolicy>& exec,
+          const T1& src, T2& dst,
+          cusp::csc_format,
+          cusp::csc_format)
+{
+    copy_matrix_dimensions(src, dst);
+    cusp::copy(exec, src.column_offsets, dst.column_offsets);
+    cusp::copy(exec, src.row_indices,    dst.row_indices);
+    cusp::copy(exec, src.values,         dst.values);
+}
+
 template <typename DerivedPolicy, typename T1, typename T2>
 void copy(thrust::execution_policy<DerivedPolicy>& exec,
           const T1& src, T2& dst,
@@ -97,6 +109,62 @@ void copy(thrust::execution_policy<DerivedPolicy>& exec,
     cusp::copy(exec, src.coo, dst.coo);
 }
 
+template <typename DerivedPolicy, typename T1, typename T2>
+void copy(thrust::execution_policy<DerivedPolicy>& exec,
+          const T1& src, T2& dst,
+          cusp::bsr_format,
+          cusp::bsr_format)
+{
+    copy_matrix_dimensions(src, dst);
+    dst.block_rows = src.block_rows;
+    dst.block_cols = src.block_cols;
+    cusp::copy(exec, src.row_offsets,    dst.row_offsets);
+    cusp::copy(exec, src.column_indices, dst.column_indices);
+    cusp::copy(exec, src.values,         dst.values);
+}
+
+template <typename DerivedPolicy, typename T1, typename T2>
+void copy(thrust::execution_policy<DerivedPolicy>& exec,
+          const T1& src, T2& dst,
+          cusp::sell_format,
+          cusp::sell_format)
+{
+    copy_matrix_dimensions(src, dst);
+    dst.chunk_size  = src.chunk_size;
+    dst.sort_window = src.sort_window;
+    cusp::copy(exec, src.chunk_offsets,   dst.chunk_offsets);
+    cusp::copy(exec, src.row_permutation, dst.row_permutation);
+    cusp::copy(exec, src.column_indices,  dst.column_indices);
+    cusp::copy(exec, src.values,          dst.values);
+}
+
+template <typename DerivedPolicy, typename T1, typename T2>
+void copy(thrust::execution_policy<DerivedPolicy>& exec,
+          const T1& src, T2& dst,
+          cusp::symmetric_csr_format,
+          cusp::symmetric_csr_format)
+{
+    copy_matrix_dimensions(src, dst);
+    cusp::copy(exec, src.row_offsets,    dst.row_offsets);
+    cusp::copy(exec, src.column_indices, dst.column_indices);
+    cusp::copy(exec, src.values,         dst.values);
+}
+
+template <typename DerivedPolicy, typename T1, typename T2>
+void copy(thrust::execution_policy<DerivedPolicy>& exec,
+          const T1& src, T2& dst,
+          cusp::compressed_csr_format,
+          cusp::compressed_csr_format)
+{
+    copy_matrix_dimensions(src, dst);
+    dst.delta_width = src.delta_width;
+    cusp::copy(exec, src.row_offsets,    dst.row_offsets);
+    cusp::copy(exec, src.column_bases,   dst.column_bases);
+    cusp::copy(exec, src.column_indices, dst.column_indices);
+    cusp::copy(exec, src.column_deltas,  dst.column_deltas);
+    cusp::copy(exec, src.values,         dst.values);
+}
+
 template <typename DerivedPolicy, typename T1, typename T2>
 void copy(thrust::execution_policy<DerivedPolicy>& exec,
           const T1& src, T2& dst,
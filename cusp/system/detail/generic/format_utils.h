@@ -41,6 +41,12 @@ void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
                       Array& output,
                       cusp::csr_format);
 
+template <typename DerivedPolicy, typename Matrix, typename Array>
+void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
+                      const Matrix& A,
+                      Array& output,
+                      cusp::csc_format);
+
 template <typename DerivedPolicy, typename Matrix, typename Array>
 void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
                       const Matrix& A,
@@ -59,6 +65,30 @@ void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
                       Array& output,
                       cusp::hyb_format);
 
+template <typename DerivedPolicy, typename Matrix, typename Array>
+void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
+                      const Matrix& A,
+                      Array& output,
+                      cusp::bsr_format);
+
+template <typename DerivedPolicy, typename Matrix, typename Array>
+void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
+                      const Matrix& A,
+                      Array& output,
+                      cusp::sell_format);
+
+template <typename DerivedPolicy, typename Matrix, typename Array>
+void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
+                      const Matrix& A,
+                      Array& output,
+                      cusp::symmetric_csr_format);
+
+template <typename DerivedPolicy, typename Matrix, typename Array>
+void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
+                      const Matrix& A,
+                      Array& output,
+                      cusp::compressed_csr_format);
+
 template <typename DerivedPolicy, typename OffsetArray, typename IndexArray>
 void offsets_to_indices(thrust::execution_policy<DerivedPolicy> &exec,
                         const OffsetArray& offsets, IndexArray& indices);
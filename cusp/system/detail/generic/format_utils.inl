@@ -93,6 +93,33 @@ void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
                        output.begin());
 }
 
+template <typename DerivedPolicy, typename Matrix, typename Array>
+void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
+                      const Matrix& A,
+                      Array& output,
+                      cusp::csc_format)
+{
+    typedef typename Matrix::index_type  IndexType;
+    typedef typename Array::value_type   ValueType;
+
+    // first expand the compressed column offsets into column indices
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> column_indices(exec, A.num_entries);
+    cusp::offsets_to_indices(exec, A.column_offsets, column_indices);
+
+    // initialize output to zero
+    thrust::fill(exec, output.begin(), output.end(), ValueType(0));
+
+    // scatter the diagonal values to output
+    thrust::scatter_if(exec,
+                       A.values.begin(), A.values.end(),
+                       column_indices.begin(),
+                       thrust::make_transform_iterator(
+                           thrust::make_zip_iterator(
+                               thrust::make_tuple(A.row_indices.begin(), column_indices.begin())),
+                           cusp::equal_pair_functor<IndexType>()),
+                       output.begin());
+}
+
 template <typename DerivedPolicy, typename Matrix, typename Array>
 void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
                       const Matrix& A,
@@ -169,6 +196,55 @@ void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
      cusp::equal_pair_functor<IndexType>());
 }
 
+template <typename DerivedPolicy, typename Matrix, typename Array>
+void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
+                      const Matrix& A,
+                      Array& output,
+                      cusp::bsr_format)
+{
+    typedef typename Matrix::const_coo_view_type CooViewType;
+
+    CooViewType A_coo(A);
+
+    extract_diagonal(exec, A_coo, output, cusp::coo_format());
+}
+
+template <typename DerivedPolicy, typename Matrix, typename Array>
+void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
+                      const Matrix& A,
+                      Array& output,
+                      cusp::sell_format)
+{
+    typedef typename Matrix::const_coo_view_type CooViewType;
+
+    CooViewType A_coo(A);
+
+    extract_diagonal(exec, A_coo, output, cusp::coo_format());
+}
+
+// the diagonal entries are stored like in a csr_matrix
+template <typename DerivedPolicy, typename Matrix, typename Array>
+void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
+                      const Matrix& A,
+                      Array& output,
+                      cusp::symmetric_csr_format)
+{
+    extract_diagonal(exec, A, output, cusp::csr_format());
+}
+
+template <typename DerivedPolicy, typename Matrix, typename Array>
+void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
+                      const Matrix& A,
+                      Array& output,
+                      cusp::compressed_csr_format)
+{
+    typedef typename Matrix::const_coo_view_type CooViewType;
+
+    CooViewType A_coo(A);
+
+    extract_diagonal(exec, A_coo, output, cusp::coo_format());
+}
+
 template <typename DerivedPolicy, typename Matrix, typename Array>
 void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
                       const Matrix& A, Array& output)
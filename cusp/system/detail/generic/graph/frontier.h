@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+
+#include <cusp/system/detail/generic/multiply/spmspv.h>
+
+#include <thrust/functional.h>
+#include <thrust/transform_reduce.h>
+
+#include <thrust/iterator/permutation_iterator.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace detail
+{
+
+// a frontier whose edges are more than 1/FRONTIER_DENSE_FRACTION of the
+// entries of the graph is expanded with a SpMV instead of a SpMSpV
+static const size_t FRONTIER_DENSE_FRACTION = 16;
+
+// number of edges leaving the vertices of the frontier
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t frontier_edges(thrust::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType& frontier,
+                      const size_t frontier_size)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    if(frontier_size == 0)
+        return 0;
+
+    return thrust::transform_reduce(exec,
+                                    frontier.begin(), frontier.begin() + frontier_size,
+                                    spmspv_degree_functor<IndexType>(thrust::raw_pointer_cast(&G.row_offsets[0])),
+                                    size_t(0),
+                                    thrust::plus<size_t>());
+}
+
+// Sparse matrix times sparse vector over a semiring, with the values of the
+// frontier vertices read from the dense array x. Every edge (i,j) of G
+// leaving a frontier vertex i contributes combine(G(i,j), x[i]) to entry j,
+// and the contributions to each entry are merged with reduce. The entries
+// of the result are returned sorted by index, the number of entries is
+// returned.
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename ArrayType4,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+size_t frontier_expand(thrust::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       const ArrayType1& frontier,
+                       const size_t frontier_size,
+                       const ArrayType2& x,
+                       ArrayType3& indices,
+                       ArrayType4& values,
+                       BinaryFunction1 combine,
+                       BinaryFunction2 reduce)
+{
+    return spmspv_expand(exec, G, frontier, frontier_size,
+                         thrust::make_permutation_iterator(x.begin(), frontier.begin()),
+                         indices, values, combine, reduce);
+}
+
+} // end namespace detail
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
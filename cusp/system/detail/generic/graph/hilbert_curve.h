@@ -19,10 +19,17 @@
 
 #include <cusp/detail/config.h>
 #include <cusp/exception.h>
+#include <cusp/detail/temporary_array.h>
 #include <cusp/detail/type_traits.h>
 
 #include <cusp/detail/execution_policy.h>
 
+#include <thrust/extrema.h>
+#include <thrust/scatter.h>
+
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+
 namespace cusp
 {
 namespace system
@@ -31,6 +38,100 @@ namespace detail
 {
 namespace generic
 {
+namespace detail
+{
+
+template <typename DerivedPolicy, typename Array2d>
+void hilbert_check_coordinates(thrust::execution_policy<DerivedPolicy>& exec,
+                               const Array2d& coord)
+{
+    typedef typename Array2d::const_column_view::iterator Iterator;
+    typedef typename Array2d::value_type ValueType;
+
+    const size_t dims = coord.num_cols;
+
+    if( (dims != 2) && (dims != 3) )
+        throw cusp::invalid_input_exception("Hilbert curve partitioning only implemented for 2D or 3D data.");
+
+    if(coord.num_rows == 0)
+        return;
+
+    for(size_t d = 0; d < dims; d++)
+    {
+        thrust::pair<Iterator,Iterator> iter = thrust::minmax_element(exec, coord.column(d).begin(), coord.column(d).end());
+
+        if( *iter.first < ValueType(0) || *iter.second > ValueType(1) )
+            throw cusp::invalid_input_exception("Hilbert coordinates should be in the range [0,1]");
+    }
+}
+
+template <typename IndexType>
+struct hilbert_part_functor : public thrust::unary_function<IndexType,IndexType>
+{
+    const size_t num_points;
+    const size_t num_parts;
+
+    hilbert_part_functor(const size_t num_points, const size_t num_parts)
+        : num_points(num_points), num_parts(num_parts) {}
+
+    __host__ __device__
+    IndexType operator()(const IndexType k) const
+    {
+        return k * num_parts / num_points;
+    }
+};
+
+// splits the points into num_parts contiguous pieces of the curve whose
+// sizes differ by at most one
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2>
+void hilbert_parts(thrust::execution_policy<DerivedPolicy>& exec,
+                   const ArrayType1& order,
+                   const size_t num_parts,
+                   ArrayType2& parts)
+{
+    typedef typename ArrayType1::value_type IndexType;
+
+    const size_t num_points = order.size();
+
+    thrust::scatter(exec,
+                    thrust::make_transform_iterator(thrust::counting_iterator<IndexType>(0),
+                                                    hilbert_part_functor<IndexType>(num_points, num_parts)),
+                    thrust::make_transform_iterator(thrust::counting_iterator<IndexType>(num_points),
+                                                    hilbert_part_functor<IndexType>(num_points, num_parts)),
+                    order.begin(), parts.begin());
+}
+
+// the permutation moves every point to its position along the curve
+template <typename DerivedPolicy, typename ArrayType, typename PermutationType>
+void hilbert_permutation(thrust::execution_policy<DerivedPolicy>& exec,
+                         const ArrayType& order,
+                         PermutationType& P)
+{
+    typedef typename ArrayType::value_type IndexType;
+
+    const size_t num_points = order.size();
+
+    P.resize(num_points);
+
+    thrust::scatter(exec,
+                    thrust::counting_iterator<IndexType>(0),
+                    thrust::counting_iterator<IndexType>(num_points),
+                    order.begin(), P.permutation.begin());
+}
+
+} // end namespace detail
+
+// Every system sorts the point indices along the curve with hilbert_order,
+// the parts and the permutation are derived from that order here.
+template <typename DerivedPolicy,
+          typename Array2d,
+          typename ArrayType>
+void hilbert_order(thrust::execution_policy<DerivedPolicy>& exec,
+                   const Array2d& coord,
+                         ArrayType& order)
+{
+  throw cusp::not_implemented_exception("No generic Hilbert curve");
+}
 
 template <typename DerivedPolicy,
           typename Array2d,
@@ -40,7 +141,41 @@ void hilbert_curve(thrust::execution_policy<DerivedPolicy>& exec,
                    const size_t num_parts,
                          Array1d& parts)
 {
-  throw cusp::not_implemented_exception("No generic Hilbert curve");
+    typedef typename Array1d::value_type PartType;
+
+    if(num_parts == 0)
+        throw cusp::invalid_input_exception("number of parts must be positive");
+
+    detail::hilbert_check_coordinates(exec, coord);
+
+    cusp::detail::temporary_array<PartType, DerivedPolicy> order(exec, coord.num_rows);
+
+    hilbert_order(thrust::detail::derived_cast(exec), coord, order);
+    detail::hilbert_parts(exec, order, num_parts, parts);
+}
+
+template <typename DerivedPolicy,
+          typename Array2d,
+          typename Array1d,
+          typename PermutationType>
+void hilbert_curve(thrust::execution_policy<DerivedPolicy>& exec,
+                   const Array2d& coord,
+                   const size_t num_parts,
+                         Array1d& parts,
+                         PermutationType& P)
+{
+    typedef typename PermutationType::index_type IndexType;
+
+    if(num_parts == 0)
+        throw cusp::invalid_input_exception("number of parts must be positive");
+
+    detail::hilbert_check_coordinates(exec, coord);
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> order(exec, coord.num_rows);
+
+    hilbert_order(thrust::detail::derived_cast(exec), coord, order);
+    detail::hilbert_parts(exec, order, num_parts, parts);
+    detail::hilbert_permutation(exec, order, P);
 }
 
 } // end namespace generic
@@ -0,0 +1,353 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/array2d_format_utils.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/detail/type_traits.h>
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
+
+#include <cusp/system/detail/generic/graph/frontier.h>
+
+#include <cusp/detail/execution_policy.h>
+#include <thrust/copy.h>
+#include <thrust/fill.h>
+#include <thrust/for_each.h>
+#include <thrust/functional.h>
+#include <thrust/logical.h>
+#include <thrust/reduce.h>
+#include <thrust/remove.h>
+#include <thrust/scatter.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/tuple.h>
+
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace detail
+{
+
+template <typename IndexType>
+struct msbfs_out_of_range_functor
+{
+    const size_t N;
+
+    msbfs_out_of_range_functor(const size_t N) : N(N) {}
+
+    __host__ __device__
+    bool operator()(const IndexType src) const
+    {
+        return src < 0 || size_t(src) >= N;
+    }
+};
+
+// bit of the s-th source of a batch
+template <typename IndexType, typename BitsType>
+struct msbfs_bit_functor : public thrust::unary_function<IndexType,BitsType>
+{
+    __host__ __device__
+    BitsType operator()(const IndexType s) const
+    {
+        return BitsType(1) << s;
+    }
+};
+
+template <typename BitsType>
+struct msbfs_nonzero_functor
+{
+    __host__ __device__
+    bool operator()(const BitsType bits) const
+    {
+        return bits != 0;
+    }
+};
+
+// (vertex, bits) entries that no source reaches for the first time
+struct msbfs_empty_functor
+{
+    template <typename Tuple>
+    __host__ __device__
+    bool operator()(const Tuple& t) const
+    {
+        return thrust::get<1>(t) == 0;
+    }
+};
+
+// sources that reach a vertex for the first time
+template <typename BitsType>
+struct msbfs_new_functor
+{
+    __host__ __device__
+    BitsType operator()(const BitsType reached, const BitsType visited) const
+    {
+        return reached & ~visited;
+    }
+};
+
+// (vertex, bits) writes depth to the level of the vertex for every source
+// whose bit is set
+template <typename LevelType, typename BitsType, typename Orientation>
+struct msbfs_level_functor
+{
+    LevelType * levels;
+    const size_t pitch;
+    const size_t first_source;
+    const LevelType depth;
+
+    msbfs_level_functor(LevelType * levels, const size_t pitch, const size_t first_source, const LevelType depth)
+        : levels(levels), pitch(pitch), first_source(first_source), depth(depth) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    void operator()(const Tuple& t) const
+    {
+        const size_t i    = thrust::get<0>(t);
+        BitsType     bits = thrust::get<1>(t);
+
+        for(size_t s = first_source; bits != 0; s++, bits >>= 1)
+            if(bits & 1)
+                levels[cusp::detail::index_of(i, s, pitch, Orientation())] = depth;
+    }
+};
+
+} // end namespace detail
+
+// Breadth-first search from up to 64 sources at once over the (or,and)
+// semiring. Every vertex keeps one bit per source of the batch for the
+// sources that reached it and for the sources whose frontier contains it,
+// so one SpMSpV, or one SpMV on the transpose of G for large frontiers,
+// advances all searches of the batch by one level. The frontier is kept as
+// a list of vertices, so a sparse level only touches the edges leaving it.
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType,
+          typename Array2dType>
+void multi_source_breadth_first_search(thrust::execution_policy<DerivedPolicy>& exec,
+                                       const MatrixType& G,
+                                       const ArrayType& sources,
+                                             Array2dType& levels,
+                                             cusp::csr_format)
+{
+    typedef typename MatrixType::index_type   IndexType;
+    typedef typename MatrixType::value_type   WeightType;
+    typedef typename MatrixType::memory_space MemorySpace;
+    typedef typename Array2dType::value_type  LevelType;
+    typedef typename Array2dType::orientation Orientation;
+    typedef unsigned long long                BitsType;
+
+    // number of sources searched together
+    const size_t BATCH_SIZE = 64;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const size_t N = G.num_rows;
+    const size_t S = sources.size();
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> all_sources(exec, sources.begin(), sources.end());
+
+    if(thrust::any_of(exec, all_sources.begin(), all_sources.end(), detail::msbfs_out_of_range_functor<IndexType>(N)))
+        throw cusp::invalid_input_exception("source vertex out of range");
+
+    levels.resize(N, S);
+    thrust::fill(exec, levels.values.begin(), levels.values.end(), LevelType(-1));
+
+    if(N == 0 || S == 0)
+        return;
+
+    cusp::array1d<BitsType, MemorySpace> visited(N);
+    // frontier bits are zero outside of the frontier, and the last frontier
+    // of every batch is empty
+    cusp::array1d<BitsType, MemorySpace> frontier_bits(N, BitsType(0));
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> frontier(exec, N);
+    cusp::array1d<IndexType, MemorySpace> indices;
+    cusp::array1d<BitsType,  MemorySpace> values;
+
+    // incoming edges for the dense levels, built on first use
+    cusp::csr_matrix<IndexType, WeightType, MemorySpace> Gt;
+    cusp::array1d<BitsType, MemorySpace> reached;
+    bool has_incoming_edges = false;
+
+    LevelType * levels_ptr = thrust::raw_pointer_cast(&levels.values[0]);
+
+    for(size_t first_source = 0; first_source < S; first_source += BATCH_SIZE)
+    {
+        typedef detail::msbfs_level_functor<LevelType, BitsType, Orientation> LevelFunctor;
+
+        const size_t batch_size = std::min(BATCH_SIZE, S - first_source);
+
+        thrust::fill(exec, visited.begin(), visited.end(), BitsType(0));
+
+        // merge the bits of repeated sources
+        cusp::detail::temporary_array<IndexType, DerivedPolicy> seeds(exec, all_sources.begin() + first_source, all_sources.begin() + first_source + batch_size);
+        cusp::detail::temporary_array<BitsType,  DerivedPolicy> seed_bits(exec, batch_size);
+        thrust::transform(exec,
+                          thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(batch_size),
+                          seed_bits.begin(), detail::msbfs_bit_functor<IndexType, BitsType>());
+        thrust::stable_sort_by_key(exec, seeds.begin(), seeds.end(), seed_bits.begin());
+
+        cusp::detail::temporary_array<IndexType, DerivedPolicy> unique_seeds(exec, batch_size);
+        cusp::detail::temporary_array<BitsType,  DerivedPolicy> unique_bits(exec, batch_size);
+
+        const size_t num_seeds =
+            thrust::reduce_by_key(exec,
+                                  seeds.begin(), seeds.end(), seed_bits.begin(),
+                                  unique_seeds.begin(), unique_bits.begin(),
+                                  thrust::equal_to<IndexType>(), thrust::bit_or<BitsType>()).first - unique_seeds.begin();
+
+        thrust::scatter(exec, unique_bits.begin(), unique_bits.begin() + num_seeds, unique_seeds.begin(), frontier_bits.begin());
+        thrust::scatter(exec, unique_bits.begin(), unique_bits.begin() + num_seeds, unique_seeds.begin(), visited.begin());
+
+        thrust::for_each(exec,
+                         thrust::make_zip_iterator(thrust::make_tuple(unique_seeds.begin(), unique_bits.begin())),
+                         thrust::make_zip_iterator(thrust::make_tuple(unique_seeds.begin(), unique_bits.begin())) + num_seeds,
+                         LevelFunctor(levels_ptr, levels.pitch, first_source, LevelType(0)));
+
+        thrust::copy(exec, unique_seeds.begin(), unique_seeds.begin() + num_seeds, frontier.begin());
+        size_t frontier_size = num_seeds;
+
+        for(LevelType depth = 1; frontier_size > 0; depth++)
+        {
+            if(detail::frontier_edges(exec, G, frontier, frontier_size) * detail::FRONTIER_DENSE_FRACTION > G.num_entries)
+            {
+                if(!has_incoming_edges)
+                {
+                    cusp::transpose(exec, G, Gt);
+                    reached.resize(N);
+                    has_incoming_edges = true;
+                }
+
+                cusp::generalized_spmv(exec, Gt, frontier_bits, cusp::constant_array<BitsType>(N, 0), reached,
+                                       thrust::project2nd<WeightType, BitsType>(), thrust::bit_or<BitsType>());
+
+                thrust::transform(exec, reached.begin(), reached.end(), visited.begin(), frontier_bits.begin(),
+                                  detail::msbfs_new_functor<BitsType>());
+                thrust::transform(exec, visited.begin(), visited.end(), frontier_bits.begin(), visited.begin(),
+                                  thrust::bit_or<BitsType>());
+
+                thrust::for_each(exec,
+                                 thrust::make_zip_iterator(thrust::make_tuple(thrust::counting_iterator<IndexType>(0), frontier_bits.begin())),
+                                 thrust::make_zip_iterator(thrust::make_tuple(thrust::counting_iterator<IndexType>(N), frontier_bits.end())),
+                                 LevelFunctor(levels_ptr, levels.pitch, first_source, depth));
+
+                frontier_size =
+                    thrust::copy_if(exec,
+                                    thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(N),
+                                    frontier_bits.begin(),
+                                    frontier.begin(),
+                                    detail::msbfs_nonzero_functor<BitsType>()) - frontier.begin();
+            }
+            else
+            {
+                const size_t num_entries =
+                    detail::frontier_expand(exec, G, frontier, frontier_size, frontier_bits, indices, values,
+                                            thrust::project2nd<WeightType, BitsType>(), thrust::bit_or<BitsType>());
+
+                thrust::transform(exec,
+                                  values.begin(), values.begin() + num_entries,
+                                  thrust::make_permutation_iterator(visited.begin(), indices.begin()),
+                                  values.begin(),
+                                  detail::msbfs_new_functor<BitsType>());
+
+                // clear the bits of the expanded frontier
+                thrust::fill(exec,
+                             thrust::make_permutation_iterator(frontier_bits.begin(), frontier.begin()),
+                             thrust::make_permutation_iterator(frontier_bits.begin(), frontier.begin()) + frontier_size,
+                             BitsType(0));
+
+                // keep the vertices that some source reaches for the first time
+                frontier_size =
+                    thrust::remove_if(exec,
+                                      thrust::make_zip_iterator(thrust::make_tuple(indices.begin(), values.begin())),
+                                      thrust::make_zip_iterator(thrust::make_tuple(indices.begin(), values.begin())) + num_entries,
+                                      detail::msbfs_empty_functor()) - thrust::make_zip_iterator(thrust::make_tuple(indices.begin(), values.begin()));
+
+                thrust::copy(exec, indices.begin(), indices.begin() + frontier_size, frontier.begin());
+                thrust::scatter(exec, values.begin(), values.begin() + frontier_size, indices.begin(), frontier_bits.begin());
+
+                thrust::transform(exec,
+                                  values.begin(), values.begin() + frontier_size,
+                                  thrust::make_permutation_iterator(visited.begin(), indices.begin()),
+                                  thrust::make_permutation_iterator(visited.begin(), indices.begin()),
+                                  thrust::bit_or<BitsType>());
+
+                thrust::for_each(exec,
+                                 thrust::make_zip_iterator(thrust::make_tuple(indices.begin(), values.begin())),
+                                 thrust::make_zip_iterator(thrust::make_tuple(indices.begin(), values.begin())) + frontier_size,
+                                 LevelFunctor(levels_ptr, levels.pitch, first_source, depth));
+            }
+        }
+    }
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType,
+          typename Array2dType>
+void multi_source_breadth_first_search(thrust::execution_policy<DerivedPolicy>& exec,
+                                       const MatrixType& G,
+                                       const ArrayType& sources,
+                                             Array2dType& levels,
+                                             cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    cusp::graph::multi_source_breadth_first_search(exec, G_csr, sources, levels);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType,
+          typename Array2dType>
+void multi_source_breadth_first_search(thrust::execution_policy<DerivedPolicy>& exec,
+                                       const MatrixType& G,
+                                       const ArrayType& sources,
+                                             Array2dType& levels)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    multi_source_breadth_first_search(thrust::detail::derived_cast(exec), G, sources, levels, format);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
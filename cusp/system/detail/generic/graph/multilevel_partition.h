@@ -0,0 +1,1040 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/detail/type_traits.h>
+
+#include <cusp/array1d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/copy.h>
+#include <cusp/exception.h>
+#include <cusp/format_utils.h>
+#include <cusp/sort.h>
+
+#include <cusp/detail/execution_policy.h>
+#include <thrust/binary_search.h>
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/extrema.h>
+#include <thrust/fill.h>
+#include <thrust/functional.h>
+#include <thrust/gather.h>
+#include <thrust/inner_product.h>
+#include <thrust/reduce.h>
+#include <thrust/remove.h>
+#include <thrust/scan.h>
+#include <thrust/scatter.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/tuple.h>
+
+#include <thrust/iterator/constant_iterator.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace detail
+{
+
+// graphs with at most this many vertices are bisected directly
+static const size_t PARTITION_COARSEST_SIZE = 64;
+
+// rounds of heavy-edge matching on every level
+static const int PARTITION_MATCHING_ROUNDS = 4;
+
+// passes of refinement on every level
+static const int PARTITION_REFINEMENT_PASSES = 8;
+
+// seeds tried by the initial bisection
+static const int PARTITION_INITIAL_SEEDS = 4;
+
+// allowed excess weight of a side of a bisection
+static const double PARTITION_IMBALANCE = 0.03;
+
+// (weight, priority, vertex) of the edge to an unmatched neighbor
+template <typename IndexType>
+struct partition_candidate_functor
+{
+    typedef thrust::tuple<IndexType,unsigned int,IndexType> result_type;
+
+    template <typename Tuple>
+    __host__ __device__
+    result_type operator()(const Tuple& t) const
+    {
+        // (row, column, weight, row match, column match, column priority)
+        const IndexType i = thrust::get<0>(t);
+        const IndexType j = thrust::get<1>(t);
+
+        if(i == j || thrust::get<3>(t) != -1 || thrust::get<4>(t) != -1)
+            return result_type(-1, 0, -1);
+
+        return result_type(thrust::get<2>(t), thrust::get<5>(t), j);
+    }
+};
+
+// matches i and j if they picked each other
+template <typename IndexType>
+struct partition_handshake_functor
+{
+    const IndexType * candidates;
+
+    partition_handshake_functor(const IndexType * candidates)
+        : candidates(candidates) {}
+
+    __host__ __device__
+    IndexType operator()(const IndexType i, const IndexType match) const
+    {
+        const IndexType j = candidates[i];
+
+        return (match == -1 && j != -1 && candidates[j] == i) ? j : match;
+    }
+};
+
+// vertex that names the coarse vertex of i
+template <typename IndexType>
+struct partition_leader_functor
+{
+    __host__ __device__
+    IndexType operator()(const IndexType i, const IndexType match) const
+    {
+        return (match == -1 || i < match) ? i : match;
+    }
+};
+
+template <typename IndexType>
+struct partition_is_leader_functor
+{
+    __host__ __device__
+    IndexType operator()(const IndexType i, const IndexType match) const
+    {
+        return (match == -1 || i <= match) ? 1 : 0;
+    }
+};
+
+struct partition_self_loop_functor
+{
+    template <typename Tuple>
+    __host__ __device__
+    bool operator()(const Tuple& t) const
+    {
+        return thrust::get<0>(t) == thrust::get<1>(t);
+    }
+};
+
+// weight of an edge to the other side minus the weight of an edge to the
+// same side
+template <typename IndexType>
+struct partition_gain_functor
+{
+    typedef IndexType result_type;
+
+    template <typename Tuple>
+    __host__ __device__
+    IndexType operator()(const Tuple& t) const
+    {
+        return thrust::get<0>(t) != thrust::get<1>(t) ? thrust::get<2>(t) : -thrust::get<2>(t);
+    }
+};
+
+template <typename IndexType>
+struct partition_movable_functor
+{
+    const IndexType side;
+    const bool positive_gain;
+
+    partition_movable_functor(const IndexType side, const bool positive_gain)
+        : side(side), positive_gain(positive_gain) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    bool operator()(const Tuple& t) const
+    {
+        return thrust::get<0>(t) == side && (!positive_gain || thrust::get<1>(t) > 0);
+    }
+};
+
+template <typename IndexType>
+struct partition_same_side_functor
+{
+    const IndexType side;
+
+    partition_same_side_functor(const IndexType side)
+        : side(side) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    bool operator()(const Tuple& t) const
+    {
+        return thrust::get<0>(t) == side && thrust::get<1>(t) == side;
+    }
+};
+
+struct partition_cut_functor
+{
+    template <typename Tuple>
+    __host__ __device__
+    bool operator()(const Tuple& t) const
+    {
+        return thrust::get<0>(t) != thrust::get<1>(t);
+    }
+};
+
+// Heavy-edge matching. In every round each unmatched vertex picks the
+// heaviest edge to an unmatched neighbor, ties broken by random priorities,
+// and two vertices are matched if they picked each other. Unmatched
+// vertices keep -1.
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+void partition_match(thrust::execution_policy<DerivedPolicy>& exec,
+                     const MatrixType& G,
+                     ArrayType& match)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef thrust::tuple<IndexType,unsigned int,IndexType> Candidate;
+
+    const size_t N = G.num_rows;
+    const size_t M = G.num_entries;
+
+    thrust::fill(exec, match.begin(), match.end(), IndexType(-1));
+
+    if(M == 0)
+        return;
+
+    cusp::detail::temporary_array<IndexType,    DerivedPolicy> candidates(exec, N);
+    cusp::detail::temporary_array<IndexType,    DerivedPolicy> rows(exec, N);
+    cusp::detail::temporary_array<IndexType,    DerivedPolicy> weights(exec, N);
+    cusp::detail::temporary_array<unsigned int, DerivedPolicy> priorities(exec, N);
+    cusp::detail::temporary_array<IndexType,    DerivedPolicy> vertices(exec, N);
+
+    for(int round = 0; round < PARTITION_MATCHING_ROUNDS; round++)
+    {
+        cusp::random_array<unsigned int> random(N, round);
+
+        // heaviest edge of every vertex to an unmatched neighbor
+        const size_t num_rows =
+            thrust::reduce_by_key(exec,
+                                  G.row_indices.begin(), G.row_indices.end(),
+                                  thrust::make_transform_iterator(
+                                      thrust::make_zip_iterator(thrust::make_tuple(
+                                          G.row_indices.begin(), G.column_indices.begin(), G.values.begin(),
+                                          thrust::make_permutation_iterator(match.begin(), G.row_indices.begin()),
+                                          thrust::make_permutation_iterator(match.begin(), G.column_indices.begin()),
+                                          thrust::make_permutation_iterator(random.begin(), G.column_indices.begin()))),
+                                      partition_candidate_functor<IndexType>()),
+                                  rows.begin(),
+                                  thrust::make_zip_iterator(thrust::make_tuple(weights.begin(), priorities.begin(), vertices.begin())),
+                                  thrust::equal_to<IndexType>(),
+                                  thrust::maximum<Candidate>()).first - rows.begin();
+
+        thrust::fill(exec, candidates.begin(), candidates.end(), IndexType(-1));
+        thrust::scatter(exec, vertices.begin(), vertices.begin() + num_rows, rows.begin(), candidates.begin());
+
+        const size_t num_unmatched = thrust::count(exec, match.begin(), match.end(), IndexType(-1));
+
+        thrust::transform(exec,
+                          thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(N),
+                          match.begin(), match.begin(),
+                          partition_handshake_functor<IndexType>(thrust::raw_pointer_cast(&candidates[0])));
+
+        if(size_t(thrust::count(exec, match.begin(), match.end(), IndexType(-1))) == num_unmatched)
+            break;
+    }
+}
+
+// Merges every matched pair into one coarse vertex, numbered in the order
+// of its smaller vertex. Parallel edges are merged by adding their weights.
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType1, typename ArrayType2>
+void partition_contract(thrust::execution_policy<DerivedPolicy>& exec,
+                        const MatrixType& G,
+                        const ArrayType1& vertex_weights,
+                        const ArrayType1& match,
+                        ArrayType1& coarse_map,
+                        MatrixType& C,
+                        ArrayType2& coarse_weights)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const size_t N = G.num_rows;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> numbers(exec, N);
+    thrust::transform(exec,
+                      thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(N),
+                      match.begin(), numbers.begin(), partition_is_leader_functor<IndexType>());
+
+    const size_t num_coarse = thrust::count(exec, numbers.begin(), numbers.end(), IndexType(1));
+    thrust::exclusive_scan(exec, numbers.begin(), numbers.end(), numbers.begin());
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> leaders(exec, N);
+    thrust::transform(exec,
+                      thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(N),
+                      match.begin(), leaders.begin(), partition_leader_functor<IndexType>());
+
+    coarse_map.resize(N);
+    thrust::gather(exec, leaders.begin(), leaders.end(), numbers.begin(), coarse_map.begin());
+
+    // weights of the coarse vertices
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> sorted_map(exec, coarse_map.begin(), coarse_map.end());
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> sorted_weights(exec, vertex_weights.begin(), vertex_weights.end());
+    thrust::stable_sort_by_key(exec, sorted_map.begin(), sorted_map.end(), sorted_weights.begin());
+
+    coarse_weights.resize(num_coarse);
+    thrust::reduce_by_key(exec,
+                          sorted_map.begin(), sorted_map.end(), sorted_weights.begin(),
+                          thrust::make_discard_iterator(), coarse_weights.begin());
+
+    // edges between coarse vertices
+    cusp::array1d<IndexType, typename MatrixType::memory_space> rows(G.num_entries);
+    cusp::array1d<IndexType, typename MatrixType::memory_space> columns(G.num_entries);
+    cusp::array1d<IndexType, typename MatrixType::memory_space> weights(G.values);
+
+    thrust::gather(exec, G.row_indices.begin(), G.row_indices.end(), coarse_map.begin(), rows.begin());
+    thrust::gather(exec, G.column_indices.begin(), G.column_indices.end(), coarse_map.begin(), columns.begin());
+
+    const size_t num_edges =
+        thrust::remove_if(exec,
+                          thrust::make_zip_iterator(thrust::make_tuple(rows.begin(), columns.begin(), weights.begin())),
+                          thrust::make_zip_iterator(thrust::make_tuple(rows.end(), columns.end(), weights.end())),
+                          partition_self_loop_functor())
+        - thrust::make_zip_iterator(thrust::make_tuple(rows.begin(), columns.begin(), weights.begin()));
+
+    rows.resize(num_edges);
+    columns.resize(num_edges);
+    weights.resize(num_edges);
+
+    if(num_edges == 0)
+    {
+        C.resize(num_coarse, num_coarse, 0);
+        return;
+    }
+
+    cusp::sort_by_row_and_column(exec, rows, columns, weights);
+
+    const size_t num_coarse_edges =
+        thrust::inner_product(exec,
+                              thrust::make_zip_iterator(thrust::make_tuple(rows.begin(), columns.begin())),
+                              thrust::make_zip_iterator(thrust::make_tuple(rows.end(), columns.end())) - 1,
+                              thrust::make_zip_iterator(thrust::make_tuple(rows.begin(), columns.begin())) + 1,
+                              size_t(1),
+                              thrust::plus<size_t>(),
+                              thrust::not_equal_to< thrust::tuple<IndexType,IndexType> >());
+
+    C.resize(num_coarse, num_coarse, num_coarse_edges);
+
+    thrust::reduce_by_key(exec,
+                          thrust::make_zip_iterator(thrust::make_tuple(rows.begin(), columns.begin())),
+                          thrust::make_zip_iterator(thrust::make_tuple(rows.end(), columns.end())),
+                          weights.begin(),
+                          thrust::make_zip_iterator(thrust::make_tuple(C.row_indices.begin(), C.column_indices.begin())),
+                          C.values.begin());
+}
+
+// gain of moving each vertex to the other side of the bisection
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType1, typename ArrayType2>
+void partition_gains(thrust::execution_policy<DerivedPolicy>& exec,
+                     const MatrixType& G,
+                     const ArrayType1& sides,
+                     ArrayType2& gains)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> rows(exec, G.num_rows);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> sums(exec, G.num_rows);
+
+    const size_t num_rows =
+        thrust::reduce_by_key(exec,
+                              G.row_indices.begin(), G.row_indices.end(),
+                              thrust::make_transform_iterator(
+                                  thrust::make_zip_iterator(thrust::make_tuple(
+                                      thrust::make_permutation_iterator(sides.begin(), G.row_indices.begin()),
+                                      thrust::make_permutation_iterator(sides.begin(), G.column_indices.begin()),
+                                      G.values.begin())),
+                                  partition_gain_functor<IndexType>()),
+                              rows.begin(), sums.begin()).first - rows.begin();
+
+    thrust::fill(exec, gains.begin(), gains.end(), IndexType(0));
+    thrust::scatter(exec, sums.begin(), sums.begin() + num_rows, rows.begin(), gains.begin());
+}
+
+// Moves vertices of side from to the other side in order of decreasing
+// gain. At most max_weight is moved, and if min_weight is positive the
+// moves stop once it is reached. Moving vertices of one side only never
+// loses more than the sum of their gains, so the moves can be applied
+// together. Returns the moved weight.
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+typename ArrayType1::value_type
+partition_move(thrust::execution_policy<DerivedPolicy>& exec,
+               const ArrayType1& vertex_weights,
+               const ArrayType2& gains,
+               ArrayType3& sides,
+               const typename ArrayType1::value_type from,
+               const bool positive_gain,
+               const typename ArrayType1::value_type min_weight,
+               const typename ArrayType1::value_type max_weight)
+{
+    typedef typename ArrayType1::value_type IndexType;
+
+    const size_t N = sides.size();
+
+    if(max_weight <= 0)
+        return 0;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> candidates(exec, N);
+
+    const size_t num_candidates =
+        thrust::copy_if(exec,
+                        thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(N),
+                        thrust::make_zip_iterator(thrust::make_tuple(sides.begin(), gains.begin())),
+                        candidates.begin(),
+                        partition_movable_functor<IndexType>(from, positive_gain)) - candidates.begin();
+
+    if(num_candidates == 0)
+        return 0;
+
+    // candidates ordered by decreasing gain and then by index
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> keys(exec, num_candidates);
+    thrust::gather(exec, candidates.begin(), candidates.begin() + num_candidates, gains.begin(), keys.begin());
+    thrust::stable_sort_by_key(exec, keys.begin(), keys.end(), candidates.begin(), thrust::greater<IndexType>());
+
+    thrust::gather(exec, candidates.begin(), candidates.begin() + num_candidates, vertex_weights.begin(), keys.begin());
+    thrust::inclusive_scan(exec, keys.begin(), keys.end(), keys.begin());
+
+    size_t num_moves = thrust::upper_bound(exec, keys.begin(), keys.end(), max_weight) - keys.begin();
+
+    if(min_weight > 0)
+        num_moves = std::min(num_moves, size_t(thrust::lower_bound(exec, keys.begin(), keys.end(), min_weight) - keys.begin()) + 1);
+
+    if(num_moves == 0)
+        return 0;
+
+    thrust::scatter(exec,
+                    thrust::constant_iterator<IndexType>(1 - from),
+                    thrust::constant_iterator<IndexType>(1 - from) + num_moves,
+                    candidates.begin(), sides.begin());
+
+    return keys[num_moves - 1];
+}
+
+// Restores the balance of the bisection and then moves vertices with
+// positive gain, one direction at a time, until no such move fits.
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+void partition_refine(thrust::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType& vertex_weights,
+                      const typename MatrixType::index_type max_weights[2],
+                      ArrayType& sides)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const IndexType total_weight = thrust::reduce(exec, vertex_weights.begin(), vertex_weights.end());
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> gains(exec, G.num_rows);
+
+    for(int pass = 0; pass < PARTITION_REFINEMENT_PASSES; pass++)
+    {
+        IndexType moved = 0;
+        IndexType first = 0;
+
+        for(int direction = 0; direction < 2; direction++)
+        {
+            IndexType weights[2];
+            weights[1] = thrust::inner_product(exec, sides.begin(), sides.end(), vertex_weights.begin(), IndexType(0));
+            weights[0] = total_weight - weights[1];
+
+            // move from the heavier side first
+            if(direction == 0)
+                first = (weights[0] - max_weights[0] >= weights[1] - max_weights[1]) ? 0 : 1;
+
+            const IndexType from = direction == 0 ? first : 1 - first;
+            const IndexType to   = 1 - from;
+
+            partition_gains(exec, G, sides, gains);
+
+            if(weights[from] > max_weights[from])
+                moved += partition_move(exec, vertex_weights, gains, sides, from, false,
+                                        weights[from] - max_weights[from], max_weights[to] - weights[to]);
+            else
+                moved += partition_move(exec, vertex_weights, gains, sides, from, true,
+                                        IndexType(0), max_weights[to] - weights[to]);
+        }
+
+        if(moved == 0)
+            break;
+    }
+}
+
+template <typename IndexType>
+IndexType partition_host_cut(const std::vector<IndexType>& offsets,
+                             const std::vector<IndexType>& columns,
+                             const std::vector<IndexType>& weights,
+                             const std::vector<IndexType>& sides)
+{
+    IndexType cut = 0;
+
+    for(size_t i = 0; i + 1 < offsets.size(); i++)
+        for(IndexType jj = offsets[i]; jj < offsets[i + 1]; jj++)
+            if(sides[i] != sides[columns[jj]])
+                cut += weights[jj];
+
+    return cut;
+}
+
+// vertices of one side ordered by decreasing gain and then by index
+template <typename IndexType>
+struct partition_host_queue
+{
+    typedef std::set< std::pair<IndexType,IndexType> > type;
+};
+
+// moves vertex i to the other side and updates the gains of its neighbors,
+// unlocked neighbors are kept in the queue of their side
+template <typename IndexType>
+void partition_host_move(const std::vector<IndexType>& offsets,
+                         const std::vector<IndexType>& columns,
+                         const std::vector<IndexType>& weights,
+                         const std::vector<char>& locked,
+                         const IndexType i,
+                         std::vector<IndexType>& gains,
+                         std::vector<IndexType>& sides,
+                         typename partition_host_queue<IndexType>::type queues[2])
+{
+    sides[i] = 1 - sides[i];
+    gains[i] = -gains[i];
+
+    for(IndexType jj = offsets[i]; jj < offsets[i + 1]; jj++)
+    {
+        const IndexType j = columns[jj];
+
+        if(j == i || locked[j]) continue;
+
+        queues[sides[j]].erase(std::make_pair(-gains[j], j));
+        gains[j] += (sides[j] == sides[i]) ? -2 * weights[jj] : 2 * weights[jj];
+        queues[sides[j]].insert(std::make_pair(-gains[j], j));
+    }
+}
+
+template <typename IndexType>
+void partition_host_gains(const std::vector<IndexType>& offsets,
+                          const std::vector<IndexType>& columns,
+                          const std::vector<IndexType>& weights,
+                          const std::vector<IndexType>& sides,
+                          std::vector<IndexType>& gains)
+{
+    for(size_t i = 0; i + 1 < offsets.size(); i++)
+    {
+        gains[i] = 0;
+
+        for(IndexType jj = offsets[i]; jj < offsets[i + 1]; jj++)
+            gains[i] += (sides[i] != sides[columns[jj]]) ? weights[jj] : -weights[jj];
+    }
+}
+
+// Fiduccia-Mattheyses refinement of a small bisection. Each pass moves
+// every vertex at most once, always the movable vertex of highest gain,
+// and then rolls back to the smallest cut seen during the pass.
+template <typename IndexType>
+void partition_host_fm(const std::vector<IndexType>& offsets,
+                       const std::vector<IndexType>& columns,
+                       const std::vector<IndexType>& weights,
+                       const std::vector<IndexType>& vertex_weights,
+                       const IndexType max_weights[2],
+                       std::vector<IndexType>& sides)
+{
+    typedef typename partition_host_queue<IndexType>::type Queue;
+
+    // stop a pass after this many moves without improvement
+    const size_t MAX_UNPRODUCTIVE_MOVES = 64;
+
+    const size_t N = vertex_weights.size();
+
+    std::vector<IndexType> gains(N);
+    std::vector<char> locked(N);
+    std::vector<IndexType> moves;
+    Queue queues[2];
+
+    IndexType cut = partition_host_cut(offsets, columns, weights, sides);
+
+    for(int pass = 0; pass < PARTITION_REFINEMENT_PASSES; pass++)
+    {
+        IndexType side_weights[2] = {0, 0};
+        for(size_t i = 0; i < N; i++)
+            side_weights[sides[i]] += vertex_weights[i];
+
+        partition_host_gains(offsets, columns, weights, sides, gains);
+        std::fill(locked.begin(), locked.end(), 0);
+        moves.clear();
+
+        queues[0].clear();
+        queues[1].clear();
+        for(size_t i = 0; i < N; i++)
+            queues[sides[i]].insert(std::make_pair(-gains[i], IndexType(i)));
+
+        IndexType best_cut   = cut;
+        size_t    best_moves = 0;
+
+        while(moves.size() - best_moves < MAX_UNPRODUCTIVE_MOVES)
+        {
+            // best vertex of each side that fits on the other side
+            IndexType best = -1;
+
+            for(int from = 0; from < 2; from++)
+            {
+                const int to = 1 - from;
+
+                if(side_weights[to] >= max_weights[to])
+                    continue;
+
+                for(typename Queue::const_iterator it = queues[from].begin(); it != queues[from].end(); ++it)
+                {
+                    const IndexType i = it->second;
+
+                    if(side_weights[to] + vertex_weights[i] > max_weights[to])
+                        continue;
+
+                    if(best == -1 || gains[i] > gains[best] || (gains[i] == gains[best] && i < best))
+                        best = i;
+
+                    break;
+                }
+            }
+
+            if(best == -1)
+                break;
+
+            queues[sides[best]].erase(std::make_pair(-gains[best], best));
+            side_weights[sides[best]]     -= vertex_weights[best];
+            side_weights[1 - sides[best]] += vertex_weights[best];
+            cut -= gains[best];
+
+            locked[best] = 1;
+            partition_host_move(offsets, columns, weights, locked, best, gains, sides, queues);
+            moves.push_back(best);
+
+            if(cut < best_cut)
+            {
+                best_cut   = cut;
+                best_moves = moves.size();
+            }
+        }
+
+        // undo the moves after the best cut
+        for(size_t k = moves.size(); k > best_moves; k--)
+            sides[moves[k - 1]] = 1 - sides[moves[k - 1]];
+
+        cut = best_cut;
+
+        if(best_moves == 0)
+            break;
+    }
+}
+
+// Greedy graph growing bisection of a small graph on the host. Starting
+// from a few seeds, side 0 repeatedly takes the vertex of highest gain
+// until it reaches its target weight. Every bisection is refined with FM
+// and the one with the smallest cut is kept.
+template <typename MatrixType, typename ArrayType1, typename ArrayType2>
+void partition_initial(const MatrixType& G,
+                       const ArrayType1& vertex_weights,
+                       const typename MatrixType::index_type target_weight,
+                       const typename MatrixType::index_type max_weights[2],
+                       ArrayType2& sides)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename partition_host_queue<IndexType>::type Queue;
+
+    cusp::coo_matrix<IndexType, IndexType, cusp::host_memory> H(G);
+
+    const size_t N = H.num_rows;
+
+    std::vector<IndexType> offsets(N + 1, 0);
+    for(size_t n = 0; n < H.num_entries; n++)
+        offsets[H.row_indices[n] + 1]++;
+    for(size_t i = 0; i < N; i++)
+        offsets[i + 1] += offsets[i];
+
+    std::vector<IndexType> columns(H.column_indices.begin(), H.column_indices.end());
+    std::vector<IndexType> weights(H.values.begin(), H.values.end());
+
+    cusp::array1d<IndexType, cusp::host_memory> h_vertex_weights(vertex_weights);
+    std::vector<IndexType> vertex_weight(h_vertex_weights.begin(), h_vertex_weights.end());
+
+    std::vector<IndexType> best_sides(N, 1);
+    IndexType best_cut = -1;
+
+    std::vector<IndexType> gains(N);
+    std::vector<IndexType> trial(N);
+    std::vector<char> locked(N);
+    Queue queues[2];
+
+    const size_t num_seeds = std::min<size_t>(PARTITION_INITIAL_SEEDS, N);
+
+    for(size_t seed = 0; seed < num_seeds; seed++)
+    {
+        std::fill(trial.begin(), trial.end(), IndexType(1));
+        std::fill(locked.begin(), locked.end(), 0);
+        partition_host_gains(offsets, columns, weights, trial, gains);
+
+        queues[0].clear();
+        queues[1].clear();
+        for(size_t i = 0; i < N; i++)
+            queues[1].insert(std::make_pair(-gains[i], IndexType(i)));
+
+        IndexType weight = 0;
+        IndexType next   = seed * N / num_seeds;
+
+        while(weight < target_weight)
+        {
+            queues[1].erase(std::make_pair(-gains[next], next));
+            weight += vertex_weight[next];
+
+            locked[next] = 1;
+            partition_host_move(offsets, columns, weights, locked, next, gains, trial, queues);
+
+            if(queues[1].empty())
+                break;
+
+            next = queues[1].begin()->second;
+        }
+
+        partition_host_fm(offsets, columns, weights, vertex_weight, max_weights, trial);
+
+        const IndexType cut = partition_host_cut(offsets, columns, weights, trial);
+
+        if(best_cut == -1 || cut < best_cut)
+        {
+            best_cut = cut;
+            best_sides.swap(trial);
+        }
+    }
+
+    cusp::array1d<IndexType, cusp::host_memory> h_sides(best_sides.begin(), best_sides.end());
+    cusp::copy(h_sides, sides);
+}
+
+// largest weight allowed on a side whose target is target_weight
+template <typename IndexType>
+IndexType partition_max_weight(const IndexType target_weight, const IndexType max_vertex_weight)
+{
+    return target_weight + std::max(IndexType(target_weight * PARTITION_IMBALANCE), max_vertex_weight);
+}
+
+// Multilevel bisection: coarsen G by heavy-edge matching, bisect the
+// coarsest graph and refine the bisection on every finer graph. Side 0
+// receives about target_weight of the vertex weight.
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+void partition_bisect(thrust::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType& vertex_weights,
+                      const typename MatrixType::index_type target_weight,
+                      ArrayType& sides)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const IndexType total_weight = thrust::reduce(exec, vertex_weights.begin(), vertex_weights.end());
+    const IndexType targets[2]   = {target_weight, total_weight - target_weight};
+
+    // graphs[l] is coarsened from level l, which is G for l == 0
+    std::vector<MatrixType> graphs;
+    std::vector<ArrayType>  weights;
+    std::vector<ArrayType>  maps;
+
+    while(true)
+    {
+        const MatrixType& fine         = graphs.empty() ? G : graphs.back();
+        const ArrayType&  fine_weights = graphs.empty() ? vertex_weights : weights.back();
+
+        if(fine.num_rows <= PARTITION_COARSEST_SIZE)
+            break;
+
+        ArrayType match(fine.num_rows);
+        partition_match(exec, fine, match);
+
+        MatrixType coarse;
+        ArrayType  coarse_weights;
+        ArrayType  coarse_map;
+        partition_contract(exec, fine, fine_weights, match, coarse_map, coarse, coarse_weights);
+
+        if(coarse.num_rows == fine.num_rows)
+            break;
+
+        const size_t num_fine_rows = fine.num_rows;
+
+        graphs.push_back(MatrixType());
+        weights.push_back(ArrayType());
+        maps.push_back(ArrayType());
+
+        graphs.back().swap(coarse);
+        weights.back().swap(coarse_weights);
+        maps.back().swap(coarse_map);
+
+        // stop once matching barely shrinks the graph
+        if(10 * graphs.back().num_rows > 9 * num_fine_rows)
+            break;
+    }
+
+    for(size_t level = graphs.size() + 1; level > 0; level--)
+    {
+        const MatrixType& graph        = level == 1 ? G : graphs[level - 2];
+        const ArrayType&  graph_weights = level == 1 ? vertex_weights : weights[level - 2];
+
+        const IndexType max_vertex_weight =
+            graph.num_rows == 0 ? IndexType(0) :
+            thrust::reduce(exec, graph_weights.begin(), graph_weights.end(), IndexType(0), thrust::maximum<IndexType>());
+
+        IndexType max_weights[2];
+        max_weights[0] = partition_max_weight(targets[0], max_vertex_weight);
+        max_weights[1] = partition_max_weight(targets[1], max_vertex_weight);
+
+        if(level == graphs.size() + 1)
+        {
+            sides.resize(graph.num_rows);
+            partition_initial(graph, graph_weights, targets[0], max_weights, sides);
+        }
+        else
+        {
+            ArrayType fine_sides(graph.num_rows);
+            thrust::gather(exec, maps[level - 1].begin(), maps[level - 1].end(), sides.begin(), fine_sides.begin());
+            sides.swap(fine_sides);
+
+            partition_refine(exec, graph, graph_weights, max_weights, sides);
+        }
+    }
+}
+
+// Splits G into num_parts parts numbered from first_part by recursive
+// bisection, every side keeps the share of the weight of its parts
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+void partition_recursive(thrust::execution_policy<DerivedPolicy>& exec,
+                         const MatrixType& G,
+                         const ArrayType& vertex_weights,
+                         const size_t num_parts,
+                         const typename MatrixType::index_type first_part,
+                         ArrayType& parts)
+{
+    using namespace thrust::placeholders;
+
+    typedef typename MatrixType::index_type IndexType;
+
+    const size_t N = G.num_rows;
+
+    parts.resize(N);
+
+    if(num_parts == 1 || N == 0)
+    {
+        thrust::fill(exec, parts.begin(), parts.end(), first_part);
+        return;
+    }
+
+    const size_t num_parts0 = num_parts / 2;
+
+    const IndexType total_weight = thrust::reduce(exec, vertex_weights.begin(), vertex_weights.end());
+
+    ArrayType sides;
+    partition_bisect(exec, G, vertex_weights, IndexType(size_t(total_weight) * num_parts0 / num_parts), sides);
+
+    for(IndexType side = 0; side < 2; side++)
+    {
+        // vertices of this side and their numbers in the subgraph
+        ArrayType vertices(N);
+        const size_t num_vertices =
+            thrust::copy_if(exec,
+                            thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(N),
+                            sides.begin(), vertices.begin(), _1 == side) - vertices.begin();
+        vertices.resize(num_vertices);
+
+        ArrayType numbers(N);
+        thrust::transform(exec, sides.begin(), sides.end(), numbers.begin(), _1 == side);
+        thrust::exclusive_scan(exec, numbers.begin(), numbers.end(), numbers.begin());
+
+        // edges inside this side
+        const size_t num_edges =
+            thrust::count_if(exec,
+                             thrust::make_zip_iterator(thrust::make_tuple(
+                                 thrust::make_permutation_iterator(sides.begin(), G.row_indices.begin()),
+                                 thrust::make_permutation_iterator(sides.begin(), G.column_indices.begin()))),
+                             thrust::make_zip_iterator(thrust::make_tuple(
+                                 thrust::make_permutation_iterator(sides.begin(), G.row_indices.end()),
+                                 thrust::make_permutation_iterator(sides.begin(), G.column_indices.end()))),
+                             partition_same_side_functor<IndexType>(side));
+
+        MatrixType S(num_vertices, num_vertices, num_edges);
+
+        thrust::copy_if(exec,
+                        thrust::make_zip_iterator(thrust::make_tuple(G.row_indices.begin(), G.column_indices.begin(), G.values.begin())),
+                        thrust::make_zip_iterator(thrust::make_tuple(G.row_indices.end(), G.column_indices.end(), G.values.end())),
+                        thrust::make_zip_iterator(thrust::make_tuple(
+                            thrust::make_permutation_iterator(sides.begin(), G.row_indices.begin()),
+                            thrust::make_permutation_iterator(sides.begin(), G.column_indices.begin()))),
+                        thrust::make_zip_iterator(thrust::make_tuple(S.row_indices.begin(), S.column_indices.begin(), S.values.begin())),
+                        partition_same_side_functor<IndexType>(side));
+
+        thrust::gather(exec, S.row_indices.begin(), S.row_indices.end(), numbers.begin(), S.row_indices.begin());
+        thrust::gather(exec, S.column_indices.begin(), S.column_indices.end(), numbers.begin(), S.column_indices.begin());
+
+        ArrayType subgraph_weights(num_vertices);
+        thrust::gather(exec, vertices.begin(), vertices.end(), vertex_weights.begin(), subgraph_weights.begin());
+
+        ArrayType subgraph_parts;
+        partition_recursive(exec, S, subgraph_weights,
+                            side == 0 ? num_parts0 : num_parts - num_parts0,
+                            side == 0 ? first_part : IndexType(first_part + num_parts0),
+                            subgraph_parts);
+
+        thrust::scatter(exec, subgraph_parts.begin(), subgraph_parts.end(), vertices.begin(), parts.begin());
+    }
+}
+
+} // end namespace detail
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t multilevel_partition(thrust::execution_policy<DerivedPolicy>& exec,
+                            const MatrixType& G,
+                            const size_t num_parts,
+                                  ArrayType& parts,
+                            cusp::csr_format)
+{
+    typedef typename MatrixType::index_type                        IndexType;
+    typedef typename MatrixType::memory_space                      MemorySpace;
+    typedef cusp::coo_matrix<IndexType, IndexType, MemorySpace>    GraphType;
+    typedef cusp::array1d<IndexType, MemorySpace>                  IndexArray;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    if(num_parts == 0)
+        throw cusp::invalid_input_exception("number of parts must be positive");
+
+    const size_t N = G.num_rows;
+
+    // the pattern of G without self loops, with unit weights
+    GraphType A(N, N, G.num_entries);
+    cusp::offsets_to_indices(exec, G.row_offsets, A.row_indices);
+    thrust::copy(exec, G.column_indices.begin(), G.column_indices.end(), A.column_indices.begin());
+    thrust::fill(exec, A.values.begin(), A.values.end(), IndexType(1));
+
+    const size_t num_edges =
+        thrust::remove_if(exec,
+                          thrust::make_zip_iterator(thrust::make_tuple(A.row_indices.begin(), A.column_indices.begin(), A.values.begin())),
+                          thrust::make_zip_iterator(thrust::make_tuple(A.row_indices.end(), A.column_indices.end(), A.values.end())),
+                          detail::partition_self_loop_functor())
+        - thrust::make_zip_iterator(thrust::make_tuple(A.row_indices.begin(), A.column_indices.begin(), A.values.begin()));
+
+    A.resize(N, N, num_edges);
+
+    IndexArray vertex_weights(N, IndexType(1));
+    IndexArray result;
+
+    detail::partition_recursive(exec, A, vertex_weights, num_parts, IndexType(0), result);
+
+    thrust::copy(exec, result.begin(), result.end(), parts.begin());
+
+    return thrust::count_if(exec,
+                            thrust::make_zip_iterator(thrust::make_tuple(
+                                thrust::make_permutation_iterator(result.begin(), A.row_indices.begin()),
+                                thrust::make_permutation_iterator(result.begin(), A.column_indices.begin()))),
+                            thrust::make_zip_iterator(thrust::make_tuple(
+                                thrust::make_permutation_iterator(result.begin(), A.row_indices.end()),
+                                thrust::make_permutation_iterator(result.begin(), A.column_indices.end()))),
+                            detail::partition_cut_functor());
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t multilevel_partition(thrust::execution_policy<DerivedPolicy>& exec,
+                            const MatrixType& G,
+                            const size_t num_parts,
+                                  ArrayType& parts,
+                            cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    return cusp::graph::multilevel_partition(exec, G_csr, num_parts, parts);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t multilevel_partition(thrust::execution_policy<DerivedPolicy>& exec,
+                            const MatrixType& G,
+                            const size_t num_parts,
+                                  ArrayType& parts)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    return multilevel_partition(thrust::detail::derived_cast(exec), G, num_parts, parts, format);
+}
+
+// declared after the format overloads, which call the overload above
+// with a format tag as the last argument
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType,
+          typename PermutationType>
+size_t multilevel_partition(thrust::execution_policy<DerivedPolicy>& exec,
+                            const MatrixType& G,
+                            const size_t num_parts,
+                                  ArrayType& parts,
+                                  PermutationType& P)
+{
+    typedef typename PermutationType::index_type IndexType;
+
+    const size_t edge_cut = multilevel_partition(exec, G, num_parts, parts);
+
+    const size_t N = G.num_rows;
+
+    // vertices ordered by part and then by index
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> keys(exec, parts.begin(), parts.begin() + N);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> order(exec, N);
+    thrust::sequence(exec, order.begin(), order.end());
+    thrust::stable_sort_by_key(exec, keys.begin(), keys.end(), order.begin());
+
+    P.resize(N);
+    thrust::scatter(exec,
+                    thrust::counting_iterator<IndexType>(0),
+                    thrust::counting_iterator<IndexType>(N),
+                    order.begin(), P.permutation.begin());
+
+    return edge_cut;
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,210 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/detail/type_traits.h>
+
+#include <cusp/array1d.h>
+#include <cusp/copy.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
+
+#include <cusp/detail/execution_policy.h>
+#include <thrust/fill.h>
+#include <thrust/functional.h>
+#include <thrust/inner_product.h>
+#include <thrust/transform.h>
+
+#include <thrust/iterator/counting_iterator.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace detail
+{
+
+// share of the rank of a vertex sent along each of its edges
+template <typename IndexType, typename ValueType>
+struct pagerank_share_functor
+{
+    const IndexType * row_offsets;
+    const ValueType damping;
+
+    pagerank_share_functor(const IndexType * row_offsets, const ValueType damping)
+        : row_offsets(row_offsets), damping(damping) {}
+
+    __host__ __device__
+    ValueType operator()(const IndexType i, const ValueType rank) const
+    {
+        const IndexType degree = row_offsets[i + 1] - row_offsets[i];
+
+        return degree == 0 ? ValueType(0) : damping * rank / ValueType(degree);
+    }
+};
+
+// rank of a vertex without edges, which is spread over all vertices
+template <typename IndexType, typename ValueType>
+struct pagerank_dangling_functor
+{
+    const IndexType * row_offsets;
+
+    pagerank_dangling_functor(const IndexType * row_offsets)
+        : row_offsets(row_offsets) {}
+
+    __host__ __device__
+    ValueType operator()(const IndexType i, const ValueType rank) const
+    {
+        return row_offsets[i + 1] == row_offsets[i] ? rank : ValueType(0);
+    }
+};
+
+template <typename ValueType>
+struct pagerank_difference_functor
+{
+    __host__ __device__
+    ValueType operator()(const ValueType a, const ValueType b) const
+    {
+        return a < b ? b - a : a - b;
+    }
+};
+
+} // end namespace detail
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t pagerank(thrust::execution_policy<DerivedPolicy>& exec,
+                const MatrixType& G,
+                      ArrayType& ranks,
+                const typename ArrayType::value_type damping,
+                const typename ArrayType::value_type tolerance,
+                const size_t max_iterations,
+                      cusp::csr_format)
+{
+    typedef typename MatrixType::index_type   IndexType;
+    typedef typename MatrixType::value_type   MatrixValueType;
+    typedef typename ArrayType::value_type    ValueType;
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const size_t N = G.num_rows;
+
+    ranks.resize(N);
+
+    if(N == 0)
+        return 0;
+
+    // the ranks flow along the incoming edges of every vertex
+    cusp::csr_matrix<IndexType, MatrixValueType, MemorySpace> Gt;
+    cusp::transpose(exec, G, Gt);
+
+    const IndexType * row_offsets = thrust::raw_pointer_cast(&G.row_offsets[0]);
+
+    cusp::array1d<ValueType, MemorySpace> rank(N, ValueType(1) / ValueType(N));
+    cusp::array1d<ValueType, MemorySpace> next(N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> shares(exec, N);
+
+    size_t iteration = 0;
+
+    while(iteration < max_iterations)
+    {
+        iteration++;
+
+        thrust::transform(exec,
+                          thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(N),
+                          rank.begin(), shares.begin(),
+                          detail::pagerank_share_functor<IndexType, ValueType>(row_offsets, damping));
+
+        const ValueType dangling =
+            thrust::inner_product(exec,
+                                  thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(N),
+                                  rank.begin(), ValueType(0),
+                                  thrust::plus<ValueType>(),
+                                  detail::pagerank_dangling_functor<IndexType, ValueType>(row_offsets));
+
+        const ValueType teleport = ((ValueType(1) - damping) + damping * dangling) / ValueType(N);
+
+        // next = teleport + Gt * shares over the (+,second) semiring
+        cusp::generalized_spmv(exec, Gt, shares, cusp::constant_array<ValueType>(N, teleport), next,
+                               thrust::project2nd<MatrixValueType, ValueType>(), thrust::plus<ValueType>());
+
+        const ValueType change =
+            thrust::inner_product(exec, next.begin(), next.end(), rank.begin(), ValueType(0),
+                                  thrust::plus<ValueType>(), detail::pagerank_difference_functor<ValueType>());
+
+        rank.swap(next);
+
+        if(change < tolerance)
+            break;
+    }
+
+    cusp::copy(exec, rank, ranks);
+
+    return iteration;
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t pagerank(thrust::execution_policy<DerivedPolicy>& exec,
+                const MatrixType& G,
+                      ArrayType& ranks,
+                const typename ArrayType::value_type damping,
+                const typename ArrayType::value_type tolerance,
+                const size_t max_iterations,
+                      cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    return cusp::graph::pagerank(exec, G_csr, ranks, damping, tolerance, max_iterations);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t pagerank(thrust::execution_policy<DerivedPolicy>& exec,
+                const MatrixType& G,
+                      ArrayType& ranks,
+                const typename ArrayType::value_type damping,
+                const typename ArrayType::value_type tolerance,
+                const size_t max_iterations)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    return pagerank(thrust::detail::derived_cast(exec), G, ranks, damping, tolerance, max_iterations, format);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -21,10 +21,28 @@
 #include <cusp/detail/execution_policy.h>
 #include <cusp/detail/temporary_array.h>
 
-#include <cusp/graph/breadth_first_search.h>
+#include <cusp/array1d.h>
+#include <cusp/exception.h>
+#include <cusp/format_utils.h>
 
-#include <thrust/count.h>
-#include <thrust/extrema.h>
+#include <thrust/copy.h>
+#include <thrust/fill.h>
+#include <thrust/functional.h>
+#include <thrust/gather.h>
+#include <thrust/scan.h>
+#include <thrust/scatter.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/unique.h>
+
+#include <thrust/iterator/constant_iterator.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
 
 namespace cusp
 {
@@ -35,6 +53,267 @@ namespace detail
 namespace generic
 {
 
+namespace detail
+{
+
+// true for vertices that are neither excluded, with a negative mark, nor
+// marked with stamp
+template <typename IndexType>
+struct peripheral_unmarked_functor
+{
+    const IndexType stamp;
+
+    peripheral_unmarked_functor(const IndexType stamp)
+        : stamp(stamp) {}
+
+    __host__ __device__
+    bool operator()(const IndexType mark) const
+    {
+        return mark >= 0 && mark != stamp;
+    }
+};
+
+// Replaces the frontier with the unmarked neighbors of its vertices and sets
+// their mark to stamp. A neighbor of several
+// frontier vertices belongs to the first of them. If ordered is set, the
+// new frontier is sorted by parent, then by degree and then by index.
+template <typename DerivedPolicy, typename MatrixType, typename IndexArray>
+void peripheral_expand_frontier(thrust::execution_policy<DerivedPolicy>& exec,
+                                const MatrixType& G,
+                                const IndexArray& degrees,
+                                IndexArray& marks,
+                                const typename IndexArray::value_type stamp,
+                                IndexArray& frontier,
+                                const bool ordered)
+{
+    typedef typename IndexArray::value_type IndexType;
+
+    const size_t frontier_size = frontier.size();
+
+    // offsets of the edges of every frontier vertex
+    IndexArray offsets(exec, frontier_size + 1, IndexType(0));
+    thrust::gather(exec, frontier.begin(), frontier.end(), degrees.begin(), offsets.begin());
+    thrust::exclusive_scan(exec, offsets.begin(), offsets.end(), offsets.begin());
+
+    const size_t num_edges = offsets[frontier_size];
+
+    if(num_edges == 0)
+    {
+        IndexArray empty(exec);
+        frontier.swap(empty);
+        return;
+    }
+
+    // frontier position of the parent of every edge
+    IndexArray parents(exec, num_edges);
+    cusp::offsets_to_indices(exec, offsets, parents);
+
+    // position of every edge in the column indices of G
+    IndexArray shifts(exec, frontier_size);
+    thrust::transform(exec,
+                      thrust::make_permutation_iterator(G.row_offsets.begin(), frontier.begin()),
+                      thrust::make_permutation_iterator(G.row_offsets.begin(), frontier.end()),
+                      offsets.begin(), shifts.begin(), thrust::minus<IndexType>());
+
+    IndexArray positions(exec, num_edges);
+    thrust::transform(exec,
+                      thrust::counting_iterator<IndexType>(0),
+                      thrust::counting_iterator<IndexType>(num_edges),
+                      thrust::make_permutation_iterator(shifts.begin(), parents.begin()),
+                      positions.begin(), thrust::plus<IndexType>());
+
+    IndexArray neighbors(exec, num_edges);
+    thrust::gather(exec, positions.begin(), positions.end(), G.column_indices.begin(), neighbors.begin());
+
+    // keep the edges to unmarked vertices
+    IndexArray children(exec, num_edges);
+    IndexArray child_parents(exec, num_edges);
+
+    size_t num_children =
+        thrust::copy_if(exec, neighbors.begin(), neighbors.end(),
+                        thrust::make_permutation_iterator(marks.begin(), neighbors.begin()),
+                        children.begin(), peripheral_unmarked_functor<IndexType>(stamp)) - children.begin();
+    thrust::copy_if(exec, parents.begin(), parents.end(),
+                    thrust::make_permutation_iterator(marks.begin(), neighbors.begin()),
+                    child_parents.begin(), peripheral_unmarked_functor<IndexType>(stamp));
+
+    // edges are in parent order, so a stable sort keeps the first parent of
+    // every child in front
+    thrust::stable_sort_by_key(exec, children.begin(), children.begin() + num_children, child_parents.begin());
+    num_children = thrust::unique_by_key(exec, children.begin(), children.begin() + num_children,
+                                         child_parents.begin()).first - children.begin();
+
+    IndexArray next(exec, children.begin(), children.begin() + num_children);
+
+    if(ordered)
+    {
+        // sort by degree and then stably by parent
+        IndexArray permutation(exec, num_children);
+        thrust::sequence(exec, permutation.begin(), permutation.end());
+
+        IndexArray keys(exec, num_children);
+        thrust::gather(exec, children.begin(), children.begin() + num_children, degrees.begin(), keys.begin());
+        thrust::stable_sort_by_key(exec, keys.begin(), keys.end(), permutation.begin());
+
+        thrust::gather(exec, permutation.begin(), permutation.end(), child_parents.begin(), keys.begin());
+        thrust::stable_sort_by_key(exec, keys.begin(), keys.end(), permutation.begin());
+
+        thrust::gather(exec, permutation.begin(), permutation.end(), children.begin(), next.begin());
+    }
+
+    thrust::scatter(exec,
+                    thrust::constant_iterator<IndexType>(stamp),
+                    thrust::constant_iterator<IndexType>(stamp) + num_children,
+                    next.begin(), marks.begin());
+
+    frontier.swap(next);
+}
+
+// Level structure rooted at root, built frontier by frontier over the
+// vertices with a nonnegative mark. The reached vertices are marked with
+// stamp and stored level by level in vertices, level l starts at
+// offsets[l] and the last offset is the number of reached vertices. Only
+// the reached vertices and their edges are visited.
+template <typename DerivedPolicy, typename MatrixType, typename IndexArray>
+void peripheral_level_structure(thrust::execution_policy<DerivedPolicy>& exec,
+                                const MatrixType& G,
+                                const IndexArray& degrees,
+                                IndexArray& marks,
+                                const typename IndexArray::value_type stamp,
+                                const typename IndexArray::value_type root,
+                                IndexArray& vertices,
+                                std::vector<size_t>& offsets)
+{
+    IndexArray frontier(exec, 1, root);
+    marks[root] = stamp;
+
+    offsets.assign(1, 0);
+
+    while(frontier.size() > 0)
+    {
+        thrust::copy(exec, frontier.begin(), frontier.end(), vertices.begin() + offsets.back());
+        offsets.push_back(offsets.back() + frontier.size());
+
+        peripheral_expand_frontier(exec, G, degrees, marks, stamp, frontier, false);
+    }
+}
+
+// depth and width of a level structure from the sizes of its levels
+template <typename IndexType>
+void peripheral_level_extent(const std::vector<size_t>& offsets,
+                             IndexType& depth,
+                             IndexType& width)
+{
+    depth = offsets.size() - 2;
+    width = 0;
+
+    for(size_t l = 0; l + 1 < offsets.size(); l++)
+        width = std::max(width, IndexType(offsets[l + 1] - offsets[l]));
+}
+
+// George-Liu search starting from the vertex x. Every sweep computes the
+// level structure of the current vertex and tries the vertices of smallest
+// degree in its last level, one per degree and at most max_candidates of
+// them. The search moves to the first candidate with a deeper level
+// structure, otherwise it returns the candidate of smallest width. Every
+// level structure is marked with a new stamp and only covers the vertices
+// reached from x, so a sweep costs O(n + nnz) of the component. The level
+// structure of the returned vertex is left in vertices and offsets, the
+// candidate arrays are work space of N entries.
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename IndexArray>
+typename MatrixType::index_type
+peripheral_search(thrust::execution_policy<DerivedPolicy>& exec,
+                  const MatrixType& G,
+                  const IndexArray& degrees,
+                        IndexArray& marks,
+                        typename IndexArray::value_type& stamp,
+                  typename MatrixType::index_type x,
+                        IndexArray& vertices,
+                        std::vector<size_t>& offsets,
+                        IndexArray& candidate_vertices,
+                        IndexArray& best_vertices,
+                  const size_t max_sweeps,
+                  const size_t max_candidates)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    std::vector<size_t> candidate_offsets;
+    std::vector<size_t> best_offsets;
+
+    IndexType height, width;
+
+    peripheral_level_structure(exec, G, degrees, marks, ++stamp, x, vertices, offsets);
+    peripheral_level_extent(offsets, height, width);
+
+    for(size_t sweep = 0; sweep < max_sweeps; sweep++)
+    {
+        // vertices of the last level ordered by degree, one per degree
+        const size_t num_last = offsets[height + 1] - offsets[height];
+
+        IndexArray candidates(exec, vertices.begin() + offsets[height], vertices.begin() + offsets[height + 1]);
+        IndexArray candidate_degrees(exec, num_last);
+
+        thrust::gather(exec,
+                       candidates.begin(), candidates.end(),
+                       degrees.begin(),
+                       candidate_degrees.begin());
+
+        thrust::stable_sort_by_key(exec, candidate_degrees.begin(), candidate_degrees.end(), candidates.begin());
+
+        const size_t num_candidates =
+            std::min(max_candidates,
+                     size_t(thrust::unique_by_key(exec,
+                                                  candidate_degrees.begin(), candidate_degrees.end(),
+                                                  candidates.begin()).first - candidate_degrees.begin()));
+
+        IndexType best       = -1;
+        IndexType best_width = G.num_rows + 1;
+        bool      deeper     = false;
+
+        for(size_t k = 0; k < num_candidates && !deeper; k++)
+        {
+            const IndexType y = candidates[k];
+
+            IndexType y_height, y_width;
+
+            peripheral_level_structure(exec, G, degrees, marks, ++stamp, y, candidate_vertices, candidate_offsets);
+            peripheral_level_extent(candidate_offsets, y_height, y_width);
+
+            if(y_height > height)
+            {
+                x      = y;
+                height = y_height;
+                deeper = true;
+
+                candidate_vertices.swap(vertices);
+                candidate_offsets.swap(offsets);
+            }
+            else if(y_width < best_width)
+            {
+                best       = y;
+                best_width = y_width;
+
+                candidate_vertices.swap(best_vertices);
+                candidate_offsets.swap(best_offsets);
+            }
+        }
+
+        if(!deeper)
+        {
+            best_vertices.swap(vertices);
+            best_offsets.swap(offsets);
+
+            return best;
+        }
+    }
+
+    return x;
+}
+
+} // end namespace detail
+
 template<typename DerivedPolicy,
          typename MatrixType,
          typename ArrayType>
@@ -42,65 +321,59 @@ typename MatrixType::index_type
 pseudo_peripheral_vertex(thrust::execution_policy<DerivedPolicy>& exec,
                          const MatrixType& G,
                                ArrayType& levels,
+                         const size_t max_sweeps,
+                         const size_t max_candidates,
                          cusp::csr_format)
 {
-    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::index_type                         IndexType;
+    typedef typename MatrixType::memory_space                       MemorySpace;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy> IndexArray;
 
     if(G.num_rows != G.num_cols)
         throw cusp::invalid_input_exception("matrix must be square");
 
-    IndexType delta = 0;
-    IndexType x = rand() % G.num_rows;
-    IndexType y;
+    if(max_candidates == 0)
+        throw cusp::invalid_input_exception("number of candidates must be positive");
+
+    const size_t N = G.num_rows;
 
-    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_lengths(exec, G.num_rows);
+    if(N == 0)
+        return 0;
+
+    IndexArray degrees(exec, N);
     thrust::transform(exec,
                       G.row_offsets.begin() + 1, G.row_offsets.end(),
-                      G.row_offsets.begin(), row_lengths.begin(),
+                      G.row_offsets.begin(), degrees.begin(),
                       thrust::minus<IndexType>());
 
-    while(1)
-    {
-        cusp::graph::breadth_first_search(exec, G, x, levels);
+    IndexArray marks(exec, N, IndexType(0));
+    IndexType  stamp = 0;
 
-        typename ArrayType::iterator max_level_iter = thrust::max_element(exec, levels.begin(), levels.end());
-        int max_level = *max_level_iter;
-        int max_count = thrust::count(exec, levels.begin(), levels.end(), max_level);
+    // level structures of the search, allocated once for all sweeps
+    IndexArray vertices(exec, N);
+    IndexArray candidate_vertices(exec, N);
+    IndexArray best_vertices(exec, N);
+    std::vector<size_t> offsets;
 
-        if( max_count > 1 )
-        {
-            cusp::detail::temporary_array<IndexType, DerivedPolicy> max_level_vertices(exec, max_count);
-            cusp::detail::temporary_array<IndexType, DerivedPolicy> max_level_valence(exec, max_count);
+    const IndexType x =
+        detail::peripheral_search(exec, G, degrees, marks, stamp, IndexType(rand() % N),
+                                  vertices, offsets, candidate_vertices, best_vertices,
+                                  max_sweeps, max_candidates);
 
-            thrust::copy_if(exec,
-                            thrust::counting_iterator<IndexType>(0),
-                            thrust::counting_iterator<IndexType>(G.num_rows),
-                            levels.begin(),
-                            max_level_vertices.begin(),
-                            thrust::placeholders::_1 == max_level);
-
-            thrust::gather(exec,
-                           thrust::counting_iterator<IndexType>(0),
-                           thrust::counting_iterator<IndexType>(max_count),
-                           row_lengths.begin(),
-                           max_level_valence.begin());
-
-            int min_valence_pos = thrust::min_element(exec, max_level_valence.begin(), max_level_valence.end()) - max_level_valence.begin();
-
-            y = max_level_vertices[min_valence_pos];
-        }
-        else
-        {
-            y = max_level_iter - levels.begin();
-        }
+    // level of every reached vertex, -1 for the other components
+    const size_t num_reached = offsets.back();
 
-        if( levels[y] <= delta ) break;
+    cusp::array1d<IndexType, MemorySpace> level_offsets(offsets.begin(), offsets.end());
+    IndexArray reached_levels(exec, num_reached);
+    cusp::offsets_to_indices(exec, level_offsets, reached_levels);
 
-        x = y;
-        delta = levels[y];
-    }
+    thrust::fill(exec, levels.begin(), levels.end(), IndexType(-1));
+    thrust::scatter(exec,
+                    reached_levels.begin(), reached_levels.end(),
+                    vertices.begin(),
+                    levels.begin());
 
-    return y;
+    return x;
 }
 
 template<typename DerivedPolicy,
@@ -109,13 +382,26 @@ template<typename DerivedPolicy,
 typename MatrixType::index_type
 pseudo_peripheral_vertex(thrust::execution_policy<DerivedPolicy>& exec,
                          const MatrixType& G,
-                               ArrayType& levels)
+                               ArrayType& levels,
+                         const size_t max_sweeps,
+                         const size_t max_candidates)
 {
     typedef typename MatrixType::format Format;
 
     Format format;
 
-    return pseudo_peripheral_vertex(thrust::detail::derived_cast(exec), G, levels, format);
+    return pseudo_peripheral_vertex(thrust::detail::derived_cast(exec), G, levels, max_sweeps, max_candidates, format);
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+typename MatrixType::index_type
+pseudo_peripheral_vertex(thrust::execution_policy<DerivedPolicy>& exec,
+                         const MatrixType& G,
+                               ArrayType& levels)
+{
+    return pseudo_peripheral_vertex(exec, G, levels, size_t(-1), size_t(1));
 }
 
 template<typename DerivedPolicy,
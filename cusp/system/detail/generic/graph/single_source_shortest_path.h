@@ -0,0 +1,299 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/detail/type_traits.h>
+
+#include <cusp/array1d.h>
+#include <cusp/copy.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/functional.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
+
+#include <cusp/system/detail/generic/graph/frontier.h>
+
+#include <cusp/detail/execution_policy.h>
+#include <thrust/copy.h>
+#include <thrust/fill.h>
+#include <thrust/for_each.h>
+#include <thrust/functional.h>
+#include <thrust/logical.h>
+#include <thrust/scatter.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/tuple.h>
+
+#include <thrust/iterator/constant_iterator.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+
+#include <limits>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace detail
+{
+
+// length of the path through an edge of weight w to a vertex at distance
+// d, unreached vertices stay unreached
+template <typename WeightType, typename ValueType>
+struct sssp_relax_functor : public thrust::binary_function<WeightType,ValueType,ValueType>
+{
+    ValueType infinity;
+
+    sssp_relax_functor(void)
+        : infinity(std::numeric_limits<ValueType>::max()) {}
+
+    __host__ __device__
+    ValueType operator()(const WeightType w, const ValueType d) const
+    {
+        return d == infinity ? infinity : d + ValueType(w);
+    }
+};
+
+// (candidate, distance, active) lowers the distance and activates the
+// vertex if the candidate is shorter
+struct sssp_update_functor
+{
+    template <typename Tuple>
+    __host__ __device__
+    void operator()(Tuple t) const
+    {
+        if(thrust::get<0>(t) < thrust::get<1>(t))
+        {
+            thrust::get<1>(t) = thrust::get<0>(t);
+            thrust::get<2>(t) = 1;
+        }
+    }
+};
+
+// (active, distance) of the vertices relaxed in the current bucket
+template <typename ValueType>
+struct sssp_frontier_functor
+{
+    const ValueType bound;
+
+    sssp_frontier_functor(const ValueType bound)
+        : bound(bound) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    bool operator()(const Tuple& t) const
+    {
+        return thrust::get<0>(t) && thrust::get<1>(t) < bound;
+    }
+};
+
+// distance of an active vertex, infinity otherwise
+template <typename ValueType>
+struct sssp_pending_functor
+{
+    const ValueType infinity;
+
+    sssp_pending_functor(const ValueType infinity)
+        : infinity(infinity) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    ValueType operator()(const Tuple& t) const
+    {
+        return thrust::get<0>(t) ? thrust::get<1>(t) : infinity;
+    }
+};
+
+} // end namespace detail
+
+// Frontier based Bellman-Ford over the (min,+) semiring. Every round relaxes
+// the edges of the vertices whose distance changed in the previous round,
+// as a SpMSpV on G while the frontier is small and as a SpMV on the
+// transpose of G otherwise. With a positive delta only vertices closer than
+// the current bucket bound are relaxed (delta-stepping), and the bound
+// moves up by delta once the bucket is settled. Delta-stepping needs
+// nonnegative weights, without it a negative cycle is detected after N
+// rounds.
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+void single_source_shortest_path(thrust::execution_policy<DerivedPolicy>& exec,
+                                 const MatrixType& G,
+                                 const typename MatrixType::index_type src,
+                                       ArrayType& distances,
+                                 const typename ArrayType::value_type delta,
+                                       cusp::csr_format)
+{
+    typedef typename MatrixType::index_type   IndexType;
+    typedef typename MatrixType::value_type   WeightType;
+    typedef typename ArrayType::value_type    ValueType;
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    typedef detail::sssp_relax_functor<WeightType, ValueType> RelaxFunctor;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const size_t    N        = G.num_rows;
+    const ValueType infinity = std::numeric_limits<ValueType>::max();
+
+    if(src < 0 || size_t(src) >= N)
+        throw cusp::invalid_input_exception("source vertex out of range");
+
+    // buckets only settle if no edge can lower a distance below the bound
+    if(delta > ValueType(0) &&
+       thrust::any_of(exec, G.values.begin(), G.values.end(), cusp::less_value<WeightType>(WeightType(0))))
+        throw cusp::invalid_input_exception("delta-stepping requires nonnegative edge weights");
+
+    cusp::array1d<ValueType, MemorySpace> dist(N, infinity);
+    cusp::array1d<IndexType, MemorySpace> active(N, IndexType(0));
+    dist[src]   = ValueType(0);
+    active[src] = 1;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> frontier(exec, N);
+    cusp::array1d<IndexType, MemorySpace> indices;
+    cusp::array1d<ValueType, MemorySpace> values;
+
+    // incoming edges for the dense rounds, built on first use
+    cusp::csr_matrix<IndexType, WeightType, MemorySpace> Gt;
+    cusp::array1d<ValueType, MemorySpace> next;
+    bool has_incoming_edges = false;
+
+    ValueType bound  = delta > ValueType(0) ? delta : infinity;
+    size_t    rounds = 0;
+
+    while(true)
+    {
+        const size_t frontier_size =
+            thrust::copy_if(exec,
+                            thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(N),
+                            thrust::make_zip_iterator(thrust::make_tuple(active.begin(), dist.begin())),
+                            frontier.begin(),
+                            detail::sssp_frontier_functor<ValueType>(bound)) - frontier.begin();
+
+        if(frontier_size == 0)
+        {
+            if(bound == infinity)
+                break;
+
+            // move to the bucket of the closest active vertex
+            const ValueType pending =
+                thrust::transform_reduce(exec,
+                                         thrust::make_zip_iterator(thrust::make_tuple(active.begin(), dist.begin())),
+                                         thrust::make_zip_iterator(thrust::make_tuple(active.end(), dist.end())),
+                                         detail::sssp_pending_functor<ValueType>(infinity),
+                                         infinity,
+                                         thrust::minimum<ValueType>());
+
+            if(pending == infinity)
+                break;
+
+            bound = delta * (ValueType(size_t(pending / delta)) + ValueType(1));
+            continue;
+        }
+
+        if(bound == infinity && ++rounds > N)
+            throw cusp::runtime_exception("graph contains a negative cycle");
+
+        thrust::scatter(exec,
+                        thrust::constant_iterator<IndexType>(0),
+                        thrust::constant_iterator<IndexType>(0) + frontier_size,
+                        frontier.begin(), active.begin());
+
+        if(detail::frontier_edges(exec, G, frontier, frontier_size) * detail::FRONTIER_DENSE_FRACTION > G.num_entries)
+        {
+            if(!has_incoming_edges)
+            {
+                cusp::transpose(exec, G, Gt);
+                next.resize(N);
+                has_incoming_edges = true;
+            }
+
+            cusp::generalized_spmv(exec, Gt, dist, dist, next, RelaxFunctor(), thrust::minimum<ValueType>());
+
+            thrust::for_each(exec,
+                             thrust::make_zip_iterator(thrust::make_tuple(next.begin(), dist.begin(), active.begin())),
+                             thrust::make_zip_iterator(thrust::make_tuple(next.end(), dist.end(), active.end())),
+                             detail::sssp_update_functor());
+        }
+        else
+        {
+            const size_t num_entries =
+                detail::frontier_expand(exec, G, frontier, frontier_size, dist, indices, values,
+                                        RelaxFunctor(), thrust::minimum<ValueType>());
+
+            thrust::for_each(exec,
+                             thrust::make_zip_iterator(thrust::make_tuple(
+                                 values.begin(),
+                                 thrust::make_permutation_iterator(dist.begin(), indices.begin()),
+                                 thrust::make_permutation_iterator(active.begin(), indices.begin()))),
+                             thrust::make_zip_iterator(thrust::make_tuple(
+                                 values.begin() + num_entries,
+                                 thrust::make_permutation_iterator(dist.begin(), indices.begin() + num_entries),
+                                 thrust::make_permutation_iterator(active.begin(), indices.begin() + num_entries))),
+                             detail::sssp_update_functor());
+        }
+    }
+
+    cusp::copy(exec, dist, distances);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+void single_source_shortest_path(thrust::execution_policy<DerivedPolicy>& exec,
+                                 const MatrixType& G,
+                                 const typename MatrixType::index_type src,
+                                       ArrayType& distances,
+                                 const typename ArrayType::value_type delta,
+                                       cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    cusp::graph::single_source_shortest_path(exec, G_csr, src, distances, delta);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+void single_source_shortest_path(thrust::execution_policy<DerivedPolicy>& exec,
+                                 const MatrixType& G,
+                                 const typename MatrixType::index_type src,
+                                       ArrayType& distances,
+                                 const typename ArrayType::value_type delta)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    single_source_shortest_path(thrust::detail::derived_cast(exec), G, src, distances, delta, format);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,493 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/type_traits.h>
+
+#include <cusp/array1d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/copy.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/format_utils.h>
+#include <cusp/linear_operator.h>
+#include <cusp/monitor.h>
+#include <cusp/permutation_matrix.h>
+#include <cusp/sort.h>
+
+#include <cusp/eigen/lobpcg.h>
+#include <cusp/precond/aggregation/smoothed_aggregation.h>
+
+#include <cusp/detail/execution_policy.h>
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/fill.h>
+#include <thrust/functional.h>
+#include <thrust/gather.h>
+#include <thrust/reduce.h>
+#include <thrust/scatter.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/tuple.h>
+
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace detail
+{
+
+// parts with fewer vertices keep the order inherited from their parent and
+// are split without computing a Fiedler vector
+static const size_t SPECTRAL_DIRECT_SIZE = 16;
+
+// diagonal shift of the Laplacian handed to smoothed aggregation, which
+// keeps the coarsest level nonsingular
+static const double SPECTRAL_SHIFT = 1e-6;
+
+// stopping criteria of LOBPCG, the Fiedler vector is only used to order the
+// vertices so a loose tolerance suffices
+static const size_t SPECTRAL_ITERATIONS = 100;
+static const double SPECTRAL_TOLERANCE  = 1e-4;
+
+// entries whose two indices differ
+struct spectral_edge_functor
+{
+    template <typename Tuple>
+    __host__ __device__
+    bool operator()(const Tuple& t) const
+    {
+        return thrust::get<0>(t) != thrust::get<1>(t);
+    }
+};
+
+// (degree + shift) of vertex i from the offsets of its edges
+template <typename IndexType, typename ValueType>
+struct spectral_degree_functor
+{
+    const ValueType shift;
+
+    spectral_degree_functor(const ValueType shift)
+        : shift(shift) {}
+
+    __host__ __device__
+    ValueType operator()(const IndexType end, const IndexType start) const
+    {
+        return ValueType(end - start) + shift;
+    }
+};
+
+// row k of L_p x + offset, where L_p is the Laplacian of the subgraph induced
+// by the vertices in positions [begin,end) of the ordering
+template <typename IndexType, typename ValueType>
+struct spectral_laplacian_functor
+{
+    const IndexType * row_offsets;
+    const IndexType * column_indices;
+    const ValueType * values;
+    const IndexType * order;
+    const IndexType * position;
+    const ValueType * x;
+    const IndexType begin;
+    const IndexType end;
+    const ValueType offset;
+
+    spectral_laplacian_functor(const IndexType * row_offsets, const IndexType * column_indices, const ValueType * values,
+                               const IndexType * order, const IndexType * position, const ValueType * x,
+                               const IndexType begin, const IndexType end, const ValueType offset)
+        : row_offsets(row_offsets), column_indices(column_indices), values(values),
+          order(order), position(position), x(x), begin(begin), end(end), offset(offset) {}
+
+    __host__ __device__
+    ValueType operator()(const IndexType k) const
+    {
+        const IndexType i  = order[begin + k];
+        const ValueType xk = x[k];
+
+        ValueType sum = offset;
+
+        for(IndexType jj = row_offsets[i]; jj < row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = column_indices[jj];
+            const IndexType p = position[j];
+
+            if(j == i || p < begin || p >= end) continue;
+
+            // off-diagonal entries hold minus the edge weight
+            sum -= values[jj] * (xk - x[p - begin]);
+        }
+
+        return sum;
+    }
+};
+
+// Laplacian of the subgraph induced by a range of the ordering. A single
+// operator over the Laplacian L of the whole graph serves every bisection,
+// select() moves it to another part without assembling a submatrix. The
+// constant vector is shifted to the top of the spectrum so the smallest
+// eigenpair is the Fiedler pair.
+template <typename MatrixType, typename ArrayType>
+class spectral_laplacian_operator
+    : public cusp::linear_operator<typename MatrixType::value_type,
+                                   typename MatrixType::memory_space,
+                                   typename MatrixType::index_type>
+{
+    typedef typename MatrixType::index_type   IndexType;
+    typedef typename MatrixType::value_type   ValueType;
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    typedef cusp::linear_operator<ValueType,MemorySpace,IndexType> Parent;
+
+public:
+
+    const MatrixType& L;
+    const ArrayType&  order;
+    const ArrayType&  position;
+    const ValueType   shift;
+
+    IndexType begin;
+    IndexType end;
+
+    spectral_laplacian_operator(const MatrixType& L, const ArrayType& order,
+                                const ArrayType& position, const ValueType shift)
+        : Parent(L.num_rows, L.num_cols), L(L), order(order), position(position),
+          shift(shift), begin(0), end(L.num_rows) {}
+
+    void select(const IndexType first, const IndexType last)
+    {
+        begin = first;
+        end   = last;
+
+        Parent::resize(last - first, last - first, 0);
+    }
+
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y) const
+    {
+        const IndexType n = end - begin;
+
+        const ValueType offset = shift * thrust::reduce(x.begin(), x.end(), ValueType(0)) / ValueType(n);
+
+        thrust::transform(thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(n),
+                          y.begin(),
+                          spectral_laplacian_functor<IndexType,ValueType>(
+                              thrust::raw_pointer_cast(&L.row_offsets[0]),
+                              thrust::raw_pointer_cast(&L.column_indices[0]),
+                              thrust::raw_pointer_cast(&L.values[0]),
+                              thrust::raw_pointer_cast(&order[0]),
+                              thrust::raw_pointer_cast(&position[0]),
+                              thrust::raw_pointer_cast(&x[0]),
+                              begin, end, offset));
+    }
+};
+
+// Restriction of a preconditioner of the whole Laplacian to a range of the
+// ordering. Vectors are extended by zero, the result is projected onto the
+// complement of the constant vector.
+template <typename Preconditioner, typename ArrayType>
+class spectral_preconditioner
+    : public cusp::linear_operator<typename Preconditioner::value_type,
+                                   typename Preconditioner::memory_space,
+                                   typename Preconditioner::index_type>
+{
+    typedef typename Preconditioner::index_type   IndexType;
+    typedef typename Preconditioner::value_type   ValueType;
+    typedef typename Preconditioner::memory_space MemorySpace;
+
+    typedef cusp::linear_operator<ValueType,MemorySpace,IndexType> Parent;
+
+public:
+
+    Preconditioner&  M;
+    const ArrayType& order;
+
+    IndexType begin;
+    IndexType end;
+
+    // work vectors of the length of the whole graph
+    cusp::array1d<ValueType,MemorySpace> x_full;
+    cusp::array1d<ValueType,MemorySpace> y_full;
+
+    spectral_preconditioner(Preconditioner& M, const ArrayType& order)
+        : Parent(M.num_rows, M.num_cols), M(M), order(order), begin(0), end(M.num_rows),
+          x_full(M.num_rows), y_full(M.num_rows) {}
+
+    void select(const IndexType first, const IndexType last)
+    {
+        begin = first;
+        end   = last;
+
+        Parent::resize(last - first, last - first, 0);
+    }
+
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y)
+    {
+        using namespace thrust::placeholders;
+
+        const ValueType n = end - begin;
+
+        thrust::fill(x_full.begin(), x_full.end(), ValueType(0));
+        thrust::scatter(x.begin(), x.end(), order.begin() + begin, x_full.begin());
+
+        M(x_full, y_full);
+
+        thrust::gather(order.begin() + begin, order.begin() + end, y_full.begin(), y.begin());
+
+        const ValueType mean = thrust::reduce(y.begin(), y.end(), ValueType(0)) / n;
+        thrust::transform(y.begin(), y.end(), y.begin(), _1 - mean);
+    }
+};
+
+// Orders the vertices in positions [begin,end) along the Fiedler vector of
+// their subgraph and splits them into num_parts parts numbered from
+// first_part, every side keeps the share of the vertices of its parts
+template <typename DerivedPolicy, typename LaplacianOperator, typename Preconditioner, typename ArrayType>
+void spectral_bisect(thrust::execution_policy<DerivedPolicy>& exec,
+                     LaplacianOperator& A,
+                     Preconditioner& M,
+                     ArrayType& order,
+                     ArrayType& position,
+                     ArrayType& parts,
+                     const typename ArrayType::value_type begin,
+                     const typename ArrayType::value_type end,
+                     const size_t num_parts,
+                     const typename ArrayType::value_type first_part)
+{
+    using namespace thrust::placeholders;
+
+    typedef typename ArrayType::value_type         IndexType;
+    typedef typename LaplacianOperator::value_type ValueType;
+    typedef typename ArrayType::memory_space       MemorySpace;
+
+    const size_t n = end - begin;
+
+    if(num_parts == 1 || n == 0)
+    {
+        thrust::fill(exec,
+                     thrust::make_permutation_iterator(parts.begin(), order.begin() + begin),
+                     thrust::make_permutation_iterator(parts.begin(), order.begin() + end),
+                     first_part);
+        return;
+    }
+
+    const size_t num_parts0 = num_parts / 2;
+
+    if(n >= SPECTRAL_DIRECT_SIZE)
+    {
+        A.select(begin, end);
+        M.select(begin, end);
+
+        // random start orthogonal to the constant vector
+        cusp::array1d<ValueType, MemorySpace> X(cusp::random_array<ValueType>(n, begin));
+        const ValueType mean = thrust::reduce(exec, X.begin(), X.end(), ValueType(0)) / ValueType(n);
+        thrust::transform(exec, X.begin(), X.end(), X.begin(), _1 - mean);
+
+        cusp::array1d<ValueType, MemorySpace> S(1, ValueType(0));
+
+        cusp::constant_array<ValueType> b(n, ValueType(1));
+        cusp::monitor<ValueType> monitor(b, SPECTRAL_ITERATIONS, SPECTRAL_TOLERANCE);
+
+        cusp::eigen::lobpcg(A, S, X, monitor, M, false);
+
+        thrust::stable_sort_by_key(exec, X.begin(), X.end(), order.begin() + begin);
+        thrust::scatter(exec,
+                        thrust::counting_iterator<IndexType>(begin), thrust::counting_iterator<IndexType>(end),
+                        order.begin() + begin, position.begin());
+    }
+
+    const IndexType middle = begin + IndexType(n * num_parts0 / num_parts);
+
+    spectral_bisect(exec, A, M, order, position, parts, begin, middle, num_parts0, first_part);
+    spectral_bisect(exec, A, M, order, position, parts, middle, end, num_parts - num_parts0,
+                    IndexType(first_part + num_parts0));
+}
+
+} // end namespace detail
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType,
+          typename PermutationType>
+size_t spectral_partition(thrust::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                          const size_t num_parts,
+                                ArrayType& parts,
+                                PermutationType& P,
+                          cusp::csr_format)
+{
+    typedef typename MatrixType::index_type                     IndexType;
+    typedef double                                              ValueType;
+    typedef typename MatrixType::memory_space                   MemorySpace;
+    typedef cusp::array1d<IndexType, MemorySpace>               IndexArray;
+    typedef cusp::csr_matrix<IndexType, ValueType, MemorySpace> LaplacianMatrix;
+
+    typedef cusp::precond::aggregation::smoothed_aggregation<IndexType, ValueType, MemorySpace> Preconditioner;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    if(num_parts == 0)
+        throw cusp::invalid_input_exception("number of parts must be positive");
+
+    const size_t N = G.num_rows;
+
+    P.resize(N);
+
+    if(N == 0)
+        return 0;
+
+    // edges of G without self loops
+    IndexArray rows(G.num_entries);
+    cusp::offsets_to_indices(exec, G.row_offsets, rows);
+
+    const size_t num_edges =
+        thrust::count_if(exec,
+                         thrust::make_zip_iterator(thrust::make_tuple(rows.begin(), G.column_indices.begin())),
+                         thrust::make_zip_iterator(thrust::make_tuple(rows.end(), G.column_indices.end())),
+                         detail::spectral_edge_functor());
+
+    // assemble L = D - A with unit weights plus a small shift of the diagonal
+    cusp::coo_matrix<IndexType, ValueType, MemorySpace> C(N, N, num_edges + N);
+
+    thrust::copy_if(exec,
+                    thrust::make_zip_iterator(thrust::make_tuple(rows.begin(), G.column_indices.begin())),
+                    thrust::make_zip_iterator(thrust::make_tuple(rows.end(), G.column_indices.end())),
+                    thrust::make_zip_iterator(thrust::make_tuple(C.row_indices.begin(), C.column_indices.begin())),
+                    detail::spectral_edge_functor());
+    thrust::fill(exec, C.values.begin(), C.values.begin() + num_edges, ValueType(-1));
+
+    IndexArray offsets(N + 1);
+    cusp::indices_to_offsets(exec, C.row_indices.subarray(0, num_edges), offsets);
+
+    thrust::sequence(exec, C.row_indices.begin() + num_edges, C.row_indices.end());
+    thrust::sequence(exec, C.column_indices.begin() + num_edges, C.column_indices.end());
+    thrust::transform(exec, offsets.begin() + 1, offsets.end(), offsets.begin(), C.values.begin() + num_edges,
+                      detail::spectral_degree_functor<IndexType, ValueType>(detail::SPECTRAL_SHIFT));
+
+    cusp::sort_by_row_and_column(exec, C.row_indices, C.column_indices, C.values);
+
+    LaplacianMatrix L(N, N, num_edges + N);
+    cusp::indices_to_offsets(exec, C.row_indices, L.row_offsets);
+    thrust::copy(exec, C.column_indices.begin(), C.column_indices.end(), L.column_indices.begin());
+    thrust::copy(exec, C.values.begin(), C.values.end(), L.values.begin());
+
+    // the eigenvalues of every induced subgraph are below twice the largest degree
+    const ValueType max_degree =
+        thrust::reduce(exec, C.values.begin() + num_edges, C.values.end(), ValueType(0), thrust::maximum<ValueType>());
+
+    IndexArray order(N);
+    IndexArray position(N);
+    IndexArray result(N);
+    thrust::sequence(exec, order.begin(), order.end());
+    thrust::sequence(exec, position.begin(), position.end());
+
+    // one Laplacian operator and one hierarchy serve every bisection
+    detail::spectral_laplacian_operator<LaplacianMatrix, IndexArray> A(L, order, position, 2 * max_degree + 1);
+
+    if(num_parts == 1)
+    {
+        thrust::fill(exec, result.begin(), result.end(), IndexType(0));
+    }
+    else
+    {
+        Preconditioner M(L);
+        detail::spectral_preconditioner<Preconditioner, IndexArray> M_part(M, order);
+
+        detail::spectral_bisect(exec, A, M_part, order, position, result, IndexType(0), IndexType(N), num_parts, IndexType(0));
+    }
+
+    thrust::copy(exec, result.begin(), result.end(), parts.begin());
+    thrust::copy(exec, position.begin(), position.end(), P.permutation.begin());
+
+    // C still holds the entries of L in the same order
+    return thrust::count_if(exec,
+                            thrust::make_zip_iterator(thrust::make_tuple(
+                                thrust::make_permutation_iterator(result.begin(), C.row_indices.begin()),
+                                thrust::make_permutation_iterator(result.begin(), L.column_indices.begin()))),
+                            thrust::make_zip_iterator(thrust::make_tuple(
+                                thrust::make_permutation_iterator(result.begin(), C.row_indices.end()),
+                                thrust::make_permutation_iterator(result.begin(), L.column_indices.end()))),
+                            detail::spectral_edge_functor());
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType,
+          typename PermutationType>
+size_t spectral_partition(thrust::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                          const size_t num_parts,
+                                ArrayType& parts,
+                                PermutationType& P,
+                          cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    return cusp::graph::spectral_partition(exec, G_csr, num_parts, parts, P);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType,
+          typename PermutationType>
+size_t spectral_partition(thrust::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                          const size_t num_parts,
+                                ArrayType& parts,
+                                PermutationType& P)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    return spectral_partition(thrust::detail::derived_cast(exec), G, num_parts, parts, P, format);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t spectral_partition(thrust::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                          const size_t num_parts,
+                                ArrayType& parts)
+{
+    typedef typename MatrixType::index_type   IndexType;
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    cusp::permutation_matrix<IndexType, MemorySpace> P;
+
+    return spectral_partition(exec, G, num_parts, parts, P);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
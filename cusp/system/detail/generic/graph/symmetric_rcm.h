@@ -15,13 +15,33 @@
  */
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/temporary_array.h>
 
-#include <cusp/graph/pseudo_peripheral.h>
+#include <cusp/exception.h>
+#include <cusp/format_utils.h>
+
+#include <cusp/system/detail/generic/graph/pseudo_peripheral.h>
 
 #include <cusp/detail/execution_policy.h>
-#include <thrust/sequence.h>
+#include <thrust/copy.h>
+#include <thrust/extrema.h>
+#include <thrust/find.h>
+#include <thrust/functional.h>
+#include <thrust/gather.h>
+#include <thrust/replace.h>
+#include <thrust/scan.h>
 #include <thrust/scatter.h>
+#include <thrust/sequence.h>
 #include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/unique.h>
+
+#include <thrust/iterator/constant_iterator.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/reverse_iterator.h>
+
+#include <vector>
 
 namespace cusp
 {
@@ -31,7 +51,38 @@ namespace detail
 {
 namespace generic
 {
+namespace detail
+{
+
+template <typename IndexType>
+struct rcm_isolated_functor
+{
+    const IndexType * Ap;
+    const IndexType * Aj;
+
+    rcm_isolated_functor(const IndexType * Ap, const IndexType * Aj)
+        : Ap(Ap), Aj(Aj) {}
+
+    // true if vertex i has no neighbors besides itself
+    __host__ __device__
+    bool operator()(const IndexType i) const
+    {
+        for(IndexType jj = Ap[i]; jj < Ap[i + 1]; jj++)
+            if(Aj[jj] != i)
+                return false;
+
+        return true;
+    }
+};
 
+} // end namespace detail
+
+// Reverse Cuthill-McKee ordering. Every component is numbered level by
+// level from a pseudo-peripheral vertex, with the children of each level
+// ordered by the position of their parent and then by degree, and the
+// order is reversed at the end. Vertices without neighbors follow the
+// components in the Cuthill-McKee order, so they come first in the RCM
+// numbering.
 template<typename DerivedPolicy,
          typename MatrixType,
          typename PermutationType>
@@ -40,26 +91,100 @@ void symmetric_rcm(thrust::execution_policy<DerivedPolicy>& exec,
                          PermutationType& P,
                    cusp::csr_format)
 {
-    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::index_type                         IndexType;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy> IndexArray;
+
+    // mark of the vertices that are numbered
+    const IndexType PLACED = -1;
 
     if(G.num_rows != G.num_cols)
         throw cusp::invalid_input_exception("matrix must be square");
 
     assert(P.num_rows == G.num_rows);
 
-    // find peripheral vertex and return BFS levels from vertex
-    cusp::graph::pseudo_peripheral_vertex(exec, G, P.permutation);
-
-    // sort vertices by level in BFS traversal
-    cusp::detail::temporary_array<IndexType,DerivedPolicy> levels(exec, G.num_rows);
-    thrust::sequence(exec, levels.begin(), levels.end());
-    thrust::sort_by_key(exec, P.permutation.begin(), P.permutation.end(), levels.begin());
+    const IndexType N = G.num_rows;
+
+    // an empty graph may have no row offsets to take the address of
+    if(N == 0)
+        return;
+
+    IndexArray degrees(exec, N);
+    thrust::transform(exec,
+                      G.row_offsets.begin() + 1, G.row_offsets.end(),
+                      G.row_offsets.begin(), degrees.begin(),
+                      thrust::minus<IndexType>());
+
+    // Cuthill-McKee order of the vertices
+    IndexArray order(exec, N);
+    IndexType num_placed = 0;
+
+    IndexArray marks(exec, N, IndexType(0));
+
+    if(G.num_entries == 0)
+    {
+        // every vertex is isolated and column_indices may be empty, so the
+        // functor below must not take its address
+        thrust::sequence(exec, order.begin(), order.end());
+        num_placed = N;
+    }
+    else
+    {
+        detail::rcm_isolated_functor<IndexType> isolated(thrust::raw_pointer_cast(&G.row_offsets[0]),
+                                                         thrust::raw_pointer_cast(&G.column_indices[0]));
+
+        // vertices without neighbors are skipped by the traversal and
+        // appended after the last component of the Cuthill-McKee order
+        thrust::replace_if(exec, marks.begin(), marks.end(),
+                           thrust::counting_iterator<IndexType>(0), isolated, PLACED);
+
+        // level structures of the pseudo-peripheral searches, shared by all
+        // components since every search only touches its own component
+        IndexArray vertices(exec, N);
+        IndexArray candidate_vertices(exec, N);
+        IndexArray best_vertices(exec, N);
+        std::vector<size_t> offsets;
+        IndexType stamp = 0;
+
+        IndexType start = 0;
+
+        while(true)
+        {
+            // first vertex of the next component
+            start = thrust::find_if(exec, marks.begin() + start, marks.end(),
+                                    detail::peripheral_unmarked_functor<IndexType>(PLACED)) - marks.begin();
+
+            if(start == N)
+                break;
+
+            // the search starts at start and stays in its component
+            const IndexType root =
+                detail::peripheral_search(exec, G, degrees, marks, stamp, start,
+                                          vertices, offsets, candidate_vertices, best_vertices,
+                                          size_t(-1), size_t(1));
+
+            IndexArray frontier(exec, 1, root);
+            marks[root] = PLACED;
+
+            while(frontier.size() > 0)
+            {
+                thrust::copy(exec, frontier.begin(), frontier.end(), order.begin() + num_placed);
+                num_placed += frontier.size();
+
+                detail::peripheral_expand_frontier(exec, G, degrees, marks, PLACED, frontier, true);
+            }
+        }
+
+        thrust::copy_if(exec,
+                        thrust::counting_iterator<IndexType>(0),
+                        thrust::counting_iterator<IndexType>(N),
+                        order.begin() + num_placed, isolated);
+    }
 
     // form RCM permutation matrix
     thrust::scatter(exec,
                     thrust::counting_iterator<IndexType>(0),
-                    thrust::counting_iterator<IndexType>(G.num_rows),
-                    levels.begin(), P.permutation.begin());
+                    thrust::counting_iterator<IndexType>(N),
+                    thrust::make_reverse_iterator(order.end()), P.permutation.begin());
 }
 
 template <typename DerivedPolicy,
@@ -97,6 +97,21 @@ void generalized_spmv(thrust::execution_policy<DerivedPolicy> &exec,
                       BinaryFunction1 combine,
                       BinaryFunction2 reduce);
 
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Vector1,
+          typename Vector2,
+          typename BinaryFunction1,
+          typename BinaryFunction2,
+          typename Accumulator>
+void generalized_spmspv(thrust::execution_policy<DerivedPolicy> &exec,
+                        const LinearOperator&  A,
+                        const Vector1& x,
+                        Vector2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        Accumulator accumulator);
+
 } // end namespace generic
 } // end namespace detail
 } // end namespace system
@@ -25,6 +25,7 @@
 #include <cusp/system/detail/generic/multiply/generalized_spgemm.h>
 #include <cusp/system/detail/generic/multiply/permute.h>
 #include <cusp/system/detail/generic/multiply/spgemm.h>
+#include <cusp/system/detail/generic/multiply/spmspv.h>
 #include <cusp/system/detail/generic/multiply/spmv.h>
 
 #include <thrust/functional.h>
@@ -185,6 +186,32 @@ void generalized_spmv(thrust::execution_policy<DerivedPolicy> &exec,
     generalized_spmv(exec, A, x, y, z, combine, reduce, format1, format2, format3, format4);
 }
 
+template <typename DerivedPolicy,
+         typename LinearOperator,
+         typename Vector1,
+         typename Vector2,
+         typename BinaryFunction1,
+         typename BinaryFunction2,
+         typename Accumulator>
+void generalized_spmspv(thrust::execution_policy<DerivedPolicy> &exec,
+                        const LinearOperator&  A,
+                        const Vector1& x,
+                        Vector2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        Accumulator accumulator)
+{
+    typedef typename LinearOperator::format  Format1;
+    typedef typename Vector1::format         Format2;
+    typedef typename Vector2::format         Format3;
+
+    Format1 format1;
+    Format2 format2;
+    Format3 format3;
+
+    generalized_spmspv(thrust::detail::derived_cast(exec), A, x, y, combine, reduce, accumulator, format1, format2, format3);
+}
+
 } // end namespace generic
 } // end namespace detail
 } // end namespace system
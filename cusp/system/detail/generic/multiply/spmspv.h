@@ -0,0 +1,486 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/detail/type_traits.h>
+
+#include <cusp/csc_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/format_utils.h>
+
+#include <cusp/system/detail/generic/multiply/generalized_spmv.h>
+
+#include <thrust/binary_search.h>
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/functional.h>
+#include <thrust/gather.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/scatter.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/tuple.h>
+
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+template <typename IndexType>
+struct spmspv_degree_functor : public thrust::unary_function<IndexType,IndexType>
+{
+    const IndexType * row_offsets;
+
+    spmspv_degree_functor(const IndexType * row_offsets)
+        : row_offsets(row_offsets) {}
+
+    __host__ __device__
+    IndexType operator()(const IndexType i) const
+    {
+        return row_offsets[i + 1] - row_offsets[i];
+    }
+};
+
+// position in A of the k-th product, given the entry of the sparse vector
+// that owns it and the end of its products in the expansion
+template <typename IndexType>
+struct spmspv_edge_functor
+{
+    const IndexType * row_offsets;
+    const IndexType * indices;
+    const IndexType * ends;
+
+    spmspv_edge_functor(const IndexType * row_offsets, const IndexType * indices, const IndexType * ends)
+        : row_offsets(row_offsets), indices(indices), ends(ends) {}
+
+    __host__ __device__
+    IndexType operator()(const IndexType k, const IndexType owner) const
+    {
+        const IndexType i = indices[owner];
+
+        return row_offsets[i + 1] - (ends[owner] - k);
+    }
+};
+
+template <typename BinaryFunction>
+struct spmspv_combine_functor
+{
+    typedef typename BinaryFunction::result_type result_type;
+
+    BinaryFunction combine;
+
+    spmspv_combine_functor(BinaryFunction combine)
+        : combine(combine) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    result_type operator()(const Tuple& t) const
+    {
+        return combine(thrust::get<0>(t), thrust::get<1>(t));
+    }
+};
+
+// position of column j in the sparse vector, or -1 if x[j] is zero
+template <typename IndexType>
+struct spmspv_position_functor : public thrust::unary_function<IndexType,IndexType>
+{
+    const IndexType * positions;
+    const IndexType   num_cols;
+
+    spmspv_position_functor(const IndexType * positions, const IndexType num_cols)
+        : positions(positions), num_cols(num_cols) {}
+
+    __host__ __device__
+    IndexType operator()(const IndexType j) const
+    {
+        return (j < 0 || j >= num_cols) ? IndexType(-1) : positions[j];
+    }
+};
+
+template <typename IndexType>
+struct spmspv_match_functor : public thrust::unary_function<IndexType,bool>
+{
+    __host__ __device__
+    bool operator()(const IndexType position) const
+    {
+        return position >= 0;
+    }
+};
+
+// Multiplies the rows of A selected by a sparse vector, given by the first
+// size entries of indices and the values they map to, over a semiring. Every
+// entry A(i,j) of a selected row i contributes combine(A(i,j), x[i]) to entry
+// j of the result. The contributions are sorted by j and merged with reduce,
+// the entries of the result are returned sorted by index and their number is
+// returned.
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType1,
+          typename ValueIterator,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+size_t spmspv_expand(thrust::execution_policy<DerivedPolicy>& exec,
+                     const MatrixType& A,
+                     const ArrayType1& indices,
+                     const size_t size,
+                     ValueIterator values,
+                     ArrayType2& output_indices,
+                     ArrayType3& output_values,
+                     BinaryFunction1 combine,
+                     BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type   IndexType;
+    typedef typename ArrayType3::value_type   ValueType;
+
+    if(size == 0)
+        return 0;
+
+    const IndexType * row_offsets = thrust::raw_pointer_cast(&A.row_offsets[0]);
+
+    // end of the products of every selected row in the expansion
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> ends(exec, size);
+    thrust::inclusive_scan(exec,
+                           thrust::make_transform_iterator(indices.begin(), spmspv_degree_functor<IndexType>(row_offsets)),
+                           thrust::make_transform_iterator(indices.begin() + size, spmspv_degree_functor<IndexType>(row_offsets)),
+                           ends.begin());
+
+    const size_t num_products = ends[size - 1];
+
+    if(num_products == 0)
+        return 0;
+
+    // entry of the sparse vector and position in A of every product
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> owners(exec, num_products);
+    thrust::upper_bound(exec,
+                        ends.begin(), ends.end(),
+                        thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(num_products),
+                        owners.begin());
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> entries(exec, num_products);
+    thrust::transform(exec,
+                      thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(num_products),
+                      owners.begin(), entries.begin(),
+                      spmspv_edge_functor<IndexType>(row_offsets,
+                                                     thrust::raw_pointer_cast(&indices[0]),
+                                                     thrust::raw_pointer_cast(&ends[0])));
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> keys(exec, num_products);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> products(exec, num_products);
+
+    thrust::gather(exec, entries.begin(), entries.end(), A.column_indices.begin(), keys.begin());
+    thrust::transform(exec,
+                      thrust::make_zip_iterator(thrust::make_tuple(
+                          thrust::make_permutation_iterator(A.values.begin(), entries.begin()),
+                          thrust::make_permutation_iterator(values, owners.begin()))),
+                      thrust::make_zip_iterator(thrust::make_tuple(
+                          thrust::make_permutation_iterator(A.values.begin(), entries.end()),
+                          thrust::make_permutation_iterator(values, owners.end()))),
+                      products.begin(),
+                      spmspv_combine_functor<BinaryFunction1>(combine));
+
+    thrust::stable_sort_by_key(exec, keys.begin(), keys.end(), products.begin());
+
+    output_indices.resize(num_products);
+    output_values.resize(num_products);
+
+    const size_t num_entries =
+        thrust::reduce_by_key(exec,
+                              keys.begin(), keys.end(), products.begin(),
+                              output_indices.begin(), output_values.begin(),
+                              thrust::equal_to<IndexType>(), reduce).first - output_indices.begin();
+
+    output_indices.resize(num_entries);
+    output_values.resize(num_entries);
+
+    return num_entries;
+}
+
+// y = A * x, every row of A is matched against x and reduced in place so
+// no accumulator is needed. Every entry of A is visited whatever the
+// number of entries of x, only x * A is proportional to the rows selected
+// by x.
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2,
+          typename Accumulator>
+void generalized_spmspv(thrust::execution_policy<DerivedPolicy>& exec,
+                        const MatrixType& A,
+                        const VectorType1& x,
+                        VectorType2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        Accumulator,
+                        cusp::csr_format,
+                        cusp::sparse_vector_format,
+                        cusp::sparse_vector_format)
+{
+    typedef typename MatrixType::index_type   IndexType;
+    typedef typename VectorType2::value_type  ValueType;
+
+    if(A.num_cols != x.length)
+        throw cusp::invalid_input_exception("matrix and vector dimensions do not match");
+
+    if(A.num_entries == 0 || x.num_entries == 0)
+    {
+        y.resize(A.num_rows, 0);
+        return;
+    }
+
+    // position in x of every column of A
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> positions(exec, A.num_cols, IndexType(-1));
+    thrust::scatter(exec,
+                    thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(x.num_entries),
+                    x.indices.begin(), positions.begin());
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> matches(exec, A.num_entries);
+    thrust::transform(exec,
+                      A.column_indices.begin(), A.column_indices.begin() + A.num_entries,
+                      matches.begin(),
+                      spmspv_position_functor<IndexType>(thrust::raw_pointer_cast(&positions[0]), A.num_cols));
+
+    const size_t num_matches = thrust::count_if(exec, matches.begin(), matches.end(), spmspv_match_functor<IndexType>());
+
+    if(num_matches == 0)
+    {
+        y.resize(A.num_rows, 0);
+        return;
+    }
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_indices(exec, A.num_entries);
+    cusp::offsets_to_indices(exec, A.row_offsets, row_indices);
+
+    // the products of the matching entries, unmatched entries read x[0]
+    // and are dropped
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> rows(exec, num_matches);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> products(exec, num_matches);
+
+    thrust::copy_if(exec,
+                    thrust::make_zip_iterator(thrust::make_tuple(
+                        row_indices.begin(),
+                        thrust::make_transform_iterator(
+                            thrust::make_zip_iterator(thrust::make_tuple(
+                                A.values.begin(),
+                                thrust::make_permutation_iterator(x.values.begin(),
+                                    thrust::make_transform_iterator(matches.begin(), valid_index_functor<IndexType>(x.num_entries))))),
+                            spmspv_combine_functor<BinaryFunction1>(combine)))),
+                    thrust::make_zip_iterator(thrust::make_tuple(
+                        row_indices.end(),
+                        thrust::make_transform_iterator(
+                            thrust::make_zip_iterator(thrust::make_tuple(
+                                A.values.begin() + A.num_entries,
+                                thrust::make_permutation_iterator(x.values.begin(),
+                                    thrust::make_transform_iterator(matches.end(), valid_index_functor<IndexType>(x.num_entries))))),
+                            spmspv_combine_functor<BinaryFunction1>(combine)))),
+                    matches.begin(),
+                    thrust::make_zip_iterator(thrust::make_tuple(rows.begin(), products.begin())),
+                    spmspv_match_functor<IndexType>());
+
+    y.resize(A.num_rows, num_matches);
+
+    const size_t num_entries =
+        thrust::reduce_by_key(exec,
+                              rows.begin(), rows.end(), products.begin(),
+                              y.indices.begin(), y.values.begin(),
+                              thrust::equal_to<IndexType>(), reduce).first - y.indices.begin();
+
+    y.resize(A.num_rows, num_entries);
+}
+
+// y = x * A, only the rows of A selected by x are visited and their
+// products are merged by sorting
+template <typename DerivedPolicy,
+          typename VectorType1,
+          typename MatrixType,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2,
+          typename Accumulator>
+void generalized_spmspv(thrust::execution_policy<DerivedPolicy>& exec,
+                        const VectorType1& x,
+                        const MatrixType& A,
+                        VectorType2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        Accumulator,
+                        cusp::sparse_vector_format,
+                        cusp::csr_format,
+                        cusp::sparse_vector_format)
+{
+    if(A.num_rows != x.length)
+        throw cusp::invalid_input_exception("matrix and vector dimensions do not match");
+
+    const size_t num_entries =
+        spmspv_expand(exec, A, x.indices, x.num_entries, x.values.begin(), y.indices, y.values, combine, reduce);
+
+    y.resize(A.num_cols, num_entries);
+}
+
+// y = A * x with A in CSC is y = x * A^T, the column offsets and row
+// indices of A are the CSR arrays of A^T so only the columns selected by x
+// are visited
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2,
+          typename Accumulator>
+void generalized_spmspv(thrust::execution_policy<DerivedPolicy>& exec,
+                        const MatrixType& A,
+                        const VectorType1& x,
+                        VectorType2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        Accumulator accumulator,
+                        cusp::csc_format,
+                        cusp::sparse_vector_format,
+                        cusp::sparse_vector_format)
+{
+    cusp::generalized_spmspv(exec, x, cusp::make_transpose_view(A), y, combine, reduce, accumulator);
+}
+
+// y = x * A with A in CSC is y = A^T * x
+template <typename DerivedPolicy,
+          typename VectorType1,
+          typename MatrixType,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2,
+          typename Accumulator>
+void generalized_spmspv(thrust::execution_policy<DerivedPolicy>& exec,
+                        const VectorType1& x,
+                        const MatrixType& A,
+                        VectorType2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        Accumulator accumulator,
+                        cusp::sparse_vector_format,
+                        cusp::csc_format,
+                        cusp::sparse_vector_format)
+{
+    cusp::generalized_spmspv(exec, cusp::make_transpose_view(A), x, y, combine, reduce, accumulator);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2,
+          typename Accumulator>
+void generalized_spmspv(thrust::execution_policy<DerivedPolicy>& exec,
+                        const MatrixType& A,
+                        const VectorType1& x,
+                        VectorType2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        Accumulator accumulator,
+                        cusp::sparse_format,
+                        cusp::sparse_vector_format,
+                        cusp::sparse_vector_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix A_csr(A);
+
+    cusp::generalized_spmspv(exec, A_csr, x, y, combine, reduce, accumulator);
+}
+
+template <typename DerivedPolicy,
+          typename VectorType1,
+          typename MatrixType,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2,
+          typename Accumulator>
+void generalized_spmspv(thrust::execution_policy<DerivedPolicy>& exec,
+                        const VectorType1& x,
+                        const MatrixType& A,
+                        VectorType2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        Accumulator accumulator,
+                        cusp::sparse_vector_format,
+                        cusp::sparse_format,
+                        cusp::sparse_vector_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix A_csr(A);
+
+    cusp::generalized_spmspv(exec, x, A_csr, y, combine, reduce, accumulator);
+}
+
+// multiply with sparse vectors, the output is overwritten so initialize is
+// not applied
+template <typename DerivedPolicy,
+         typename LinearOperator, typename MatrixOrVector1, typename MatrixOrVector2,
+         typename UnaryFunction,  typename BinaryFunction1, typename BinaryFunction2>
+void multiply(thrust::execution_policy<DerivedPolicy> &exec,
+              const LinearOperator&  A,
+              const MatrixOrVector1& B,
+              MatrixOrVector2& C,
+              UnaryFunction    initialize,
+              BinaryFunction1  combine,
+              BinaryFunction2  reduce,
+              cusp::sparse_format,
+              cusp::sparse_vector_format,
+              cusp::sparse_vector_format)
+{
+    cusp::generalized_spmspv(exec, A, B, C, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+         typename LinearOperator, typename MatrixOrVector1, typename MatrixOrVector2,
+         typename UnaryFunction,  typename BinaryFunction1, typename BinaryFunction2>
+void multiply(thrust::execution_policy<DerivedPolicy> &exec,
+              const LinearOperator&  A,
+              const MatrixOrVector1& B,
+              MatrixOrVector2& C,
+              UnaryFunction    initialize,
+              BinaryFunction1  combine,
+              BinaryFunction2  reduce,
+              cusp::sparse_vector_format,
+              cusp::sparse_format,
+              cusp::sparse_vector_format)
+{
+    cusp::generalized_spmspv(exec, A, B, C, combine, reduce);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -265,6 +265,151 @@ void multiply(thrust::execution_policy<DerivedPolicy> &exec,
     cusp::multiply(exec, A_coo_view, B, C, initialize, combine, reduce);
 }
 
+// multiplies by the COO view of the blocks, systems without a block kernel
+// use this version
+template <typename DerivedPolicy,
+         typename LinearOperator, typename MatrixOrVector1, typename MatrixOrVector2,
+         typename UnaryFunction,  typename BinaryFunction1, typename BinaryFunction2>
+void multiply(thrust::execution_policy<DerivedPolicy> &exec,
+              LinearOperator&  A,
+              MatrixOrVector1& B,
+              MatrixOrVector2& C,
+              UnaryFunction    initialize,
+              BinaryFunction1  combine,
+              BinaryFunction2  reduce,
+              cusp::bsr_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename LinearOperator::const_coo_view_type CooViewType;
+
+    if(A.num_entries == 0)
+    {
+        thrust::transform(exec, C.begin(), C.end(), C.begin(), initialize);
+        return;
+    }
+
+    CooViewType A_coo_view(A);
+
+    cusp::multiply(exec, A_coo_view, B, C, initialize, combine, reduce);
+}
+
+// multiplies by the COO view of the chunks, systems without a sliced ELL
+// kernel use this version
+template <typename DerivedPolicy,
+         typename LinearOperator, typename MatrixOrVector1, typename MatrixOrVector2,
+         typename UnaryFunction,  typename BinaryFunction1, typename BinaryFunction2>
+void multiply(thrust::execution_policy<DerivedPolicy> &exec,
+              LinearOperator&  A,
+              MatrixOrVector1& B,
+              MatrixOrVector2& C,
+              UnaryFunction    initialize,
+              BinaryFunction1  combine,
+              BinaryFunction2  reduce,
+              cusp::sell_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename LinearOperator::const_coo_view_type CooViewType;
+
+    if(A.num_entries == 0)
+    {
+        thrust::transform(exec, C.begin(), C.end(), C.begin(), initialize);
+        return;
+    }
+
+    CooViewType A_coo_view(A);
+
+    cusp::multiply(exec, A_coo_view, B, C, initialize, combine, reduce);
+}
+
+// multiplies by the COO view holding both triangles, systems without a
+// symmetric kernel use this version
+template <typename DerivedPolicy,
+         typename LinearOperator, typename MatrixOrVector1, typename MatrixOrVector2,
+         typename UnaryFunction,  typename BinaryFunction1, typename BinaryFunction2>
+void multiply(thrust::execution_policy<DerivedPolicy> &exec,
+              LinearOperator&  A,
+              MatrixOrVector1& B,
+              MatrixOrVector2& C,
+              UnaryFunction    initialize,
+              BinaryFunction1  combine,
+              BinaryFunction2  reduce,
+              cusp::symmetric_csr_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename LinearOperator::const_coo_view_type CooViewType;
+
+    if(A.num_entries == 0)
+    {
+        thrust::transform(exec, C.begin(), C.end(), C.begin(), initialize);
+        return;
+    }
+
+    CooViewType A_coo_view(A);
+
+    cusp::multiply(exec, A_coo_view, B, C, initialize, combine, reduce);
+}
+
+// multiplies by the COO view holding the decoded column indices, systems
+// without a compressed CSR kernel use this version
+template <typename DerivedPolicy,
+         typename LinearOperator, typename MatrixOrVector1, typename MatrixOrVector2,
+         typename UnaryFunction,  typename BinaryFunction1, typename BinaryFunction2>
+void multiply(thrust::execution_policy<DerivedPolicy> &exec,
+              LinearOperator&  A,
+              MatrixOrVector1& B,
+              MatrixOrVector2& C,
+              UnaryFunction    initialize,
+              BinaryFunction1  combine,
+              BinaryFunction2  reduce,
+              cusp::compressed_csr_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename LinearOperator::const_coo_view_type CooViewType;
+
+    if(A.num_entries == 0)
+    {
+        thrust::transform(exec, C.begin(), C.end(), C.begin(), initialize);
+        return;
+    }
+
+    CooViewType A_coo_view(A);
+
+    cusp::multiply(exec, A_coo_view, B, C, initialize, combine, reduce);
+}
+
+// multiplies by the row-major COO view, systems without a CSC kernel use
+// this version
+template <typename DerivedPolicy,
+         typename LinearOperator, typename MatrixOrVector1, typename MatrixOrVector2,
+         typename UnaryFunction,  typename BinaryFunction1, typename BinaryFunction2>
+void multiply(thrust::execution_policy<DerivedPolicy> &exec,
+              LinearOperator&  A,
+              MatrixOrVector1& B,
+              MatrixOrVector2& C,
+              UnaryFunction    initialize,
+              BinaryFunction1  combine,
+              BinaryFunction2  reduce,
+              cusp::csc_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename LinearOperator::const_coo_view_type CooViewType;
+
+    if(A.num_entries == 0)
+    {
+        thrust::transform(exec, C.begin(), C.end(), C.begin(), initialize);
+        return;
+    }
+
+    CooViewType A_coo_view(A);
+
+    cusp::multiply(exec, A_coo_view, B, C, initialize, combine, reduce);
+}
+
 template <typename DerivedPolicy,
           typename LinearOperator, typename MatrixOrVector1, typename MatrixOrVector2,
           typename UnaryFunction,  typename BinaryFunction1, typename BinaryFunction2>
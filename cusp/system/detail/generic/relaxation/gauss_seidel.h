@@ -22,6 +22,9 @@
 
 #include <cusp/detail/execution_policy.h>
 
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+
 namespace cusp
 {
 namespace system
@@ -30,6 +33,48 @@ namespace detail
 {
 namespace generic
 {
+namespace detail
+{
+
+// row i of A holds the equation of unknown ordering[i]
+template <typename IndexType, typename ValueType>
+struct gauss_seidel_reordered_functor
+{
+    const IndexType * Ap;
+    const IndexType * Aj;
+    const ValueType * Ax;
+    const IndexType * ordering;
+    const ValueType * b;
+    ValueType * x;
+
+    gauss_seidel_reordered_functor(const IndexType * Ap, const IndexType * Aj, const ValueType * Ax,
+                                   const IndexType * ordering, const ValueType * b, ValueType * x)
+        : Ap(Ap), Aj(Aj), Ax(Ax), ordering(ordering), b(b), x(x) {}
+
+    __host__ __device__
+    void operator()(const IndexType i) const
+    {
+        const IndexType row = ordering[i];
+
+        ValueType rsum = 0;
+        ValueType diag = 0;
+
+        for(IndexType jj = Ap[i]; jj < Ap[i + 1]; jj++)
+        {
+            const IndexType j = Aj[jj];
+
+            if (row == j)
+                diag = Ax[jj];
+            else
+                rsum += Ax[jj] * x[j];
+        }
+
+        if (diag != 0)
+            x[row] = (b[row] - rsum) / diag;
+    }
+};
+
+} // end namespace detail
 
 template<typename DerivedPolicy,
          typename MatrixType,
@@ -47,6 +92,40 @@ void gauss_seidel_indexed(sequential::execution_policy<DerivedPolicy>& exec,
     throw cusp::not_implemented_exception("generic gauss_seidel_indexed not implemented");
 }
 
+// Relaxes the rows [row_start, row_stop) of a matrix whose rows have been
+// permuted by color, so the rows of a color are stored contiguously.
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType1,
+         typename ArrayType2>
+void gauss_seidel_reordered(thrust::execution_policy<DerivedPolicy>& exec,
+                            const MatrixType& A,
+                                  ArrayType1&  x,
+                            const ArrayType1&  b,
+                            const ArrayType2& ordering,
+                            const int row_start,
+                            const int row_stop)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    if(row_start == row_stop || A.num_entries == 0)
+        return;
+
+    detail::gauss_seidel_reordered_functor<IndexType,ValueType>
+        func(thrust::raw_pointer_cast(&A.row_offsets[0]),
+             thrust::raw_pointer_cast(&A.column_indices[0]),
+             thrust::raw_pointer_cast(&A.values[0]),
+             thrust::raw_pointer_cast(&ordering[0]),
+             thrust::raw_pointer_cast(&b[0]),
+             thrust::raw_pointer_cast(&x[0]));
+
+    thrust::for_each(exec,
+                     thrust::counting_iterator<IndexType>(row_start),
+                     thrust::counting_iterator<IndexType>(row_stop),
+                     func);
+}
+
 } // end namespace generic
 } // end namespace detail
 } // end namespace system
@@ -18,6 +18,7 @@
 
 #include <cusp/detail/config.h>
 #include <cusp/detail/array2d_format_utils.h>
+#include <cusp/detail/bsr_format_utils.h>
 #include <cusp/detail/format.h>
 #include <cusp/detail/temporary_array.h>
 #include <cusp/detail/utils.h>
@@ -28,6 +29,10 @@
 #include <cusp/csr_matrix.h>
 #include <cusp/sort.h>
 
+#include <thrust/fill.h>
+#include <thrust/gather.h>
+#include <thrust/sequence.h>
+
 #include <thrust/system/detail/generic/tag.h>
 #include <thrust/iterator/counting_iterator.h>
 #include <thrust/iterator/permutation_iterator.h>
@@ -114,6 +119,64 @@ void transpose(thrust::execution_policy<DerivedPolicy>& exec,
     cusp::indices_to_offsets(exec, At_row_indices, At.row_offsets);
 }
 
+// Bsr format, the blocks of At have A.block_cols rows and A.block_rows columns
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2>
+void transpose(thrust::execution_policy<DerivedPolicy>& exec,
+               const MatrixType1& A,
+                     MatrixType2& At,
+                     cusp::bsr_format,
+                     cusp::bsr_format)
+{
+    typedef typename MatrixType2::index_type   IndexType2;
+
+    const size_t num_blocks = A.num_blocks();
+
+    cusp::detail::temporary_array<IndexType2, DerivedPolicy> At_row_indices(exec, A.column_indices);
+    cusp::detail::temporary_array<IndexType2, DerivedPolicy> permutation(exec, num_blocks);
+
+    At.resize(A.num_cols, A.num_rows, num_blocks, A.block_cols, A.block_rows);
+
+    if(num_blocks == 0)
+    {
+        thrust::fill(exec, At.row_offsets.begin(), At.row_offsets.end(), IndexType2(0));
+        return;
+    }
+
+    // transpose the block pattern and record where every block comes from
+    cusp::offsets_to_indices(exec, A.row_offsets, At.column_indices);
+
+    thrust::sequence(exec, permutation.begin(), permutation.end());
+
+    cusp::sort_by_row(exec, At_row_indices, At.column_indices, permutation);
+
+    cusp::indices_to_offsets(exec, At_row_indices, At.row_offsets);
+
+    // transpose the entries of every block
+    cusp::detail::bsr_transpose_index_functor<IndexType2> index_functor(A.block_rows, A.block_cols,
+                                                                        thrust::raw_pointer_cast(&permutation[0]));
+
+    thrust::gather(exec,
+                   thrust::make_transform_iterator(thrust::counting_iterator<IndexType2>(0), index_functor),
+                   thrust::make_transform_iterator(thrust::counting_iterator<IndexType2>(At.values.size()), index_functor),
+                   A.values.begin(),
+                   At.values.begin());
+}
+
+// Symmetric CSR format, the matrix is its own transpose
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2>
+void transpose(thrust::execution_policy<DerivedPolicy>& exec,
+               const MatrixType1& A,
+                     MatrixType2& At,
+                     cusp::symmetric_csr_format,
+                     cusp::symmetric_csr_format)
+{
+    cusp::copy(exec, A, At);
+}
+
 template <typename DerivedPolicy,
           typename MatrixType1,
           typename MatrixType2,
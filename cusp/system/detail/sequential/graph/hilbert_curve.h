@@ -19,16 +19,12 @@
 #include <cusp/detail/format.h>
 #include <cusp/detail/temporary_array.h>
 
-#include <cusp/array1d.h>
-#include <cusp/exception.h>
-
 #include <cusp/system/detail/sequential/execution_policy.h>
 
-#include <thrust/extrema.h>
-#include <thrust/gather.h>
 #include <thrust/sequence.h>
 #include <thrust/sort.h>
-#include <thrust/transform.h>
+
+#include <algorithm>
 
 namespace cusp
 {
@@ -114,162 +110,96 @@ static unsigned const istate3d [] = { // 3 dimension to nkey state transitions
     14, 23,  2,  9, 22, 23, 21,  0
 };
 
-static const unsigned *d2d[]= {idata2d,  idata2d  +4, idata2d  +8, idata2d  +12};
-static const unsigned *s2d[]= {istate2d, istate2d +4, istate2d +8, istate2d +12};
-
-static const unsigned int *d3d[] =
-{   idata3d,      idata3d +8,   idata3d +16,  idata3d +24,
-    idata3d +32,  idata3d +40,  idata3d +48,  idata3d +56,
-    idata3d +64,  idata3d +72,  idata3d +80,  idata3d +88,
-    idata3d +96,  idata3d +104, idata3d +112, idata3d +120,
-    idata3d +128, idata3d +136, idata3d +144, idata3d +152,
-    idata3d +160, idata3d +168, idata3d +176, idata3d +184
-};
-
-static const unsigned int *s3d[] =
-{   istate3d,      istate3d +8,   istate3d +16,  istate3d +24,
-    istate3d +32,  istate3d +40,  istate3d +48,  istate3d +56,
-    istate3d +64,  istate3d +72,  istate3d +80,  istate3d +88,
-    istate3d +96,  istate3d +104, istate3d +112, istate3d +120,
-    istate3d +128, istate3d +136, istate3d +144, istate3d +152,
-    istate3d +160, istate3d +168, istate3d +176, istate3d +184
-};
-
-struct hilbert_transform_2d : public thrust::unary_function<double,double>
+// number of points whose keys are computed together
+static const size_t HILBERT_BATCH_SIZE = 256;
+
+// Computes the Hilbert keys of the points in [begin,end) one batch at a time.
+// Each level of the curve is applied to the whole batch before the next one,
+// so the inner loops carry no dependence from one point to the next. The
+// 56 significant bits of a key are kept in a 64-bit integer, which orders
+// the points exactly.
+template <typename Array2d, typename KeyArray>
+void hilbert_keys(const Array2d& coord,
+                  const size_t begin,
+                  const size_t end,
+                  KeyArray& keys)
 {
-    template<typename Tuple>
-    __host__
-    double operator()(const Tuple& t) const
-    {
-        const double x = thrust::get<0>(t);
-        const double y = thrust::get<1>(t);
+    typedef typename Array2d::const_column_view::iterator Iterator;
 
-        int level;
-        unsigned int key[2], c[2], temp, state;
+    const size_t dims = coord.num_cols;
 
-        // convert x,y coordinates to integers in range [0, IMAX]
-        c[0] = (unsigned int) (x * (double) IMAX);               // x
-        c[1] = (unsigned int) (y * (double) IMAX);               // y
+    unsigned int c[3][HILBERT_BATCH_SIZE];
+    unsigned int state[HILBERT_BATCH_SIZE];
+    unsigned long long key[HILBERT_BATCH_SIZE];
 
-        // use state tables to convert nested quadrant's coordinates level by level
-        key[0] = key[1] = 0;
-        state = 0;
-        for (level = 0; level < MAXLEVEL_2d; level++) {
-            temp = ((c[0] >> (30-level)) & 2)    // extract 2 bits at current level
-                   | ((c[1] >> (31-level)) & 1);
+    for(size_t base = begin; base < end; base += HILBERT_BATCH_SIZE)
+    {
+        const size_t batch_size = std::min(HILBERT_BATCH_SIZE, end - base);
 
-            // treat key[] as long shift register, shift in converted coordinate
-            key[0] = (key[0] << 2) | (key[1] >> 30);
-            key[1] = (key[1] << 2) | *(d2d[state] + temp);
+        // convert coordinates to integers in range [0, IMAX]
+        for(size_t d = 0; d < dims; d++)
+        {
+            Iterator x = coord.column(d).begin() + base;
 
-            state = *(s2d[state] + temp);
+            for(size_t b = 0; b < batch_size; b++)
+                c[d][b] = (unsigned int) (double(x[b]) * (double) IMAX);
         }
 
-        // convert 2 part Hilbert key to double and return
-        return ldexp ((double) key[0], -24)  +  ldexp ((double) key[1], -56);
-    }
-};
-
-struct hilbert_transform_3d : public thrust::unary_function<double,double>
-{
-    template<typename Tuple>
-    __host__
-    double operator()(const Tuple& t) const
-    {
-        const double x = thrust::get<0>(t);
-        const double y = thrust::get<1>(t);
-        const double z = thrust::get<2>(t);
-
-        int level;
-        unsigned int key[2], c[3], temp, state;
-
-        // convert x,y,z coordinates to integers in range [0, IMAX]
-        c[0] = (unsigned int) (x * (double) IMAX);         // x
-        c[1] = (unsigned int) (y * (double) IMAX);         // y
-        c[2] = (unsigned int) (z * (double) IMAX);     		 // z
+        for(size_t b = 0; b < batch_size; b++)
+        {
+            key[b]   = 0;
+            state[b] = 0;
+        }
 
         // use state tables to convert nested quadrant's coordinates level by level
-        key[0] = key[1] = 0;
-        state = 0;
-        for (level = 0; level < MAXLEVEL_3d; level++) {
-            temp = ((c[0] >> (29-level)) & 4)  // extract 3 bits at current level
-                   | ((c[1] >> (30-level)) & 2)
-                   | ((c[2] >> (31-level)) & 1);
-
-            // treat key[] as long shift register, shift in converted coordinate
-            key[0] = (key[0] << 3) |  (key[1] >> 29);
-            key[1] = (key[1] << 3) | *(d3d[state] + temp);
-
-            state = *(s3d[state] + temp);
+        if(dims == 2)
+        {
+            for(int level = 0; level < MAXLEVEL_2d; level++)
+            {
+                for(size_t b = 0; b < batch_size; b++)
+                {
+                    const unsigned int temp = ((c[0][b] >> (30-level)) & 2)    // extract 2 bits at current level
+                                              | ((c[1][b] >> (31-level)) & 1);
+
+                    key[b]   = (key[b] << 2) | idata2d[4 * state[b] + temp];
+                    state[b] = istate2d[4 * state[b] + temp];
+                }
+            }
+        }
+        else
+        {
+            for(int level = 0; level < MAXLEVEL_3d; level++)
+            {
+                for(size_t b = 0; b < batch_size; b++)
+                {
+                    const unsigned int temp = ((c[0][b] >> (29-level)) & 4)  // extract 3 bits at current level
+                                              | ((c[1][b] >> (30-level)) & 2)
+                                              | ((c[2][b] >> (31-level)) & 1);
+
+                    key[b]   = (key[b] << 3) | idata3d[8 * state[b] + temp];
+                    state[b] = istate3d[8 * state[b] + temp];
+                }
+            }
         }
 
-        // convert 2 part Hilbert key to double and return
-        return ldexp ((double) key[0], -25)  +  ldexp ((double) key[1], -57);
+        for(size_t b = 0; b < batch_size; b++)
+            keys[base + b] = key[b];
     }
-};
+}
 
 } // end namespace detail
 
-template <typename DerivedPolicy, typename Array2d, typename Array1d>
-void hilbert_curve(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+// sorts the points along the Hilbert curve
+template <typename DerivedPolicy, typename Array2d, typename ArrayType>
+void hilbert_order(thrust::cpp::execution_policy<DerivedPolicy>& exec,
                    const Array2d& coord,
-                   size_t num_parts,
-                   Array1d& parts)
+                   ArrayType& order)
 {
-    typedef typename Array1d::value_type PartType;
-    typedef typename Array2d::const_column_view::iterator Iterator;
-    typedef typename Array2d::value_type ValueType;
-
-    size_t num_points = coord.num_rows;
-    size_t dims = coord.num_cols;
-
-    if( (dims != 2) && (dims != 3) )
-        throw cusp::invalid_input_exception("Hilbert curve partitioning only implemented for 2D or 3D data.");
-
-    thrust::pair<Iterator,Iterator> x_iter = thrust::minmax_element(exec, coord.column(0).begin(), coord.column(0).end());
-    thrust::pair<Iterator,Iterator> y_iter = thrust::minmax_element(exec, coord.column(1).begin(), coord.column(1).end());
-
-    ValueType xmin = *x_iter.first;
-    ValueType xmax = *x_iter.second;
-    ValueType ymin = *y_iter.first;
-    ValueType ymax = *y_iter.second;
-
-    if( xmin < ValueType(0) || xmax > ValueType(1) || ymin < ValueType(0) || ymax > ValueType(1) )
-        throw cusp::invalid_input_exception("Hilbert coordinates should be in the range [0,1]");
-
-    cusp::detail::temporary_array<double, DerivedPolicy> hilbert_keys(exec, coord.num_rows);
-
-    if( dims == 2 )
-    {
-        thrust::transform(exec,
-                          thrust::make_zip_iterator(thrust::make_tuple(coord.column(0).begin(), coord.column(1).begin())),
-                          thrust::make_zip_iterator(thrust::make_tuple(coord.column(0).end(), coord.column(1).end())),
-                          hilbert_keys.begin(), detail::hilbert_transform_2d());
-    }
-    else
-    {
-        thrust::pair<Iterator,Iterator> z_iter = thrust::minmax_element(exec, coord.column(2).begin(), coord.column(2).end());
-        ValueType zmin = *z_iter.first;
-        ValueType zmax = *z_iter.second;
-
-        if( zmin < ValueType(0) || zmax > ValueType(1) )
-            throw cusp::invalid_input_exception("Hilbert coordinates should be in the range [0,1]");
-
-        thrust::transform(exec,
-                          thrust::make_zip_iterator(thrust::make_tuple(coord.column(0).begin(), coord.column(1).begin(), coord.column(2).begin())),
-                          thrust::make_zip_iterator(thrust::make_tuple(coord.column(0).end(), coord.column(1).end(), coord.column(2).end())),
-                          hilbert_keys.begin(), detail::hilbert_transform_3d());
-    }
-
-    cusp::detail::temporary_array<PartType, DerivedPolicy> perm(exec, num_points);
-    thrust::sequence(exec, perm.begin(), perm.end());
-    thrust::sort_by_key(exec, hilbert_keys.begin(), hilbert_keys.end(), perm.begin());
+    cusp::detail::temporary_array<unsigned long long, DerivedPolicy> keys(exec, coord.num_rows);
+    detail::hilbert_keys(coord, 0, coord.num_rows, keys);
 
-    cusp::detail::temporary_array<PartType, DerivedPolicy> uniform_parts(exec, num_points);
-    thrust::transform(exec,
-                      thrust::counting_iterator<PartType>(0), thrust::counting_iterator<PartType>(num_points),
-                      thrust::constant_iterator<PartType>(num_points/num_parts), uniform_parts.begin(), thrust::divides<PartType>());
-    thrust::gather(exec, perm.begin(), perm.end(), uniform_parts.begin(), parts.begin());
+    thrust::sequence(exec, order.begin(), order.end());
+    thrust::sort_by_key(exec, keys.begin(), keys.end(), order.begin());
 }
 
 } // end namespace sequential
@@ -25,6 +25,9 @@
 
 #include <cusp/system/detail/sequential/execution_policy.h>
 
+#include <limits>
+#include <vector>
+
 namespace cusp
 {
 namespace system
@@ -38,6 +41,7 @@ template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
 size_t vertex_coloring(thrust::cpp::execution_policy<DerivedPolicy>& exec,
                        const MatrixType& G,
                        ArrayType& colors,
+                       const bool balance,
                        cusp::csr_format)
 {
     typedef typename MatrixType::index_type IndexType;
@@ -73,6 +77,40 @@ size_t vertex_coloring(thrust::cpp::execution_policy<DerivedPolicy>& exec,
         colors[vertex] = vertex_color;
     }
 
+    if(balance && max_color > 1)
+    {
+        // move vertices of classes above the average size to the first
+        // class below it that none of their neighbors uses
+        const size_t target = (N + max_color - 1) / max_color;
+
+        std::vector<size_t> sizes(max_color, 0);
+
+        for(size_t vertex = 0; vertex < N; vertex++)
+            sizes[colors[vertex]]++;
+
+        thrust::fill(exec, mark.begin(), mark.end(), std::numeric_limits<IndexType>::max());
+
+        for(size_t vertex = 0; vertex < N; vertex++)
+        {
+            const size_t color = colors[vertex];
+
+            if(sizes[color] <= target) continue;
+
+            for(IndexType offset = G.row_offsets[vertex]; offset < G.row_offsets[vertex + 1]; offset++)
+                mark[colors[G.column_indices[offset]]] = vertex;
+
+            size_t new_color = 0;
+            while(new_color < max_color && (sizes[new_color] >= target || mark[new_color] == vertex))
+                new_color++;
+
+            if(new_color == max_color) continue;
+
+            colors[vertex] = new_color;
+            sizes[color]--;
+            sizes[new_color]++;
+        }
+    }
+
     return max_color;
 }
 
@@ -19,11 +19,16 @@
 #include <cusp/detail/config.h>
 #include <cusp/system/detail/sequential/execution_policy.h>
 
+#include <cusp/system/detail/sequential/multiply/bsr_spmv.h>
+#include <cusp/system/detail/sequential/multiply/compressed_csr_spmv.h>
 #include <cusp/system/detail/sequential/multiply/coo_spmv.h>
+#include <cusp/system/detail/sequential/multiply/csc_spmv.h>
 #include <cusp/system/detail/sequential/multiply/csr_spmv.h>
 #include <cusp/system/detail/sequential/multiply/dia_spmv.h>
 #include <cusp/system/detail/sequential/multiply/ell_spmv.h>
 #include <cusp/system/detail/sequential/multiply/hyb_spmv.h>
+#include <cusp/system/detail/sequential/multiply/sell_spmv.h>
+#include <cusp/system/detail/sequential/multiply/symmetric_csr_spmv.h>
 
 #include <cusp/system/detail/sequential/multiply/csr_block_spmv.h>
 
@@ -33,3 +38,5 @@
 #include <cusp/system/detail/sequential/multiply/csr_spgemm.h>
 #include <cusp/system/detail/sequential/multiply/coo_spgemm.h>
 
+#include <cusp/system/detail/sequential/multiply/spmspv.h>
+
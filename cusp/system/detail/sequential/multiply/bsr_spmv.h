@@ -0,0 +1,360 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/system/detail/sequential/execution_policy.h>
+
+#include <thrust/memory.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+
+// Compute block row i of y. The block dimensions R and C are compile-time
+// constants, so the loops over the entries of a block are unrolled and the
+// sums of the block row are kept in a fixed-size local array.
+template <int R, int C,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_bsr_block_row(const MatrixType& A,
+                        const size_t i,
+                        const VectorType1& x,
+                        VectorType2& y,
+                        UnaryFunction   initialize,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const IndexType row_start = A.row_offsets[i];
+    const IndexType row_end   = A.row_offsets[i + 1];
+
+    ValueType sums[R];
+
+    for(int r = 0; r < R; r++)
+        sums[r] = initialize(y[i * R + r]);
+
+    for(IndexType jj = row_start; jj < row_end; jj++)
+    {
+        const size_t j    = size_t(A.column_indices[jj]) * C;
+        const size_t base = size_t(jj) * R * C;
+
+        for(int r = 0; r < R; r++)
+            for(int c = 0; c < C; c++)
+                sums[r] = reduce(sums[r], combine(A.values[base + r * C + c], x[j + c]));
+    }
+
+    for(int r = 0; r < R; r++)
+        y[i * R + r] = sums[r];
+}
+
+// Compute block row i of y for block dimensions only known at runtime, the
+// rows of the block row are processed one at a time.
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_bsr_row(const MatrixType& A,
+                  const size_t i,
+                  const VectorType1& x,
+                  VectorType2& y,
+                  UnaryFunction   initialize,
+                  BinaryFunction1 combine,
+                  BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const size_t    R         = A.block_rows;
+    const size_t    C         = A.block_cols;
+    const IndexType row_start = A.row_offsets[i];
+    const IndexType row_end   = A.row_offsets[i + 1];
+
+    for(size_t r = 0; r < R; r++)
+    {
+        ValueType sum = initialize(y[i * R + r]);
+
+        for(IndexType jj = row_start; jj < row_end; jj++)
+        {
+            const size_t j    = size_t(A.column_indices[jj]) * C;
+            const size_t base = size_t(jj) * R * C + r * C;
+
+            for(size_t c = 0; c < C; c++)
+                sum = reduce(sum, combine(A.values[base + c], x[j + c]));
+        }
+
+        y[i * R + r] = sum;
+    }
+}
+
+template <int R, int C,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_bsr_block_rows(const MatrixType& A,
+                         const size_t row_begin,
+                         const size_t row_end,
+                         const VectorType1& x,
+                         VectorType2& y,
+                         UnaryFunction   initialize,
+                         BinaryFunction1 combine,
+                         BinaryFunction2 reduce)
+{
+    for(size_t i = row_begin; i < row_end; i++)
+        spmv_bsr_block_row<R,C>(A, i, x, y, initialize, combine, reduce);
+}
+
+// Compute block rows [row_begin, row_end) of y, the common square block
+// sizes use the unrolled kernel.
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_bsr(const MatrixType& A,
+              const size_t row_begin,
+              const size_t row_end,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce)
+{
+    const size_t block_size = A.block_rows == A.block_cols ? A.block_rows : 0;
+
+    switch(block_size)
+    {
+    case 1:
+        spmv_bsr_block_rows<1,1>(A, row_begin, row_end, x, y, initialize, combine, reduce);
+        break;
+    case 2:
+        spmv_bsr_block_rows<2,2>(A, row_begin, row_end, x, y, initialize, combine, reduce);
+        break;
+    case 3:
+        spmv_bsr_block_rows<3,3>(A, row_begin, row_end, x, y, initialize, combine, reduce);
+        break;
+    case 4:
+        spmv_bsr_block_rows<4,4>(A, row_begin, row_end, x, y, initialize, combine, reduce);
+        break;
+    case 6:
+        spmv_bsr_block_rows<6,6>(A, row_begin, row_end, x, y, initialize, combine, reduce);
+        break;
+    default:
+        for(size_t i = row_begin; i < row_end; i++)
+            spmv_bsr_row(A, i, x, y, initialize, combine, reduce);
+    }
+}
+
+// Compute block row i of Y for all columns of X. Every block is loaded once
+// and applied to all columns, sums holds block_rows * X.num_cols partial
+// sums. R and C are the block dimensions, or 0 if they are only known at
+// runtime.
+template <int R, int C,
+          typename MatrixType,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename ValueType,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmm_bsr_block_row(const MatrixType& A,
+                        const size_t i,
+                        const MatrixType1& X,
+                        MatrixType2& Y,
+                        ValueType * sums,
+                        UnaryFunction   initialize,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const size_t block_rows  = R > 0 ? size_t(R) : size_t(A.block_rows);
+    const size_t block_cols  = C > 0 ? size_t(C) : size_t(A.block_cols);
+    const size_t num_vectors = X.num_cols;
+
+    const IndexType row_start = A.row_offsets[i];
+    const IndexType row_end   = A.row_offsets[i + 1];
+
+    for(size_t r = 0; r < block_rows; r++)
+        for(size_t k = 0; k < num_vectors; k++)
+            sums[r * num_vectors + k] = initialize(Y(i * block_rows + r, k));
+
+    for(IndexType jj = row_start; jj < row_end; jj++)
+    {
+        const size_t j    = size_t(A.column_indices[jj]) * block_cols;
+        const size_t base = size_t(jj) * block_rows * block_cols;
+
+        for(size_t r = 0; r < block_rows; r++)
+        {
+            for(size_t c = 0; c < block_cols; c++)
+            {
+                const ValueType Aij = A.values[base + r * block_cols + c];
+
+                for(size_t k = 0; k < num_vectors; k++)
+                    sums[r * num_vectors + k] = reduce(sums[r * num_vectors + k], combine(Aij, X(j + c, k)));
+            }
+        }
+    }
+
+    for(size_t r = 0; r < block_rows; r++)
+        for(size_t k = 0; k < num_vectors; k++)
+            Y(i * block_rows + r, k) = sums[r * num_vectors + k];
+}
+
+template <int R, int C,
+          typename MatrixType,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename ValueType,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmm_bsr_block_rows(const MatrixType& A,
+                         const size_t row_begin,
+                         const size_t row_end,
+                         const MatrixType1& X,
+                         MatrixType2& Y,
+                         ValueType * sums,
+                         UnaryFunction   initialize,
+                         BinaryFunction1 combine,
+                         BinaryFunction2 reduce)
+{
+    for(size_t i = row_begin; i < row_end; i++)
+        spmm_bsr_block_row<R,C>(A, i, X, Y, sums, initialize, combine, reduce);
+}
+
+// Compute block rows [row_begin, row_end) of Y = A * X
+template <typename MatrixType,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename ValueType,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmm_bsr(const MatrixType& A,
+              const size_t row_begin,
+              const size_t row_end,
+              const MatrixType1& X,
+              MatrixType2& Y,
+              ValueType * sums,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce)
+{
+    const size_t block_size = A.block_rows == A.block_cols ? A.block_rows : 0;
+
+    switch(block_size)
+    {
+    case 1:
+        spmm_bsr_block_rows<1,1>(A, row_begin, row_end, X, Y, sums, initialize, combine, reduce);
+        break;
+    case 2:
+        spmm_bsr_block_rows<2,2>(A, row_begin, row_end, X, Y, sums, initialize, combine, reduce);
+        break;
+    case 3:
+        spmm_bsr_block_rows<3,3>(A, row_begin, row_end, X, Y, sums, initialize, combine, reduce);
+        break;
+    case 4:
+        spmm_bsr_block_rows<4,4>(A, row_begin, row_end, X, Y, sums, initialize, combine, reduce);
+        break;
+    case 6:
+        spmm_bsr_block_rows<6,6>(A, row_begin, row_end, X, Y, sums, initialize, combine, reduce);
+        break;
+    default:
+        spmm_bsr_block_rows<0,0>(A, row_begin, row_end, X, Y, sums, initialize, combine, reduce);
+    }
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::bsr_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    const size_t num_block_rows = A.row_offsets.size() - 1;
+
+    spmv_bsr(A, 0, num_block_rows, x, y, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::bsr_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    typedef typename VectorType2::values_array_type::value_type ValueType;
+
+    const size_t num_block_rows = A.row_offsets.size() - 1;
+
+    if(num_block_rows == 0 || x.num_cols == 0)
+        return;
+
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> sums(exec, A.block_rows * x.num_cols);
+
+    spmm_bsr(A, 0, num_block_rows, x, y, thrust::raw_pointer_cast(&sums[0]), initialize, combine, reduce);
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/compressed_csr_format_utils.h>
+
+#include <cusp/system/detail/sequential/execution_policy.h>
+
+#include <thrust/memory.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+
+// Compute the rows [row_begin, row_end) of y, decoding the column indices
+// while the row is multiplied. The delta width is a template parameter so
+// the decoding of every entry reduces to a byte load and an add.
+template <int DeltaWidth,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_compressed_csr(const MatrixType& A,
+                         const size_t row_begin,
+                         const size_t row_end,
+                         const VectorType1& x,
+                         VectorType2& y,
+                         UnaryFunction   initialize,
+                         BinaryFunction1 combine,
+                         BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const IndexType num_cols = A.num_cols;
+
+    // the deltas are empty when the matrix has no entries
+    const unsigned char * column_deltas = A.column_deltas.size() == 0 ? NULL :
+                                          thrust::raw_pointer_cast(&A.column_deltas[0]);
+
+    for(size_t i = row_begin; i < row_end; i++)
+    {
+        const IndexType row_start = A.row_offsets[i];
+        const IndexType row_stop  = A.row_offsets[i + 1];
+        const IndexType base      = A.column_bases[i];
+
+        ValueType accumulator = initialize(y[i]);
+
+        if(base < num_cols)
+        {
+            const unsigned char * deltas = column_deltas + size_t(row_start) * DeltaWidth;
+
+            for(IndexType jj = row_start; jj < row_stop; jj++, deltas += DeltaWidth)
+            {
+                const IndexType j = base + cusp::detail::compressed_csr_delta<DeltaWidth,IndexType>(deltas);
+
+                accumulator = reduce(accumulator, combine(A.values[jj], x[j]));
+            }
+        }
+        else
+        {
+            // the row keeps its full column indices
+            const IndexType offset = base - num_cols - row_start;
+
+            for(IndexType jj = row_start; jj < row_stop; jj++)
+            {
+                const IndexType j = A.column_indices[offset + jj];
+
+                accumulator = reduce(accumulator, combine(A.values[jj], x[j]));
+            }
+        }
+
+        y[i] = accumulator;
+    }
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::compressed_csr_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    if(A.delta_width == 1)
+        spmv_compressed_csr<1>(A, 0, A.num_rows, x, y, initialize, combine, reduce);
+    else
+        spmv_compressed_csr<2>(A, 0, A.num_rows, x, y, initialize, combine, reduce);
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/execution_policy.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+
+// Scatter the products of the columns [col_begin, col_end) into the
+// entries y[i - row_begin] of the rows they touch. Without flags the
+// entries of y are already initialized and every product is reduced into
+// them, otherwise flags[i - row_begin] marks the entries of y that hold a
+// partial result.
+template <typename MatrixType,
+          typename VectorType1,
+          typename ArrayType,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_csc(const MatrixType& A,
+              const size_t col_begin,
+              const size_t col_end,
+              const VectorType1& x,
+              ArrayType& y,
+              unsigned char * flags,
+              const size_t row_begin,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename ArrayType::value_type  ValueType;
+
+    for(size_t j = col_begin; j < col_end; j++)
+    {
+        const IndexType col_start = A.column_offsets[j];
+        const IndexType col_stop  = A.column_offsets[j + 1];
+
+        const ValueType xj = x[j];
+
+        for(IndexType ii = col_start; ii < col_stop; ii++)
+        {
+            const size_t    k       = A.row_indices[ii] - row_begin;
+            const ValueType product = combine(A.values[ii], xj);
+
+            if(flags == NULL)
+            {
+                y[k] = reduce(y[k], product);
+            }
+            else
+            {
+                y[k]     = flags[k] ? reduce(y[k], product) : product;
+                flags[k] = 1;
+            }
+        }
+    }
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::csc_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    for(size_t i = 0; i < A.num_rows; i++)
+        y[i] = initialize(y[i]);
+
+    spmv_csc(A, 0, A.num_cols, x, y, NULL, 0, combine, reduce);
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
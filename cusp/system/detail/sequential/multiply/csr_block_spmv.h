@@ -52,13 +52,13 @@ void multiply(thrust::cpp::execution_policy<DerivedPolicy>& exec,
     typedef typename MatrixType::index_type	                    IndexType;
     typedef typename VectorType2::values_array_type::value_type ValueType;
 
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> accumulator(exec, x.num_cols);
+
     for(size_t i = 0; i < A.num_rows; i++)
     {
         const IndexType row_start = A.row_offsets[i];
         const IndexType row_end   = A.row_offsets[i + 1];
 
-		    cusp::detail::temporary_array<ValueType, DerivedPolicy> accumulator(exec, x.num_cols);
-
         for(size_t k = 0; k < x.num_cols; k++)
             accumulator[k] = initialize(y(i,k));
 
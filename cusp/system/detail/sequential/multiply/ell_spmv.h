@@ -31,6 +31,39 @@ namespace detail
 namespace sequential
 {
 
+// Accumulate the ELL entries of rows [row_start, row_end) into sums.
+// The slabs are walked one at a time so the inner loop has unit stride
+// when the arrays are stored in column-major order.
+template <typename IndexType,
+          typename IndexArray,
+          typename ValueArray,
+          typename VectorType,
+          typename ValueType,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_ell_rows(const IndexType row_start,
+                   const IndexType row_end,
+                   const IndexType num_entries_per_row,
+                   const IndexType invalid_index,
+                   const IndexArray& J,
+                   const ValueArray& V,
+                   const VectorType& x,
+                   ValueType * sums,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce)
+{
+    for(IndexType n = 0; n < num_entries_per_row; n++)
+    {
+        for(IndexType i = row_start; i < row_end; i++)
+        {
+            const IndexType j = J(i,n);
+
+            if(j != invalid_index)
+                sums[i - row_start] = reduce(sums[i - row_start], combine(V(i,n), x[j]));
+        }
+    }
+}
+
 template <typename DerivedPolicy,
          typename MatrixType,
          typename VectorType1,
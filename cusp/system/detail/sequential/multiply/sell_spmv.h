@@ -0,0 +1,248 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/execution_policy.h>
+
+#include <thrust/memory.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+
+// Compute the C rows of chunk k of y. The n-th entries of the lanes of a
+// chunk are contiguous and C is a compile-time constant, so the loop over
+// the lanes has a fixed trip count over unit-stride data and is vectorized
+// by the compiler. The sums of the chunk are kept in a fixed-size array.
+template <int C,
+          typename IndexType,
+          typename ValueType1,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_sell_chunk(const size_t k,
+                     const IndexType invalid_index,
+                     const IndexType * offsets,
+                     const IndexType * P,
+                     const IndexType * J,
+                     const ValueType1 * V,
+                     const VectorType1& x,
+                     VectorType2& y,
+                     UnaryFunction   initialize,
+                     BinaryFunction1 combine,
+                     BinaryFunction2 reduce)
+{
+    typedef typename VectorType2::value_type ValueType;
+
+    const IndexType start = offsets[k];
+    const IndexType width = (offsets[k + 1] - start) / C;
+
+    const IndexType * Pk = P + k * C;
+
+    ValueType sums[C];
+
+    for(int lane = 0; lane < C; lane++)
+        sums[lane] = initialize(y[Pk[lane]]);
+
+    for(IndexType n = 0; n < width; n++)
+    {
+        const IndexType  * Jn = J + start + n * C;
+        const ValueType1 * Vn = V + start + n * C;
+
+        for(int lane = 0; lane < C; lane++)
+        {
+            const IndexType j = Jn[lane];
+
+            if(j != invalid_index)
+                sums[lane] = reduce(sums[lane], combine(Vn[lane], x[j]));
+        }
+    }
+
+    for(int lane = 0; lane < C; lane++)
+        y[Pk[lane]] = sums[lane];
+}
+
+// Compute the first num_lanes rows of chunk k of y for chunk sizes only
+// known at runtime, the lanes are processed one at a time.
+template <typename IndexType,
+          typename ValueType1,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_sell_lanes(const size_t k,
+                     const size_t chunk_size,
+                     const size_t num_lanes,
+                     const IndexType invalid_index,
+                     const IndexType * offsets,
+                     const IndexType * P,
+                     const IndexType * J,
+                     const ValueType1 * V,
+                     const VectorType1& x,
+                     VectorType2& y,
+                     UnaryFunction   initialize,
+                     BinaryFunction1 combine,
+                     BinaryFunction2 reduce)
+{
+    typedef typename VectorType2::value_type ValueType;
+
+    const IndexType start = offsets[k];
+    const IndexType width = (offsets[k + 1] - start) / chunk_size;
+
+    for(size_t lane = 0; lane < num_lanes; lane++)
+    {
+        const IndexType i = P[k * chunk_size + lane];
+
+        ValueType sum = initialize(y[i]);
+
+        for(IndexType n = 0; n < width; n++)
+        {
+            const IndexType jj = start + n * chunk_size + lane;
+            const IndexType j  = J[jj];
+
+            if(j != invalid_index)
+                sum = reduce(sum, combine(V[jj], x[j]));
+        }
+
+        y[i] = sum;
+    }
+}
+
+template <int C,
+          typename IndexType,
+          typename ValueType1,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_sell_chunks(const size_t num_rows,
+                      const size_t chunk_begin,
+                      const size_t chunk_end,
+                      const IndexType invalid_index,
+                      const IndexType * offsets,
+                      const IndexType * P,
+                      const IndexType * J,
+                      const ValueType1 * V,
+                      const VectorType1& x,
+                      VectorType2& y,
+                      UnaryFunction   initialize,
+                      BinaryFunction1 combine,
+                      BinaryFunction2 reduce)
+{
+    // the last chunk may be partially filled
+    const size_t num_full_chunks = std::min(chunk_end, num_rows / C);
+
+    for(size_t k = chunk_begin; k < num_full_chunks; k++)
+        spmv_sell_chunk<C>(k, invalid_index, offsets, P, J, V, x, y, initialize, combine, reduce);
+
+    for(size_t k = std::max(chunk_begin, num_full_chunks); k < chunk_end; k++)
+        spmv_sell_lanes(k, C, num_rows - k * C, invalid_index, offsets, P, J, V, x, y, initialize, combine, reduce);
+}
+
+// Compute the chunks [chunk_begin, chunk_end) of y, the common chunk sizes
+// use the unrolled kernel.
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_sell(const MatrixType& A,
+               const size_t chunk_begin,
+               const size_t chunk_end,
+               const VectorType1& x,
+               VectorType2& y,
+               UnaryFunction   initialize,
+               BinaryFunction1 combine,
+               BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    if(chunk_begin == chunk_end)
+        return;
+
+    const size_t    num_rows      = A.num_rows;
+    const size_t    chunk_size    = A.chunk_size;
+    const IndexType invalid_index = MatrixType::invalid_index;
+
+    const IndexType * offsets = thrust::raw_pointer_cast(&A.chunk_offsets[0]);
+    const IndexType * P = thrust::raw_pointer_cast(&A.row_permutation[0]);
+    const IndexType * J = A.column_indices.size() == 0 ? NULL : thrust::raw_pointer_cast(&A.column_indices[0]);
+    const ValueType * V = A.values.size() == 0 ? NULL : thrust::raw_pointer_cast(&A.values[0]);
+
+    switch(chunk_size)
+    {
+    case 4:
+        spmv_sell_chunks<4>(num_rows, chunk_begin, chunk_end, invalid_index, offsets, P, J, V, x, y, initialize, combine, reduce);
+        break;
+    case 8:
+        spmv_sell_chunks<8>(num_rows, chunk_begin, chunk_end, invalid_index, offsets, P, J, V, x, y, initialize, combine, reduce);
+        break;
+    case 16:
+        spmv_sell_chunks<16>(num_rows, chunk_begin, chunk_end, invalid_index, offsets, P, J, V, x, y, initialize, combine, reduce);
+        break;
+    case 32:
+        spmv_sell_chunks<32>(num_rows, chunk_begin, chunk_end, invalid_index, offsets, P, J, V, x, y, initialize, combine, reduce);
+        break;
+    default:
+        for(size_t k = chunk_begin; k < chunk_end; k++)
+            spmv_sell_lanes(k, chunk_size, std::min(chunk_size, num_rows - k * chunk_size),
+                            invalid_index, offsets, P, J, V, x, y, initialize, combine, reduce);
+    }
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::sell_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    spmv_sell(A, 0, A.num_chunks(), x, y, initialize, combine, reduce);
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,276 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+
+// Per-thread scratch space used to accumulate one row of C at a time.
+//
+// Rows are accumulated in an open addressing hash table sized to twice
+// the upper bound on the number of products of the row. Rows whose table
+// would be at least as large as a row of C use a dense accumulator
+// instead. Both are allocated lazily and only grow as needed, so the
+// storage scales with the largest row processed by the thread rather
+// than with the number of columns of C. The symbolic pass only records
+// keys and constructs the accumulator without value storage.
+template <typename IndexType, typename ValueType>
+class spgemm_accumulator
+{
+    const size_t num_cols;
+    const bool   store_values;
+
+    std::vector<IndexType> hash_keys;
+    std::vector<ValueType> hash_values;
+    std::vector<IndexType> dense_mask;
+    std::vector<ValueType> dense_values;
+
+    size_t table_size;
+    int    hash_shift;
+    bool   use_dense;
+
+    // Fibonacci hashing, the table position is taken from the high bits
+    // of the product so strided column patterns spread over the table
+    size_t hash(const IndexType key) const
+    {
+        return size_t((static_cast<unsigned long long>(key) * 11400714819323198485ull) >> hash_shift);
+    }
+
+public:
+
+    spgemm_accumulator(const size_t num_cols, const bool store_values = true)
+        : num_cols(num_cols), store_values(store_values),
+          table_size(0), hash_shift(64), use_dense(false) {}
+
+    // prepare the accumulator for a row with at most work products
+    void begin_row(const size_t work)
+    {
+        int table_bits = 1;
+        while((size_t(1) << table_bits) < 2 * work)
+            table_bits++;
+
+        table_size = size_t(1) << table_bits;
+        hash_shift = 64 - table_bits;
+
+        use_dense = table_size >= num_cols;
+
+        if(use_dense)
+        {
+            if(dense_mask.empty())
+            {
+                dense_mask.resize(num_cols, IndexType(-1));
+
+                if(store_values)
+                    dense_values.resize(num_cols);
+            }
+        }
+        else
+        {
+            if(hash_keys.size() < table_size)
+            {
+                hash_keys.resize(table_size);
+
+                if(store_values)
+                    hash_values.resize(table_size);
+            }
+
+            std::fill(hash_keys.begin(), hash_keys.begin() + table_size, IndexType(-1));
+        }
+    }
+
+    // returns the slot of key, or the empty slot the key should occupy
+    size_t find(const IndexType key) const
+    {
+        const size_t mask = table_size - 1;
+
+        size_t h = hash(key);
+
+        while(hash_keys[h] != IndexType(-1) && hash_keys[h] != key)
+            h = (h + 1) & mask;
+
+        return h;
+    }
+
+    // record key, returns true if it had not been seen in row i
+    bool insert(const IndexType i, const IndexType key)
+    {
+        if(use_dense)
+        {
+            if(dense_mask[key] == i)
+                return false;
+
+            dense_mask[key] = i;
+            return true;
+        }
+        else
+        {
+            const size_t h = find(key);
+
+            if(hash_keys[h] == key)
+                return false;
+
+            hash_keys[h] = key;
+            return true;
+        }
+    }
+
+    // combine a product into the entry for key in row i, returns true if
+    // key had not been seen
+    template <typename BinaryFunction>
+    bool accumulate(const IndexType i, const IndexType key, const ValueType value, BinaryFunction reduce)
+    {
+        if(use_dense)
+        {
+            if(dense_mask[key] == i)
+            {
+                dense_values[key] = reduce(dense_values[key], value);
+                return false;
+            }
+
+            dense_mask[key]   = i;
+            dense_values[key] = value;
+            return true;
+        }
+        else
+        {
+            const size_t h = find(key);
+
+            if(hash_keys[h] == key)
+            {
+                hash_values[h] = reduce(hash_values[h], value);
+                return false;
+            }
+
+            hash_keys[h]   = key;
+            hash_values[h] = value;
+            return true;
+        }
+    }
+
+    ValueType value(const IndexType key) const
+    {
+        return use_dense ? ValueType(dense_values[key]) : ValueType(hash_values[find(key)]);
+    }
+};
+
+template <typename Array1, typename Array2, typename Array3>
+size_t spmm_csr_row_work(const size_t i,
+                         const Array1& A_row_offsets, const Array2& A_column_indices,
+                         const Array3& B_row_offsets)
+{
+    typedef typename Array1::value_type IndexType;
+
+    size_t work = 0;
+
+    for(IndexType jj = A_row_offsets[i]; jj < A_row_offsets[i + 1]; jj++)
+    {
+        const IndexType j = A_column_indices[jj];
+        work += B_row_offsets[j + 1] - B_row_offsets[j];
+    }
+
+    return work;
+}
+
+// Count the distinct columns of row i of C = A * B.
+template <typename Array1, typename Array2, typename Array3, typename Array4,
+          typename IndexType, typename ValueType>
+size_t spgemm_csr_row_nonzeros(const size_t i,
+                               const Array1& A_row_offsets, const Array2& A_column_indices,
+                               const Array3& B_row_offsets, const Array4& B_column_indices,
+                               spgemm_accumulator<IndexType,ValueType>& accumulator)
+{
+    typedef typename Array1::value_type IndexType1;
+    typedef typename Array3::value_type IndexType2;
+
+    size_t num_nonzeros = 0;
+
+    accumulator.begin_row(spmm_csr_row_work(i, A_row_offsets, A_column_indices, B_row_offsets));
+
+    for(IndexType1 jj = A_row_offsets[i]; jj < A_row_offsets[i + 1]; jj++)
+    {
+        const IndexType1 j = A_column_indices[jj];
+
+        for(IndexType2 kk = B_row_offsets[j]; kk < B_row_offsets[j + 1]; kk++)
+        {
+            if(accumulator.insert(i, B_column_indices[kk]))
+                num_nonzeros++;
+        }
+    }
+
+    return num_nonzeros;
+}
+
+// Compute row i of C = A * B into C_columns and C_values starting at
+// row_start. The entries are emitted in order of increasing column and
+// every entry is seeded with initialize(0), the value of the implicit
+// zero it replaces.
+template <typename Array1, typename Array2, typename Array3,
+          typename Array4, typename Array5, typename Array6,
+          typename IndexType, typename ValueArray, typename ValueType,
+          typename UnaryFunction, typename BinaryFunction1, typename BinaryFunction2>
+void spgemm_csr_row(const size_t i,
+                    const Array1& A_row_offsets, const Array2& A_column_indices, const Array3& A_values,
+                    const Array4& B_row_offsets, const Array5& B_column_indices, const Array6& B_values,
+                    const IndexType row_start, IndexType * C_columns, ValueArray& C_values,
+                    UnaryFunction initialize, BinaryFunction1 combine, BinaryFunction2 reduce,
+                    spgemm_accumulator<IndexType,ValueType>& accumulator)
+{
+    typedef typename Array1::value_type IndexType1;
+    typedef typename Array4::value_type IndexType2;
+
+    IndexType offset = row_start;
+
+    accumulator.begin_row(spmm_csr_row_work(i, A_row_offsets, A_column_indices, B_row_offsets));
+
+    for(IndexType1 jj = A_row_offsets[i]; jj < A_row_offsets[i + 1]; jj++)
+    {
+        const IndexType1 j = A_column_indices[jj];
+        const ValueType  v = A_values[jj];
+
+        for(IndexType2 kk = B_row_offsets[j]; kk < B_row_offsets[j + 1]; kk++)
+        {
+            const IndexType k = B_column_indices[kk];
+            const ValueType b = B_values[kk];
+
+            if(accumulator.accumulate(i, k, combine(v, b), reduce))
+                C_columns[offset++] = k;
+        }
+    }
+
+    std::sort(C_columns + row_start, C_columns + offset);
+
+    const ValueType init = initialize(ValueType(0));
+
+    for(IndexType n = row_start; n < offset; n++)
+        C_values[n] = reduce(init, accumulator.value(C_columns[n]));
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,329 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/exception.h>
+#include <cusp/multiply.h>
+
+#include <cusp/system/detail/sequential/execution_policy.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+
+// outputs reached by more than 1/SPMSPV_DENSE_FRACTION of their indices are
+// accumulated in one dense array by the default accumulator
+static const size_t SPMSPV_DENSE_FRACTION = 16;
+
+// number of output indices covered by one bucket, small enough for the
+// accumulator of a bucket to stay in cache
+static const size_t SPMSPV_BUCKET_WIDTH = 8192;
+
+// windows holding more than 1/SPMSPV_SCAN_FRACTION of their indices are
+// scanned instead of sorting the touched indices
+static const size_t SPMSPV_SCAN_FRACTION = 8;
+
+// Dense accumulator for a window of output indices. Every slot is marked
+// with the id of the window it was last written for, so the accumulator
+// is reused across windows without being cleared.
+template <typename IndexType, typename ValueType>
+struct spmspv_window
+{
+    std::vector<ValueType> values;
+    std::vector<IndexType> marks;
+    std::vector<IndexType> touched;
+
+    spmspv_window(const size_t width)
+        : values(width), marks(width, IndexType(-1)) {}
+
+    template <typename BinaryFunction>
+    void accumulate(const IndexType id, const IndexType slot, const ValueType& value, BinaryFunction reduce)
+    {
+        if(marks[slot] != id)
+        {
+            marks[slot]  = id;
+            values[slot] = value;
+            touched.push_back(slot);
+        }
+        else
+        {
+            values[slot] = reduce(values[slot], value);
+        }
+    }
+
+    // appends the entries of window id, which starts at output index base
+    // and spans width indices, sorted by index
+    template <typename IndexArray, typename ValueArray>
+    void flush(const IndexType id, const IndexType base, const size_t width,
+               IndexArray& output_indices, ValueArray& output_values)
+    {
+        if(touched.size() * SPMSPV_SCAN_FRACTION > width)
+        {
+            for(size_t slot = 0; slot < width; slot++)
+            {
+                if(marks[slot] != id) continue;
+
+                output_indices.push_back(base + IndexType(slot));
+                output_values.push_back(values[slot]);
+            }
+        }
+        else
+        {
+            std::sort(touched.begin(), touched.end());
+
+            for(size_t k = 0; k < touched.size(); k++)
+            {
+                output_indices.push_back(base + touched[k]);
+                output_values.push_back(values[touched[k]]);
+            }
+        }
+
+        touched.clear();
+    }
+};
+
+template <typename VectorType, typename IndexArray, typename ValueArray>
+void spmspv_assign(VectorType& y, const size_t length,
+                   const IndexArray& indices, const ValueArray& values)
+{
+    y.resize(length, indices.size());
+
+    for(size_t k = 0; k < indices.size(); k++)
+    {
+        y.indices[k] = indices[k];
+        y.values[k]  = values[k];
+    }
+}
+
+// number of products of y = x * A
+template <typename VectorType, typename MatrixType>
+size_t spmspv_products(const VectorType& x, const MatrixType& A)
+{
+    size_t num_products = 0;
+
+    for(size_t k = 0; k < x.num_entries; k++)
+        num_products += A.row_offsets[x.indices[k] + 1] - A.row_offsets[x.indices[k]];
+
+    return num_products;
+}
+
+// y = x * A, the products are distributed into buckets of bucket_width
+// consecutive output indices and every bucket is reduced in a window
+template <typename VectorType1,
+          typename MatrixType,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmspv_bucket(const VectorType1& x,
+                   const MatrixType& A,
+                   VectorType2& y,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce,
+                   const size_t bucket_width)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const size_t N           = A.num_cols;
+    const size_t num_buckets = (N + bucket_width - 1) / bucket_width;
+
+    std::vector<size_t> offsets(num_buckets + 1, 0);
+
+    for(size_t k = 0; k < x.num_entries; k++)
+    {
+        const IndexType i = x.indices[k];
+
+        for(IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = A.column_indices[jj];
+
+            offsets[j / bucket_width + 1]++;
+        }
+    }
+
+    for(size_t b = 0; b < num_buckets; b++)
+        offsets[b + 1] += offsets[b];
+
+    std::vector<IndexType> keys(offsets[num_buckets]);
+    std::vector<ValueType> products(offsets[num_buckets]);
+    std::vector<size_t>    positions(offsets.begin(), offsets.end() - 1);
+
+    for(size_t k = 0; k < x.num_entries; k++)
+    {
+        const IndexType i  = x.indices[k];
+        const ValueType xi = x.values[k];
+
+        for(IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = A.column_indices[jj];
+
+            const size_t p = positions[j / bucket_width]++;
+
+            keys[p]     = j;
+            products[p] = combine(A.values[jj], xi);
+        }
+    }
+
+    std::vector<IndexType> output_indices;
+    std::vector<ValueType> output_values;
+
+    spmspv_window<IndexType,ValueType> window(std::min(bucket_width, N));
+
+    for(size_t b = 0; b < num_buckets; b++)
+    {
+        const IndexType base = b * bucket_width;
+
+        for(size_t p = offsets[b]; p < offsets[b + 1]; p++)
+            window.accumulate(IndexType(b), keys[p] - base, products[p], reduce);
+
+        window.flush(IndexType(b), base, std::min(bucket_width, N - base), output_indices, output_values);
+    }
+
+    spmspv_assign(y, N, output_indices, output_values);
+}
+
+// y = x * A, the products are reduced directly in a window spanning the
+// whole output
+template <typename VectorType1,
+          typename MatrixType,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmspv_dense(const VectorType1& x,
+                  const MatrixType& A,
+                  VectorType2& y,
+                  BinaryFunction1 combine,
+                  BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const size_t N = A.num_cols;
+
+    spmspv_window<IndexType,ValueType> window(N);
+
+    for(size_t k = 0; k < x.num_entries; k++)
+    {
+        const IndexType i  = x.indices[k];
+        const ValueType xi = x.values[k];
+
+        for(IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = A.column_indices[jj];
+
+            window.accumulate(IndexType(0), j, combine(A.values[jj], xi), reduce);
+        }
+    }
+
+    std::vector<IndexType> output_indices;
+    std::vector<ValueType> output_values;
+
+    window.flush(IndexType(0), IndexType(0), N, output_indices, output_values);
+
+    spmspv_assign(y, N, output_indices, output_values);
+}
+
+template <typename DerivedPolicy,
+          typename VectorType1,
+          typename MatrixType,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void generalized_spmspv(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+                        const VectorType1& x,
+                        const MatrixType& A,
+                        VectorType2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        cusp::bucket_accumulator,
+                        cusp::sparse_vector_format,
+                        cusp::csr_format,
+                        cusp::sparse_vector_format)
+{
+    if(A.num_rows != x.length)
+        throw cusp::invalid_input_exception("matrix and vector dimensions do not match");
+
+    spmspv_bucket(x, A, y, combine, reduce, SPMSPV_BUCKET_WIDTH);
+}
+
+template <typename DerivedPolicy,
+          typename VectorType1,
+          typename MatrixType,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void generalized_spmspv(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+                        const VectorType1& x,
+                        const MatrixType& A,
+                        VectorType2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        cusp::dense_accumulator,
+                        cusp::sparse_vector_format,
+                        cusp::csr_format,
+                        cusp::sparse_vector_format)
+{
+    if(A.num_rows != x.length)
+        throw cusp::invalid_input_exception("matrix and vector dimensions do not match");
+
+    spmspv_dense(x, A, y, combine, reduce);
+}
+
+// falls back to the dense accumulator once the products could reach more
+// than 1/SPMSPV_DENSE_FRACTION of the output
+template <typename DerivedPolicy,
+          typename VectorType1,
+          typename MatrixType,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void generalized_spmspv(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+                        const VectorType1& x,
+                        const MatrixType& A,
+                        VectorType2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        cusp::default_accumulator,
+                        cusp::sparse_vector_format,
+                        cusp::csr_format,
+                        cusp::sparse_vector_format)
+{
+    if(A.num_rows != x.length)
+        throw cusp::invalid_input_exception("matrix and vector dimensions do not match");
+
+    if(spmspv_products(x, A) * SPMSPV_DENSE_FRACTION > A.num_cols)
+        spmspv_dense(x, A, y, combine, reduce);
+    else
+        spmspv_bucket(x, A, y, combine, reduce, SPMSPV_BUCKET_WIDTH);
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
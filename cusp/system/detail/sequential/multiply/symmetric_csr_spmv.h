@@ -0,0 +1,127 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/execution_policy.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+
+// Compute the rows [row_begin, row_end) of y. Every stored entry A(i,j) is
+// applied to row i and, off the diagonal, to row j through its mirror image
+// A(j,i). Row j is at least i, so the mirrored products either go to a row
+// of the range, which is only updated after it has been initialized, or to
+// a later row: these are accumulated in spill_values[j - row_end] and
+// spill_flags marks the entries of spill_values that have been written.
+// The spill arrays are not needed when row_end is the number of rows.
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_symmetric_csr(const MatrixType& A,
+                        const size_t row_begin,
+                        const size_t row_end,
+                        const VectorType1& x,
+                        VectorType2& y,
+                        typename VectorType2::value_type * spill_values,
+                        unsigned char * spill_flags,
+                        UnaryFunction   initialize,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType1::value_type ValueType1;
+    typedef typename VectorType2::value_type ValueType;
+
+    for(size_t i = row_begin; i < row_end; i++)
+        y[i] = initialize(y[i]);
+
+    for(size_t i = row_begin; i < row_end; i++)
+    {
+        const IndexType row_start = A.row_offsets[i];
+        const IndexType row_stop  = A.row_offsets[i + 1];
+
+        const ValueType1 xi = x[i];
+
+        ValueType accumulator = y[i];
+
+        for(IndexType jj = row_start; jj < row_stop; jj++)
+        {
+            const IndexType j = A.column_indices[jj];
+
+            accumulator = reduce(accumulator, combine(A.values[jj], x[j]));
+
+            if(size_t(j) == i)
+                continue;
+
+            const ValueType product = combine(A.values[jj], xi);
+
+            if(size_t(j) < row_end)
+            {
+                y[j] = reduce(y[j], product);
+            }
+            else
+            {
+                const size_t k = j - row_end;
+
+                spill_values[k] = spill_flags[k] ? reduce(spill_values[k], product) : product;
+                spill_flags[k]  = 1;
+            }
+        }
+
+        y[i] = accumulator;
+    }
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::symmetric_csr_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    spmv_symmetric_csr(A, 0, A.num_rows, x, y, NULL, NULL, initialize, combine, reduce);
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,362 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/copy.h>
+#include <cusp/exception.h>
+#include <cusp/format_utils.h>
+
+#include <cusp/system/omp/detail/utils.h>
+
+#include <thrust/count.h>
+#include <thrust/fill.h>
+#include <thrust/memory.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// The CSR to ELL, DIA and HYB kernels take the compressed rows as separate
+// arrays so the COO conversions can reuse them with computed row offsets.
+
+template <typename DerivedPolicy,
+          typename OffsetArray, typename IndexArray, typename ValueArray,
+          typename DestinationType>
+void csr_to_dia(omp::execution_policy<DerivedPolicy>& exec,
+                const size_t num_rows, const size_t num_cols,
+                const OffsetArray& row_offsets, const IndexArray& column_indices, const ValueArray& values,
+                DestinationType& dst,
+                size_t alignment)
+{
+    typedef typename OffsetArray::value_type      OffsetType;
+    typedef typename DestinationType::index_type  IndexType;
+    typedef typename DestinationType::value_type  ValueType;
+
+    const size_t num_entries = column_indices.size();
+
+    if(num_entries == 0)
+    {
+        dst.resize(num_rows, num_cols, num_entries, 0);
+        return;
+    }
+
+    // flag the occupied diagonals, shifted by num_rows. Rows of different
+    // chunks may share a diagonal, so every chunk flags its own array and
+    // the arrays are merged afterwards.
+    const int    num_chunks = std::min<size_t>(max_threads(), num_rows);
+    const size_t chunk_size = (num_rows + num_chunks - 1) / num_chunks;
+
+    std::vector< std::vector<char> > chunk_flags(num_chunks);
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int p = 0; p < num_chunks; p++)
+    {
+        const size_t row_begin = std::min(chunk_size * p, num_rows);
+        const size_t row_end   = std::min(row_begin + chunk_size, num_rows);
+
+        std::vector<char>& flags = chunk_flags[p];
+        flags.resize(num_rows + num_cols, 0);
+
+        for(size_t i = row_begin; i < row_end; i++)
+            for(OffsetType jj = row_offsets[i]; jj < row_offsets[i + 1]; jj++)
+                flags[column_indices[jj] - i + num_rows] = 1;
+    }
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> diagonal_map(exec, num_rows + num_cols);
+
+    #pragma omp parallel for schedule(static)
+    for(int d = 0; d < int(num_rows + num_cols); d++)
+    {
+        IndexType flag = 0;
+
+        for(int p = 0; p < num_chunks; p++)
+            flag |= chunk_flags[p][d];
+
+        diagonal_map[d] = flag;
+    }
+
+    // number the occupied diagonals, diagonal d is at diagonal_map[d] - 1
+    parallel_inclusive_scan(diagonal_map, num_rows + num_cols);
+
+    const IndexType num_diagonals = diagonal_map[num_rows + num_cols - 1];
+
+    const float max_fill   = 3.0;
+    const float threshold  = 1e6; // 1M entries
+    const float size       = float(num_diagonals) * float(num_rows);
+    const float fill_ratio = size / std::max(1.0f, float(num_entries));
+
+    if (max_fill < fill_ratio && size > threshold)
+        throw cusp::format_conversion_exception("dia_matrix fill-in would exceed maximum tolerance");
+
+    // allocate DIA structure
+    dst.resize(num_rows, num_cols, num_entries, num_diagonals, alignment);
+
+    thrust::fill(exec, dst.values.values.begin(), dst.values.values.end(), ValueType(0));
+
+    #pragma omp parallel for schedule(static)
+    for(int d = 0; d < int(num_rows + num_cols); d++)
+    {
+        const IndexType previous = (d == 0) ? IndexType(0) : IndexType(diagonal_map[d - 1]);
+
+        if(diagonal_map[d] != previous)
+            dst.diagonal_offsets[previous] = IndexType(d) - IndexType(num_rows);
+    }
+
+    const size_t pitch = dst.values.pitch;
+
+    #pragma omp parallel for schedule(dynamic, 256)
+    for(int i = 0; i < int(num_rows); i++)
+    {
+        for(OffsetType jj = row_offsets[i]; jj < row_offsets[i + 1]; jj++)
+        {
+            const IndexType diagonal = diagonal_map[column_indices[jj] - i + num_rows] - 1;
+
+            dst.values.values[diagonal * pitch + i] = values[jj];
+        }
+    }
+}
+
+template <typename DerivedPolicy,
+          typename OffsetArray, typename IndexArray, typename ValueArray,
+          typename DestinationType>
+void csr_to_ell(omp::execution_policy<DerivedPolicy>& exec,
+                const size_t num_rows, const size_t num_cols,
+                const OffsetArray& row_offsets, const IndexArray& column_indices, const ValueArray& values,
+                DestinationType& dst,
+                size_t num_entries_per_row, size_t alignment)
+{
+    typedef typename OffsetArray::value_type      OffsetType;
+    typedef typename DestinationType::index_type  IndexType;
+    typedef typename DestinationType::value_type  ValueType;
+
+    const size_t num_entries = column_indices.size();
+
+    if(num_entries == 0)
+    {
+        dst.resize(num_rows, num_cols, num_entries, num_entries_per_row);
+        return;
+    }
+
+    if(num_entries_per_row == 0)
+    {
+        const size_t max_entries_per_row = cusp::compute_max_entries_per_row(exec, row_offsets);
+
+        const float max_fill  = 3.0;
+        const float threshold  = 1e6; // 1M entries
+        const float size       = float(max_entries_per_row) * float(num_rows);
+        const float fill_ratio = size / std::max(1.0f, float(num_entries));
+
+        if (max_fill < fill_ratio && size > threshold)
+            throw cusp::format_conversion_exception("ell_matrix fill-in would exceed maximum tolerance");
+
+        num_entries_per_row = max_entries_per_row;
+    }
+    else if(cusp::compute_max_entries_per_row(exec, row_offsets) > num_entries_per_row)
+    {
+        throw cusp::format_conversion_exception("ell_matrix num_entries_per_row is smaller than the longest row");
+    }
+
+    const size_t num_nonzeros = num_entries - thrust::count(exec, values.begin(), values.end(), ValueType(0));
+
+    // allocate output storage
+    dst.resize(num_rows, num_cols, num_nonzeros, num_entries_per_row, alignment);
+
+    const size_t pitch = dst.column_indices.pitch;
+
+    // write each row of the ELL slabs, padding includes the aligned rows
+    #pragma omp parallel for schedule(dynamic, 256)
+    for(int i = 0; i < int(pitch); i++)
+    {
+        size_t n = 0;
+
+        if(size_t(i) < num_rows)
+        {
+            for(OffsetType jj = row_offsets[i]; jj < row_offsets[i + 1]; jj++, n++)
+            {
+                dst.column_indices.values[n * pitch + i] = column_indices[jj];
+                dst.values.values[n * pitch + i]         = values[jj];
+            }
+        }
+
+        for(; n < num_entries_per_row; n++)
+        {
+            dst.column_indices.values[n * pitch + i] = IndexType(-1);
+            dst.values.values[n * pitch + i]         = ValueType(0);
+        }
+    }
+}
+
+template <typename DerivedPolicy,
+          typename OffsetArray, typename IndexArray, typename ValueArray,
+          typename DestinationType>
+void csr_to_hyb(omp::execution_policy<DerivedPolicy>& exec,
+                const size_t num_rows, const size_t num_cols,
+                const OffsetArray& row_offsets, const IndexArray& column_indices, const ValueArray& values,
+                DestinationType& dst,
+                size_t num_entries_per_row, size_t alignment)
+{
+    typedef typename OffsetArray::value_type      OffsetType;
+    typedef typename DestinationType::index_type  IndexType;
+    typedef typename DestinationType::value_type  ValueType;
+
+    const size_t num_entries = column_indices.size();
+
+    if(num_entries == 0)
+    {
+        dst.resize(num_rows, num_cols, 0, 0, num_entries_per_row, alignment);
+        return;
+    }
+
+    if(num_entries_per_row == 0)
+    {
+        const float  relative_speed      = 3.0;
+        const size_t breakeven_threshold = 4096;
+
+        num_entries_per_row = cusp::compute_optimal_entries_per_row(exec, row_offsets, relative_speed, breakeven_threshold);
+    }
+
+    // count the entries of each row that overflow into the COO part
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> coo_offsets(exec, num_rows + 1);
+
+    coo_offsets[0] = 0;
+
+    #pragma omp parallel for schedule(static)
+    for(int i = 0; i < int(num_rows); i++)
+    {
+        const size_t row_length = row_offsets[i + 1] - row_offsets[i];
+
+        coo_offsets[i + 1] = row_length > num_entries_per_row ? IndexType(row_length - num_entries_per_row) : IndexType(0);
+    }
+
+    parallel_inclusive_scan(coo_offsets, num_rows + 1);
+
+    const size_t num_coo_entries = coo_offsets[num_rows];
+    const size_t num_ell_entries = num_entries - num_coo_entries;
+
+    // allocate output storage
+    dst.resize(num_rows, num_cols, num_ell_entries, num_coo_entries, num_entries_per_row, alignment);
+
+    const size_t pitch = dst.ell.column_indices.pitch;
+
+    #pragma omp parallel for schedule(dynamic, 256)
+    for(int i = 0; i < int(pitch); i++)
+    {
+        size_t n = 0;
+
+        if(size_t(i) < num_rows)
+        {
+            OffsetType jj = row_offsets[i];
+
+            for(; jj < row_offsets[i + 1] && n < num_entries_per_row; jj++, n++)
+            {
+                dst.ell.column_indices.values[n * pitch + i] = column_indices[jj];
+                dst.ell.values.values[n * pitch + i]         = values[jj];
+            }
+
+            for(IndexType k = coo_offsets[i]; jj < row_offsets[i + 1]; jj++, k++)
+            {
+                dst.coo.row_indices[k]    = i;
+                dst.coo.column_indices[k] = column_indices[jj];
+                dst.coo.values[k]         = values[jj];
+            }
+        }
+
+        for(; n < num_entries_per_row; n++)
+        {
+            dst.ell.column_indices.values[n * pitch + i] = IndexType(-1);
+            dst.ell.values.values[n * pitch + i]         = ValueType(0);
+        }
+    }
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(omp::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::coo_format&)
+{
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if(src.num_entries == 0) return;
+
+    cusp::offsets_to_indices(exec, src.row_offsets, dst.row_indices);
+    cusp::copy(exec, src.column_indices, dst.column_indices);
+    cusp::copy(exec, src.values,         dst.values);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(omp::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::dia_format&,
+        size_t alignment = 32)
+{
+    csr_to_dia(exec, src.num_rows, src.num_cols,
+               src.row_offsets, src.column_indices, src.values,
+               dst, alignment);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(omp::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::ell_format&,
+        size_t num_entries_per_row = 0,
+        size_t alignment = 32)
+{
+    csr_to_ell(exec, src.num_rows, src.num_cols,
+               src.row_offsets, src.column_indices, src.values,
+               dst, num_entries_per_row, alignment);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(omp::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::hyb_format&,
+        size_t num_entries_per_row = 0,
+        size_t alignment = 32)
+{
+    csr_to_hyb(exec, src.num_rows, src.num_cols,
+               src.row_offsets, src.column_indices, src.values,
+               dst, num_entries_per_row, alignment);
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
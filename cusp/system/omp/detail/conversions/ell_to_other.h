@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/format_utils.h>
+
+#include <cusp/system/omp/detail/utils.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// computes the CSR row offsets of the entries of an ELL matrix with nonzero
+// values and returns the number of such entries
+template <typename MatrixType, typename OffsetArray>
+size_t ell_row_offsets(const MatrixType& src, OffsetArray& row_offsets)
+{
+    typedef typename MatrixType::value_type  ValueType;
+    typedef typename OffsetArray::value_type OffsetType;
+
+    const size_t num_rows  = src.num_rows;
+    const size_t num_slots = src.column_indices.num_cols;
+    const size_t pitch     = src.values.pitch;
+
+    row_offsets[0] = 0;
+
+    #pragma omp parallel for schedule(static)
+    for(int i = 0; i < int(num_rows); i++)
+    {
+        OffsetType count = 0;
+
+        for(size_t n = 0; n < num_slots; n++)
+            if(src.values.values[n * pitch + i] != ValueType(0))
+                count++;
+
+        row_offsets[i + 1] = count;
+    }
+
+    parallel_inclusive_scan(row_offsets, num_rows + 1);
+
+    return row_offsets[num_rows];
+}
+
+// gathers the entries of an ELL matrix with nonzero values into the CSR
+// arrays described by row_offsets
+template <typename MatrixType, typename OffsetArray, typename IndexArray, typename ValueArray>
+void ell_gather_entries(const MatrixType& src, const OffsetArray& row_offsets,
+                        IndexArray& column_indices, ValueArray& values)
+{
+    typedef typename MatrixType::value_type  ValueType;
+    typedef typename OffsetArray::value_type OffsetType;
+
+    const size_t num_rows  = src.num_rows;
+    const size_t num_slots = src.column_indices.num_cols;
+    const size_t pitch     = src.values.pitch;
+
+    #pragma omp parallel for schedule(static)
+    for(int i = 0; i < int(num_rows); i++)
+    {
+        OffsetType k = row_offsets[i];
+
+        for(size_t n = 0; n < num_slots; n++)
+        {
+            const ValueType value = src.values.values[n * pitch + i];
+
+            if(value != ValueType(0))
+            {
+                column_indices[k] = src.column_indices.values[n * pitch + i];
+                values[k]         = value;
+                k++;
+            }
+        }
+    }
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(omp::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::ell_format&,
+        cusp::coo_format&)
+{
+    typedef typename DestinationType::index_type IndexType;
+
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if(src.num_entries == 0) return;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_offsets(exec, src.num_rows + 1);
+
+    const size_t num_entries = ell_row_offsets(src, row_offsets);
+
+    if(num_entries != src.num_entries)
+        dst.resize(src.num_rows, src.num_cols, num_entries);
+
+    ell_gather_entries(src, row_offsets, dst.column_indices, dst.values);
+
+    cusp::offsets_to_indices(exec, row_offsets, dst.row_indices);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(omp::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::ell_format&,
+        cusp::csr_format&)
+{
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if(src.num_entries == 0) return;
+
+    const size_t num_entries = ell_row_offsets(src, dst.row_offsets);
+
+    if(num_entries != src.num_entries)
+        dst.resize(src.num_rows, src.num_cols, num_entries);
+
+    ell_gather_entries(src, dst.row_offsets, dst.column_indices, dst.values);
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
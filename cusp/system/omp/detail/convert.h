@@ -18,4 +18,7 @@
 
 #include <cusp/detail/config.h>
 
-// this system has no special version of this algorithm
+#include <cusp/system/omp/detail/conversions/coo_to_other.h>
+#include <cusp/system/omp/detail/conversions/csr_to_other.h>
+#include <cusp/system/omp/detail/conversions/dia_to_other.h>
+#include <cusp/system/omp/detail/conversions/ell_to_other.h>
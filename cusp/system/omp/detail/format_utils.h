@@ -17,9 +17,17 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/functional.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system inherits format_utils
-#include <cusp/system/cpp/detail/format_utils.h>
+#include <cusp/system/omp/detail/utils.h>
+
+#include <thrust/extrema.h>
+#include <thrust/inner_product.h>
+#include <thrust/sort.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace cusp
 {
@@ -30,8 +38,120 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::offsets_to_indices;
-using cusp::system::detail::sequential::indices_to_offsets;
+template <typename DerivedPolicy,
+          typename OffsetArray,
+          typename IndexArray>
+void offsets_to_indices(omp::execution_policy<DerivedPolicy> &exec,
+                        const OffsetArray& offsets,
+                        IndexArray& indices)
+{
+    typedef typename OffsetArray::value_type OffsetType;
+    typedef typename IndexArray::value_type  IndexType;
+
+    const int num_rows = offsets.size() - 1;
+
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for(int i = 0; i < num_rows; i++)
+        for(OffsetType j = offsets[i]; j < offsets[i + 1]; j++)
+            indices[j] = IndexType(i);
+}
+
+// offsets[i] is set to the position of the first index that is not less
+// than i. Sorted indices are converted in parallel, unsorted indices fall
+// back to counting them serially.
+template <typename DerivedPolicy,
+          typename IndexArray,
+          typename OffsetArray>
+void indices_to_offsets(omp::execution_policy<DerivedPolicy> &exec,
+                        const IndexArray& indices,
+                        OffsetArray& offsets)
+{
+    typedef typename IndexArray::value_type  IndexType;
+    typedef typename OffsetArray::value_type OffsetType;
+
+    const int num_indices = indices.size();
+    const int num_offsets = offsets.size();
+
+    if(!thrust::is_sorted(exec, indices.begin(), indices.end()))
+    {
+        for(int i = 0; i < num_offsets; i++)
+            offsets[i] = OffsetType(0);
+
+        for(int i = 0; i < num_indices; i++)
+            offsets[indices[i] + 1]++;
+
+        for(int i = 1; i < num_offsets; i++)
+            offsets[i] += offsets[i - 1];
+
+        return;
+    }
+
+    // every index fills the offsets of the rows between it and its
+    // predecessor
+    #pragma omp parallel for schedule(static)
+    for(int i = 0; i <= num_indices; i++)
+    {
+        const IndexType start = (i == 0) ? IndexType(0) : IndexType(indices[i - 1] + 1);
+        const IndexType end   = (i == num_indices) ? IndexType(num_offsets - 1) : IndexType(indices[i]);
+
+        for(IndexType row = start; row <= end; row++)
+            offsets[row] = OffsetType(i);
+    }
+}
+
+template <typename DerivedPolicy, typename ArrayType>
+size_t compute_optimal_entries_per_row(omp::execution_policy<DerivedPolicy> &exec,
+                                       const ArrayType& row_offsets,
+                                       float relative_speed,
+                                       size_t breakeven_threshold)
+{
+    typedef typename ArrayType::value_type IndexType;
+
+    const size_t num_rows = row_offsets.size() - 1;
+
+    // compute maximum row length
+    const size_t max_cols_per_row =
+        thrust::inner_product(exec,
+                              row_offsets.begin() + 1, row_offsets.end(),
+                              row_offsets.begin(),
+                              IndexType(0),
+                              thrust::maximum<IndexType>(),
+                              thrust::minus<IndexType>());
+
+    const size_t num_bins   = max_cols_per_row + 1;
+    const int    num_chunks = max_threads();
+
+    // histogram the row lengths of each chunk of rows
+    std::vector<size_t> histograms(num_chunks * num_bins, 0);
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int p = 0; p < num_chunks; p++)
+    {
+        const size_t start = num_rows * p / num_chunks;
+        const size_t end   = num_rows * (p + 1) / num_chunks;
+
+        size_t * histogram = &histograms[p * num_bins];
+
+        for(size_t i = start; i < end; i++)
+            histogram[row_offsets[i + 1] - row_offsets[i]]++;
+    }
+
+    // find the first row length with enough shorter rows to make ELL pay off
+    cusp::detail::speed_threshold_functor threshold(num_rows, relative_speed, breakeven_threshold);
+
+    size_t cumulative_histogram = 0;
+
+    for(size_t k = 0; k < max_cols_per_row; k++)
+    {
+        for(int p = 0; p < num_chunks; p++)
+            cumulative_histogram += histograms[p * num_bins + k];
+
+        if(threshold(cumulative_histogram))
+            return k;
+    }
+
+    return max_cols_per_row;
+}
 
 } // end namespace detail
 } // end namespace omp
@@ -17,7 +17,20 @@
 #pragma once
 
 #include <cusp/detail/config.h>
-#include <cusp/system/cpp/detail/graph/breadth_first_search.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/copy.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/transpose.h>
+
+#include <cusp/system/omp/detail/utils.h>
+
+#include <thrust/fill.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace cusp
 {
@@ -28,10 +41,308 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::breadth_first_search;
+// Direction-optimizing BFS. Small frontiers are expanded top-down, large ones
+// bottom-up: every unvisited vertex looks for a parent among its incoming
+// edges in a bitmap of the frontier. Vertices are split into one range per
+// chunk. A top-down step buckets the discovered vertices by the chunk owning
+// them, and each chunk then claims the vertices of its range, so no vertex is
+// written by two threads and the search needs no atomics.
+template <typename VertexId>
+struct bfs_state
+{
+    size_t num_vertices;
+    int    num_chunks;
+
+    std::vector<VertexId> frontier;
+    std::vector<unsigned int> frontier_bits;
+
+    // vertices discovered by chunk s for chunk d, and their parents
+    std::vector< std::vector<VertexId> > bucket_vertices;
+    std::vector< std::vector<VertexId> > bucket_parents;
+
+    // next frontier of each chunk
+    std::vector< std::vector<VertexId> > next;
+
+    bfs_state(const size_t num_vertices, const int num_chunks)
+        : num_vertices(num_vertices), num_chunks(num_chunks),
+          frontier_bits((num_vertices + 31) / 32),
+          bucket_vertices(num_chunks * num_chunks),
+          bucket_parents(num_chunks * num_chunks),
+          next(num_chunks) {}
+
+    size_t chunk_begin(const int c) const
+    {
+        return num_vertices * c / num_chunks;
+    }
+
+    int owner(const VertexId v) const
+    {
+        return int(size_t(v) * num_chunks / num_vertices);
+    }
+};
+
+// returns true if every edge (i,j) of G has a matching edge (j,i), assumes
+// the column indices of each row are sorted
+template <typename MatrixType>
+bool bfs_has_symmetric_pattern(const MatrixType& G)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const int num_rows = G.num_rows;
+
+    int symmetric = 1;
+
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(&&:symmetric)
+    for(int i = 0; i < num_rows; i++)
+    {
+        for(IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1] && symmetric; jj++)
+        {
+            const IndexType j = G.column_indices[jj];
+
+            if(j < 0) continue;
+
+            symmetric = std::binary_search(G.column_indices.begin() + G.row_offsets[j],
+                                           G.column_indices.begin() + G.row_offsets[j + 1],
+                                           IndexType(i));
+        }
+    }
+
+    return symmetric;
+}
+
+// expands the frontier along the outgoing edges of its vertices
+template <typename MatrixType, typename LevelArray, typename ParentArray, typename VertexId>
+void bfs_top_down_step(const MatrixType& G, LevelArray& levels, ParentArray& parents,
+                       const bool mark_parents, const VertexId depth, bfs_state<VertexId>& state)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const int    num_chunks    = state.num_chunks;
+    const size_t frontier_size = state.frontier.size();
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int s = 0; s < num_chunks; s++)
+    {
+        for(int d = 0; d < num_chunks; d++)
+        {
+            state.bucket_vertices[s * num_chunks + d].clear();
+            state.bucket_parents[s * num_chunks + d].clear();
+        }
+
+        const size_t start = frontier_size * s / num_chunks;
+        const size_t end   = frontier_size * (s + 1) / num_chunks;
+
+        for(size_t k = start; k < end; k++)
+        {
+            const VertexId u = state.frontier[k];
+
+            for(IndexType jj = G.row_offsets[u]; jj < G.row_offsets[u + 1]; jj++)
+            {
+                const VertexId v = G.column_indices[jj];
+
+                if(v < 0 || levels[v] != -1) continue;
+
+                const int d = state.owner(v);
+
+                state.bucket_vertices[s * num_chunks + d].push_back(v);
+                state.bucket_parents[s * num_chunks + d].push_back(u);
+            }
+        }
+    }
+
+    // each chunk keeps the first discovery of every vertex it owns
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int d = 0; d < num_chunks; d++)
+    {
+        state.next[d].clear();
+
+        for(int s = 0; s < num_chunks; s++)
+        {
+            const std::vector<VertexId>& vertices = state.bucket_vertices[s * num_chunks + d];
+            const std::vector<VertexId>& sources  = state.bucket_parents[s * num_chunks + d];
+
+            for(size_t k = 0; k < vertices.size(); k++)
+            {
+                const VertexId v = vertices[k];
+
+                if(levels[v] != -1) continue;
+
+                levels[v] = depth + 1;
+                if(mark_parents) parents[v] = sources[k];
+                state.next[d].push_back(v);
+            }
+        }
+    }
+}
+
+// searches the incoming edges of every unvisited vertex for a frontier vertex,
+// H holds the incoming edges of each vertex in its rows
+template <typename MatrixType, typename LevelArray, typename ParentArray, typename VertexId>
+void bfs_bottom_up_step(const MatrixType& H, LevelArray& levels, ParentArray& parents,
+                        const bool mark_parents, const VertexId depth, bfs_state<VertexId>& state)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const int    num_chunks = state.num_chunks;
+    const int    num_words  = state.frontier_bits.size();
+    const size_t N          = state.num_vertices;
+
+    #pragma omp parallel for schedule(static)
+    for(int w = 0; w < num_words; w++)
+    {
+        unsigned int bits = 0;
+
+        for(size_t v = size_t(w) * 32; v < std::min(N, size_t(w + 1) * 32); v++)
+            if(levels[v] == depth)
+                bits |= 1u << (v % 32);
+
+        state.frontier_bits[w] = bits;
+    }
+
+    // vertices of other chunks are only read through the bitmap
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int c = 0; c < num_chunks; c++)
+    {
+        state.next[c].clear();
+
+        for(size_t v = state.chunk_begin(c); v < state.chunk_begin(c + 1); v++)
+        {
+            if(levels[v] != -1) continue;
+
+            for(IndexType jj = H.row_offsets[v]; jj < H.row_offsets[v + 1]; jj++)
+            {
+                const VertexId u = H.column_indices[jj];
+
+                if(u < 0 || !(state.frontier_bits[u / 32] & (1u << (u % 32)))) continue;
+
+                levels[v] = depth + 1;
+                if(mark_parents) parents[v] = u;
+                state.next[c].push_back(VertexId(v));
+                break;
+            }
+        }
+    }
+}
+
+// gathers the next frontier of every chunk and returns the number of edges
+// leaving the new frontier
+template <typename MatrixType, typename VertexId>
+size_t bfs_next_frontier(const MatrixType& G, bfs_state<VertexId>& state)
+{
+    const int num_chunks = state.num_chunks;
+
+    std::vector<size_t> offsets(num_chunks + 1, 0);
+
+    for(int c = 0; c < num_chunks; c++)
+        offsets[c + 1] = offsets[c] + state.next[c].size();
+
+    state.frontier.resize(offsets[num_chunks]);
+
+    size_t frontier_edges = 0;
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks) reduction(+:frontier_edges)
+    for(int c = 0; c < num_chunks; c++)
+    {
+        for(size_t k = 0; k < state.next[c].size(); k++)
+        {
+            const VertexId u = state.next[c][k];
+
+            state.frontier[offsets[c] + k] = u;
+            frontier_edges += G.row_offsets[u + 1] - G.row_offsets[u];
+        }
+    }
+
+    return frontier_edges;
+}
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+void breadth_first_search(omp::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                          const typename MatrixType::index_type src,
+                          ArrayType& labels,
+                          const bool mark_levels,
+                          cusp::csr_format)
+{
+    typedef typename MatrixType::index_type   VertexId;
+    typedef typename MatrixType::value_type   ValueType;
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    // switch to bottom-up steps when the frontier has more than 1/ALPHA of
+    // the unexplored edges and back when it has fewer than 1/BETA of the
+    // vertices
+    const size_t ALPHA = 14;
+    const size_t BETA  = 24;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const size_t N = G.num_rows;
+
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> levels(exec, N, VertexId(-1));
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> parents(exec);
+
+    if(G.num_entries == 0)
+    {
+        cusp::copy(exec, levels, labels);
+        return;
+    }
+
+    if(!mark_levels)
+    {
+        parents.resize(N);
+        thrust::fill(exec, parents.begin(), parents.end(), VertexId(-1));
+        parents[src] = -2;
+    }
+
+    levels[src] = 0;
+
+    bfs_state<VertexId> state(N, std::min<size_t>(max_threads(), N));
+    state.frontier.push_back(src);
+
+    // incoming edges for the bottom-up steps, G itself if it is symmetric
+    cusp::csr_matrix<VertexId, ValueType, MemorySpace> Gt;
+    bool has_incoming_edges = false;
+    bool use_transpose      = false;
+
+    size_t frontier_edges   = G.row_offsets[src + 1] - G.row_offsets[src];
+    size_t unexplored_edges = G.num_entries - frontier_edges;
+    bool   bottom_up        = false;
+
+    for(VertexId depth = 0; !state.frontier.empty(); depth++)
+    {
+        if(!bottom_up && frontier_edges > unexplored_edges / ALPHA)
+            bottom_up = true;
+        else if(bottom_up && state.frontier.size() < N / BETA)
+            bottom_up = false;
+
+        if(bottom_up && !has_incoming_edges)
+        {
+            use_transpose = !bfs_has_symmetric_pattern(G);
+
+            if(use_transpose)
+                cusp::transpose(exec, G, Gt);
+
+            has_incoming_edges = true;
+        }
+
+        if(!bottom_up)
+            bfs_top_down_step(G, levels, parents, !mark_levels, depth, state);
+        else if(use_transpose)
+            bfs_bottom_up_step(Gt, levels, parents, !mark_levels, depth, state);
+        else
+            bfs_bottom_up_step(G, levels, parents, !mark_levels, depth, state);
+
+        frontier_edges    = bfs_next_frontier(G, state);
+        unexplored_edges -= std::min(unexplored_edges, frontier_edges);
+    }
+
+    if(mark_levels)
+        cusp::copy(exec, levels, labels);
+    else
+        cusp::copy(exec, parents, labels);
+}
 
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
 } // end namespace cusp
-
@@ -17,5 +17,193 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system has no special version of this algorithm
+#include <cusp/exception.h>
+
+#include <cusp/system/omp/detail/utils.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// Shiloach-Vishkin style components. Every vertex points to the root of its
+// tree, which is always the smallest vertex of the tree. In each round the
+// roots hook onto the smallest root found across their edges and the trees
+// are then flattened by pointer jumping. As in the breadth-first search each
+// chunk owns a range of vertices, the hooks are bucketed by the chunk owning
+// the root, so every write goes to a vertex of the writing chunk.
+template <typename VertexId>
+struct cc_state
+{
+    size_t num_vertices;
+    int    num_chunks;
+
+    std::vector<VertexId> parents;
+    std::vector<VertexId> next_parents;
+
+    // roots hooked by chunk s for chunk d, and the roots they hook onto
+    std::vector< std::vector<VertexId> > bucket_roots;
+    std::vector< std::vector<VertexId> > bucket_labels;
+
+    cc_state(const size_t num_vertices, const int num_chunks)
+        : num_vertices(num_vertices), num_chunks(num_chunks),
+          parents(num_vertices), next_parents(num_vertices),
+          bucket_roots(num_chunks * num_chunks),
+          bucket_labels(num_chunks * num_chunks) {}
+
+    size_t chunk_begin(const int c) const
+    {
+        return num_vertices * c / num_chunks;
+    }
+
+    int owner(const VertexId v) const
+    {
+        return int(size_t(v) * num_chunks / num_vertices);
+    }
+};
+
+// hooks every root onto the smallest root adjacent to its tree and returns
+// the number of hooks, assumes every vertex points to its root
+template <typename MatrixType, typename VertexId>
+size_t cc_hook_step(const MatrixType& G, cc_state<VertexId>& state)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const int num_chunks = state.num_chunks;
+
+    size_t num_hooks = 0;
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks) reduction(+:num_hooks)
+    for(int s = 0; s < num_chunks; s++)
+    {
+        for(int d = 0; d < num_chunks; d++)
+        {
+            state.bucket_roots[s * num_chunks + d].clear();
+            state.bucket_labels[s * num_chunks + d].clear();
+        }
+
+        for(size_t u = state.chunk_begin(s); u < state.chunk_begin(s + 1); u++)
+        {
+            const VertexId root = state.parents[u];
+
+            VertexId label = root;
+
+            for(IndexType jj = G.row_offsets[u]; jj < G.row_offsets[u + 1]; jj++)
+            {
+                const VertexId v = G.column_indices[jj];
+
+                if(v < 0) continue;
+
+                label = std::min(label, state.parents[v]);
+            }
+
+            if(label == root) continue;
+
+            const int d = state.owner(root);
+
+            state.bucket_roots[s * num_chunks + d].push_back(root);
+            state.bucket_labels[s * num_chunks + d].push_back(label);
+            num_hooks++;
+        }
+    }
+
+    // each chunk hooks the roots it owns onto the smallest label proposed
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int d = 0; d < num_chunks; d++)
+    {
+        for(int s = 0; s < num_chunks; s++)
+        {
+            const std::vector<VertexId>& roots  = state.bucket_roots[s * num_chunks + d];
+            const std::vector<VertexId>& labels = state.bucket_labels[s * num_chunks + d];
+
+            for(size_t k = 0; k < roots.size(); k++)
+                state.parents[roots[k]] = std::min(state.parents[roots[k]], labels[k]);
+        }
+    }
+
+    return num_hooks;
+}
+
+// points every vertex to the root of its tree
+template <typename VertexId>
+void cc_pointer_jumping(cc_state<VertexId>& state)
+{
+    const int num_vertices = state.num_vertices;
+
+    bool done = false;
+
+    while(!done)
+    {
+        int changed = 0;
+
+        #pragma omp parallel for schedule(static) reduction(||:changed)
+        for(int u = 0; u < num_vertices; u++)
+        {
+            const VertexId parent = state.parents[u];
+            const VertexId grandparent = state.parents[parent];
+
+            state.next_parents[u] = grandparent;
+            changed = changed || (parent != grandparent);
+        }
+
+        state.parents.swap(state.next_parents);
+        done = !changed;
+    }
+}
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t connected_components(omp::execution_policy<DerivedPolicy>& exec,
+                            const MatrixType& G,
+                            ArrayType& components,
+                            cusp::csr_format)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const int num_vertices = G.num_rows;
+
+    if(num_vertices == 0)
+        return 0;
+
+    cc_state<VertexId> state(num_vertices, std::min(max_threads(), num_vertices));
+
+    #pragma omp parallel for schedule(static)
+    for(int u = 0; u < num_vertices; u++)
+        state.parents[u] = u;
+
+    while(cc_hook_step(G, state) > 0)
+        cc_pointer_jumping(state);
+
+    // number the components in the order of their smallest vertex, which
+    // matches the order in which a sequential search discovers them
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> root_index(exec, num_vertices);
+
+    #pragma omp parallel for schedule(static)
+    for(int u = 0; u < num_vertices; u++)
+        root_index[u] = state.parents[u] == VertexId(u) ? 1 : 0;
+
+    parallel_inclusive_scan(root_index, num_vertices);
+
+    #pragma omp parallel for schedule(static)
+    for(int u = 0; u < num_vertices; u++)
+        components[u] = root_index[state.parents[u]] - 1;
+
+    return root_index[num_vertices - 1];
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
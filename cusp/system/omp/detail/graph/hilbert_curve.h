@@ -17,10 +17,15 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system inherits elementwise
 #include <cusp/system/detail/sequential/graph/hilbert_curve.h>
 
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+
+#include <algorithm>
+
 namespace cusp
 {
 namespace system
@@ -30,7 +35,32 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::hilbert_curve;
+// computes the keys of batches of points in parallel and sorts them with
+// the parallel sort of the omp system
+template <typename DerivedPolicy, typename Array2d, typename ArrayType>
+void hilbert_order(omp::execution_policy<DerivedPolicy>& exec,
+                   const Array2d& coord,
+                   ArrayType& order)
+{
+    using cusp::system::detail::sequential::detail::HILBERT_BATCH_SIZE;
+
+    const size_t num_points  = coord.num_rows;
+    const long   num_batches = (num_points + HILBERT_BATCH_SIZE - 1) / HILBERT_BATCH_SIZE;
+
+    cusp::detail::temporary_array<unsigned long long, DerivedPolicy> keys(exec, num_points);
+
+    #pragma omp parallel for schedule(static)
+    for(long batch = 0; batch < num_batches; batch++)
+    {
+        const size_t begin = batch * HILBERT_BATCH_SIZE;
+        const size_t end   = std::min(num_points, begin + HILBERT_BATCH_SIZE);
+
+        cusp::system::detail::sequential::detail::hilbert_keys(coord, begin, end, keys);
+    }
+
+    thrust::sequence(exec, order.begin(), order.end());
+    thrust::sort_by_key(exec, keys.begin(), keys.end(), order.begin());
+}
 
 } // end namespace detail
 } // end namespace omp
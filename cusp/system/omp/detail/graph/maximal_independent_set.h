@@ -17,7 +17,10 @@
 #pragma once
 
 #include <cusp/detail/config.h>
-#include <cusp/system/cpp/detail/graph/maximal_independent_set.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/array1d.h>
 
 namespace cusp
 {
@@ -28,10 +31,130 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::maximal_independent_set;
+// Luby style MIS(k). Every vertex is ranked by the tuple (state, random
+// value, index) and undecided vertices that rank highest in their k-ring
+// join the set. This is the algorithm of the generic implementation, with
+// the same random values, so the result does not depend on the number of
+// threads. Each round reads the states of the previous round only.
+template <typename StateArray, typename RandomArray, typename IndexType>
+bool mis_ranks_higher(const StateArray& states, const RandomArray& values,
+                      const IndexType i, const IndexType j)
+{
+    if(states[i] != states[j]) return states[i] > states[j];
+    if(values[i] != values[j]) return values[i] > values[j];
+    return i > j;
+}
+
+// finds the highest ranked vertex in the k-ring of every vertex
+template <typename MatrixType, typename StateArray, typename RandomArray, typename IndexArray>
+void mis_compute_maxima(const MatrixType& G, const StateArray& states, const RandomArray& values,
+                        const size_t k, IndexArray& maximal_indices, IndexArray& last_indices)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const IndexType N = G.num_rows;
+
+    #pragma omp parallel for schedule(static)
+    for(IndexType i = 0; i < N; i++)
+        maximal_indices[i] = i;
+
+    for(size_t ring = 0; ring < k; ring++)
+    {
+        maximal_indices.swap(last_indices);
+
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for(IndexType i = 0; i < N; i++)
+        {
+            IndexType maximal = last_indices[i];
+
+            for(IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+            {
+                const IndexType m = last_indices[G.column_indices[jj]];
+
+                if(mis_ranks_higher(states, values, m, maximal))
+                    maximal = m;
+            }
+
+            maximal_indices[i] = maximal;
+        }
+    }
+}
+
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t maximal_independent_set(omp::execution_policy<DerivedPolicy>& exec,
+                               const MatrixType& G,
+                               ArrayType& stencil,
+                               const size_t k,
+                               cusp::csr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef unsigned int                    RandomType;
+    typedef unsigned char                   NodeStateType;
+
+    // states of the vertices
+    const NodeStateType NON_MIS_NODE = 0;
+    const NodeStateType UNDECIDED    = 1;
+    const NodeStateType MIS_NODE     = 2;
+
+    const IndexType N = G.num_rows;
+
+    cusp::random_array<RandomType> values(N);
+
+    cusp::detail::temporary_array<NodeStateType, DerivedPolicy> states(exec, N, UNDECIDED);
+    cusp::detail::temporary_array<NodeStateType, DerivedPolicy> next_states(exec, N);
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> maximal_indices(exec, N);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> last_indices(exec, N);
+
+    size_t active_nodes = N;
+
+    while(active_nodes > 0)
+    {
+        mis_compute_maxima(G, states, values, k, maximal_indices, last_indices);
+
+        active_nodes = 0;
+
+        // local maxima join the set and the undecided vertices in the k-ring
+        // of a set vertex leave it
+        #pragma omp parallel for schedule(static) reduction(+:active_nodes)
+        for(IndexType i = 0; i < N; i++)
+        {
+            NodeStateType state = states[i];
+
+            if(state == UNDECIDED)
+            {
+                const IndexType m = maximal_indices[i];
+
+                if(m == i)
+                    state = MIS_NODE;
+                else if(states[m] == MIS_NODE || (states[m] == UNDECIDED && maximal_indices[m] == m))
+                    state = NON_MIS_NODE;
+                else
+                    active_nodes++;
+            }
+
+            next_states[i] = state;
+        }
+
+        states.swap(next_states);
+    }
+
+    // write output
+    stencil.resize(N);
+
+    size_t set_nodes = 0;
+
+    #pragma omp parallel for schedule(static) reduction(+:set_nodes)
+    for(IndexType i = 0; i < N; i++)
+    {
+        stencil[i] = states[i] == MIS_NODE;
+        set_nodes += states[i] == MIS_NODE;
+    }
+
+    return set_nodes;
+}
 
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
 } // end namespace cusp
-
@@ -17,5 +17,197 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
 
-// this system has no special version of this algorithm
+#include <cusp/exception.h>
+
+#include <cusp/system/omp/detail/graph/breadth_first_search.h>
+#include <cusp/system/omp/detail/utils.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// Level structure of a pseudo-peripheral search. Only the levels of the
+// vertices visited by the previous search are reset, so the arrays are
+// allocated once and reused by every sweep.
+template <typename VertexId>
+struct peripheral_structure
+{
+    std::vector<VertexId> levels;
+
+    // visited vertices in level order, the last level starts at last_level
+    std::vector<VertexId> visited;
+    size_t last_level;
+
+    VertexId depth;
+    size_t   width;
+
+    peripheral_structure(const size_t num_vertices)
+        : levels(num_vertices, VertexId(-1)), last_level(0), depth(0), width(0) {}
+
+    void swap(peripheral_structure& S)
+    {
+        levels.swap(S.levels);
+        visited.swap(S.visited);
+        std::swap(last_level, S.last_level);
+        std::swap(depth, S.depth);
+        std::swap(width, S.width);
+    }
+};
+
+// builds the level structure rooted at root, returns false if it was
+// abandoned because a level has more than max_width vertices
+template <typename MatrixType, typename VertexId>
+bool peripheral_level_structure(const MatrixType& G, const VertexId root, const size_t max_width,
+                                peripheral_structure<VertexId>& S, bfs_state<VertexId>& state)
+{
+    const int num_visited = S.visited.size();
+
+    #pragma omp parallel for schedule(static)
+    for(int k = 0; k < num_visited; k++)
+        S.levels[S.visited[k]] = -1;
+
+    S.visited.clear();
+    S.visited.push_back(root);
+    S.levels[root] = 0;
+    S.last_level   = 0;
+    S.depth        = 0;
+    S.width        = 1;
+
+    state.frontier.clear();
+    state.frontier.push_back(root);
+
+    while(true)
+    {
+        bfs_top_down_step(G, S.levels, S.levels, false, S.depth, state);
+        bfs_next_frontier(G, state);
+
+        if(state.frontier.empty())
+            return true;
+
+        S.depth++;
+        S.width      = std::max(S.width, state.frontier.size());
+        S.last_level = S.visited.size();
+        S.visited.insert(S.visited.end(), state.frontier.begin(), state.frontier.end());
+
+        if(S.width > max_width)
+            return false;
+    }
+}
+
+// George-Liu search with level structures built by parallel top-down BFS
+// steps. The candidates of a sweep are the vertices of smallest degree in
+// the last level, one per degree. A candidate whose structure grows wider
+// than the narrowest complete one is abandoned early (Reid and Scott).
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+typename MatrixType::index_type
+pseudo_peripheral_vertex(omp::execution_policy<DerivedPolicy>& exec,
+                         const MatrixType& G,
+                               ArrayType& levels,
+                         const size_t max_sweeps,
+                         const size_t max_candidates,
+                         cusp::csr_format)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    if(max_candidates == 0)
+        throw cusp::invalid_input_exception("number of candidates must be positive");
+
+    const size_t N = G.num_rows;
+
+    if(N == 0)
+        return 0;
+
+    bfs_state<VertexId> state(N, std::min<size_t>(max_threads(), N));
+
+    // structures of the current vertex, of the candidate being built and of
+    // the narrowest candidate
+    peripheral_structure<VertexId> current(N);
+    peripheral_structure<VertexId> candidate(N);
+    peripheral_structure<VertexId> best(N);
+
+    VertexId x = rand() % N;
+
+    peripheral_level_structure(G, x, N, current, state);
+
+    std::vector< std::pair<VertexId,VertexId> > last;
+
+    for(size_t sweep = 0; sweep < max_sweeps; sweep++)
+    {
+        // (degree, vertex) of the vertices in the last level
+        last.clear();
+
+        for(size_t k = current.last_level; k < current.visited.size(); k++)
+        {
+            const VertexId v = current.visited[k];
+            last.push_back(std::make_pair(VertexId(G.row_offsets[v + 1] - G.row_offsets[v]), v));
+        }
+
+        std::sort(last.begin(), last.end());
+
+        VertexId y          = -1;
+        size_t   best_width = N;
+        bool     deeper     = false;
+        size_t   tried      = 0;
+
+        for(size_t k = 0; k < last.size() && tried < max_candidates; k++)
+        {
+            if(k > 0 && last[k].first == last[k - 1].first)
+                continue;
+
+            tried++;
+
+            if(!peripheral_level_structure(G, last[k].second, best_width, candidate, state))
+                continue;
+
+            if(candidate.depth > current.depth)
+            {
+                x = last[k].second;
+                current.swap(candidate);
+                deeper = true;
+                break;
+            }
+
+            if(y == -1 || candidate.width < best_width)
+            {
+                y = last[k].second;
+                best_width = candidate.width;
+                best.swap(candidate);
+            }
+        }
+
+        if(!deeper)
+        {
+            #pragma omp parallel for schedule(static)
+            for(int i = 0; i < int(N); i++)
+                levels[i] = best.levels[i];
+
+            return y;
+        }
+    }
+
+    #pragma omp parallel for schedule(static)
+    for(int i = 0; i < int(N); i++)
+        levels[i] = current.levels[i];
+
+    return x;
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
@@ -17,7 +17,16 @@
 #pragma once
 
 #include <cusp/detail/config.h>
-#include <cusp/system/cpp/detail/graph/vertex_coloring.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/array1d.h>
+#include <cusp/exception.h>
+
+#include <cusp/system/omp/detail/utils.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace cusp
 {
@@ -28,10 +37,260 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::vertex_coloring;
+template <typename MatrixType>
+struct vc_degree_functor
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const MatrixType& G;
+
+    vc_degree_functor(const MatrixType& G) : G(G) {}
+
+    IndexType operator()(const size_t v) const
+    {
+        return G.row_offsets[v + 1] - G.row_offsets[v];
+    }
+};
+
+template <typename ArrayType>
+struct vc_color_functor
+{
+    typedef typename ArrayType::value_type IndexType;
+
+    const ArrayType& colors;
+
+    vc_color_functor(const ArrayType& colors) : colors(colors) {}
+
+    IndexType operator()(const size_t v) const
+    {
+        return colors[v];
+    }
+};
+
+// Jones-Plassmann coloring. Vertices are ranked by a random value and their
+// index, and in every round each uncolored vertex without an uncolored
+// higher ranked neighbor takes the smallest color its neighbors do not use.
+// These vertices are independent, so they are colored at once from the
+// colors of the previous rounds and the result does not depend on the
+// number of threads.
+template <typename RandomArray, typename IndexType>
+bool vc_ranks_higher(const RandomArray& values, const IndexType i, const IndexType j)
+{
+    if(values[i] != values[j]) return values[i] > values[j];
+    return i > j;
+}
+
+// colors the vertices of the active list that are ready and returns the
+// list of the remaining ones
+template <typename MatrixType, typename RandomArray, typename ColorArray, typename IndexType>
+void vc_coloring_round(const MatrixType& G, const RandomArray& values, ColorArray& colors,
+                       const IndexType max_degree, const int num_chunks,
+                       std::vector<IndexType>& active, std::vector<IndexType>& chosen,
+                       std::vector< std::vector<IndexType> >& next)
+{
+    const size_t num_active = active.size();
+
+    chosen.resize(num_active);
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int c = 0; c < num_chunks; c++)
+    {
+        // the last vertex to mark each color as used
+        std::vector<IndexType> mark(max_degree + 1, IndexType(-1));
+
+        for(size_t k = num_active * c / num_chunks; k < num_active * (c + 1) / num_chunks; k++)
+        {
+            const IndexType v = active[k];
+
+            bool ready = true;
+
+            for(IndexType jj = G.row_offsets[v]; jj < G.row_offsets[v + 1] && ready; jj++)
+            {
+                const IndexType u = G.column_indices[jj];
+
+                if(u == v) continue;
+
+                if(colors[u] == -1)
+                    ready = vc_ranks_higher(values, v, u);
+                else if(colors[u] <= max_degree)
+                    mark[colors[u]] = v;
+            }
+
+            IndexType color = -1;
+
+            if(ready)
+            {
+                color = 0;
+                while(mark[color] == v)
+                    color++;
+            }
+
+            chosen[k] = color;
+        }
+    }
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int c = 0; c < num_chunks; c++)
+    {
+        next[c].clear();
+
+        for(size_t k = num_active * c / num_chunks; k < num_active * (c + 1) / num_chunks; k++)
+        {
+            if(chosen[k] == -1)
+                next[c].push_back(active[k]);
+            else
+                colors[active[k]] = chosen[k];
+        }
+    }
+
+    active.clear();
+
+    for(int c = 0; c < num_chunks; c++)
+        active.insert(active.end(), next[c].begin(), next[c].end());
+}
+
+// Moves vertices of classes above the average size to classes below it. The
+// classes are filled one at a time. The vertices that may move to a class
+// have no neighbor in it, and of the adjacent ones only the highest ranked
+// is kept. The moves are then applied in vertex order, and the selection is
+// repeated until the class is full or no vertex can move to it.
+template <typename MatrixType, typename RandomArray, typename ColorArray>
+void vc_balance_colors(const MatrixType& G, const RandomArray& values, ColorArray& colors,
+                       const size_t num_colors, const int num_chunks)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const IndexType N = G.num_rows;
+    const size_t target = (N + num_colors - 1) / num_colors;
+
+    std::vector<size_t> chunk_sizes(num_chunks * num_colors, 0);
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int c = 0; c < num_chunks; c++)
+        for(IndexType v = IndexType(size_t(N) * c / num_chunks); v < IndexType(size_t(N) * (c + 1) / num_chunks); v++)
+            chunk_sizes[c * num_colors + colors[v]]++;
+
+    std::vector<size_t> sizes(num_colors, 0);
+
+    for(int c = 0; c < num_chunks; c++)
+        for(size_t color = 0; color < num_colors; color++)
+            sizes[color] += chunk_sizes[c * num_colors + color];
+
+    std::vector<char> candidates(N);
+    std::vector< std::vector<IndexType> > moves(num_chunks);
+
+    for(size_t target_color = 0; target_color < num_colors; target_color++)
+    {
+        bool moved = true;
+
+        while(moved && sizes[target_color] < target)
+        {
+            #pragma omp parallel for schedule(dynamic, 1024)
+            for(IndexType v = 0; v < N; v++)
+            {
+                bool candidate = sizes[colors[v]] > target;
+
+                for(IndexType jj = G.row_offsets[v]; jj < G.row_offsets[v + 1] && candidate; jj++)
+                    candidate = size_t(colors[G.column_indices[jj]]) != target_color;
+
+                candidates[v] = candidate;
+            }
+
+            #pragma omp parallel for schedule(static) num_threads(num_chunks)
+            for(int c = 0; c < num_chunks; c++)
+            {
+                moves[c].clear();
+
+                for(IndexType v = IndexType(size_t(N) * c / num_chunks); v < IndexType(size_t(N) * (c + 1) / num_chunks); v++)
+                {
+                    if(!candidates[v]) continue;
+
+                    bool highest = true;
+
+                    for(IndexType jj = G.row_offsets[v]; jj < G.row_offsets[v + 1] && highest; jj++)
+                    {
+                        const IndexType u = G.column_indices[jj];
+
+                        if(u != v && candidates[u])
+                            highest = vc_ranks_higher(values, v, u);
+                    }
+
+                    if(highest)
+                        moves[c].push_back(v);
+                }
+            }
+
+            moved = false;
+
+            for(int c = 0; c < num_chunks && sizes[target_color] < target; c++)
+            {
+                for(size_t k = 0; k < moves[c].size() && sizes[target_color] < target; k++)
+                {
+                    const IndexType v = moves[c][k];
+                    const size_t color = colors[v];
+
+                    if(sizes[color] <= target) continue;
+
+                    colors[v] = target_color;
+                    sizes[color]--;
+                    sizes[target_color]++;
+                    moved = true;
+                }
+            }
+        }
+    }
+}
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t vertex_coloring(omp::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       ArrayType& colors,
+                       const bool balance,
+                       cusp::csr_format)
+{
+    typedef typename MatrixType::index_type                         IndexType;
+    typedef unsigned int                                            RandomType;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy> IndexArray;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const IndexType N = G.num_rows;
+    const int num_chunks = max_threads();
+
+    cusp::random_array<RandomType> values(N);
+    IndexArray vertex_colors(exec, N, IndexType(-1));
+
+    const IndexType max_degree = parallel_max(N, IndexType(0), vc_degree_functor<MatrixType>(G));
+
+    std::vector<IndexType> active(N);
+
+    #pragma omp parallel for schedule(static)
+    for(IndexType v = 0; v < N; v++)
+        active[v] = v;
+
+    std::vector<IndexType> chosen;
+    std::vector< std::vector<IndexType> > next(num_chunks);
+
+    while(!active.empty())
+        vc_coloring_round(G, values, vertex_colors, max_degree, num_chunks, active, chosen, next);
+
+    const IndexType max_color =
+        parallel_max(N, IndexType(-1), vc_color_functor<IndexArray>(vertex_colors));
+
+    const size_t num_colors = max_color + 1;
+
+    if(balance && num_colors > 1)
+        vc_balance_colors(G, values, vertex_colors, num_colors, num_chunks);
+
+    #pragma omp parallel for schedule(static)
+    for(IndexType v = 0; v < N; v++)
+        colors[v] = vertex_colors[v];
+
+    return num_colors;
+}
 
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
 } // end namespace cusp
-
@@ -18,10 +18,24 @@
 
 #include <cusp/detail/config.h>
 
+#include <cusp/system/omp/detail/multiply/bsr_spmv.h>
+#include <cusp/system/omp/detail/multiply/compressed_csr_spmv.h>
+#include <cusp/system/omp/detail/multiply/coo_spmv.h>
+#include <cusp/system/omp/detail/multiply/csc_spmv.h>
 #include <cusp/system/omp/detail/multiply/csr_spmv.h>
+#include <cusp/system/omp/detail/multiply/dia_spmv.h>
+#include <cusp/system/omp/detail/multiply/ell_spmv.h>
+#include <cusp/system/omp/detail/multiply/hyb_spmv.h>
+#include <cusp/system/omp/detail/multiply/sell_spmv.h>
+#include <cusp/system/omp/detail/multiply/symmetric_csr_spmv.h>
+
+#include <cusp/system/omp/detail/multiply/csr_block_spmv.h>
+
 #include <cusp/system/omp/detail/multiply/coo_spgemm.h>
 #include <cusp/system/omp/detail/multiply/csr_spgemm.h>
 
+#include <cusp/system/omp/detail/multiply/spmspv.h>
+
 // this system inherits multiply
 #include <cusp/system/cpp/detail/multiply.h>
 
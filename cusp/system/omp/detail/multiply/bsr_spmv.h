@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/system/detail/sequential/multiply/bsr_spmv.h>
+#include <cusp/system/omp/detail/utils.h>
+
+#include <thrust/memory.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// Every thread computes a contiguous range of block rows with the
+// sequential kernels, so each entry of y is written by one thread only.
+// The ranges hold about the same number of blocks.
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::bsr_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const size_t num_block_rows = A.row_offsets.size() - 1;
+
+    if(num_block_rows == 0)
+        return;
+
+    const int num_chunks = std::min<size_t>(max_threads(), num_block_rows);
+
+    const IndexType * offsets = thrust::raw_pointer_cast(&A.row_offsets[0]);
+
+    // first block row of every chunk
+    std::vector<size_t> range_begin;
+    split_offsets(offsets, num_block_rows, num_chunks, range_begin);
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int c = 0; c < num_chunks; c++)
+        cusp::system::detail::sequential::spmv_bsr(A, range_begin[c], range_begin[c + 1], x, y, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::bsr_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    typedef typename MatrixType::index_type                     IndexType;
+    typedef typename VectorType2::values_array_type::value_type ValueType;
+
+    const size_t num_block_rows = A.row_offsets.size() - 1;
+
+    if(num_block_rows == 0 || x.num_cols == 0)
+        return;
+
+    const int    num_chunks = std::min<size_t>(max_threads(), num_block_rows);
+    const size_t chunk_size = A.block_rows * x.num_cols;
+
+    // partial sums of the block row computed by each chunk
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> sums(exec, num_chunks * chunk_size);
+    ValueType * sums_ptr = thrust::raw_pointer_cast(&sums[0]);
+
+    const IndexType * offsets = thrust::raw_pointer_cast(&A.row_offsets[0]);
+
+    // first block row of every chunk
+    std::vector<size_t> range_begin;
+    split_offsets(offsets, num_block_rows, num_chunks, range_begin);
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int c = 0; c < num_chunks; c++)
+        cusp::system::detail::sequential::spmm_bsr(A, range_begin[c], range_begin[c + 1], x, y, sums_ptr + c * chunk_size,
+                                                   initialize, combine, reduce);
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/system/omp/detail/utils.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::coo_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const IndexType num_rows    = A.num_rows;
+    const IndexType num_entries = A.num_entries;
+
+    #pragma omp parallel for
+    for(IndexType i = 0; i < num_rows; i++)
+        y[i] = initialize(y[i]);
+
+    if(num_entries == 0)
+        return;
+
+    // segmented reduction over the row-sorted entries, each thread
+    // receives an equal share of the nonzeros
+    const int    num_partitions        = max_threads();
+    const size_t entries_per_partition = (size_t(num_entries) + num_partitions - 1) / num_partitions;
+
+    // partial results of the first row of each partition
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> carry_rows(exec, num_partitions);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> carry_values(exec, num_partitions);
+
+    #pragma omp parallel for schedule(static) num_threads(num_partitions)
+    for(int p = 0; p < num_partitions; p++)
+    {
+        const IndexType start = std::min(entries_per_partition * p, size_t(num_entries));
+        const IndexType end   = std::min(entries_per_partition * (p + 1), size_t(num_entries));
+
+        carry_rows[p] = num_rows;
+
+        IndexType n = start;
+        bool first_row = true;
+
+        while(n < end)
+        {
+            const IndexType row = A.row_indices[n];
+
+            ValueType accumulator = combine(A.values[n], x[A.column_indices[n]]);
+
+            for(n++; n < end && A.row_indices[n] == row; n++)
+            {
+                const IndexType j   = A.column_indices[n];
+                const ValueType Aij = A.values[n];
+                const ValueType xj  = x[j];
+
+                accumulator = reduce(accumulator, combine(Aij, xj));
+            }
+
+            // the first row of the partition may have started in a preceding
+            // partition, all subsequent rows are owned by this partition
+            if(first_row)
+            {
+                carry_rows[p]   = row;
+                carry_values[p] = accumulator;
+                first_row       = false;
+            }
+            else
+            {
+                y[row] = reduce(y[row], accumulator);
+            }
+        }
+    }
+
+    // fix-up rows which span multiple partitions
+    for(int p = 0; p < num_partitions; p++)
+    {
+        const IndexType row = carry_rows[p];
+
+        if(row < num_rows)
+            y[row] = reduce(y[row], carry_values[p]);
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
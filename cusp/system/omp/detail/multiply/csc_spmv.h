@@ -0,0 +1,143 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/multiply/csc_spmv.h>
+#include <cusp/system/omp/detail/utils.h>
+
+#include <thrust/memory.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// The columns are split into contiguous ranges holding about the same
+// number of entries. Every thread scatters one range into a private buffer
+// covering the rows between the smallest and the largest row index of its
+// entries. Afterwards the rows are split evenly among the threads and
+// every thread reduces the buffers of all ranges into its own rows, so
+// each entry of y is written by one thread only.
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::csc_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const size_t num_rows = A.num_rows;
+    const size_t num_cols = A.num_cols;
+
+    if(num_rows == 0)
+        return;
+
+    const int num_ranges = std::max<size_t>(1, std::min<size_t>(max_threads(), num_cols));
+
+    const IndexType * offsets = thrust::raw_pointer_cast(&A.column_offsets[0]);
+
+    // first column of every range
+    std::vector<size_t> range_begin;
+    split_offsets(offsets, num_cols, num_ranges, range_begin);
+
+    // rows [buffer_begin, buffer_end) touched by every range
+    std::vector<size_t> buffer_begin(num_ranges, 0);
+    std::vector<size_t> buffer_end(num_ranges, 0);
+
+    std::vector< std::vector<ValueType> >     buffer_values(num_ranges);
+    std::vector< std::vector<unsigned char> > buffer_flags(num_ranges);
+
+    #pragma omp parallel for schedule(static) num_threads(num_ranges)
+    for(int r = 0; r < num_ranges; r++)
+    {
+        const IndexType entry_begin = offsets[range_begin[r]];
+        const IndexType entry_end   = offsets[range_begin[r + 1]];
+
+        if(entry_begin == entry_end)
+            continue;
+
+        size_t min_row = num_rows;
+        size_t max_row = 0;
+
+        for(IndexType ii = entry_begin; ii < entry_end; ii++)
+        {
+            min_row = std::min<size_t>(min_row, A.row_indices[ii]);
+            max_row = std::max<size_t>(max_row, A.row_indices[ii]);
+        }
+
+        buffer_begin[r] = min_row;
+        buffer_end[r]   = max_row + 1;
+
+        buffer_values[r].resize(max_row + 1 - min_row);
+        buffer_flags[r].resize(max_row + 1 - min_row, 0);
+
+        cusp::system::detail::sequential::spmv_csc(A, range_begin[r], range_begin[r + 1], x,
+                buffer_values[r], &buffer_flags[r][0], min_row, combine, reduce);
+    }
+
+    const int    num_blocks = std::min<size_t>(max_threads(), num_rows);
+    const size_t block_size = (num_rows + num_blocks - 1) / num_blocks;
+
+    #pragma omp parallel for schedule(static) num_threads(num_blocks)
+    for(int b = 0; b < num_blocks; b++)
+    {
+        const size_t row_begin = std::min(block_size * b, num_rows);
+        const size_t row_end   = std::min(row_begin + block_size, num_rows);
+
+        for(size_t i = row_begin; i < row_end; i++)
+            y[i] = initialize(y[i]);
+
+        // the ranges are reduced in column order
+        for(int r = 0; r < num_ranges; r++)
+        {
+            const size_t first = std::max(row_begin, buffer_begin[r]);
+            const size_t last  = std::min(row_end,   buffer_end[r]);
+
+            for(size_t i = first; i < last; i++)
+                if(buffer_flags[r][i - buffer_begin[r]])
+                    y[i] = reduce(y[i], buffer_values[r][i - buffer_begin[r]]);
+        }
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,147 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/array2d_format_utils.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// Compute columns [col_start, col_start + NUM_COLS) of row i of y. Every
+// nonzero of the row is loaded once and applied to all NUM_COLS vectors,
+// the partial sums are kept in a fixed-size local array. The vectors are
+// read through their value arrays, which need not be contiguous.
+template <unsigned int NUM_COLS,
+          typename MatrixType,
+          typename IndexType,
+          typename ArrayType1,
+          typename ArrayType2,
+          typename Orientation1,
+          typename Orientation2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_csr_block_row(const MatrixType& A,
+                        const IndexType i,
+                        const IndexType col_start,
+                        const ArrayType1& x,
+                        const IndexType x_pitch,
+                        Orientation1,
+                        ArrayType2& y,
+                        const IndexType y_pitch,
+                        Orientation2,
+                        UnaryFunction   initialize,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce)
+{
+    typedef typename ArrayType2::value_type ValueType2;
+
+    using cusp::detail::index_of;
+
+    ValueType2 sums[NUM_COLS];
+
+    for(IndexType k = 0; k < IndexType(NUM_COLS); k++)
+        sums[k] = initialize(y[index_of(i, col_start + k, y_pitch, Orientation2())]);
+
+    const IndexType row_start = A.row_offsets[i];
+    const IndexType row_end   = A.row_offsets[i + 1];
+
+    for(IndexType jj = row_start; jj < row_end; jj++)
+    {
+        const IndexType  j   = A.column_indices[jj];
+        const ValueType2 Aij = A.values[jj];
+
+        for(IndexType k = 0; k < IndexType(NUM_COLS); k++)
+            sums[k] = reduce(sums[k], combine(Aij, x[index_of(j, col_start + k, x_pitch, Orientation1())]));
+    }
+
+    for(IndexType k = 0; k < IndexType(NUM_COLS); k++)
+        y[index_of(i, col_start + k, y_pitch, Orientation2())] = sums[k];
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::csr_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    typedef typename MatrixType::index_type   IndexType;
+
+    typedef typename VectorType1::orientation Orientation1;
+    typedef typename VectorType2::orientation Orientation2;
+
+    const IndexType num_rows = A.num_rows;
+    const IndexType num_cols = x.num_cols;
+
+    if(num_rows == 0 || num_cols == 0)
+        return;
+
+    const IndexType x_pitch = x.pitch;
+    const IndexType y_pitch = y.pitch;
+
+    // the vectors are processed in panels of 16, 8, 4, 2 and 1 columns
+    // so the accumulators of every panel have a compile-time size
+    #pragma omp parallel for schedule(static)
+    for(IndexType i = 0; i < num_rows; i++)
+    {
+        IndexType k = 0;
+
+        for(; k + 16 <= num_cols; k += 16)
+            spmv_csr_block_row<16>(A, i, k, x.values, x_pitch, Orientation1(), y.values, y_pitch, Orientation2(), initialize, combine, reduce);
+
+        if(num_cols - k >= 8) {
+            spmv_csr_block_row<8>(A, i, k, x.values, x_pitch, Orientation1(), y.values, y_pitch, Orientation2(), initialize, combine, reduce);
+            k += 8;
+        }
+        if(num_cols - k >= 4) {
+            spmv_csr_block_row<4>(A, i, k, x.values, x_pitch, Orientation1(), y.values, y_pitch, Orientation2(), initialize, combine, reduce);
+            k += 4;
+        }
+        if(num_cols - k >= 2) {
+            spmv_csr_block_row<2>(A, i, k, x.values, x_pitch, Orientation1(), y.values, y_pitch, Orientation2(), initialize, combine, reduce);
+            k += 2;
+        }
+        if(num_cols - k >= 1) {
+            spmv_csr_block_row<1>(A, i, k, x.values, x_pitch, Orientation1(), y.values, y_pitch, Orientation2(), initialize, combine, reduce);
+        }
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
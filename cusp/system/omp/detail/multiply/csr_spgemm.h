@@ -17,10 +17,13 @@
 
 #include <cusp/array1d.h>
 
-#include <cusp/detail/temporary_array.h>
+#include <cusp/system/detail/sequential/multiply/spgemm_accumulator.h>
+#include <cusp/system/omp/detail/utils.h>
 
-#include <iostream>
-#include <list>
+#include <thrust/memory.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace cusp
 {
@@ -43,43 +46,26 @@ size_t spmm_csr_pass1(omp::execution_policy<DerivedPolicy>& exec,
                       const Array3& B_row_offsets, const Array4& B_column_indices,
                       Array5& C_row_offsets)
 {
-    typedef typename Array1::value_type IndexType1;
-    typedef typename Array2::value_type IndexType2;
+    typedef typename Array5::value_type IndexType;
 
     C_row_offsets[0] = 0;
 
     #pragma omp parallel
     {
-        cusp::detail::temporary_array<int, DerivedPolicy> mask(exec, num_cols, -1);
+        cusp::system::detail::sequential::spgemm_accumulator<IndexType, char> accumulator(num_cols, false);
 
         // Compute nnz in C (including explicit zeros)
-        #pragma omp for
+        #pragma omp for schedule(dynamic, 64)
         for(int i = 0; i < int(num_rows); i++)
         {
-            size_t num_nonzeros = 0;
-
-            for(IndexType1 jj = A_row_offsets[i]; jj < A_row_offsets[i + 1]; jj++)
-            {
-                IndexType1 j = A_column_indices[jj];
-
-                for(IndexType2 kk = B_row_offsets[j]; kk < B_row_offsets[j + 1]; kk++)
-                {
-                    IndexType2 k = B_column_indices[kk];
-
-                    if(mask[k] != i)
-                    {
-                        mask[k] = i;
-                        num_nonzeros++;
-                    }
-                }
-            }
-
-            C_row_offsets[i + 1] = num_nonzeros;
+            C_row_offsets[i + 1] =
+                cusp::system::detail::sequential::spgemm_csr_row_nonzeros(i, A_row_offsets, A_column_indices,
+                                                                          B_row_offsets, B_column_indices,
+                                                                          accumulator);
         } // end for loop
     }// end omp parallel
 
-    for(int i = 1; i < int(num_rows + 1); i++)
-      C_row_offsets[i] += C_row_offsets[i - 1];
+    parallel_inclusive_scan(C_row_offsets, num_rows + 1);
 
     return C_row_offsets[num_rows];
 }
@@ -100,63 +86,23 @@ void spmm_csr_pass2(omp::execution_policy<DerivedPolicy>& exec,
     typedef typename Array7::value_type IndexType;
     typedef typename Array9::value_type ValueType;
 
-    const IndexType unseen = static_cast<IndexType>(-1);
-    const IndexType init   = static_cast<IndexType>(-2);
+    if(C_row_offsets[num_rows] == 0)
+        return;
+
+    IndexType * C_columns = thrust::raw_pointer_cast(&C_column_indices[0]);
 
     #pragma omp parallel
     {
         // Compute entries of C
-        cusp::detail::temporary_array<IndexType, DerivedPolicy> next(exec, num_cols, unseen);
-        cusp::detail::temporary_array<ValueType, DerivedPolicy> sums(exec, num_cols, ValueType(0));
+        cusp::system::detail::sequential::spgemm_accumulator<IndexType, ValueType> accumulator(num_cols);
 
-        #pragma omp for
-        for (int i = 0; i < int(num_rows); i++)
+        #pragma omp for schedule(dynamic, 64)
+        for(int i = 0; i < int(num_rows); i++)
         {
-            IndexType head   = init;
-            IndexType length = 0;
-
-            IndexType jj_start = A_row_offsets[i];
-            IndexType jj_end   = A_row_offsets[i + 1];
-
-            for (IndexType jj = jj_start; jj < jj_end; jj++)
-            {
-                IndexType j = A_column_indices[jj];
-                ValueType v = A_values[jj];
-
-                IndexType kk_start = B_row_offsets[j];
-                IndexType kk_end   = B_row_offsets[j + 1];
-
-                for (IndexType kk = kk_start; kk < kk_end; kk++)
-                {
-                    IndexType k = B_column_indices[kk];
-                    ValueType b = B_values[kk];
-
-                    sums[k] = reduce(sums[k], combine(v, b));
-
-                    if (next[k] == unseen)
-                    {
-                        next[k] = head;
-                        head = k;
-                        length++;
-                    }
-                }
-            }
-
-            size_t offset = C_row_offsets[i];
-
-            for (IndexType jj = 0; jj < length; jj++)
-            {
-                C_column_indices[offset] = head;
-                C_values[offset] = sums[head];
-                offset++;
-
-                IndexType temp = head;
-                head = next[head];
-
-                // clear arrays
-                next[temp] = unseen;
-                sums[temp] = ValueType(0);
-            }
+            cusp::system::detail::sequential::spgemm_csr_row(i, A_row_offsets, A_column_indices, A_values,
+                                                             B_row_offsets, B_column_indices, B_values,
+                                                             IndexType(C_row_offsets[i]), C_columns, C_values,
+                                                             initialize, combine, reduce, accumulator);
         } // end for loop
     } //omp parallel
 }
@@ -201,4 +147,3 @@ void multiply(omp::execution_policy<DerivedPolicy>& exec,
 } // end namespace omp
 } // end namespace system
 } // end namespace cusp
-
@@ -29,9 +29,14 @@
 #include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
 
+#include <cusp/detail/temporary_array.h>
 #include <cusp/detail/utils.h>
 #include <cusp/detail/array2d_format_utils.h>
 
+#include <cusp/system/omp/detail/utils.h>
+
+#include <algorithm>
+
 namespace cusp
 {
 namespace system
@@ -42,7 +47,7 @@ namespace detail
 {
 
 template <typename DerivedPolicy,
-		      typename MatrixType,
+          typename MatrixType,
           typename VectorType1,
           typename VectorType2,
           typename UnaryFunction,
@@ -62,26 +67,82 @@ void multiply(omp::execution_policy<DerivedPolicy>& exec,
     typedef typename MatrixType::index_type  IndexType;
     typedef typename VectorType2::value_type ValueType;
 
-	int N = A.num_rows;
+    const IndexType num_rows    = A.num_rows;
+    const IndexType num_entries = A.row_offsets[num_rows];
+
+    if(num_rows == 0)
+        return;
+
+    // split the merge of row ends and nonzeros into equal sized
+    // partitions so every thread receives the same amount of work
+    // regardless of how the nonzeros are distributed among the rows
+    const int    num_partitions      = max_threads();
+    const size_t num_merge_items     = size_t(num_rows) + size_t(num_entries);
+    const size_t items_per_partition = (num_merge_items + num_partitions - 1) / num_partitions;
+
+    // partial results of rows which straddle partition boundaries
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> carry_rows(exec, num_partitions);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> carry_values(exec, num_partitions);
 
-    #pragma omp parallel for
-    for(int i = 0; i < N; i++)
+    #pragma omp parallel for schedule(static) num_threads(num_partitions)
+    for(int p = 0; p < num_partitions; p++)
     {
-        const IndexType row_start = A.row_offsets[i];
-        const IndexType row_end   = A.row_offsets[i+1];
+        const size_t diagonal_start = std::min(items_per_partition * p, num_merge_items);
+        const size_t diagonal_end   = std::min(diagonal_start + items_per_partition, num_merge_items);
+
+        IndexType row, jj, row_end, jj_end;
+        cusp::detail::merge_path_search(diagonal_start, A.row_offsets, num_rows, num_entries, row, jj);
+        cusp::detail::merge_path_search(diagonal_end,   A.row_offsets, num_rows, num_entries, row_end, jj_end);
+
+        // rows which end inside this partition are written directly,
+        // their leading entries may belong to a preceding partition
+        for(; row < row_end; row++)
+        {
+            const IndexType row_stop = A.row_offsets[row + 1];
+
+            ValueType accumulator = initialize(y[row]);
 
-        ValueType accumulator = initialize(y[i]);
+            for(; jj < row_stop; jj++)
+            {
+                const IndexType j   = A.column_indices[jj];
+                const ValueType Aij = A.values[jj];
+                const ValueType xj  = x[j];
 
-        for (IndexType jj = row_start; jj < row_end; jj++)
+                accumulator = reduce(accumulator, combine(Aij, xj));
+            }
+
+            y[row] = accumulator;
+        }
+
+        // carry out the partial result of the row which continues
+        // into the next partition
+        carry_rows[p] = num_rows;
+
+        if(jj < jj_end)
         {
-            const IndexType j   = A.column_indices[jj];
-            const ValueType Aij = A.values[jj];
-            const ValueType xj  = x[j];
+            ValueType accumulator = combine(A.values[jj], x[A.column_indices[jj]]);
+
+            for(jj++; jj < jj_end; jj++)
+            {
+                const IndexType j   = A.column_indices[jj];
+                const ValueType Aij = A.values[jj];
+                const ValueType xj  = x[j];
 
-            accumulator = reduce(accumulator, combine(Aij, xj));
+                accumulator = reduce(accumulator, combine(Aij, xj));
+            }
+
+            carry_rows[p]   = row_end;
+            carry_values[p] = accumulator;
         }
+    }
+
+    // fix-up rows which span multiple partitions
+    for(int p = 0; p < num_partitions; p++)
+    {
+        const IndexType row = carry_rows[p];
 
-        y[i] = accumulator;
+        if(row < num_rows)
+            y[row] = reduce(y[row], carry_values[p]);
     }
 }
 
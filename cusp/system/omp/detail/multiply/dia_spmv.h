@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// Accumulate the DIA entries of rows [row_start, row_end) into sums.
+// Each diagonal is a contiguous run of values and x so the inner loop
+// is free of branches and indirection.
+template <typename IndexType,
+          typename OffsetsArray,
+          typename ValueArray,
+          typename VectorType,
+          typename ValueType,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_dia_rows(const IndexType row_start,
+                   const IndexType row_end,
+                   const IndexType num_cols,
+                   const IndexType num_diagonals,
+                   const OffsetsArray& diagonal_offsets,
+                   const ValueArray& V,
+                   const VectorType& x,
+                   ValueType * sums,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce)
+{
+    for(IndexType n = 0; n < num_diagonals; n++)
+    {
+        const IndexType k = diagonal_offsets[n];
+
+        const IndexType i_start = std::max(row_start, -k);
+        const IndexType i_end   = std::min(row_end, num_cols - k);
+
+        for(IndexType i = i_start; i < i_end; i++)
+            sums[i - row_start] = reduce(sums[i - row_start], combine(V(i,n), x[i + k]));
+    }
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::dia_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const IndexType BLOCK_SIZE = 256;
+
+    const IndexType num_rows      = A.num_rows;
+    const IndexType num_cols      = A.num_cols;
+    const IndexType num_diagonals = A.values.num_cols;
+    const IndexType num_blocks    = (num_rows + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    #pragma omp parallel for schedule(static)
+    for(IndexType block = 0; block < num_blocks; block++)
+    {
+        const IndexType row_start = block * BLOCK_SIZE;
+        const IndexType row_end   = std::min(row_start + BLOCK_SIZE, num_rows);
+
+        ValueType sums[BLOCK_SIZE];
+
+        for(IndexType i = row_start; i < row_end; i++)
+            sums[i - row_start] = initialize(y[i]);
+
+        spmv_dia_rows(row_start, row_end, num_cols, num_diagonals,
+                      A.diagonal_offsets, A.values, x, sums, combine, reduce);
+
+        for(IndexType i = row_start; i < row_end; i++)
+            y[i] = sums[i - row_start];
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,107 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/omp/detail/multiply/ell_spmv.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::hyb_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    typedef typename MatrixType::ell_matrix_type EllMatrixType;
+
+    const IndexType BLOCK_SIZE = 256;
+
+    const IndexType num_rows            = A.num_rows;
+    const IndexType num_entries_per_row = A.ell.column_indices.num_cols;
+    const IndexType num_coo_entries     = A.coo.num_entries;
+    const IndexType num_blocks          = (num_rows + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    // the ELL and COO parts are fused into a single pass over each
+    // block of rows, the COO entries are sorted by row so the range
+    // belonging to a block is found with a binary search
+    #pragma omp parallel for schedule(static)
+    for(IndexType block = 0; block < num_blocks; block++)
+    {
+        const IndexType row_start = block * BLOCK_SIZE;
+        const IndexType row_end   = std::min(row_start + BLOCK_SIZE, num_rows);
+
+        ValueType sums[BLOCK_SIZE];
+
+        for(IndexType i = row_start; i < row_end; i++)
+            sums[i - row_start] = initialize(y[i]);
+
+        cusp::system::detail::sequential::spmv_ell_rows(row_start, row_end, num_entries_per_row,
+                                                        IndexType(EllMatrixType::invalid_index),
+                                                        A.ell.column_indices, A.ell.values, x, sums, combine, reduce);
+
+        if(num_coo_entries > 0)
+        {
+            const IndexType coo_start = std::lower_bound(A.coo.row_indices.begin(), A.coo.row_indices.begin() + num_coo_entries, row_start) - A.coo.row_indices.begin();
+            const IndexType coo_end   = std::lower_bound(A.coo.row_indices.begin() + coo_start, A.coo.row_indices.begin() + num_coo_entries, row_end) - A.coo.row_indices.begin();
+
+            for(IndexType n = coo_start; n < coo_end; n++)
+            {
+                const IndexType i   = A.coo.row_indices[n];
+                const IndexType j   = A.coo.column_indices[n];
+                const ValueType Aij = A.coo.values[n];
+                const ValueType xj  = x[j];
+
+                sums[i - row_start] = reduce(sums[i - row_start], combine(Aij, xj));
+            }
+        }
+
+        for(IndexType i = row_start; i < row_end; i++)
+            y[i] = sums[i - row_start];
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
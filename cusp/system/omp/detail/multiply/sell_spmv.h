@@ -0,0 +1,83 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/multiply/sell_spmv.h>
+#include <cusp/system/omp/detail/utils.h>
+
+#include <thrust/memory.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// The chunks are split into contiguous ranges holding about the same
+// number of stored entries, every thread computes one range with the
+// sequential kernels so each entry of y is written by one thread only.
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::sell_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const size_t num_chunks = A.num_chunks();
+
+    if(num_chunks == 0)
+        return;
+
+    const int num_ranges = std::min<size_t>(max_threads(), num_chunks);
+
+    const IndexType * offsets = thrust::raw_pointer_cast(&A.chunk_offsets[0]);
+
+    // first chunk of every range
+    std::vector<size_t> range_begin;
+    split_offsets(offsets, num_chunks, num_ranges, range_begin);
+
+    #pragma omp parallel for schedule(static) num_threads(num_ranges)
+    for(int r = 0; r < num_ranges; r++)
+        cusp::system::detail::sequential::spmv_sell(A, range_begin[r], range_begin[r + 1], x, y, initialize, combine, reduce);
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
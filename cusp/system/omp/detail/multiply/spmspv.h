@@ -0,0 +1,268 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/exception.h>
+#include <cusp/multiply.h>
+
+#include <cusp/system/detail/sequential/multiply/spmspv.h>
+#include <cusp/system/omp/detail/utils.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// y = x * A with buckets of bucket_width consecutive output indices. The
+// entries of x are split into chunks with the same number of products and
+// every chunk distributes its products into the buckets. The buckets are
+// then reduced in parallel, each by a single thread, so no output index is
+// written by two threads. Within a bucket the products keep the order of x.
+template <typename VectorType1,
+          typename MatrixType,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmspv_bucket(const VectorType1& x,
+                   const MatrixType& A,
+                   VectorType2& y,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce,
+                   const size_t bucket_width)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    using cusp::system::detail::sequential::spmspv_window;
+
+    const size_t N           = A.num_cols;
+    const size_t num_buckets = (N + bucket_width - 1) / bucket_width;
+    const size_t num_entries = x.num_entries;
+
+    if(num_entries == 0 || N == 0)
+    {
+        y.resize(N, 0);
+        return;
+    }
+
+    // end of the products of every entry of x
+    std::vector<size_t> ends(num_entries);
+
+    #pragma omp parallel for schedule(static)
+    for(int k = 0; k < int(num_entries); k++)
+        ends[k] = A.row_offsets[x.indices[k] + 1] - A.row_offsets[x.indices[k]];
+
+    parallel_inclusive_scan(ends, num_entries);
+
+    const int    num_chunks   = std::max(1, std::min<int>(max_threads(), num_entries));
+    const size_t num_products = ends[num_entries - 1];
+
+    std::vector<size_t> chunk_begin(num_chunks + 1);
+
+    for(int c = 0; c <= num_chunks; c++)
+        chunk_begin[c] = std::upper_bound(ends.begin(), ends.end(), num_products * c / num_chunks) - ends.begin();
+
+    chunk_begin[0] = 0;
+
+    // products of chunk c falling into bucket b, stored bucket-major
+    std::vector<size_t> offsets(num_buckets * num_chunks + 1, 0);
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int c = 0; c < num_chunks; c++)
+    {
+        for(size_t k = chunk_begin[c]; k < chunk_begin[c + 1]; k++)
+        {
+            const IndexType i = x.indices[k];
+
+            for(IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            {
+                const IndexType j = A.column_indices[jj];
+
+                offsets[(j / bucket_width) * num_chunks + c + 1]++;
+            }
+        }
+    }
+
+    for(size_t b = 0; b < num_buckets * num_chunks; b++)
+        offsets[b + 1] += offsets[b];
+
+    std::vector<IndexType> keys(offsets.back());
+    std::vector<ValueType> products(offsets.back());
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int c = 0; c < num_chunks; c++)
+    {
+        std::vector<size_t> positions(num_buckets);
+
+        for(size_t b = 0; b < num_buckets; b++)
+            positions[b] = offsets[b * num_chunks + c];
+
+        for(size_t k = chunk_begin[c]; k < chunk_begin[c + 1]; k++)
+        {
+            const IndexType i  = x.indices[k];
+            const ValueType xi = x.values[k];
+
+            for(IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            {
+                const IndexType j = A.column_indices[jj];
+
+                const size_t p = positions[j / bucket_width]++;
+
+                keys[p]     = j;
+                products[p] = combine(A.values[jj], xi);
+            }
+        }
+    }
+
+    std::vector< std::vector<IndexType> > bucket_indices(num_buckets);
+    std::vector< std::vector<ValueType> > bucket_values(num_buckets);
+
+    #pragma omp parallel
+    {
+        spmspv_window<IndexType,ValueType> window(std::min(bucket_width, N));
+
+        #pragma omp for schedule(dynamic)
+        for(int b = 0; b < int(num_buckets); b++)
+        {
+            const IndexType base = IndexType(b * bucket_width);
+
+            for(size_t p = offsets[b * num_chunks]; p < offsets[(b + 1) * num_chunks]; p++)
+                window.accumulate(IndexType(b), keys[p] - base, products[p], reduce);
+
+            window.flush(IndexType(b), base, std::min(bucket_width, N - base),
+                         bucket_indices[b], bucket_values[b]);
+        }
+    }
+
+    std::vector<size_t> output_offsets(num_buckets + 1, 0);
+
+    for(size_t b = 0; b < num_buckets; b++)
+        output_offsets[b + 1] = output_offsets[b] + bucket_indices[b].size();
+
+    y.resize(N, output_offsets[num_buckets]);
+
+    #pragma omp parallel for schedule(dynamic)
+    for(int b = 0; b < int(num_buckets); b++)
+    {
+        for(size_t k = 0; k < bucket_indices[b].size(); k++)
+        {
+            y.indices[output_offsets[b] + k] = bucket_indices[b][k];
+            y.values[output_offsets[b] + k]  = bucket_values[b][k];
+        }
+    }
+}
+
+template <typename DerivedPolicy,
+          typename VectorType1,
+          typename MatrixType,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void generalized_spmspv(omp::execution_policy<DerivedPolicy>& exec,
+                        const VectorType1& x,
+                        const MatrixType& A,
+                        VectorType2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        cusp::bucket_accumulator,
+                        cusp::sparse_vector_format,
+                        cusp::csr_format,
+                        cusp::sparse_vector_format)
+{
+    using cusp::system::detail::sequential::SPMSPV_BUCKET_WIDTH;
+
+    if(A.num_rows != x.length)
+        throw cusp::invalid_input_exception("matrix and vector dimensions do not match");
+
+    const size_t window_width = (A.num_cols + max_threads() - 1) / max_threads();
+
+    spmspv_bucket(x, A, y, combine, reduce, std::max<size_t>(1, std::min(SPMSPV_BUCKET_WIDTH, window_width)));
+}
+
+// one bucket per thread, every thread reduces its share of the output in
+// a dense window
+template <typename DerivedPolicy,
+          typename VectorType1,
+          typename MatrixType,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void generalized_spmspv(omp::execution_policy<DerivedPolicy>& exec,
+                        const VectorType1& x,
+                        const MatrixType& A,
+                        VectorType2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        cusp::dense_accumulator,
+                        cusp::sparse_vector_format,
+                        cusp::csr_format,
+                        cusp::sparse_vector_format)
+{
+    if(A.num_rows != x.length)
+        throw cusp::invalid_input_exception("matrix and vector dimensions do not match");
+
+    const size_t window_width = (A.num_cols + max_threads() - 1) / max_threads();
+
+    spmspv_bucket(x, A, y, combine, reduce, std::max<size_t>(1, window_width));
+}
+
+template <typename DerivedPolicy,
+          typename VectorType1,
+          typename MatrixType,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void generalized_spmspv(omp::execution_policy<DerivedPolicy>& exec,
+                        const VectorType1& x,
+                        const MatrixType& A,
+                        VectorType2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        cusp::default_accumulator,
+                        cusp::sparse_vector_format,
+                        cusp::csr_format,
+                        cusp::sparse_vector_format)
+{
+    using cusp::system::detail::sequential::SPMSPV_DENSE_FRACTION;
+    using cusp::system::detail::sequential::spmspv_products;
+
+    if(A.num_rows != x.length)
+        throw cusp::invalid_input_exception("matrix and vector dimensions do not match");
+
+    if(spmspv_products(x, A) * SPMSPV_DENSE_FRACTION > A.num_cols)
+        generalized_spmspv(exec, x, A, y, combine, reduce, cusp::dense_accumulator(),
+                           cusp::sparse_vector_format(), cusp::csr_format(), cusp::sparse_vector_format());
+    else
+        generalized_spmspv(exec, x, A, y, combine, reduce, cusp::bucket_accumulator(),
+                           cusp::sparse_vector_format(), cusp::csr_format(), cusp::sparse_vector_format());
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
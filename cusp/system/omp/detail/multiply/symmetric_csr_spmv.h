@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/multiply/symmetric_csr_spmv.h>
+#include <cusp/system/omp/detail/utils.h>
+
+#include <thrust/memory.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// The rows are split into contiguous ranges holding about the same number
+// of stored entries. Every thread computes one range with the sequential
+// kernel, the mirrored products falling into later ranges are accumulated
+// in a private spill array reaching up to the largest column of the range.
+// Afterwards every thread adds the spilled products of the earlier ranges
+// to its own rows, so each entry of y is written by one thread only.
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::symmetric_csr_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const size_t num_rows = A.num_rows;
+
+    if(num_rows == 0)
+        return;
+
+    const int num_ranges = std::min<size_t>(max_threads(), num_rows);
+
+    const IndexType * offsets = thrust::raw_pointer_cast(&A.row_offsets[0]);
+
+    // first row of every range
+    std::vector<size_t> range_begin;
+    split_offsets(offsets, num_rows, num_ranges, range_begin);
+
+    std::vector< std::vector<ValueType> >     spill_values(num_ranges);
+    std::vector< std::vector<unsigned char> > spill_flags(num_ranges);
+
+    #pragma omp parallel for schedule(static) num_threads(num_ranges)
+    for(int r = 0; r < num_ranges; r++)
+    {
+        const size_t row_begin = range_begin[r];
+        const size_t row_end   = range_begin[r + 1];
+
+        // the columns of a row are sorted, its last entry has the largest column
+        size_t spill_size = 0;
+
+        for(size_t i = row_begin; i < row_end; i++)
+            if(offsets[i] < offsets[i + 1])
+                spill_size = std::max<size_t>(spill_size, A.column_indices[offsets[i + 1] - 1] + 1);
+
+        spill_size = spill_size > row_end ? spill_size - row_end : 0;
+
+        spill_values[r].resize(spill_size);
+        spill_flags[r].resize(spill_size, 0);
+
+        cusp::system::detail::sequential::spmv_symmetric_csr(A, row_begin, row_end, x, y,
+                spill_size == 0 ? NULL : &spill_values[r][0],
+                spill_size == 0 ? NULL : &spill_flags[r][0],
+                initialize, combine, reduce);
+    }
+
+    #pragma omp parallel for schedule(static) num_threads(num_ranges)
+    for(int r = 1; r < num_ranges; r++)
+    {
+        const size_t row_begin = range_begin[r];
+        const size_t row_end   = range_begin[r + 1];
+
+        for(int s = 0; s < r; s++)
+        {
+            // the spill array of range s starts at the end of range s
+            const size_t spill_begin = range_begin[s + 1];
+            const size_t spill_end   = spill_begin + spill_values[s].size();
+
+            for(size_t i = std::max(row_begin, spill_begin); i < std::min(row_end, spill_end); i++)
+                if(spill_flags[s][i - spill_begin])
+                    y[i] = reduce(y[i], spill_values[s][i - spill_begin]);
+        }
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
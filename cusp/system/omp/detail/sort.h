@@ -17,9 +17,17 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system inherits sort
-#include <cusp/system/cpp/detail/sort.h>
+#include <cusp/exception.h>
+
+#include <cusp/system/omp/detail/utils.h>
+
+#include <thrust/extrema.h>
+#include <thrust/memory.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace cusp
 {
@@ -30,11 +38,316 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::counting_sort;
-using cusp::system::detail::sequential::counting_sort_by_key;
+// number of bits needed to represent every key in [0, max]
+template <typename IndexType>
+int radix_sort_bits(IndexType max)
+{
+    int num_bits = 0;
+
+    while(max > IndexType(0))
+    {
+        max >>= 1;
+        num_bits++;
+    }
+
+    return num_bits;
+}
+
+// Stable LSD radix sort of the low num_bits bits of keys[0,n), reordering
+// vals along with the keys unless vals is NULL. keys_temp and vals_temp
+// must hold n elements and are used as the alternate buffers.
+//
+// Each pass splits the keys into one chunk per thread. Every chunk
+// histograms its digits, the histograms are scanned in (digit, chunk)
+// order, and every chunk then scatters its keys to its own offsets, so no
+// atomics are needed and equal keys keep their relative order. Passes in
+// which every key has the same digit are skipped.
+template <typename KeyType, typename ValueType>
+void radix_sort_by_key(KeyType * keys, ValueType * vals,
+                       KeyType * keys_temp, ValueType * vals_temp,
+                       const size_t n, const int num_bits)
+{
+    const int RADIX_BITS = 8;
+    const int RADIX      = 1 << RADIX_BITS;
+
+    const int num_chunks = std::min(size_t(max_threads()), n / 4096 + 1);
+
+    KeyType   * keys_begin = keys;
+    ValueType * vals_begin = vals;
+
+    std::vector<size_t> counts(num_chunks * RADIX);
+
+    for(int shift = 0; shift < num_bits; shift += RADIX_BITS)
+    {
+        // histogram the digits of each chunk
+        #pragma omp parallel for schedule(static) num_threads(num_chunks)
+        for(int p = 0; p < num_chunks; p++)
+        {
+            const size_t start = n * p / num_chunks;
+            const size_t end   = n * (p + 1) / num_chunks;
+
+            size_t * histogram = &counts[p * RADIX];
+
+            std::fill(histogram, histogram + RADIX, size_t(0));
+
+            for(size_t i = start; i < end; i++)
+                histogram[(keys[i] >> shift) & (RADIX - 1)]++;
+        }
+
+        // scan the histograms into scatter offsets
+        size_t sum = 0;
+        bool   skip_pass = false;
+
+        for(int digit = 0; digit < RADIX; digit++)
+        {
+            const size_t digit_start = sum;
+
+            for(int p = 0; p < num_chunks; p++)
+            {
+                const size_t count = counts[p * RADIX + digit];
+                counts[p * RADIX + digit] = sum;
+                sum += count;
+            }
+
+            if(sum - digit_start == n)
+                skip_pass = true;
+        }
+
+        if(skip_pass)
+            continue;
+
+        // scatter each chunk to its offsets
+        #pragma omp parallel for schedule(static) num_threads(num_chunks)
+        for(int p = 0; p < num_chunks; p++)
+        {
+            const size_t start = n * p / num_chunks;
+            const size_t end   = n * (p + 1) / num_chunks;
+
+            size_t * offsets = &counts[p * RADIX];
+
+            for(size_t i = start; i < end; i++)
+            {
+                const size_t j = offsets[(keys[i] >> shift) & (RADIX - 1)]++;
+
+                keys_temp[j] = keys[i];
+
+                if(vals != NULL)
+                    vals_temp[j] = vals[i];
+            }
+        }
+
+        std::swap(keys, keys_temp);
+        std::swap(vals, vals_temp);
+    }
+
+    // move the result back to the input buffers
+    if(keys != keys_begin)
+    {
+        #pragma omp parallel for schedule(static)
+        for(int i = 0; i < int(n); i++)
+        {
+            keys_begin[i] = keys[i];
+
+            if(vals != NULL)
+                vals_begin[i] = vals[i];
+        }
+    }
+}
+
+// sort (row,column) pairs packed into a single key of type KeyType,
+// returning the permutation that was applied to the pairs
+template <typename KeyType, typename DerivedPolicy,
+          typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void sort_packed_by_row_and_column(omp::execution_policy<DerivedPolicy>& exec,
+                                   ArrayType1& row_indices, ArrayType2& column_indices,
+                                   ArrayType3& permutation,
+                                   const int row_bits, const int col_bits)
+{
+    typedef typename ArrayType1::value_type IndexType1;
+    typedef typename ArrayType2::value_type IndexType2;
+    typedef typename ArrayType3::value_type PermutationType;
+
+    const size_t  N        = row_indices.size();
+    const KeyType col_mask = (KeyType(1) << col_bits) - 1;
+
+    cusp::detail::temporary_array<KeyType, DerivedPolicy>         keys(exec, N);
+    cusp::detail::temporary_array<KeyType, DerivedPolicy>         keys_temp(exec, N);
+    cusp::detail::temporary_array<PermutationType, DerivedPolicy> permutation_temp(exec, N);
+
+    #pragma omp parallel for schedule(static)
+    for(int i = 0; i < int(N); i++)
+    {
+        keys[i]        = (KeyType(row_indices[i]) << col_bits) | KeyType(column_indices[i]);
+        permutation[i] = i;
+    }
+
+    radix_sort_by_key(thrust::raw_pointer_cast(&keys[0]),
+                      thrust::raw_pointer_cast(&permutation[0]),
+                      thrust::raw_pointer_cast(&keys_temp[0]),
+                      thrust::raw_pointer_cast(&permutation_temp[0]),
+                      N, row_bits + col_bits);
+
+    #pragma omp parallel for schedule(static)
+    for(int i = 0; i < int(N); i++)
+    {
+        row_indices[i]    = IndexType1(keys[i] >> col_bits);
+        column_indices[i] = IndexType2(keys[i] & col_mask);
+    }
+}
+
+template <typename DerivedPolicy, typename ArrayType>
+void counting_sort(omp::execution_policy<DerivedPolicy>& exec,
+                   ArrayType& keys,
+                   typename ArrayType::value_type min,
+                   typename ArrayType::value_type max)
+{
+    typedef typename ArrayType::value_type IndexType;
+
+    if(min < IndexType(0))
+      throw cusp::invalid_input_exception("counting_sort min element less than 0");
+
+    if(max < min)
+      throw cusp::invalid_input_exception("counting_sort min element less than max element");
+
+    const size_t N = keys.size();
+
+    if(N == 0)
+        return;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> temp_keys(exec, N);
+
+    radix_sort_by_key(thrust::raw_pointer_cast(&keys[0]), (IndexType *) NULL,
+                      thrust::raw_pointer_cast(&temp_keys[0]), (IndexType *) NULL,
+                      N, radix_sort_bits(max));
+}
+
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2>
+void counting_sort_by_key(omp::execution_policy<DerivedPolicy>& exec,
+                          ArrayType1& keys, ArrayType2& vals,
+                          typename ArrayType1::value_type min,
+                          typename ArrayType1::value_type max)
+{
+    typedef typename ArrayType1::value_type IndexType1;
+    typedef typename ArrayType2::value_type IndexType2;
+
+    if(min < IndexType1(0))
+      throw cusp::invalid_input_exception("counting_sort min element less than 0");
+
+    if(max < min)
+      throw cusp::invalid_input_exception("counting_sort min element less than max element");
+
+    if(keys.size() < vals.size())
+      throw cusp::invalid_input_exception("counting_sort keys.size() less than vals.size()");
+
+    const size_t N = keys.size();
+
+    if(N == 0)
+        return;
+
+    cusp::detail::temporary_array<IndexType1, DerivedPolicy> temp_keys(exec, N);
+    cusp::detail::temporary_array<IndexType2, DerivedPolicy> temp_vals(exec, N);
+
+    radix_sort_by_key(thrust::raw_pointer_cast(&keys[0]), thrust::raw_pointer_cast(&vals[0]),
+                      thrust::raw_pointer_cast(&temp_keys[0]), thrust::raw_pointer_cast(&temp_vals[0]),
+                      N, radix_sort_bits(max));
+}
+
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void sort_by_row_and_column(omp::execution_policy<DerivedPolicy>& exec,
+                            ArrayType1& row_indices, ArrayType2& column_indices, ArrayType3& values,
+                            typename ArrayType1::value_type min_row,
+                            typename ArrayType1::value_type max_row,
+                            typename ArrayType2::value_type min_col,
+                            typename ArrayType2::value_type max_col)
+{
+    typedef typename ArrayType1::value_type IndexType1;
+    typedef typename ArrayType2::value_type IndexType2;
+    typedef typename ArrayType3::value_type ValueType;
+
+    const size_t N = row_indices.size();
+
+    if(N == 0)
+        return;
+
+    IndexType1 maxr = max_row;
+    IndexType2 maxc = max_col;
+
+    if(maxr == 0)
+        maxr = *thrust::max_element(exec, row_indices.begin(), row_indices.end());
+    if(maxc == 0)
+        maxc = *thrust::max_element(exec, column_indices.begin(), column_indices.end());
+
+    const int row_bits = radix_sort_bits(maxr);
+    const int col_bits = radix_sort_bits(maxc);
+
+    cusp::detail::temporary_array<size_t, DerivedPolicy> permutation(exec, N);
+
+    if(row_bits + col_bits < 32)
+    {
+        sort_packed_by_row_and_column<unsigned int>(exec, row_indices, column_indices, permutation, row_bits, col_bits);
+    }
+    else if(row_bits + col_bits < 64)
+    {
+        sort_packed_by_row_and_column<unsigned long long>(exec, row_indices, column_indices, permutation, row_bits, col_bits);
+    }
+    else
+    {
+        // the indices do not fit in a single key, so sort by column and
+        // then stably by row
+        cusp::detail::temporary_array<IndexType1, DerivedPolicy> rows(exec, N);
+        cusp::detail::temporary_array<IndexType1, DerivedPolicy> rows_temp(exec, N);
+        cusp::detail::temporary_array<IndexType2, DerivedPolicy> cols(exec, N);
+        cusp::detail::temporary_array<IndexType2, DerivedPolicy> cols_temp(exec, N);
+        cusp::detail::temporary_array<size_t, DerivedPolicy>     permutation_temp(exec, N);
+
+        #pragma omp parallel for schedule(static)
+        for(int i = 0; i < int(N); i++)
+        {
+            cols[i]        = column_indices[i];
+            permutation[i] = i;
+        }
+
+        radix_sort_by_key(thrust::raw_pointer_cast(&cols[0]),
+                          thrust::raw_pointer_cast(&permutation[0]),
+                          thrust::raw_pointer_cast(&cols_temp[0]),
+                          thrust::raw_pointer_cast(&permutation_temp[0]),
+                          N, col_bits);
+
+        #pragma omp parallel for schedule(static)
+        for(int i = 0; i < int(N); i++)
+            rows[i] = row_indices[permutation[i]];
+
+        radix_sort_by_key(thrust::raw_pointer_cast(&rows[0]),
+                          thrust::raw_pointer_cast(&permutation[0]),
+                          thrust::raw_pointer_cast(&rows_temp[0]),
+                          thrust::raw_pointer_cast(&permutation_temp[0]),
+                          N, row_bits);
+
+        #pragma omp parallel for schedule(static)
+        for(int i = 0; i < int(N); i++)
+        {
+            row_indices[i] = rows[i];
+            cols_temp[i]   = column_indices[i];
+        }
+
+        #pragma omp parallel for schedule(static)
+        for(int i = 0; i < int(N); i++)
+            column_indices[i] = cols_temp[permutation[i]];
+    }
+
+    // use permutation to reorder the values
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> temp_values(exec, N);
+
+    #pragma omp parallel for schedule(static)
+    for(int i = 0; i < int(N); i++)
+        temp_values[i] = values[i];
+
+    #pragma omp parallel for schedule(static)
+    for(int i = 0; i < int(N); i++)
+        values[i] = temp_values[permutation[i]];
+}
 
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
 } // end namespace cusp
-
@@ -17,9 +17,15 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system inherits transpose
-#include <cusp/system/cpp/detail/transpose.h>
+#include <cusp/system/omp/detail/utils.h>
+
+#include <thrust/fill.h>
+#include <thrust/memory.h>
+
+#include <algorithm>
 
 namespace cusp
 {
@@ -30,10 +36,175 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::transpose;
+// Turns the per-partition column histograms into scatter offsets.
+//
+// On return counts[p * num_cols + c] holds the number of entries of
+// column c in partitions [0,p) and At_row_offsets holds the row offsets
+// of the transpose. Entries of a column are therefore placed in
+// partition order, which keeps the result independent of the number of
+// partitions.
+template <typename Array1, typename Array2>
+void transpose_offsets(Array1& counts, const size_t num_partitions,
+                       const size_t num_cols, Array2& At_row_offsets)
+{
+    typedef typename Array2::value_type IndexType;
+
+    #pragma omp parallel for schedule(static)
+    for(int c = 0; c < int(num_cols); c++)
+    {
+        IndexType sum = 0;
+
+        for(size_t p = 0; p < num_partitions; p++)
+        {
+            const IndexType count = counts[p * num_cols + c];
+            counts[p * num_cols + c] = sum;
+            sum += count;
+        }
+
+        At_row_offsets[c + 1] = sum;
+    }
+
+    At_row_offsets[0] = 0;
+
+    parallel_inclusive_scan(At_row_offsets, num_cols + 1);
+}
+
+// every partition holds a num_cols histogram, so the partition count is
+// limited to keep that storage proportional to the number of entries
+inline size_t transpose_num_partitions(const size_t num_entries, const size_t num_cols)
+{
+    const size_t max_partitions = std::max(size_t(1), 2 * num_entries / (num_cols + 1));
+
+    return std::min(size_t(max_threads()), max_partitions);
+}
+
+// COO format
+template <typename DerivedPolicy, typename MatrixType1, typename MatrixType2>
+void transpose(omp::execution_policy<DerivedPolicy>& exec,
+               const MatrixType1& A, MatrixType2& At,
+               cusp::coo_format, cusp::coo_format)
+{
+    typedef typename MatrixType2::index_type IndexType;
+
+    At.resize(A.num_cols, A.num_rows, A.num_entries);
+
+    if(A.num_entries == 0)
+        return;
+
+    const size_t num_entries    = A.num_entries;
+    const size_t num_cols       = A.num_cols;
+    const size_t num_partitions = transpose_num_partitions(num_entries, num_cols);
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> counts(exec, num_partitions * num_cols, IndexType(0));
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> starting_pos(exec, num_cols + 1);
+
+    // histogram the columns of each partition of entries
+    #pragma omp parallel for schedule(static) num_threads(num_partitions)
+    for(int p = 0; p < int(num_partitions); p++)
+    {
+        const size_t start = num_entries * p / num_partitions;
+        const size_t end   = num_entries * (p + 1) / num_partitions;
+
+        IndexType * histogram = thrust::raw_pointer_cast(&counts[0]) + p * num_cols;
+
+        for(size_t i = start; i < end; i++)
+            histogram[A.column_indices[i]]++;
+    }
+
+    transpose_offsets(counts, num_partitions, num_cols, starting_pos);
+
+    // scatter each partition into place
+    #pragma omp parallel for schedule(static) num_threads(num_partitions)
+    for(int p = 0; p < int(num_partitions); p++)
+    {
+        const size_t start = num_entries * p / num_partitions;
+        const size_t end   = num_entries * (p + 1) / num_partitions;
+
+        IndexType * offsets = thrust::raw_pointer_cast(&counts[0]) + p * num_cols;
+
+        for(size_t i = start; i < end; i++)
+        {
+            IndexType col = A.column_indices[i];
+            IndexType j   = starting_pos[col] + offsets[col]++;
+
+            At.row_indices[j]    = col;
+            At.column_indices[j] = A.row_indices[i];
+            At.values[j]         = A.values[i];
+        }
+    }
+}
+
+// CSR format
+template <typename DerivedPolicy, typename MatrixType1, typename MatrixType2>
+void transpose(omp::execution_policy<DerivedPolicy>& exec,
+               const MatrixType1& A, MatrixType2& At,
+               cusp::csr_format, cusp::csr_format)
+{
+    typedef typename MatrixType1::index_type IndexType1;
+    typedef typename MatrixType2::index_type IndexType;
+
+    At.resize(A.num_cols, A.num_rows, A.num_entries);
+
+    if(A.num_entries == 0)
+    {
+        thrust::fill(exec, At.row_offsets.begin(), At.row_offsets.end(), IndexType(0));
+        return;
+    }
+
+    const size_t num_entries    = A.num_entries;
+    const size_t num_rows       = A.num_rows;
+    const size_t num_cols       = A.num_cols;
+    const size_t num_partitions = transpose_num_partitions(num_entries, num_cols);
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> counts(exec, num_partitions * num_cols, IndexType(0));
+    cusp::detail::temporary_array<size_t, DerivedPolicy>    row_starts(exec, num_partitions + 1);
+
+    // split the rows into partitions with roughly equal numbers of entries
+    #pragma omp parallel for schedule(static) num_threads(num_partitions)
+    for(int p = 0; p < int(num_partitions); p++)
+    {
+        const IndexType1 * row_offsets = thrust::raw_pointer_cast(&A.row_offsets[0]);
+        const IndexType1   target      = num_entries * p / num_partitions;
+
+        row_starts[p] = std::lower_bound(row_offsets, row_offsets + num_rows, target) - row_offsets;
+    }
+
+    row_starts[num_partitions] = num_rows;
+
+    // histogram the columns of each partition of rows
+    #pragma omp parallel for schedule(static) num_threads(num_partitions)
+    for(int p = 0; p < int(num_partitions); p++)
+    {
+        IndexType * histogram = thrust::raw_pointer_cast(&counts[0]) + p * num_cols;
+
+        for(size_t row = row_starts[p]; row < row_starts[p + 1]; row++)
+            for(IndexType1 i = A.row_offsets[row]; i < A.row_offsets[row + 1]; i++)
+                histogram[A.column_indices[i]]++;
+    }
+
+    transpose_offsets(counts, num_partitions, num_cols, At.row_offsets);
+
+    // scatter each partition into place
+    #pragma omp parallel for schedule(static) num_threads(num_partitions)
+    for(int p = 0; p < int(num_partitions); p++)
+    {
+        IndexType * offsets = thrust::raw_pointer_cast(&counts[0]) + p * num_cols;
+
+        for(size_t row = row_starts[p]; row < row_starts[p + 1]; row++)
+        {
+            for(IndexType1 i = A.row_offsets[row]; i < A.row_offsets[row + 1]; i++)
+            {
+                IndexType col = A.column_indices[i];
+                IndexType j   = At.row_offsets[col] + offsets[col]++;
+
+                At.column_indices[j] = row;
+                At.values[j]         = A.values[i];
+            }
+        }
+    }
+}
 
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
 } // end namespace cusp
-
@@ -0,0 +1,164 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// thin wrappers around the OpenMP runtime so that the kernels in this
+// system still compile (and run on a single thread) without -fopenmp
+inline int max_threads(void)
+{
+#if defined(_OPENMP)
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+inline int num_threads(void)
+{
+#if defined(_OPENMP)
+    return omp_get_num_threads();
+#else
+    return 1;
+#endif
+}
+
+inline int thread_num(void)
+{
+#if defined(_OPENMP)
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+// in-place inclusive scan of array[0,n) with one chunk per thread
+template <typename Array>
+void parallel_inclusive_scan(Array& array, const size_t n)
+{
+    typedef typename Array::value_type ValueType;
+
+    const int    num_chunks = max_threads();
+    const size_t chunk_size = (n + num_chunks - 1) / num_chunks;
+
+    std::vector<ValueType> chunk_sums(num_chunks, ValueType(0));
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int p = 0; p < num_chunks; p++)
+    {
+        const size_t start = std::min(chunk_size * p, n);
+        const size_t end   = std::min(start + chunk_size, n);
+
+        ValueType sum = ValueType(0);
+
+        for(size_t i = start; i < end; i++)
+        {
+            sum += array[i];
+            array[i] = sum;
+        }
+
+        chunk_sums[p] = sum;
+    }
+
+    // exclusive scan of the chunk sums
+    ValueType sum = ValueType(0);
+
+    for(int p = 0; p < num_chunks; p++)
+    {
+        const ValueType temp = chunk_sums[p];
+        chunk_sums[p] = sum;
+        sum += temp;
+    }
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int p = 1; p < num_chunks; p++)
+    {
+        const size_t start = std::min(chunk_size * p, n);
+        const size_t end   = std::min(start + chunk_size, n);
+
+        for(size_t i = start; i < end; i++)
+            array[i] += chunk_sums[p];
+    }
+}
+
+// maximum of init and f(i) over i in [0,n), with one chunk per thread.
+// Unlike reduction(max:...) this only needs OpenMP 2.0.
+template <typename ValueType, typename UnaryFunction>
+ValueType parallel_max(const size_t n, const ValueType init, UnaryFunction f)
+{
+    const int    num_chunks = max_threads();
+    const size_t chunk_size = (n + num_chunks - 1) / num_chunks;
+
+    std::vector<ValueType> chunk_max(num_chunks, init);
+
+    #pragma omp parallel for schedule(static) num_threads(num_chunks)
+    for(int p = 0; p < num_chunks; p++)
+    {
+        const size_t start = std::min(chunk_size * p, n);
+        const size_t end   = std::min(start + chunk_size, n);
+
+        ValueType value = init;
+
+        for(size_t i = start; i < end; i++)
+            value = std::max<ValueType>(value, f(i));
+
+        chunk_max[p] = value;
+    }
+
+    return *std::max_element(chunk_max.begin(), chunk_max.end());
+}
+
+// Splits the n segments of an offset array into num_ranges ranges of
+// consecutive segments with about the same number of entries. Range r is
+// [range_begin[r], range_begin[r + 1]), a segment is never split.
+template <typename IndexType>
+void split_offsets(const IndexType * offsets, const size_t n, const int num_ranges,
+                   std::vector<size_t>& range_begin)
+{
+    const size_t num_entries = offsets[n];
+
+    range_begin.resize(num_ranges + 1);
+    range_begin[0] = 0;
+
+    for(int r = 1; r < num_ranges; r++)
+        range_begin[r] = std::lower_bound(offsets, offsets + n, IndexType(num_entries * r / num_ranges)) - offsets;
+
+    range_begin[num_ranges] = n;
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
@@ -43,6 +43,10 @@
 #include <cusp/system/omp/detail/graph/connected_components.h>
 #include <cusp/system/omp/detail/graph/hilbert_curve.h>
 #include <cusp/system/omp/detail/graph/maximal_independent_set.h>
+#include <cusp/system/omp/detail/graph/multi_source_breadth_first_search.h>
+#include <cusp/system/omp/detail/graph/multilevel_partition.h>
+#include <cusp/system/omp/detail/graph/pagerank.h>
 #include <cusp/system/omp/detail/graph/pseudo_peripheral.h>
+#include <cusp/system/omp/detail/graph/single_source_shortest_path.h>
 #include <cusp/system/omp/detail/graph/symmetric_rcm.h>
 #include <cusp/system/omp/detail/graph/vertex_coloring.h>
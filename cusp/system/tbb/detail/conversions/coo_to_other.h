@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/copy.h>
+#include <cusp/format_utils.h>
+
+#include <cusp/system/tbb/detail/conversions/csr_to_other.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(tbb::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::coo_format&,
+        cusp::csr_format&)
+{
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if(src.num_entries == 0) return;
+
+    cusp::indices_to_offsets(exec, src.row_indices, dst.row_offsets);
+    cusp::copy(exec, src.column_indices, dst.column_indices);
+    cusp::copy(exec, src.values,         dst.values);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(tbb::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::coo_format&,
+        cusp::dia_format&,
+        size_t alignment = 32)
+{
+    typedef typename SourceType::index_type IndexType;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_offsets(exec, src.num_rows + 1);
+    cusp::indices_to_offsets(exec, src.row_indices, row_offsets);
+
+    csr_to_dia(exec, src.num_rows, src.num_cols,
+               row_offsets, src.column_indices, src.values,
+               dst, alignment);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(tbb::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::coo_format&,
+        cusp::ell_format&,
+        size_t num_entries_per_row = 0,
+        size_t alignment = 32)
+{
+    typedef typename SourceType::index_type IndexType;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_offsets(exec, src.num_rows + 1);
+    cusp::indices_to_offsets(exec, src.row_indices, row_offsets);
+
+    csr_to_ell(exec, src.num_rows, src.num_cols,
+               row_offsets, src.column_indices, src.values,
+               dst, num_entries_per_row, alignment);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(tbb::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::coo_format&,
+        cusp::hyb_format&,
+        size_t num_entries_per_row = 0,
+        size_t alignment = 32)
+{
+    typedef typename SourceType::index_type IndexType;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_offsets(exec, src.num_rows + 1);
+    cusp::indices_to_offsets(exec, src.row_indices, row_offsets);
+
+    csr_to_hyb(exec, src.num_rows, src.num_cols,
+               row_offsets, src.column_indices, src.values,
+               dst, num_entries_per_row, alignment);
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
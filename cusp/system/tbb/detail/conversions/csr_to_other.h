@@ -0,0 +1,536 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/copy.h>
+#include <cusp/exception.h>
+#include <cusp/format_utils.h>
+
+#include <thrust/count.h>
+#include <thrust/fill.h>
+#include <thrust/scan.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// flags the diagonals occupied by a range of rows, shifted by num_rows.
+// Rows handled by different threads may share a diagonal, so every thread
+// flags its own array and the arrays are merged afterwards.
+template <typename OffsetArray, typename IndexArray>
+struct dia_flag_functor
+{
+    typedef typename OffsetArray::value_type OffsetType;
+
+    typedef ::tbb::enumerable_thread_specific< std::vector<char> > FlagArrays;
+
+    const OffsetArray& row_offsets;
+    const IndexArray&  column_indices;
+    FlagArrays&        flag_arrays;
+
+    const size_t num_rows;
+    const size_t num_diagonals;
+
+    dia_flag_functor(const OffsetArray& row_offsets, const IndexArray& column_indices,
+                     FlagArrays& flag_arrays, const size_t num_rows, const size_t num_diagonals)
+        : row_offsets(row_offsets), column_indices(column_indices),
+          flag_arrays(flag_arrays), num_rows(num_rows), num_diagonals(num_diagonals) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        std::vector<char>& flags = flag_arrays.local();
+
+        if(flags.size() != num_diagonals)
+            flags.assign(num_diagonals, 0);
+
+        for(size_t i = r.begin(); i != r.end(); i++)
+            for(OffsetType jj = row_offsets[i]; jj < row_offsets[i + 1]; jj++)
+                flags[column_indices[jj] + num_rows - i] = 1;
+    }
+};
+
+// merges the flags of every thread into diagonal_map
+template <typename MapArray>
+struct dia_merge_flags_functor
+{
+    typedef typename MapArray::value_type MapType;
+
+    const std::vector<const char *>& flag_arrays;
+    MapArray& diagonal_map;
+
+    dia_merge_flags_functor(const std::vector<const char *>& flag_arrays, MapArray& diagonal_map)
+        : flag_arrays(flag_arrays), diagonal_map(diagonal_map) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t d = r.begin(); d != r.end(); d++)
+        {
+            MapType flag = MapType(0);
+
+            for(size_t t = 0; t < flag_arrays.size() && flag == MapType(0); t++)
+                flag = flag_arrays[t][d] ? MapType(1) : MapType(0);
+
+            diagonal_map[d] = flag;
+        }
+    }
+};
+
+// records the offset of every occupied diagonal once diagonal_map numbers them
+template <typename MapArray, typename DestinationType>
+struct dia_offsets_functor
+{
+    typedef typename DestinationType::index_type IndexType;
+
+    const MapArray&  diagonal_map;
+    DestinationType& dst;
+
+    const size_t num_rows;
+
+    dia_offsets_functor(const MapArray& diagonal_map, DestinationType& dst, const size_t num_rows)
+        : diagonal_map(diagonal_map), dst(dst), num_rows(num_rows) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t d = r.begin(); d != r.end(); d++)
+        {
+            const IndexType previous = (d == 0) ? IndexType(0) : IndexType(diagonal_map[d - 1]);
+
+            if(diagonal_map[d] != previous)
+                dst.diagonal_offsets[previous] = IndexType(d) - IndexType(num_rows);
+        }
+    }
+};
+
+template <typename OffsetArray, typename IndexArray, typename ValueArray,
+          typename MapArray, typename DestinationType>
+struct dia_scatter_functor
+{
+    typedef typename OffsetArray::value_type     OffsetType;
+    typedef typename DestinationType::index_type IndexType;
+
+    const OffsetArray& row_offsets;
+    const IndexArray&  column_indices;
+    const ValueArray&  values;
+    const MapArray&    diagonal_map;
+    DestinationType&   dst;
+
+    const size_t num_rows;
+
+    dia_scatter_functor(const OffsetArray& row_offsets, const IndexArray& column_indices,
+                        const ValueArray& values, const MapArray& diagonal_map,
+                        DestinationType& dst, const size_t num_rows)
+        : row_offsets(row_offsets), column_indices(column_indices), values(values),
+          diagonal_map(diagonal_map), dst(dst), num_rows(num_rows) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        const size_t pitch = dst.values.pitch;
+
+        for(size_t i = r.begin(); i != r.end(); i++)
+        {
+            for(OffsetType jj = row_offsets[i]; jj < row_offsets[i + 1]; jj++)
+            {
+                const IndexType diagonal = diagonal_map[column_indices[jj] + num_rows - i] - 1;
+
+                dst.values.values[diagonal * pitch + i] = values[jj];
+            }
+        }
+    }
+};
+
+// counts the entries of each row that overflow into the COO part of a HYB
+// matrix, stored one past the row
+template <typename OffsetArray, typename CountArray>
+struct hyb_count_functor
+{
+    typedef typename CountArray::value_type CountType;
+
+    const OffsetArray& row_offsets;
+    CountArray&        coo_offsets;
+
+    const size_t num_entries_per_row;
+
+    hyb_count_functor(const OffsetArray& row_offsets, CountArray& coo_offsets,
+                      const size_t num_entries_per_row)
+        : row_offsets(row_offsets), coo_offsets(coo_offsets),
+          num_entries_per_row(num_entries_per_row) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t i = r.begin(); i != r.end(); i++)
+        {
+            const size_t row_length = row_offsets[i + 1] - row_offsets[i];
+
+            coo_offsets[i + 1] = row_length > num_entries_per_row ? CountType(row_length - num_entries_per_row) : CountType(0);
+        }
+    }
+};
+
+// writes each row of the ELL slabs, padding includes the aligned rows
+template <typename OffsetArray, typename IndexArray, typename ValueArray, typename EllType>
+struct ell_fill_functor
+{
+    typedef typename OffsetArray::value_type OffsetType;
+    typedef typename EllType::index_type     IndexType;
+    typedef typename EllType::value_type     ValueType;
+
+    const OffsetArray& row_offsets;
+    const IndexArray&  column_indices;
+    const ValueArray&  values;
+    EllType&           ell;
+
+    const size_t num_rows;
+    const size_t num_entries_per_row;
+
+    ell_fill_functor(const OffsetArray& row_offsets, const IndexArray& column_indices,
+                     const ValueArray& values, EllType& ell,
+                     const size_t num_rows, const size_t num_entries_per_row)
+        : row_offsets(row_offsets), column_indices(column_indices), values(values),
+          ell(ell), num_rows(num_rows), num_entries_per_row(num_entries_per_row) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        const size_t pitch = ell.column_indices.pitch;
+
+        for(size_t i = r.begin(); i != r.end(); i++)
+        {
+            size_t n = 0;
+
+            if(i < num_rows)
+            {
+                for(OffsetType jj = row_offsets[i]; jj < row_offsets[i + 1] && n < num_entries_per_row; jj++, n++)
+                {
+                    ell.column_indices.values[n * pitch + i] = column_indices[jj];
+                    ell.values.values[n * pitch + i]         = values[jj];
+                }
+            }
+
+            for(; n < num_entries_per_row; n++)
+            {
+                ell.column_indices.values[n * pitch + i] = IndexType(-1);
+                ell.values.values[n * pitch + i]         = ValueType(0);
+            }
+        }
+    }
+};
+
+// same as ell_fill_functor, except that the entries that do not fit into the
+// ELL slabs are moved into the COO part at the positions given by coo_offsets
+template <typename OffsetArray, typename IndexArray, typename ValueArray,
+          typename CountArray, typename HybType>
+struct hyb_fill_functor
+{
+    typedef typename OffsetArray::value_type OffsetType;
+    typedef typename HybType::index_type     IndexType;
+    typedef typename HybType::value_type     ValueType;
+    typedef typename CountArray::value_type  CountType;
+
+    const OffsetArray& row_offsets;
+    const IndexArray&  column_indices;
+    const ValueArray&  values;
+    const CountArray&  coo_offsets;
+    HybType&           hyb;
+
+    const size_t num_rows;
+    const size_t num_entries_per_row;
+
+    hyb_fill_functor(const OffsetArray& row_offsets, const IndexArray& column_indices,
+                     const ValueArray& values, const CountArray& coo_offsets, HybType& hyb,
+                     const size_t num_rows, const size_t num_entries_per_row)
+        : row_offsets(row_offsets), column_indices(column_indices), values(values),
+          coo_offsets(coo_offsets), hyb(hyb),
+          num_rows(num_rows), num_entries_per_row(num_entries_per_row) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        const size_t pitch = hyb.ell.column_indices.pitch;
+
+        for(size_t i = r.begin(); i != r.end(); i++)
+        {
+            size_t n = 0;
+
+            if(i < num_rows)
+            {
+                OffsetType jj = row_offsets[i];
+
+                for(; jj < row_offsets[i + 1] && n < num_entries_per_row; jj++, n++)
+                {
+                    hyb.ell.column_indices.values[n * pitch + i] = column_indices[jj];
+                    hyb.ell.values.values[n * pitch + i]         = values[jj];
+                }
+
+                for(CountType k = coo_offsets[i]; jj < row_offsets[i + 1]; jj++, k++)
+                {
+                    hyb.coo.row_indices[k]    = i;
+                    hyb.coo.column_indices[k] = column_indices[jj];
+                    hyb.coo.values[k]         = values[jj];
+                }
+            }
+
+            for(; n < num_entries_per_row; n++)
+            {
+                hyb.ell.column_indices.values[n * pitch + i] = IndexType(-1);
+                hyb.ell.values.values[n * pitch + i]         = ValueType(0);
+            }
+        }
+    }
+};
+
+// The CSR to ELL, DIA and HYB kernels take the compressed rows as separate
+// arrays so the COO conversions can reuse them with computed row offsets.
+
+template <typename DerivedPolicy,
+          typename OffsetArray, typename IndexArray, typename ValueArray,
+          typename DestinationType>
+void csr_to_dia(tbb::execution_policy<DerivedPolicy>& exec,
+                const size_t num_rows, const size_t num_cols,
+                const OffsetArray& row_offsets, const IndexArray& column_indices, const ValueArray& values,
+                DestinationType& dst,
+                size_t alignment)
+{
+    typedef typename DestinationType::index_type  IndexType;
+    typedef typename DestinationType::value_type  ValueType;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy> MapArray;
+
+    const size_t num_entries = column_indices.size();
+
+    if(num_entries == 0)
+    {
+        dst.resize(num_rows, num_cols, num_entries, 0);
+        return;
+    }
+
+    typedef dia_flag_functor<OffsetArray,IndexArray> FlagFunctor;
+
+    typename FlagFunctor::FlagArrays flag_arrays;
+
+    FlagFunctor flag_func(row_offsets, column_indices, flag_arrays, num_rows, num_rows + num_cols);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_rows), flag_func);
+
+    std::vector<const char *> flag_pointers;
+
+    for(typename FlagFunctor::FlagArrays::const_iterator iter = flag_arrays.begin(); iter != flag_arrays.end(); ++iter)
+        flag_pointers.push_back(&(*iter)[0]);
+
+    MapArray diagonal_map(exec, num_rows + num_cols);
+
+    dia_merge_flags_functor<MapArray> merge_func(flag_pointers, diagonal_map);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_rows + num_cols), merge_func);
+
+    // number the occupied diagonals, diagonal d is at diagonal_map[d] - 1
+    thrust::inclusive_scan(exec, diagonal_map.begin(), diagonal_map.end(), diagonal_map.begin());
+
+    const IndexType num_diagonals = diagonal_map[num_rows + num_cols - 1];
+
+    const float max_fill   = 3.0;
+    const float threshold  = 1e6; // 1M entries
+    const float size       = float(num_diagonals) * float(num_rows);
+    const float fill_ratio = size / std::max(1.0f, float(num_entries));
+
+    if (max_fill < fill_ratio && size > threshold)
+        throw cusp::format_conversion_exception("dia_matrix fill-in would exceed maximum tolerance");
+
+    // allocate DIA structure
+    dst.resize(num_rows, num_cols, num_entries, num_diagonals, alignment);
+
+    thrust::fill(exec, dst.values.values.begin(), dst.values.values.end(), ValueType(0));
+
+    dia_offsets_functor<MapArray,DestinationType> offsets_func(diagonal_map, dst, num_rows);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_rows + num_cols), offsets_func);
+
+    dia_scatter_functor<OffsetArray,IndexArray,ValueArray,MapArray,DestinationType>
+        scatter_func(row_offsets, column_indices, values, diagonal_map, dst, num_rows);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_rows), scatter_func);
+}
+
+template <typename DerivedPolicy,
+          typename OffsetArray, typename IndexArray, typename ValueArray,
+          typename DestinationType>
+void csr_to_ell(tbb::execution_policy<DerivedPolicy>& exec,
+                const size_t num_rows, const size_t num_cols,
+                const OffsetArray& row_offsets, const IndexArray& column_indices, const ValueArray& values,
+                DestinationType& dst,
+                size_t num_entries_per_row, size_t alignment)
+{
+    typedef typename DestinationType::value_type  ValueType;
+
+    const size_t num_entries = column_indices.size();
+
+    if(num_entries == 0)
+    {
+        dst.resize(num_rows, num_cols, num_entries, num_entries_per_row);
+        return;
+    }
+
+    if(num_entries_per_row == 0)
+    {
+        const size_t max_entries_per_row = cusp::compute_max_entries_per_row(exec, row_offsets);
+
+        const float max_fill  = 3.0;
+        const float threshold  = 1e6; // 1M entries
+        const float size       = float(max_entries_per_row) * float(num_rows);
+        const float fill_ratio = size / std::max(1.0f, float(num_entries));
+
+        if (max_fill < fill_ratio && size > threshold)
+            throw cusp::format_conversion_exception("ell_matrix fill-in would exceed maximum tolerance");
+
+        num_entries_per_row = max_entries_per_row;
+    }
+    else if(cusp::compute_max_entries_per_row(exec, row_offsets) > num_entries_per_row)
+    {
+        throw cusp::format_conversion_exception("ell_matrix num_entries_per_row is smaller than the longest row");
+    }
+
+    const size_t num_nonzeros = num_entries - thrust::count(exec, values.begin(), values.end(), ValueType(0));
+
+    // allocate output storage
+    dst.resize(num_rows, num_cols, num_nonzeros, num_entries_per_row, alignment);
+
+    ell_fill_functor<OffsetArray,IndexArray,ValueArray,DestinationType>
+        fill_func(row_offsets, column_indices, values, dst, num_rows, num_entries_per_row);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, dst.column_indices.pitch), fill_func);
+}
+
+template <typename DerivedPolicy,
+          typename OffsetArray, typename IndexArray, typename ValueArray,
+          typename DestinationType>
+void csr_to_hyb(tbb::execution_policy<DerivedPolicy>& exec,
+                const size_t num_rows, const size_t num_cols,
+                const OffsetArray& row_offsets, const IndexArray& column_indices, const ValueArray& values,
+                DestinationType& dst,
+                size_t num_entries_per_row, size_t alignment)
+{
+    typedef typename DestinationType::index_type  IndexType;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy> CountArray;
+
+    const size_t num_entries = column_indices.size();
+
+    if(num_entries == 0)
+    {
+        dst.resize(num_rows, num_cols, 0, 0, num_entries_per_row, alignment);
+        return;
+    }
+
+    if(num_entries_per_row == 0)
+    {
+        const float  relative_speed      = 3.0;
+        const size_t breakeven_threshold = 4096;
+
+        num_entries_per_row = cusp::compute_optimal_entries_per_row(exec, row_offsets, relative_speed, breakeven_threshold);
+    }
+
+    CountArray coo_offsets(exec, num_rows + 1);
+
+    coo_offsets[0] = 0;
+
+    hyb_count_functor<OffsetArray,CountArray> count_func(row_offsets, coo_offsets, num_entries_per_row);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_rows), count_func);
+
+    thrust::inclusive_scan(exec, coo_offsets.begin(), coo_offsets.end(), coo_offsets.begin());
+
+    const size_t num_coo_entries = coo_offsets[num_rows];
+    const size_t num_ell_entries = num_entries - num_coo_entries;
+
+    // allocate output storage
+    dst.resize(num_rows, num_cols, num_ell_entries, num_coo_entries, num_entries_per_row, alignment);
+
+    hyb_fill_functor<OffsetArray,IndexArray,ValueArray,CountArray,DestinationType>
+        fill_func(row_offsets, column_indices, values, coo_offsets, dst, num_rows, num_entries_per_row);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, dst.ell.column_indices.pitch), fill_func);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(tbb::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::coo_format&)
+{
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if(src.num_entries == 0) return;
+
+    cusp::offsets_to_indices(exec, src.row_offsets, dst.row_indices);
+    cusp::copy(exec, src.column_indices, dst.column_indices);
+    cusp::copy(exec, src.values,         dst.values);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(tbb::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::dia_format&,
+        size_t alignment = 32)
+{
+    csr_to_dia(exec, src.num_rows, src.num_cols,
+               src.row_offsets, src.column_indices, src.values,
+               dst, alignment);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(tbb::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::ell_format&,
+        size_t num_entries_per_row = 0,
+        size_t alignment = 32)
+{
+    csr_to_ell(exec, src.num_rows, src.num_cols,
+               src.row_offsets, src.column_indices, src.values,
+               dst, num_entries_per_row, alignment);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(tbb::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::hyb_format&,
+        size_t num_entries_per_row = 0,
+        size_t alignment = 32)
+{
+    csr_to_hyb(exec, src.num_rows, src.num_cols,
+               src.row_offsets, src.column_indices, src.values,
+               dst, num_entries_per_row, alignment);
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
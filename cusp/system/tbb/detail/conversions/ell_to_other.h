@@ -0,0 +1,173 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/format_utils.h>
+
+#include <thrust/scan.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// Counts the entries of each row of an ELL matrix with nonzero values into
+// row_offsets[i + 1] or, once the counts have been scanned, gathers them into
+// the CSR arrays described by row_offsets.
+template <typename MatrixType, typename OffsetArray, typename IndexArray, typename ValueArray>
+struct ell_entries_functor
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename MatrixType::value_type  ValueType;
+    typedef typename OffsetArray::value_type OffsetType;
+
+    const MatrixType& src;
+    OffsetArray&      row_offsets;
+    IndexArray&       column_indices;
+    ValueArray&       values;
+
+    const bool gather;
+
+    ell_entries_functor(const MatrixType& src, OffsetArray& row_offsets,
+                       IndexArray& column_indices, ValueArray& values, const bool gather)
+        : src(src), row_offsets(row_offsets), column_indices(column_indices),
+          values(values), gather(gather) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        const size_t num_slots = src.column_indices.num_cols;
+        const size_t pitch     = src.values.pitch;
+
+        for(size_t i = r.begin(); i != r.end(); i++)
+        {
+            if(!gather)
+            {
+                OffsetType count = 0;
+
+                for(size_t n = 0; n < num_slots; n++)
+                    if(src.values.values[n * pitch + i] != ValueType(0))
+                        count++;
+
+                row_offsets[i + 1] = count;
+                continue;
+            }
+
+            OffsetType k = row_offsets[i];
+
+            for(size_t n = 0; n < num_slots; n++)
+            {
+                const ValueType value = src.values.values[n * pitch + i];
+
+                if(value != ValueType(0))
+                {
+                    column_indices[k] = src.column_indices.values[n * pitch + i];
+                    values[k]         = value;
+                    k++;
+                }
+            }
+        }
+    }
+};
+
+template <typename DerivedPolicy, typename SourceType, typename OffsetArray, typename IndexArray, typename ValueArray>
+size_t ell_row_offsets(tbb::execution_policy<DerivedPolicy>& exec,
+                      const SourceType& src, OffsetArray& row_offsets,
+                      IndexArray& column_indices, ValueArray& values)
+{
+    const size_t num_rows = src.num_rows;
+
+    ell_entries_functor<SourceType,OffsetArray,IndexArray,ValueArray>
+        count_func(src, row_offsets, column_indices, values, false);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_rows), count_func);
+
+    row_offsets[0] = 0;
+    thrust::inclusive_scan(exec, row_offsets.begin(), row_offsets.begin() + num_rows + 1, row_offsets.begin());
+
+    return row_offsets[num_rows];
+}
+
+template <typename SourceType, typename OffsetArray, typename IndexArray, typename ValueArray>
+void ell_gather_entries(const SourceType& src, OffsetArray& row_offsets,
+                        IndexArray& column_indices, ValueArray& values)
+{
+    ell_entries_functor<SourceType,OffsetArray,IndexArray,ValueArray>
+        gather_func(src, row_offsets, column_indices, values, true);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, size_t(src.num_rows)), gather_func);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(tbb::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::ell_format&,
+        cusp::coo_format&)
+{
+    typedef typename DestinationType::index_type IndexType;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy> OffsetArray;
+
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if(src.num_entries == 0) return;
+
+    OffsetArray row_offsets(exec, src.num_rows + 1);
+
+    const size_t num_entries = ell_row_offsets(exec, src, row_offsets, dst.column_indices, dst.values);
+
+    if(num_entries != src.num_entries)
+        dst.resize(src.num_rows, src.num_cols, num_entries);
+
+    ell_gather_entries(src, row_offsets, dst.column_indices, dst.values);
+
+    cusp::offsets_to_indices(exec, row_offsets, dst.row_indices);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(tbb::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::ell_format&,
+        cusp::csr_format&)
+{
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if(src.num_entries == 0) return;
+
+    const size_t num_entries = ell_row_offsets(exec, src, dst.row_offsets, dst.column_indices, dst.values);
+
+    if(num_entries != src.num_entries)
+        dst.resize(src.num_rows, src.num_cols, num_entries);
+
+    ell_gather_entries(src, dst.row_offsets, dst.column_indices, dst.values);
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
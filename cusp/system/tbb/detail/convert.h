@@ -18,4 +18,7 @@
 
 #include <cusp/detail/config.h>
 
-// this system has no special version of this algorithm
+#include <cusp/system/tbb/detail/conversions/coo_to_other.h>
+#include <cusp/system/tbb/detail/conversions/csr_to_other.h>
+#include <cusp/system/tbb/detail/conversions/dia_to_other.h>
+#include <cusp/system/tbb/detail/conversions/ell_to_other.h>
@@ -18,5 +18,111 @@
 
 #include <cusp/detail/config.h>
 
-// this system inherits transpose
-#include <cusp/system/cpp/detail/format_utils.h>
+#include <thrust/sort.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+template <typename OffsetArray, typename IndexArray>
+struct offsets_to_indices_functor
+{
+    typedef typename OffsetArray::value_type OffsetType;
+    typedef typename IndexArray::value_type  IndexType;
+
+    const OffsetArray& offsets;
+    IndexArray&        indices;
+
+    offsets_to_indices_functor(const OffsetArray& offsets, IndexArray& indices)
+        : offsets(offsets), indices(indices) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t i = r.begin(); i != r.end(); i++)
+            for(OffsetType j = offsets[i]; j < offsets[i + 1]; j++)
+                indices[j] = IndexType(i);
+    }
+};
+
+// every index fills the offsets of the rows between it and its predecessor
+template <typename IndexArray, typename OffsetArray>
+struct indices_to_offsets_functor
+{
+    typedef typename IndexArray::value_type  IndexType;
+    typedef typename OffsetArray::value_type OffsetType;
+
+    const IndexArray& indices;
+    OffsetArray&      offsets;
+
+    indices_to_offsets_functor(const IndexArray& indices, OffsetArray& offsets)
+        : indices(indices), offsets(offsets) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        const size_t num_indices = indices.size();
+        const size_t num_offsets = offsets.size();
+
+        for(size_t i = r.begin(); i != r.end(); i++)
+        {
+            const IndexType start = (i == 0) ? IndexType(0) : IndexType(indices[i - 1] + 1);
+            const IndexType end   = (i == num_indices) ? IndexType(num_offsets - 1) : IndexType(indices[i]);
+
+            for(IndexType row = start; row <= end; row++)
+                offsets[row] = OffsetType(i);
+        }
+    }
+};
+
+template <typename DerivedPolicy,
+          typename OffsetArray,
+          typename IndexArray>
+void offsets_to_indices(tbb::execution_policy<DerivedPolicy> &exec,
+                        const OffsetArray& offsets,
+                        IndexArray& indices)
+{
+    offsets_to_indices_functor<OffsetArray,IndexArray> func(offsets, indices);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, offsets.size() - 1), func);
+}
+
+// offsets[i] is set to the position of the first index that is not less
+// than i. Sorted indices are converted in parallel, unsorted indices fall
+// back to counting them serially.
+template <typename DerivedPolicy,
+          typename IndexArray,
+          typename OffsetArray>
+void indices_to_offsets(tbb::execution_policy<DerivedPolicy> &exec,
+                        const IndexArray& indices,
+                        OffsetArray& offsets)
+{
+    typedef typename OffsetArray::value_type OffsetType;
+
+    if(!thrust::is_sorted(exec, indices.begin(), indices.end()))
+    {
+        for(size_t i = 0; i < offsets.size(); i++)
+            offsets[i] = OffsetType(0);
+
+        for(size_t i = 0; i < indices.size(); i++)
+            offsets[indices[i] + 1]++;
+
+        for(size_t i = 1; i < offsets.size(); i++)
+            offsets[i] += offsets[i - 1];
+
+        return;
+    }
+
+    indices_to_offsets_functor<IndexArray,OffsetArray> func(indices, offsets);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, indices.size() + 1), func);
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
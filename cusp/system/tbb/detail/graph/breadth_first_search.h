@@ -17,5 +17,450 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system has no special version of this algorithm
+#include <cusp/copy.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/transpose.h>
+
+#include <thrust/fill.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// Direction-optimizing BFS. Small frontiers are expanded top-down, large ones
+// bottom-up: every unvisited vertex looks for a parent among its incoming
+// edges in a bitmap of the frontier. Vertices are split into one range per
+// chunk. A top-down step buckets the discovered vertices by the chunk owning
+// them, and each chunk then claims the vertices of its range, so no vertex is
+// written by two tasks and the search needs no atomics.
+template <typename VertexId>
+struct bfs_state
+{
+    size_t num_vertices;
+    size_t num_chunks;
+
+    std::vector<VertexId> frontier;
+    std::vector<unsigned int> frontier_bits;
+
+    // vertices discovered by chunk s for chunk d, and their parents
+    std::vector< std::vector<VertexId> > bucket_vertices;
+    std::vector< std::vector<VertexId> > bucket_parents;
+
+    // next frontier of each chunk and the edges leaving it
+    std::vector< std::vector<VertexId> > next;
+    std::vector<size_t> next_edges;
+
+    bfs_state(const size_t num_vertices, const size_t num_chunks)
+        : num_vertices(num_vertices), num_chunks(num_chunks),
+          frontier_bits((num_vertices + 31) / 32),
+          bucket_vertices(num_chunks * num_chunks),
+          bucket_parents(num_chunks * num_chunks),
+          next(num_chunks), next_edges(num_chunks) {}
+
+    size_t chunk_begin(const size_t c) const
+    {
+        return num_vertices * c / num_chunks;
+    }
+
+    size_t owner(const VertexId v) const
+    {
+        return size_t(v) * num_chunks / num_vertices;
+    }
+};
+
+// checks for every edge (i,j) in a range of rows that there is an edge
+// (j,i), assumes the column indices of each row are sorted
+template <typename MatrixType>
+struct bfs_symmetric_functor
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const MatrixType& G;
+    std::vector<int>& symmetric;
+
+    const size_t num_chunks;
+
+    bfs_symmetric_functor(const MatrixType& G, std::vector<int>& symmetric, const size_t num_chunks)
+        : G(G), symmetric(symmetric), num_chunks(num_chunks) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t c = r.begin(); c != r.end(); c++)
+        {
+            const size_t start = size_t(G.num_rows) * c / num_chunks;
+            const size_t end   = size_t(G.num_rows) * (c + 1) / num_chunks;
+
+            bool result = true;
+
+            for(size_t i = start; i < end && result; i++)
+            {
+                for(IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1] && result; jj++)
+                {
+                    const IndexType j = G.column_indices[jj];
+
+                    if(j < 0) continue;
+
+                    result = std::binary_search(G.column_indices.begin() + G.row_offsets[j],
+                                                G.column_indices.begin() + G.row_offsets[j + 1],
+                                                IndexType(i));
+                }
+            }
+
+            symmetric[c] = result;
+        }
+    }
+};
+
+// Expands the frontier along the outgoing edges of its vertices into the
+// buckets or, once the buckets are filled, lets each chunk keep the first
+// discovery of every vertex it owns.
+template <typename MatrixType, typename LevelArray, typename ParentArray, typename VertexId>
+struct bfs_top_down_functor
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const MatrixType&     G;
+    LevelArray&           levels;
+    ParentArray&          parents;
+    bfs_state<VertexId>&  state;
+
+    const bool     mark_parents;
+    const VertexId depth;
+    const bool     claim;
+
+    bfs_top_down_functor(const MatrixType& G, LevelArray& levels, ParentArray& parents,
+                         bfs_state<VertexId>& state, const bool mark_parents,
+                         const VertexId depth, const bool claim)
+        : G(G), levels(levels), parents(parents), state(state),
+          mark_parents(mark_parents), depth(depth), claim(claim) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        const size_t num_chunks = state.num_chunks;
+
+        for(size_t c = r.begin(); c != r.end(); c++)
+        {
+            if(claim)
+            {
+                state.next[c].clear();
+
+                for(size_t s = 0; s < num_chunks; s++)
+                {
+                    const std::vector<VertexId>& vertices = state.bucket_vertices[s * num_chunks + c];
+                    const std::vector<VertexId>& sources  = state.bucket_parents[s * num_chunks + c];
+
+                    for(size_t k = 0; k < vertices.size(); k++)
+                    {
+                        const VertexId v = vertices[k];
+
+                        if(levels[v] != -1) continue;
+
+                        levels[v] = depth + 1;
+                        if(mark_parents) parents[v] = sources[k];
+                        state.next[c].push_back(v);
+                    }
+                }
+
+                continue;
+            }
+
+            for(size_t d = 0; d < num_chunks; d++)
+            {
+                state.bucket_vertices[c * num_chunks + d].clear();
+                state.bucket_parents[c * num_chunks + d].clear();
+            }
+
+            const size_t start = state.frontier.size() * c / num_chunks;
+            const size_t end   = state.frontier.size() * (c + 1) / num_chunks;
+
+            for(size_t k = start; k < end; k++)
+            {
+                const VertexId u = state.frontier[k];
+
+                for(IndexType jj = G.row_offsets[u]; jj < G.row_offsets[u + 1]; jj++)
+                {
+                    const VertexId v = G.column_indices[jj];
+
+                    if(v < 0 || levels[v] != -1) continue;
+
+                    const size_t d = state.owner(v);
+
+                    state.bucket_vertices[c * num_chunks + d].push_back(v);
+                    state.bucket_parents[c * num_chunks + d].push_back(u);
+                }
+            }
+        }
+    }
+};
+
+// Searches the incoming edges of every unvisited vertex for a frontier vertex,
+// H holds the incoming edges of each vertex in its rows. Vertices of other
+// chunks are only read through the frontier bitmap, which is built first.
+template <typename MatrixType, typename LevelArray, typename ParentArray, typename VertexId>
+struct bfs_bottom_up_functor
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const MatrixType&     H;
+    LevelArray&           levels;
+    ParentArray&          parents;
+    bfs_state<VertexId>&  state;
+
+    const bool     mark_parents;
+    const VertexId depth;
+    const bool     search;
+
+    bfs_bottom_up_functor(const MatrixType& H, LevelArray& levels, ParentArray& parents,
+                          bfs_state<VertexId>& state, const bool mark_parents,
+                          const VertexId depth, const bool search)
+        : H(H), levels(levels), parents(parents), state(state),
+          mark_parents(mark_parents), depth(depth), search(search) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        const size_t N = state.num_vertices;
+
+        if(!search)
+        {
+            for(size_t w = r.begin(); w != r.end(); w++)
+            {
+                unsigned int bits = 0;
+
+                for(size_t v = w * 32; v < std::min(N, (w + 1) * 32); v++)
+                    if(levels[v] == depth)
+                        bits |= 1u << (v % 32);
+
+                state.frontier_bits[w] = bits;
+            }
+
+            return;
+        }
+
+        for(size_t c = r.begin(); c != r.end(); c++)
+        {
+            state.next[c].clear();
+
+            for(size_t v = state.chunk_begin(c); v < state.chunk_begin(c + 1); v++)
+            {
+                if(levels[v] != -1) continue;
+
+                for(IndexType jj = H.row_offsets[v]; jj < H.row_offsets[v + 1]; jj++)
+                {
+                    const VertexId u = H.column_indices[jj];
+
+                    if(u < 0 || !(state.frontier_bits[u / 32] & (1u << (u % 32)))) continue;
+
+                    levels[v] = depth + 1;
+                    if(mark_parents) parents[v] = u;
+                    state.next[c].push_back(VertexId(v));
+                    break;
+                }
+            }
+        }
+    }
+};
+
+// copies the next frontier of each chunk to its offset in the frontier and
+// counts the edges leaving it
+template <typename MatrixType, typename VertexId>
+struct bfs_frontier_functor
+{
+    const MatrixType&          G;
+    bfs_state<VertexId>&       state;
+    const std::vector<size_t>& offsets;
+
+    bfs_frontier_functor(const MatrixType& G, bfs_state<VertexId>& state, const std::vector<size_t>& offsets)
+        : G(G), state(state), offsets(offsets) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t c = r.begin(); c != r.end(); c++)
+        {
+            size_t edges = 0;
+
+            for(size_t k = 0; k < state.next[c].size(); k++)
+            {
+                const VertexId u = state.next[c][k];
+
+                state.frontier[offsets[c] + k] = u;
+                edges += G.row_offsets[u + 1] - G.row_offsets[u];
+            }
+
+            state.next_edges[c] = edges;
+        }
+    }
+};
+
+template <typename MatrixType>
+bool bfs_has_symmetric_pattern(const MatrixType& G, const size_t num_chunks)
+{
+    std::vector<int> symmetric(num_chunks);
+
+    bfs_symmetric_functor<MatrixType> func(G, symmetric, num_chunks);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_chunks), func);
+
+    return std::find(symmetric.begin(), symmetric.end(), 0) == symmetric.end();
+}
+
+template <typename MatrixType, typename LevelArray, typename ParentArray, typename VertexId>
+void bfs_top_down_step(const MatrixType& G, LevelArray& levels, ParentArray& parents,
+                       const bool mark_parents, const VertexId depth, bfs_state<VertexId>& state)
+{
+    bfs_top_down_functor<MatrixType,LevelArray,ParentArray,VertexId>
+        expand_func(G, levels, parents, state, mark_parents, depth, false);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, state.num_chunks), expand_func);
+
+    bfs_top_down_functor<MatrixType,LevelArray,ParentArray,VertexId>
+        claim_func(G, levels, parents, state, mark_parents, depth, true);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, state.num_chunks), claim_func);
+}
+
+template <typename MatrixType, typename LevelArray, typename ParentArray, typename VertexId>
+void bfs_bottom_up_step(const MatrixType& H, LevelArray& levels, ParentArray& parents,
+                        const bool mark_parents, const VertexId depth, bfs_state<VertexId>& state)
+{
+    bfs_bottom_up_functor<MatrixType,LevelArray,ParentArray,VertexId>
+        bitmap_func(H, levels, parents, state, mark_parents, depth, false);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, state.frontier_bits.size()), bitmap_func);
+
+    bfs_bottom_up_functor<MatrixType,LevelArray,ParentArray,VertexId>
+        search_func(H, levels, parents, state, mark_parents, depth, true);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, state.num_chunks), search_func);
+}
+
+// gathers the next frontier of every chunk and returns the number of edges
+// leaving the new frontier
+template <typename MatrixType, typename VertexId>
+size_t bfs_next_frontier(const MatrixType& G, bfs_state<VertexId>& state)
+{
+    const size_t num_chunks = state.num_chunks;
+
+    std::vector<size_t> offsets(num_chunks + 1, 0);
+
+    for(size_t c = 0; c < num_chunks; c++)
+        offsets[c + 1] = offsets[c] + state.next[c].size();
+
+    state.frontier.resize(offsets[num_chunks]);
+
+    bfs_frontier_functor<MatrixType,VertexId> func(G, state, offsets);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_chunks), func);
+
+    size_t frontier_edges = 0;
+
+    for(size_t c = 0; c < num_chunks; c++)
+        frontier_edges += state.next_edges[c];
+
+    return frontier_edges;
+}
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+void breadth_first_search(tbb::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                          const typename MatrixType::index_type src,
+                          ArrayType& labels,
+                          const bool mark_levels,
+                          cusp::csr_format)
+{
+    typedef typename MatrixType::index_type   VertexId;
+    typedef typename MatrixType::value_type   ValueType;
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    // switch to bottom-up steps when the frontier has more than 1/ALPHA of
+    // the unexplored edges and back when it has fewer than 1/BETA of the
+    // vertices
+    const size_t ALPHA = 14;
+    const size_t BETA  = 24;
+
+    const size_t VERTICES_PER_CHUNK = 16384;
+    const size_t MAX_CHUNKS         = 64;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const size_t N = G.num_rows;
+
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> levels(exec, N, VertexId(-1));
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> parents(exec);
+
+    if(G.num_entries == 0)
+    {
+        cusp::copy(exec, levels, labels);
+        return;
+    }
+
+    if(!mark_levels)
+    {
+        parents.resize(N);
+        thrust::fill(exec, parents.begin(), parents.end(), VertexId(-1));
+        parents[src] = -2;
+    }
+
+    levels[src] = 0;
+
+    const size_t num_chunks = std::min(MAX_CHUNKS, (N + VERTICES_PER_CHUNK - 1) / VERTICES_PER_CHUNK);
+
+    bfs_state<VertexId> state(N, num_chunks);
+    state.frontier.push_back(src);
+
+    // incoming edges for the bottom-up steps, G itself if it is symmetric
+    cusp::csr_matrix<VertexId, ValueType, MemorySpace> Gt;
+    bool has_incoming_edges = false;
+    bool use_transpose      = false;
+
+    size_t frontier_edges   = G.row_offsets[src + 1] - G.row_offsets[src];
+    size_t unexplored_edges = G.num_entries - frontier_edges;
+    bool   bottom_up        = false;
+
+    for(VertexId depth = 0; !state.frontier.empty(); depth++)
+    {
+        if(!bottom_up && frontier_edges > unexplored_edges / ALPHA)
+            bottom_up = true;
+        else if(bottom_up && state.frontier.size() < N / BETA)
+            bottom_up = false;
+
+        if(bottom_up && !has_incoming_edges)
+        {
+            use_transpose = !bfs_has_symmetric_pattern(G, num_chunks);
+
+            if(use_transpose)
+                cusp::transpose(exec, G, Gt);
+
+            has_incoming_edges = true;
+        }
+
+        if(!bottom_up)
+            bfs_top_down_step(G, levels, parents, !mark_levels, depth, state);
+        else if(use_transpose)
+            bfs_bottom_up_step(Gt, levels, parents, !mark_levels, depth, state);
+        else
+            bfs_bottom_up_step(G, levels, parents, !mark_levels, depth, state);
+
+        frontier_edges    = bfs_next_frontier(G, state);
+        unexplored_edges -= std::min(unexplored_edges, frontier_edges);
+    }
+
+    if(mark_levels)
+        cusp::copy(exec, levels, labels);
+    else
+        cusp::copy(exec, parents, labels);
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
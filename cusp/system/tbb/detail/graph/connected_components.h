@@ -17,5 +17,281 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system has no special version of this algorithm
+#include <cusp/exception.h>
+
+#include <thrust/scan.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// Shiloach-Vishkin style components. Every vertex points to the root of its
+// tree, which is always the smallest vertex of the tree. In each round the
+// roots hook onto the smallest root found across their edges and the trees
+// are then flattened by pointer jumping. As in the breadth-first search each
+// chunk owns a range of vertices, the hooks are bucketed by the chunk owning
+// the root, so every write goes to a vertex of the writing chunk.
+template <typename VertexId>
+struct cc_state
+{
+    size_t num_vertices;
+    size_t num_chunks;
+
+    std::vector<VertexId> parents;
+    std::vector<VertexId> next_parents;
+
+    // roots hooked by chunk s for chunk d, and the roots they hook onto
+    std::vector< std::vector<VertexId> > bucket_roots;
+    std::vector< std::vector<VertexId> > bucket_labels;
+
+    // hooks proposed and parents changed by each chunk
+    std::vector<size_t> num_hooks;
+    std::vector<int>    changed;
+
+    cc_state(const size_t num_vertices, const size_t num_chunks)
+        : num_vertices(num_vertices), num_chunks(num_chunks),
+          parents(num_vertices), next_parents(num_vertices),
+          bucket_roots(num_chunks * num_chunks),
+          bucket_labels(num_chunks * num_chunks),
+          num_hooks(num_chunks), changed(num_chunks) {}
+
+    size_t chunk_begin(const size_t c) const
+    {
+        return num_vertices * c / num_chunks;
+    }
+
+    size_t owner(const VertexId v) const
+    {
+        return size_t(v) * num_chunks / num_vertices;
+    }
+};
+
+// Proposes to hook the root of every vertex onto the smallest root among its
+// neighbors or, once the buckets are filled, lets each chunk hook the roots
+// it owns onto the smallest label proposed.
+template <typename MatrixType, typename VertexId>
+struct cc_hook_functor
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const MatrixType&     G;
+    cc_state<VertexId>&   state;
+
+    const bool hook;
+
+    cc_hook_functor(const MatrixType& G, cc_state<VertexId>& state, const bool hook)
+        : G(G), state(state), hook(hook) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        const size_t num_chunks = state.num_chunks;
+
+        for(size_t c = r.begin(); c != r.end(); c++)
+        {
+            if(hook)
+            {
+                for(size_t s = 0; s < num_chunks; s++)
+                {
+                    const std::vector<VertexId>& roots  = state.bucket_roots[s * num_chunks + c];
+                    const std::vector<VertexId>& labels = state.bucket_labels[s * num_chunks + c];
+
+                    for(size_t k = 0; k < roots.size(); k++)
+                        state.parents[roots[k]] = std::min(state.parents[roots[k]], labels[k]);
+                }
+
+                continue;
+            }
+
+            for(size_t d = 0; d < num_chunks; d++)
+            {
+                state.bucket_roots[c * num_chunks + d].clear();
+                state.bucket_labels[c * num_chunks + d].clear();
+            }
+
+            size_t hooks = 0;
+
+            for(size_t u = state.chunk_begin(c); u < state.chunk_begin(c + 1); u++)
+            {
+                const VertexId root = state.parents[u];
+
+                VertexId label = root;
+
+                for(IndexType jj = G.row_offsets[u]; jj < G.row_offsets[u + 1]; jj++)
+                {
+                    const VertexId v = G.column_indices[jj];
+
+                    if(v < 0) continue;
+
+                    label = std::min(label, state.parents[v]);
+                }
+
+                if(label == root) continue;
+
+                const size_t d = state.owner(root);
+
+                state.bucket_roots[c * num_chunks + d].push_back(root);
+                state.bucket_labels[c * num_chunks + d].push_back(label);
+                hooks++;
+            }
+
+            state.num_hooks[c] = hooks;
+        }
+    }
+};
+
+// points every vertex of a chunk to its grandparent
+template <typename VertexId>
+struct cc_jump_functor
+{
+    cc_state<VertexId>& state;
+
+    cc_jump_functor(cc_state<VertexId>& state) : state(state) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t c = r.begin(); c != r.end(); c++)
+        {
+            bool changed = false;
+
+            for(size_t u = state.chunk_begin(c); u < state.chunk_begin(c + 1); u++)
+            {
+                const VertexId parent = state.parents[u];
+                const VertexId grandparent = state.parents[parent];
+
+                state.next_parents[u] = grandparent;
+                changed = changed || (parent != grandparent);
+            }
+
+            state.changed[c] = changed;
+        }
+    }
+};
+
+// Marks the roots of a chunk or, once the marks are scanned, labels every
+// vertex with the index of its root.
+template <typename VertexId, typename IndexArray, typename ArrayType>
+struct cc_label_functor
+{
+    const cc_state<VertexId>& state;
+    IndexArray&               root_index;
+    ArrayType&                components;
+
+    const bool label;
+
+    cc_label_functor(const cc_state<VertexId>& state, IndexArray& root_index,
+                     ArrayType& components, const bool label)
+        : state(state), root_index(root_index), components(components), label(label) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t c = r.begin(); c != r.end(); c++)
+        {
+            for(size_t u = state.chunk_begin(c); u < state.chunk_begin(c + 1); u++)
+            {
+                if(label)
+                    components[u] = root_index[state.parents[u]] - 1;
+                else
+                    root_index[u] = state.parents[u] == VertexId(u) ? 1 : 0;
+            }
+        }
+    }
+};
+
+// hooks every root onto the smallest root adjacent to its tree and returns
+// the number of hooks, assumes every vertex points to its root
+template <typename MatrixType, typename VertexId>
+size_t cc_hook_step(const MatrixType& G, cc_state<VertexId>& state)
+{
+    cc_hook_functor<MatrixType,VertexId> propose_func(G, state, false);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, state.num_chunks), propose_func);
+
+    cc_hook_functor<MatrixType,VertexId> hook_func(G, state, true);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, state.num_chunks), hook_func);
+
+    size_t num_hooks = 0;
+
+    for(size_t c = 0; c < state.num_chunks; c++)
+        num_hooks += state.num_hooks[c];
+
+    return num_hooks;
+}
+
+// points every vertex to the root of its tree
+template <typename VertexId>
+void cc_pointer_jumping(cc_state<VertexId>& state)
+{
+    bool done = false;
+
+    while(!done)
+    {
+        cc_jump_functor<VertexId> func(state);
+        ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, state.num_chunks), func);
+
+        state.parents.swap(state.next_parents);
+        done = std::find(state.changed.begin(), state.changed.end(), 1) == state.changed.end();
+    }
+}
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t connected_components(tbb::execution_policy<DerivedPolicy>& exec,
+                            const MatrixType& G,
+                            ArrayType& components,
+                            cusp::csr_format)
+{
+    typedef typename MatrixType::index_type VertexId;
+    typedef cusp::detail::temporary_array<VertexId, DerivedPolicy> IndexArray;
+
+    const size_t VERTICES_PER_CHUNK = 16384;
+    const size_t MAX_CHUNKS         = 64;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const size_t N = G.num_rows;
+
+    if(N == 0)
+        return 0;
+
+    const size_t num_chunks = std::min(MAX_CHUNKS, (N + VERTICES_PER_CHUNK - 1) / VERTICES_PER_CHUNK);
+
+    cc_state<VertexId> state(N, num_chunks);
+
+    for(size_t u = 0; u < N; u++)
+        state.parents[u] = u;
+
+    while(cc_hook_step(G, state) > 0)
+        cc_pointer_jumping(state);
+
+    // number the components in the order of their smallest vertex, which
+    // matches the order in which a sequential search discovers them
+    IndexArray root_index(exec, N);
+
+    cc_label_functor<VertexId,IndexArray,ArrayType> mark_func(state, root_index, components, false);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_chunks), mark_func);
+
+    thrust::inclusive_scan(exec, root_index.begin(), root_index.end(), root_index.begin());
+
+    cc_label_functor<VertexId,IndexArray,ArrayType> label_func(state, root_index, components, true);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_chunks), label_func);
+
+    return root_index[N - 1];
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
@@ -17,6 +17,71 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system inherits elementwise
 #include <cusp/system/detail/sequential/graph/hilbert_curve.h>
+
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+template <typename Array2d, typename KeyArray>
+struct hilbert_keys_functor
+{
+    const Array2d& coord;
+    KeyArray& keys;
+
+    hilbert_keys_functor(const Array2d& coord, KeyArray& keys)
+        : coord(coord), keys(keys) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        using cusp::system::detail::sequential::detail::HILBERT_BATCH_SIZE;
+
+        const size_t begin = r.begin() * HILBERT_BATCH_SIZE;
+        const size_t end   = std::min<size_t>(coord.num_rows, r.end() * HILBERT_BATCH_SIZE);
+
+        cusp::system::detail::sequential::detail::hilbert_keys(coord, begin, end, keys);
+    }
+};
+
+// computes the keys of batches of points in parallel and sorts them with
+// the parallel sort of the tbb system
+template <typename DerivedPolicy, typename Array2d, typename ArrayType>
+void hilbert_order(tbb::execution_policy<DerivedPolicy>& exec,
+                   const Array2d& coord,
+                   ArrayType& order)
+{
+    using cusp::system::detail::sequential::detail::HILBERT_BATCH_SIZE;
+
+    typedef cusp::detail::temporary_array<unsigned long long, DerivedPolicy> KeyArray;
+
+    const size_t num_points  = coord.num_rows;
+    const size_t num_batches = (num_points + HILBERT_BATCH_SIZE - 1) / HILBERT_BATCH_SIZE;
+
+    KeyArray keys(exec, num_points);
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_batches),
+                        hilbert_keys_functor<Array2d, KeyArray>(coord, keys));
+
+    thrust::sequence(exec, order.begin(), order.end());
+    thrust::sort_by_key(exec, keys.begin(), keys.end(), order.begin());
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
@@ -17,5 +17,184 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system has no special version of this algorithm
+#include <cusp/array1d.h>
+
+#include <thrust/count.h>
+#include <thrust/functional.h>
+#include <thrust/sequence.h>
+#include <thrust/transform.h>
+
+#include <thrust/iterator/constant_iterator.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// Luby style MIS(k). Every vertex is ranked by the tuple (state, random
+// value, index) and undecided vertices that rank highest in their k-ring
+// join the set. This is the algorithm of the generic implementation, with
+// the same random values, so the result does not depend on the number of
+// tasks. Each round reads the states of the previous round only.
+template <typename StateArray, typename RandomArray, typename IndexType>
+bool mis_ranks_higher(const StateArray& states, const RandomArray& values,
+                      const IndexType i, const IndexType j)
+{
+    if(states[i] != states[j]) return states[i] > states[j];
+    if(values[i] != values[j]) return values[i] > values[j];
+    return i > j;
+}
+
+// finds the highest ranked vertex in the neighborhood of every vertex of
+// the previous ring
+template <typename MatrixType, typename StateArray, typename RandomArray, typename IndexArray>
+struct mis_maxima_functor
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const MatrixType&  G;
+    const StateArray&  states;
+    const RandomArray& values;
+    const IndexArray&  last_indices;
+    IndexArray&        maximal_indices;
+
+    mis_maxima_functor(const MatrixType& G, const StateArray& states, const RandomArray& values,
+                       const IndexArray& last_indices, IndexArray& maximal_indices)
+        : G(G), states(states), values(values),
+          last_indices(last_indices), maximal_indices(maximal_indices) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t i = r.begin(); i != r.end(); i++)
+        {
+            IndexType maximal = last_indices[i];
+
+            for(IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+            {
+                const IndexType m = last_indices[G.column_indices[jj]];
+
+                if(mis_ranks_higher(states, values, m, maximal))
+                    maximal = m;
+            }
+
+            maximal_indices[i] = maximal;
+        }
+    }
+};
+
+// local maxima join the set and the undecided vertices in the k-ring of a
+// set vertex leave it
+template <typename StateArray, typename IndexArray>
+struct mis_update_functor
+{
+    typedef typename StateArray::value_type NodeStateType;
+    typedef typename IndexArray::value_type IndexType;
+
+    const StateArray& states;
+    const IndexArray& maximal_indices;
+    StateArray&       next_states;
+
+    mis_update_functor(const StateArray& states, const IndexArray& maximal_indices, StateArray& next_states)
+        : states(states), maximal_indices(maximal_indices), next_states(next_states) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        // states of the vertices
+        const NodeStateType NON_MIS_NODE = 0;
+        const NodeStateType UNDECIDED    = 1;
+        const NodeStateType MIS_NODE     = 2;
+
+        for(size_t i = r.begin(); i != r.end(); i++)
+        {
+            NodeStateType state = states[i];
+
+            if(state == UNDECIDED)
+            {
+                const IndexType m = maximal_indices[i];
+
+                if(m == IndexType(i))
+                    state = MIS_NODE;
+                else if(states[m] == MIS_NODE || (states[m] == UNDECIDED && maximal_indices[m] == m))
+                    state = NON_MIS_NODE;
+            }
+
+            next_states[i] = state;
+        }
+    }
+};
+
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t maximal_independent_set(tbb::execution_policy<DerivedPolicy>& exec,
+                               const MatrixType& G,
+                               ArrayType& stencil,
+                               const size_t k,
+                               cusp::csr_format)
+{
+    typedef typename MatrixType::index_type                             IndexType;
+    typedef unsigned int                                                RandomType;
+    typedef unsigned char                                               NodeStateType;
+    typedef cusp::random_array<RandomType>                              RandomArray;
+    typedef cusp::detail::temporary_array<NodeStateType, DerivedPolicy> StateArray;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy>     IndexArray;
+
+    const NodeStateType UNDECIDED = 1;
+    const NodeStateType MIS_NODE  = 2;
+
+    const size_t N = G.num_rows;
+
+    RandomArray values(N);
+
+    StateArray states(exec, N, UNDECIDED);
+    StateArray next_states(exec, N);
+
+    IndexArray maximal_indices(exec, N);
+    IndexArray last_indices(exec, N);
+
+    size_t active_nodes = N;
+
+    while(active_nodes > 0)
+    {
+        // find the highest ranked vertex in the k-ring of every vertex
+        thrust::sequence(exec, maximal_indices.begin(), maximal_indices.end());
+
+        for(size_t ring = 0; ring < k; ring++)
+        {
+            maximal_indices.swap(last_indices);
+
+            mis_maxima_functor<MatrixType,StateArray,RandomArray,IndexArray>
+                maxima_func(G, states, values, last_indices, maximal_indices);
+            ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, N), maxima_func);
+        }
+
+        mis_update_functor<StateArray,IndexArray> update_func(states, maximal_indices, next_states);
+        ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, N), update_func);
+
+        states.swap(next_states);
+
+        active_nodes = thrust::count(exec, states.begin(), states.end(), UNDECIDED);
+    }
+
+    // write output
+    stencil.resize(N);
+
+    thrust::transform(exec, states.begin(), states.end(),
+                      thrust::constant_iterator<NodeStateType>(MIS_NODE),
+                      stencil.begin(), thrust::equal_to<NodeStateType>());
+
+    return thrust::count(exec, stencil.begin(), stencil.end(), typename ArrayType::value_type(true));
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
@@ -17,5 +17,365 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system has no special version of this algorithm
+#include <cusp/array1d.h>
+#include <cusp/exception.h>
+
+#include <thrust/copy.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// Jones-Plassmann coloring. Vertices are ranked by a random value and their
+// index, and in every round each uncolored vertex without an uncolored
+// higher ranked neighbor takes the smallest color its neighbors do not use.
+// These vertices are independent, so they are colored at once from the
+// colors of the previous rounds and the result does not depend on the
+// number of tasks.
+template <typename IndexType>
+struct vc_state
+{
+    size_t num_vertices;
+    size_t num_chunks;
+
+    // uncolored vertices and the colors chosen for them in this round
+    std::vector<IndexType> active;
+    std::vector<IndexType> chosen;
+
+    // uncolored vertices left by each chunk and the largest color it set
+    std::vector< std::vector<IndexType> > next;
+    std::vector<IndexType> max_colors;
+
+    // color class sizes counted by each chunk
+    std::vector<size_t> chunk_sizes;
+
+    // vertices that may move to a color class and the moves kept by each chunk
+    std::vector<char> candidates;
+    std::vector< std::vector<IndexType> > moves;
+
+    vc_state(const size_t num_vertices, const size_t num_chunks)
+        : num_vertices(num_vertices), num_chunks(num_chunks),
+          active(num_vertices), next(num_chunks), max_colors(num_chunks, IndexType(-1)),
+          moves(num_chunks) {}
+
+    size_t chunk_begin(const size_t c) const
+    {
+        return num_vertices * c / num_chunks;
+    }
+
+    size_t active_begin(const size_t c) const
+    {
+        return active.size() * c / num_chunks;
+    }
+};
+
+template <typename RandomArray, typename IndexType>
+bool vc_ranks_higher(const RandomArray& values, const IndexType i, const IndexType j)
+{
+    if(values[i] != values[j]) return values[i] > values[j];
+    return i > j;
+}
+
+// Chooses a color for the active vertices that are ready or, once the
+// colors are chosen, sets them and collects the remaining vertices.
+template <typename MatrixType, typename RandomArray, typename ColorArray, typename IndexType>
+struct vc_coloring_functor
+{
+    const MatrixType&    G;
+    const RandomArray&   values;
+    ColorArray&          colors;
+    vc_state<IndexType>& state;
+
+    const bool commit;
+
+    vc_coloring_functor(const MatrixType& G, const RandomArray& values, ColorArray& colors,
+                        vc_state<IndexType>& state, const bool commit)
+        : G(G), values(values), colors(colors), state(state), commit(commit) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t c = r.begin(); c != r.end(); c++)
+        {
+            if(commit)
+            {
+                state.next[c].clear();
+
+                for(size_t k = state.active_begin(c); k < state.active_begin(c + 1); k++)
+                {
+                    if(state.chosen[k] == -1)
+                    {
+                        state.next[c].push_back(state.active[k]);
+                    }
+                    else
+                    {
+                        colors[state.active[k]] = state.chosen[k];
+                        state.max_colors[c] = std::max(state.max_colors[c], state.chosen[k]);
+                    }
+                }
+
+                continue;
+            }
+
+            // the last vertex to mark each color as used
+            std::vector<IndexType> mark;
+
+            for(size_t k = state.active_begin(c); k < state.active_begin(c + 1); k++)
+            {
+                const IndexType v = state.active[k];
+
+                bool ready = true;
+
+                for(IndexType jj = G.row_offsets[v]; jj < G.row_offsets[v + 1] && ready; jj++)
+                {
+                    const IndexType u = G.column_indices[jj];
+
+                    if(u == v) continue;
+
+                    if(colors[u] == -1)
+                    {
+                        ready = vc_ranks_higher(values, v, u);
+                    }
+                    else
+                    {
+                        if(size_t(colors[u]) >= mark.size())
+                            mark.resize(colors[u] + 1, IndexType(-1));
+
+                        mark[colors[u]] = v;
+                    }
+                }
+
+                IndexType color = -1;
+
+                if(ready)
+                {
+                    color = 0;
+                    while(size_t(color) < mark.size() && mark[color] == v)
+                        color++;
+                }
+
+                state.chosen[k] = color;
+            }
+        }
+    }
+};
+
+// counts the vertices of each color in every chunk
+template <typename ColorArray, typename IndexType>
+struct vc_sizes_functor
+{
+    const ColorArray&    colors;
+    vc_state<IndexType>& state;
+
+    const size_t num_colors;
+
+    vc_sizes_functor(const ColorArray& colors, vc_state<IndexType>& state, const size_t num_colors)
+        : colors(colors), state(state), num_colors(num_colors) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t c = r.begin(); c != r.end(); c++)
+            for(size_t v = state.chunk_begin(c); v < state.chunk_begin(c + 1); v++)
+                state.chunk_sizes[c * num_colors + colors[v]]++;
+    }
+};
+
+// Marks the vertices of classes above the target size that have no neighbor
+// in the target class or, once they are marked, keeps the marked vertices
+// that rank highest among their marked neighbors.
+template <typename MatrixType, typename RandomArray, typename ColorArray, typename IndexType>
+struct vc_balance_functor
+{
+    const MatrixType&          G;
+    const RandomArray&         values;
+    const ColorArray&          colors;
+    const std::vector<size_t>& sizes;
+    vc_state<IndexType>&       state;
+
+    const size_t target;
+    const size_t target_color;
+    const bool   select;
+
+    vc_balance_functor(const MatrixType& G, const RandomArray& values, const ColorArray& colors,
+                       const std::vector<size_t>& sizes, vc_state<IndexType>& state,
+                       const size_t target, const size_t target_color, const bool select)
+        : G(G), values(values), colors(colors), sizes(sizes), state(state),
+          target(target), target_color(target_color), select(select) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t c = r.begin(); c != r.end(); c++)
+        {
+            if(select)
+                state.moves[c].clear();
+
+            for(size_t v = state.chunk_begin(c); v < state.chunk_begin(c + 1); v++)
+            {
+                if(!select)
+                {
+                    bool candidate = sizes[colors[v]] > target;
+
+                    for(IndexType jj = G.row_offsets[v]; jj < G.row_offsets[v + 1] && candidate; jj++)
+                        candidate = size_t(colors[G.column_indices[jj]]) != target_color;
+
+                    state.candidates[v] = candidate;
+
+                    continue;
+                }
+
+                if(!state.candidates[v]) continue;
+
+                bool highest = true;
+
+                for(IndexType jj = G.row_offsets[v]; jj < G.row_offsets[v + 1] && highest; jj++)
+                {
+                    const IndexType u = G.column_indices[jj];
+
+                    if(u != IndexType(v) && state.candidates[u])
+                        highest = vc_ranks_higher(values, IndexType(v), u);
+                }
+
+                if(highest)
+                    state.moves[c].push_back(v);
+            }
+        }
+    }
+};
+
+// Moves vertices of classes above the average size to classes below it. The
+// classes are filled one at a time and the moves are applied in vertex order
+// until the class is full or no vertex can move to it.
+template <typename MatrixType, typename RandomArray, typename ColorArray, typename IndexType>
+void vc_balance_colors(const MatrixType& G, const RandomArray& values, ColorArray& colors,
+                       const size_t num_colors, vc_state<IndexType>& state)
+{
+    const size_t N = state.num_vertices;
+    const size_t num_chunks = state.num_chunks;
+    const size_t target = (N + num_colors - 1) / num_colors;
+
+    state.chunk_sizes.resize(num_chunks * num_colors, 0);
+
+    vc_sizes_functor<ColorArray,IndexType> sizes_func(colors, state, num_colors);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_chunks), sizes_func);
+
+    std::vector<size_t> sizes(num_colors, 0);
+
+    for(size_t c = 0; c < num_chunks; c++)
+        for(size_t color = 0; color < num_colors; color++)
+            sizes[color] += state.chunk_sizes[c * num_colors + color];
+
+    state.candidates.resize(N);
+
+    for(size_t target_color = 0; target_color < num_colors; target_color++)
+    {
+        bool moved = true;
+
+        while(moved && sizes[target_color] < target)
+        {
+            vc_balance_functor<MatrixType,RandomArray,ColorArray,IndexType>
+                candidate_func(G, values, colors, sizes, state, target, target_color, false);
+            ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_chunks), candidate_func);
+
+            vc_balance_functor<MatrixType,RandomArray,ColorArray,IndexType>
+                select_func(G, values, colors, sizes, state, target, target_color, true);
+            ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_chunks), select_func);
+
+            moved = false;
+
+            for(size_t c = 0; c < num_chunks && sizes[target_color] < target; c++)
+            {
+                for(size_t k = 0; k < state.moves[c].size() && sizes[target_color] < target; k++)
+                {
+                    const IndexType v = state.moves[c][k];
+                    const size_t color = colors[v];
+
+                    if(sizes[color] <= target) continue;
+
+                    colors[v] = target_color;
+                    sizes[color]--;
+                    sizes[target_color]++;
+                    moved = true;
+                }
+            }
+        }
+    }
+}
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t vertex_coloring(tbb::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       ArrayType& colors,
+                       const bool balance,
+                       cusp::csr_format)
+{
+    typedef typename MatrixType::index_type                         IndexType;
+    typedef unsigned int                                            RandomType;
+    typedef cusp::random_array<RandomType>                          RandomArray;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy> ColorArray;
+
+    const size_t VERTICES_PER_CHUNK = 16384;
+    const size_t MAX_CHUNKS         = 64;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const size_t N = G.num_rows;
+
+    if(N == 0)
+        return 0;
+
+    const size_t num_chunks = std::min(MAX_CHUNKS, (N + VERTICES_PER_CHUNK - 1) / VERTICES_PER_CHUNK);
+
+    RandomArray values(N);
+    ColorArray vertex_colors(exec, N, IndexType(-1));
+
+    vc_state<IndexType> state(N, num_chunks);
+
+    for(size_t v = 0; v < N; v++)
+        state.active[v] = v;
+
+    while(!state.active.empty())
+    {
+        state.chosen.resize(state.active.size());
+
+        vc_coloring_functor<MatrixType,RandomArray,ColorArray,IndexType>
+            choose_func(G, values, vertex_colors, state, false);
+        ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_chunks), choose_func);
+
+        vc_coloring_functor<MatrixType,RandomArray,ColorArray,IndexType>
+            commit_func(G, values, vertex_colors, state, true);
+        ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_chunks), commit_func);
+
+        state.active.clear();
+
+        for(size_t c = 0; c < num_chunks; c++)
+            state.active.insert(state.active.end(), state.next[c].begin(), state.next[c].end());
+    }
+
+    const size_t num_colors = *std::max_element(state.max_colors.begin(), state.max_colors.end()) + 1;
+
+    if(balance && num_colors > 1)
+        vc_balance_colors(G, values, vertex_colors, num_colors, state);
+
+    thrust::copy(exec, vertex_colors.begin(), vertex_colors.end(), colors.begin());
+
+    return num_colors;
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
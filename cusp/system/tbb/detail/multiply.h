@@ -18,5 +18,28 @@
 
 #include <cusp/detail/config.h>
 
+#include <cusp/system/tbb/detail/multiply/coo_spmv.h>
+#include <cusp/system/tbb/detail/multiply/csr_spmv.h>
+#include <cusp/system/tbb/detail/multiply/hyb_spmv.h>
+
+#include <cusp/system/tbb/detail/multiply/csr_spgemm.h>
+
 // this system inherits multiply
 #include <cusp/system/cpp/detail/multiply.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+using cusp::system::detail::sequential::multiply;
+using cusp::system::detail::sequential::generalized_spmspv;
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
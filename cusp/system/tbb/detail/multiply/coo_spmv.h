@@ -0,0 +1,190 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+template <typename VectorType, typename UnaryFunction>
+struct initialize_functor
+{
+    VectorType&   y;
+    UnaryFunction initialize;
+
+    initialize_functor(VectorType& y, UnaryFunction initialize)
+        : y(y), initialize(initialize) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t i = r.begin(); i != r.end(); i++)
+            y[i] = initialize(y[i]);
+    }
+};
+
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2,
+          typename IndexArray,
+          typename ValueArray>
+struct coo_segmented_spmv_functor
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const MatrixType&  A;
+    const VectorType1& x;
+    VectorType2&       y;
+
+    BinaryFunction1 combine;
+    BinaryFunction2 reduce;
+
+    const size_t entries_per_partition;
+
+    IndexArray& carry_rows;
+    ValueArray& carry_values;
+
+    coo_segmented_spmv_functor(const MatrixType& A, const VectorType1& x, VectorType2& y,
+                               BinaryFunction1 combine, BinaryFunction2 reduce,
+                               const size_t entries_per_partition,
+                               IndexArray& carry_rows, ValueArray& carry_values)
+        : A(A), x(x), y(y), combine(combine), reduce(reduce),
+          entries_per_partition(entries_per_partition),
+          carry_rows(carry_rows), carry_values(carry_values) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        const size_t num_entries = A.num_entries;
+
+        for(size_t p = r.begin(); p != r.end(); p++)
+        {
+            const size_t start = std::min(entries_per_partition * p, num_entries);
+            const size_t end   = std::min(start + entries_per_partition, num_entries);
+
+            carry_rows[p] = A.num_rows;
+
+            size_t n = start;
+            bool first_row = true;
+
+            while(n < end)
+            {
+                const IndexType row = A.row_indices[n];
+
+                ValueType accumulator = combine(A.values[n], x[A.column_indices[n]]);
+
+                for(n++; n < end && A.row_indices[n] == row; n++)
+                {
+                    const IndexType j   = A.column_indices[n];
+                    const ValueType Aij = A.values[n];
+                    const ValueType xj  = x[j];
+
+                    accumulator = reduce(accumulator, combine(Aij, xj));
+                }
+
+                // the first row of the partition may have started in a preceding
+                // partition, all subsequent rows are owned by this partition
+                if(first_row)
+                {
+                    carry_rows[p]   = row;
+                    carry_values[p] = accumulator;
+                    first_row       = false;
+                }
+                else
+                {
+                    y[row] = reduce(y[row], accumulator);
+                }
+            }
+        }
+    }
+};
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(tbb::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::coo_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy> IndexArray;
+    typedef cusp::detail::temporary_array<ValueType, DerivedPolicy> ValueArray;
+
+    const size_t ENTRIES_PER_PARTITION = 4096;
+
+    const IndexType num_rows    = A.num_rows;
+    const size_t    num_entries = A.num_entries;
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_rows),
+                        initialize_functor<VectorType2,UnaryFunction>(y, initialize));
+
+    if(num_entries == 0)
+        return;
+
+    // segmented reduction over the row-sorted entries
+    const size_t num_partitions = (num_entries + ENTRIES_PER_PARTITION - 1) / ENTRIES_PER_PARTITION;
+
+    IndexArray carry_rows(exec, num_partitions);
+    ValueArray carry_values(exec, num_partitions);
+
+    coo_segmented_spmv_functor<MatrixType,VectorType1,VectorType2,BinaryFunction1,BinaryFunction2,IndexArray,ValueArray>
+      functor(A, x, y, combine, reduce, ENTRIES_PER_PARTITION, carry_rows, carry_values);
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_partitions), functor);
+
+    // fix-up rows which span multiple partitions
+    for(size_t p = 0; p < num_partitions; p++)
+    {
+        const IndexType row = carry_rows[p];
+
+        if(row < num_rows)
+            y[row] = reduce(y[row], carry_values[p]);
+    }
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,248 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/system/detail/sequential/multiply/spgemm_accumulator.h>
+
+#include <thrust/memory.h>
+#include <thrust/scan.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// upper bound on the number of products formed by each row of C, plus
+// one so that empty rows still carry some weight
+template <typename MatrixType1, typename MatrixType2, typename Array>
+struct spgemm_row_work_functor
+{
+    typedef typename MatrixType1::index_type IndexType;
+
+    const MatrixType1& A;
+    const MatrixType2& B;
+    Array& row_work;
+
+    spgemm_row_work_functor(const MatrixType1& A, const MatrixType2& B, Array& row_work)
+        : A(A), B(B), row_work(row_work) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t i = r.begin(); i != r.end(); i++)
+        {
+            size_t work = 1;
+
+            for(IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            {
+                const IndexType j = A.column_indices[jj];
+                work += B.row_offsets[j + 1] - B.row_offsets[j];
+            }
+
+            row_work[i + 1] = work;
+        }
+    }
+};
+
+// count the nonzeros of the rows of C in a range of partitions, the
+// accumulators only record keys
+template <typename MatrixType1, typename MatrixType2, typename Array1, typename Array2>
+struct spgemm_symbolic_functor
+{
+    typedef typename Array2::value_type IndexType;
+
+    typedef cusp::system::detail::sequential::spgemm_accumulator<IndexType,char> Accumulator;
+    typedef ::tbb::enumerable_thread_specific<Accumulator>                      AccumulatorArray;
+
+    const MatrixType1& A;
+    const MatrixType2& B;
+    const Array1& partition_offsets;
+    Array2& C_row_offsets;
+    AccumulatorArray& accumulators;
+
+    spgemm_symbolic_functor(const MatrixType1& A, const MatrixType2& B,
+                            const Array1& partition_offsets, Array2& C_row_offsets,
+                            AccumulatorArray& accumulators)
+        : A(A), B(B), partition_offsets(partition_offsets),
+          C_row_offsets(C_row_offsets), accumulators(accumulators) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        Accumulator& accumulator = accumulators.local();
+
+        for(size_t i = partition_offsets[r.begin()]; i < size_t(partition_offsets[r.end()]); i++)
+        {
+            C_row_offsets[i + 1] =
+                cusp::system::detail::sequential::spgemm_csr_row_nonzeros(i, A.row_offsets, A.column_indices,
+                                                                          B.row_offsets, B.column_indices,
+                                                                          accumulator);
+        }
+    }
+};
+
+// compute the rows of C in a range of partitions, every row is emitted
+// in order of increasing column
+template <typename MatrixType1, typename MatrixType2, typename MatrixType3, typename Array,
+          typename UnaryFunction, typename BinaryFunction1, typename BinaryFunction2>
+struct spgemm_numeric_functor
+{
+    typedef typename MatrixType3::index_type IndexType;
+    typedef typename MatrixType3::value_type ValueType;
+
+    typedef cusp::system::detail::sequential::spgemm_accumulator<IndexType,ValueType> Accumulator;
+    typedef ::tbb::enumerable_thread_specific<Accumulator>                           AccumulatorArray;
+
+    const MatrixType1& A;
+    const MatrixType2& B;
+    MatrixType3& C;
+    const Array& partition_offsets;
+    AccumulatorArray& accumulators;
+
+    UnaryFunction   initialize;
+    BinaryFunction1 combine;
+    BinaryFunction2 reduce;
+
+    spgemm_numeric_functor(const MatrixType1& A, const MatrixType2& B, MatrixType3& C,
+                           const Array& partition_offsets, AccumulatorArray& accumulators,
+                           UnaryFunction initialize, BinaryFunction1 combine, BinaryFunction2 reduce)
+        : A(A), B(B), C(C), partition_offsets(partition_offsets), accumulators(accumulators),
+          initialize(initialize), combine(combine), reduce(reduce) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        Accumulator& accumulator = accumulators.local();
+
+        IndexType * C_columns = thrust::raw_pointer_cast(&C.column_indices[0]);
+
+        for(size_t i = partition_offsets[r.begin()]; i < size_t(partition_offsets[r.end()]); i++)
+        {
+            cusp::system::detail::sequential::spgemm_csr_row(i, A.row_offsets, A.column_indices, A.values,
+                                                             B.row_offsets, B.column_indices, B.values,
+                                                             IndexType(C.row_offsets[i]), C_columns, C.values,
+                                                             initialize, combine, reduce, accumulator);
+        }
+    }
+};
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(tbb::execution_policy<DerivedPolicy>& exec,
+              const MatrixType1& A,
+              const MatrixType2& B,
+              MatrixType3& C,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::csr_format,
+              cusp::csr_format,
+              cusp::csr_format)
+{
+    typedef cusp::detail::temporary_array<size_t, DerivedPolicy> WorkArray;
+
+    const size_t WORK_PER_PARTITION = 8192;
+
+    const size_t num_rows = A.num_rows;
+
+    C.resize(A.num_rows, B.num_cols, 0);
+
+    if(num_rows == 0)
+        return;
+
+    // weight every row by its upper bound on the number of products
+    WorkArray row_work(exec, num_rows + 1);
+    row_work[0] = 0;
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_rows),
+                        spgemm_row_work_functor<MatrixType1,MatrixType2,WorkArray>(A, B, row_work));
+
+    thrust::inclusive_scan(exec, row_work.begin(), row_work.end(), row_work.begin());
+
+    // cut the rows into partitions of roughly equal work
+    const size_t total_work     = row_work[num_rows];
+    const size_t num_partitions = (total_work + WORK_PER_PARTITION - 1) / WORK_PER_PARTITION;
+
+    WorkArray partition_offsets(exec, num_partitions + 1);
+
+    for(size_t p = 0; p < num_partitions; p++)
+    {
+        const size_t target = p * WORK_PER_PARTITION;
+
+        size_t lo = 0;
+        size_t hi = num_rows;
+
+        while(lo < hi)
+        {
+            const size_t pivot = lo + (hi - lo) / 2;
+
+            if(size_t(row_work[pivot]) < target)
+                lo = pivot + 1;
+            else
+                hi = pivot;
+        }
+
+        partition_offsets[p] = lo;
+    }
+
+    partition_offsets[num_partitions] = num_rows;
+
+    // count the nonzeros of every row of C
+    typedef spgemm_symbolic_functor<MatrixType1,MatrixType2,WorkArray,typename MatrixType3::row_offsets_array_type> SymbolicFunctor;
+
+    typename SymbolicFunctor::AccumulatorArray symbolic_accumulators(typename SymbolicFunctor::Accumulator(B.num_cols, false));
+
+    C.row_offsets[0] = 0;
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_partitions),
+                        SymbolicFunctor(A, B, partition_offsets, C.row_offsets, symbolic_accumulators));
+
+    thrust::inclusive_scan(exec, C.row_offsets.begin(), C.row_offsets.end(), C.row_offsets.begin());
+
+    // Resize output
+    C.resize(A.num_rows, B.num_cols, C.row_offsets[num_rows]);
+
+    if(C.num_entries == 0)
+        return;
+
+    // compute the entries of C
+    typedef spgemm_numeric_functor<MatrixType1,MatrixType2,MatrixType3,WorkArray,UnaryFunction,BinaryFunction1,BinaryFunction2> NumericFunctor;
+
+    typename NumericFunctor::AccumulatorArray numeric_accumulators(typename NumericFunctor::Accumulator(B.num_cols));
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_partitions),
+                        NumericFunctor(A, B, C, partition_offsets, numeric_accumulators, initialize, combine, reduce));
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,190 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/detail/utils.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2,
+          typename IndexArray,
+          typename ValueArray>
+struct csr_merge_spmv_functor
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const MatrixType&  A;
+    const VectorType1& x;
+    VectorType2&       y;
+
+    UnaryFunction   initialize;
+    BinaryFunction1 combine;
+    BinaryFunction2 reduce;
+
+    const size_t items_per_partition;
+    const size_t num_merge_items;
+
+    IndexArray& carry_rows;
+    ValueArray& carry_values;
+
+    csr_merge_spmv_functor(const MatrixType& A, const VectorType1& x, VectorType2& y,
+                           UnaryFunction initialize, BinaryFunction1 combine, BinaryFunction2 reduce,
+                           const size_t items_per_partition, const size_t num_merge_items,
+                           IndexArray& carry_rows, ValueArray& carry_values)
+        : A(A), x(x), y(y),
+          initialize(initialize), combine(combine), reduce(reduce),
+          items_per_partition(items_per_partition), num_merge_items(num_merge_items),
+          carry_rows(carry_rows), carry_values(carry_values) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        const IndexType num_rows    = A.num_rows;
+        const IndexType num_entries = A.row_offsets[num_rows];
+
+        for(size_t p = r.begin(); p != r.end(); p++)
+        {
+            const size_t diagonal_start = std::min(items_per_partition * p, num_merge_items);
+            const size_t diagonal_end   = std::min(diagonal_start + items_per_partition, num_merge_items);
+
+            IndexType row, jj, row_end, jj_end;
+            cusp::detail::merge_path_search(diagonal_start, A.row_offsets, num_rows, num_entries, row, jj);
+            cusp::detail::merge_path_search(diagonal_end,   A.row_offsets, num_rows, num_entries, row_end, jj_end);
+
+            // rows which end inside this partition are written directly
+            for(; row < row_end; row++)
+            {
+                const IndexType row_stop = A.row_offsets[row + 1];
+
+                ValueType accumulator = initialize(y[row]);
+
+                for(; jj < row_stop; jj++)
+                {
+                    const IndexType j   = A.column_indices[jj];
+                    const ValueType Aij = A.values[jj];
+                    const ValueType xj  = x[j];
+
+                    accumulator = reduce(accumulator, combine(Aij, xj));
+                }
+
+                y[row] = accumulator;
+            }
+
+            // carry out the partial result of the row which continues
+            // into the next partition
+            carry_rows[p] = num_rows;
+
+            if(jj < jj_end)
+            {
+                ValueType accumulator = combine(A.values[jj], x[A.column_indices[jj]]);
+
+                for(jj++; jj < jj_end; jj++)
+                {
+                    const IndexType j   = A.column_indices[jj];
+                    const ValueType Aij = A.values[jj];
+                    const ValueType xj  = x[j];
+
+                    accumulator = reduce(accumulator, combine(Aij, xj));
+                }
+
+                carry_rows[p]   = row_end;
+                carry_values[p] = accumulator;
+            }
+        }
+    }
+};
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(tbb::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::csr_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy> IndexArray;
+    typedef cusp::detail::temporary_array<ValueType, DerivedPolicy> ValueArray;
+
+    const size_t ITEMS_PER_PARTITION = 4096;
+
+    const IndexType num_rows    = A.num_rows;
+    const IndexType num_entries = A.row_offsets[num_rows];
+
+    if(num_rows == 0)
+        return;
+
+    // the merge of row ends and nonzeros is cut into partitions of equal
+    // work, the number of partitions does not depend on the number of
+    // threads so the scheduler is free to balance them with other tasks
+    const size_t num_merge_items = size_t(num_rows) + size_t(num_entries);
+    const size_t num_partitions  = (num_merge_items + ITEMS_PER_PARTITION - 1) / ITEMS_PER_PARTITION;
+
+    IndexArray carry_rows(exec, num_partitions);
+    ValueArray carry_values(exec, num_partitions);
+
+    csr_merge_spmv_functor<MatrixType,VectorType1,VectorType2,UnaryFunction,BinaryFunction1,BinaryFunction2,IndexArray,ValueArray>
+      functor(A, x, y, initialize, combine, reduce, ITEMS_PER_PARTITION, num_merge_items, carry_rows, carry_values);
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_partitions), functor);
+
+    // fix-up rows which span multiple partitions
+    for(size_t p = 0; p < num_partitions; p++)
+    {
+        const IndexType row = carry_rows[p];
+
+        if(row < num_rows)
+            y[row] = reduce(y[row], carry_values[p]);
+    }
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
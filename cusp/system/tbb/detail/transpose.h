@@ -17,6 +17,290 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system inherits transpose
-#include <cusp/system/cpp/detail/transpose.h>
+#include <thrust/fill.h>
+#include <thrust/memory.h>
+#include <thrust/scan.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// Each partition first histograms the columns of its entries into its own
+// slice of counts and, once the slices have been turned into offsets,
+// scatters its entries into place. Entries of a column are placed in
+// partition order, so the result does not depend on the partition count.
+template <typename MatrixType1, typename MatrixType2, typename IndexArray>
+struct coo_transpose_functor
+{
+    typedef typename MatrixType2::index_type IndexType;
+
+    const MatrixType1& A;
+    MatrixType2&       At;
+
+    IndexArray&       counts;
+    const IndexArray& starting_pos;
+
+    const size_t num_partitions;
+    const bool   scatter;
+
+    coo_transpose_functor(const MatrixType1& A, MatrixType2& At,
+                          IndexArray& counts, const IndexArray& starting_pos,
+                          const size_t num_partitions, const bool scatter)
+        : A(A), At(At), counts(counts), starting_pos(starting_pos),
+          num_partitions(num_partitions), scatter(scatter) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        const size_t num_entries = A.num_entries;
+        const size_t num_cols    = A.num_cols;
+
+        for(size_t p = r.begin(); p != r.end(); p++)
+        {
+            const size_t start = num_entries * p / num_partitions;
+            const size_t end   = num_entries * (p + 1) / num_partitions;
+
+            IndexType * offsets = thrust::raw_pointer_cast(&counts[0]) + p * num_cols;
+
+            for(size_t i = start; i < end; i++)
+            {
+                IndexType col = A.column_indices[i];
+
+                if(!scatter)
+                {
+                    offsets[col]++;
+                    continue;
+                }
+
+                IndexType j = starting_pos[col] + offsets[col]++;
+
+                At.row_indices[j]    = col;
+                At.column_indices[j] = A.row_indices[i];
+                At.values[j]         = A.values[i];
+            }
+        }
+    }
+};
+
+template <typename MatrixType1, typename MatrixType2, typename IndexArray, typename RowArray>
+struct csr_transpose_functor
+{
+    typedef typename MatrixType1::index_type IndexType1;
+    typedef typename MatrixType2::index_type IndexType;
+
+    const MatrixType1& A;
+    MatrixType2&       At;
+
+    IndexArray&     counts;
+    const RowArray& row_starts;
+
+    const bool scatter;
+
+    csr_transpose_functor(const MatrixType1& A, MatrixType2& At,
+                          IndexArray& counts, const RowArray& row_starts,
+                          const bool scatter)
+        : A(A), At(At), counts(counts), row_starts(row_starts), scatter(scatter) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        const size_t num_cols = A.num_cols;
+
+        for(size_t p = r.begin(); p != r.end(); p++)
+        {
+            IndexType * offsets = thrust::raw_pointer_cast(&counts[0]) + p * num_cols;
+
+            for(size_t row = row_starts[p]; row < row_starts[p + 1]; row++)
+            {
+                for(IndexType1 i = A.row_offsets[row]; i < A.row_offsets[row + 1]; i++)
+                {
+                    IndexType col = A.column_indices[i];
+
+                    if(!scatter)
+                    {
+                        offsets[col]++;
+                        continue;
+                    }
+
+                    IndexType j = At.row_offsets[col] + offsets[col]++;
+
+                    At.column_indices[j] = row;
+                    At.values[j]         = A.values[i];
+                }
+            }
+        }
+    }
+};
+
+// splits the rows into partitions with roughly equal numbers of entries
+template <typename MatrixType, typename RowArray>
+struct transpose_row_split_functor
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const MatrixType& A;
+    RowArray&         row_starts;
+
+    const size_t num_partitions;
+
+    transpose_row_split_functor(const MatrixType& A, RowArray& row_starts, const size_t num_partitions)
+        : A(A), row_starts(row_starts), num_partitions(num_partitions) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        const IndexType * row_offsets = thrust::raw_pointer_cast(&A.row_offsets[0]);
+
+        for(size_t p = r.begin(); p != r.end(); p++)
+        {
+            const IndexType target = size_t(A.num_entries) * p / num_partitions;
+
+            row_starts[p] = std::lower_bound(row_offsets, row_offsets + A.num_rows, target) - row_offsets;
+        }
+    }
+};
+
+// turns the per-partition histograms into the number of entries of each
+// column in the preceding partitions, and records the column totals
+template <typename IndexArray, typename OffsetArray>
+struct transpose_offsets_functor
+{
+    typedef typename IndexArray::value_type IndexType;
+
+    IndexArray&  counts;
+    OffsetArray& At_row_offsets;
+
+    const size_t num_partitions;
+    const size_t num_cols;
+
+    transpose_offsets_functor(IndexArray& counts, OffsetArray& At_row_offsets,
+                              const size_t num_partitions, const size_t num_cols)
+        : counts(counts), At_row_offsets(At_row_offsets),
+          num_partitions(num_partitions), num_cols(num_cols) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t c = r.begin(); c != r.end(); c++)
+        {
+            IndexType sum = 0;
+
+            for(size_t p = 0; p < num_partitions; p++)
+            {
+                const IndexType count = counts[p * num_cols + c];
+                counts[p * num_cols + c] = sum;
+                sum += count;
+            }
+
+            At_row_offsets[c + 1] = sum;
+        }
+    }
+};
+
+// every partition holds a num_cols histogram, so the partition count is
+// limited to keep that storage proportional to the number of entries
+inline size_t transpose_num_partitions(const size_t num_entries, const size_t num_cols)
+{
+    const size_t ENTRIES_PER_PARTITION = 32768;
+
+    const size_t num_partitions = (num_entries + ENTRIES_PER_PARTITION - 1) / ENTRIES_PER_PARTITION;
+    const size_t max_partitions = std::max(size_t(1), 2 * num_entries / (num_cols + 1));
+
+    return std::min(num_partitions, max_partitions);
+}
+
+template <typename DerivedPolicy, typename IndexArray, typename OffsetArray>
+void transpose_offsets(tbb::execution_policy<DerivedPolicy>& exec,
+                       IndexArray& counts, const size_t num_partitions,
+                       const size_t num_cols, OffsetArray& At_row_offsets)
+{
+    transpose_offsets_functor<IndexArray, OffsetArray> functor(counts, At_row_offsets, num_partitions, num_cols);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_cols), functor);
+
+    At_row_offsets[0] = 0;
+
+    thrust::inclusive_scan(exec, At_row_offsets.begin(), At_row_offsets.end(), At_row_offsets.begin());
+}
+
+// COO format
+template <typename DerivedPolicy, typename MatrixType1, typename MatrixType2>
+void transpose(tbb::execution_policy<DerivedPolicy>& exec,
+               const MatrixType1& A, MatrixType2& At,
+               cusp::coo_format, cusp::coo_format)
+{
+    typedef typename MatrixType2::index_type                         IndexType;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy>  IndexArray;
+
+    At.resize(A.num_cols, A.num_rows, A.num_entries);
+
+    if(A.num_entries == 0)
+        return;
+
+    const size_t num_partitions = transpose_num_partitions(A.num_entries, A.num_cols);
+
+    IndexArray counts(exec, num_partitions * A.num_cols, IndexType(0));
+    IndexArray starting_pos(exec, A.num_cols + 1);
+
+    coo_transpose_functor<MatrixType1, MatrixType2, IndexArray>
+        histogram(A, At, counts, starting_pos, num_partitions, false);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_partitions), histogram);
+
+    transpose_offsets(exec, counts, num_partitions, A.num_cols, starting_pos);
+
+    coo_transpose_functor<MatrixType1, MatrixType2, IndexArray>
+        scatter(A, At, counts, starting_pos, num_partitions, true);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_partitions), scatter);
+}
+
+// CSR format
+template <typename DerivedPolicy, typename MatrixType1, typename MatrixType2>
+void transpose(tbb::execution_policy<DerivedPolicy>& exec,
+               const MatrixType1& A, MatrixType2& At,
+               cusp::csr_format, cusp::csr_format)
+{
+    typedef typename MatrixType2::index_type                         IndexType;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy>  IndexArray;
+    typedef cusp::detail::temporary_array<size_t, DerivedPolicy>     RowArray;
+
+    At.resize(A.num_cols, A.num_rows, A.num_entries);
+
+    if(A.num_entries == 0)
+    {
+        thrust::fill(exec, At.row_offsets.begin(), At.row_offsets.end(), IndexType(0));
+        return;
+    }
+
+    const size_t num_partitions = transpose_num_partitions(A.num_entries, A.num_cols);
+
+    IndexArray counts(exec, num_partitions * A.num_cols, IndexType(0));
+    RowArray   row_starts(exec, num_partitions + 1);
+
+    transpose_row_split_functor<MatrixType1, RowArray> split(A, row_starts, num_partitions);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_partitions), split);
+
+    row_starts[num_partitions] = A.num_rows;
+
+    csr_transpose_functor<MatrixType1, MatrixType2, IndexArray, RowArray>
+        histogram(A, At, counts, row_starts, false);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_partitions), histogram);
+
+    transpose_offsets(exec, counts, num_partitions, A.num_cols, At.row_offsets);
+
+    csr_transpose_functor<MatrixType1, MatrixType2, IndexArray, RowArray>
+        scatter(A, At, counts, row_starts, true);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_partitions), scatter);
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
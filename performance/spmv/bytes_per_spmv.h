@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cusp/compressed_csr_matrix.h>
 #include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
 #include <cusp/dia_matrix.h>
@@ -38,6 +39,20 @@ size_t bytes_per_spmv(const cusp::csr_matrix<IndexType,ValueType,cusp::host_memo
     return bytes;
 }
 
+template <typename IndexType, typename ValueType>
+size_t bytes_per_spmv(const cusp::compressed_csr_matrix<IndexType,ValueType,cusp::host_memory>& mtx)
+{
+    const size_t num_indices = mtx.column_indices.size();
+
+    size_t bytes = 0;
+    bytes += 3*sizeof(IndexType) * mtx.num_rows;     // row pointer and column base
+    bytes += mtx.delta_width * (mtx.num_entries - num_indices); // column delta
+    bytes += 1*sizeof(IndexType) * num_indices;      // full column index
+    bytes += 2*sizeof(ValueType) * mtx.num_entries;  // A[i,j] and x[j]
+    bytes += 2*sizeof(ValueType) * mtx.num_rows;     // y[i] = y[i] + ...
+    return bytes;
+}
+
 template <typename IndexType, typename ValueType>
 size_t bytes_per_spmv_block(const cusp::csr_matrix<IndexType,ValueType,cusp::host_memory>& mtx, size_t num_cols)
 {
@@ -1,5 +1,6 @@
 #include <unittest/unittest.h>
 
+#include <cusp/csc_matrix.h>
 #include <cusp/csr_matrix.h>
 #include <cusp/linear_operator.h>
 #include <cusp/monitor.h>
@@ -100,6 +101,41 @@ void TestBiConjugateGradientZeroResidual(void)
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestBiConjugateGradientZeroResidual)
 
+template <class MemorySpace>
+void TestBiConjugateGradientTransposeView(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+
+    cusp::gallery::poisson5pt(A, 10, 10);
+
+    // make the matrix nonsymmetric
+    cusp::csr_matrix<int, float, cusp::host_memory> B(A);
+    for(size_t i = 0; i < B.num_rows; i++)
+        for(int jj = B.row_offsets[i]; jj < B.row_offsets[i + 1]; jj++)
+            if(size_t(B.column_indices[jj]) == i + 1)
+                B.values[jj] = -1.5f;
+            else if(size_t(B.column_indices[jj]) + 1 == i)
+                B.values[jj] = -0.5f;
+    A = B;
+
+    cusp::array1d<float, MemorySpace> x(A.num_rows, 0.0f);
+    cusp::array1d<float, MemorySpace> b(A.num_rows, 1.0f);
+
+    cusp::monitor<float> monitor(b, 100, 1e-4);
+
+    // multiply by the transpose through the arrays of A
+    cusp::krylov::bicg(A, cusp::make_transpose_view(A), x, b, monitor);
+
+    // check residual norm
+    cusp::array1d<float, MemorySpace> residual(A.num_rows, 0.0f);
+    cusp::multiply(A, x, residual);
+    cusp::blas::axpby(residual, b, residual, -1.0f, 1.0f);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+    ASSERT_EQUAL(cusp::blas::nrm2(residual) < 1e-3 * cusp::blas::nrm2(b), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBiConjugateGradientTransposeView)
+
 template <class LinearOperator, class VectorType1, class VectorType2, class Monitor, class Preconditioner>
 void bicgstab(my_system& system, const LinearOperator& A, VectorType1& x, const VectorType2& b, Monitor& monitor, Preconditioner& M)
 {
@@ -10,6 +10,7 @@
 #include <cusp/hyb_matrix.h>
 
 #include <cusp/gallery/poisson.h>
+#include <cusp/gallery/random.h>
 
 // check whether the MIS is valid
 template <typename MatrixType, typename ArrayType1, typename ArrayType2>
@@ -160,6 +161,33 @@ void TestBreadthFirstSearch(void)
 }
 DECLARE_SPARSE_MATRIX_UNITTEST(TestBreadthFirstSearch)
 
+template <typename Space>
+void TestBreadthFirstSearchLevels(void)
+{
+    // an unsymmetric graph with enough edges to switch to bottom-up steps
+    cusp::csr_matrix<int, float, cusp::host_memory> h_G;
+    cusp::gallery::random(h_G, 20000, 20000, 200000);
+
+    cusp::csr_matrix<int, float, Space> G(h_G);
+
+    for(int src = 0; src < 20000; src += 4999)
+    {
+        cusp::array1d<int, cusp::host_memory> reference(20000);
+        cusp::graph::breadth_first_search(h_G, src, reference, true);
+
+        cusp::array1d<int, Space> levels(20000);
+        cusp::graph::breadth_first_search(G, src, levels, true);
+
+        ASSERT_EQUAL(levels, reference);
+
+        cusp::array1d<int, Space> tree(20000);
+        cusp::graph::breadth_first_search(G, src, tree, false);
+
+        ASSERT_EQUAL(is_valid_level_set(h_G, tree, reference), true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBreadthFirstSearchLevels);
+
 template <typename MatrixType, typename ArrayType>
 void breadth_first_search(my_system& system,
                           const MatrixType& G,
@@ -0,0 +1,268 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array2d.h>
+#include <cusp/bsr_matrix.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
+#include <cusp/verify.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/gallery/random.h>
+#include <cusp/krylov/cg.h>
+#include <cusp/precond/aggregation/smoothed_aggregation.h>
+
+template <class Space>
+void TestBsrMatrixBasicConstructor(void)
+{
+    cusp::bsr_matrix<int, float, Space> matrix(4, 6, 3, 2, 2);
+
+    ASSERT_EQUAL(matrix.num_rows,              4);
+    ASSERT_EQUAL(matrix.num_cols,              6);
+    ASSERT_EQUAL(matrix.num_entries,           12);
+    ASSERT_EQUAL(matrix.block_rows,            2);
+    ASSERT_EQUAL(matrix.block_cols,            2);
+    ASSERT_EQUAL(matrix.num_blocks(),          3);
+    ASSERT_EQUAL(matrix.row_offsets.size(),    3);
+    ASSERT_EQUAL(matrix.column_indices.size(), 3);
+    ASSERT_EQUAL(matrix.values.size(),         12);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixBasicConstructor);
+
+template <class Space>
+void TestBsrMatrixSwap(void)
+{
+    cusp::bsr_matrix<int, float, Space> A(4, 6, 3, 2, 2);
+    cusp::bsr_matrix<int, float, Space> B(3, 3, 1, 3, 1);
+
+    cusp::bsr_matrix<int, float, Space> A_copy(A);
+    cusp::bsr_matrix<int, float, Space> B_copy(B);
+
+    A.swap(B);
+
+    ASSERT_EQUAL(A.num_rows,       3);
+    ASSERT_EQUAL(A.num_entries,    3);
+    ASSERT_EQUAL(A.block_rows,     3);
+    ASSERT_EQUAL(A.block_cols,     1);
+    ASSERT_EQUAL(A.row_offsets,    B_copy.row_offsets);
+    ASSERT_EQUAL(B.num_rows,       4);
+    ASSERT_EQUAL(B.num_entries,    12);
+    ASSERT_EQUAL(B.block_rows,     2);
+    ASSERT_EQUAL(B.block_cols,     2);
+    ASSERT_EQUAL(B.row_offsets,    A_copy.row_offsets);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixSwap);
+
+template <class Space>
+void TestBsrMatrixConvert(void)
+{
+    typedef cusp::bsr_matrix<int, float, Space> BsrMatrix;
+
+    cusp::array2d<float, cusp::host_memory> D;
+    cusp::gallery::random(D, 24, 36, 150);
+
+    const size_t block_sizes[7][2] = {{1,1}, {2,2}, {3,3}, {4,4}, {6,6}, {2,3}, {4,6}};
+
+    for(size_t n = 0; n < 7; n++)
+    {
+        BsrMatrix A(D, block_sizes[n][0], block_sizes[n][1]);
+
+        ASSERT_EQUAL(A.block_rows, block_sizes[n][0]);
+        ASSERT_EQUAL(A.block_cols, block_sizes[n][1]);
+        ASSERT_EQUAL(cusp::is_valid_matrix(A), true);
+
+        // bsr -> array2d
+        ASSERT_EQUAL(D == cusp::array2d<float, cusp::host_memory>(A), true);
+
+        // bsr -> csr, the explicit zeros of the blocks are kept
+        cusp::csr_matrix<int, float, Space> B(A);
+        ASSERT_EQUAL(B.num_entries, A.num_entries);
+        ASSERT_EQUAL(D == cusp::array2d<float, cusp::host_memory>(B), true);
+
+        // csr -> bsr
+        BsrMatrix C(B, block_sizes[n][0], block_sizes[n][1]);
+        ASSERT_EQUAL(C.row_offsets,    A.row_offsets);
+        ASSERT_EQUAL(C.column_indices, A.column_indices);
+        ASSERT_EQUAL(C.values,         A.values);
+
+        // assignment keeps the block size of the destination
+        BsrMatrix E(4, 4, 0, block_sizes[n][0], block_sizes[n][1]);
+        E = D;
+        ASSERT_EQUAL(E.block_rows, block_sizes[n][0]);
+        ASSERT_EQUAL(E.values,     A.values);
+    }
+
+    // the dimensions must be multiples of the block size
+    BsrMatrix F(0, 0, 0, 5, 5);
+    ASSERT_THROWS(F = D, cusp::format_conversion_exception);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixConvert);
+
+template <class Space>
+void TestBsrMatrixView(void)
+{
+    typedef cusp::bsr_matrix<int, float, Space> BsrMatrix;
+    typedef typename BsrMatrix::view            View;
+
+    cusp::array2d<float, cusp::host_memory> D;
+    cusp::gallery::random(D, 12, 18, 40);
+
+    BsrMatrix A(D, 3, 3);
+
+    View V = cusp::make_bsr_matrix_view(A);
+
+    ASSERT_EQUAL(V.num_rows,     A.num_rows);
+    ASSERT_EQUAL(V.num_entries,  A.num_entries);
+    ASSERT_EQUAL(V.block_rows,   3);
+    ASSERT_EQUAL(V.num_blocks(), A.num_blocks());
+
+    V.values[0] = 17;
+    ASSERT_EQUAL(A.values[0], 17);
+
+    cusp::array1d<float, Space> x = unittest::random_samples<float>(A.num_cols);
+    cusp::array1d<float, Space> y1(A.num_rows);
+    cusp::array1d<float, Space> y2(A.num_rows);
+
+    cusp::multiply(A, x, y1);
+    cusp::multiply(V, x, y2);
+
+    ASSERT_EQUAL(y1, y2);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixView);
+
+template <typename Space>
+void CompareBsrMultiply(const cusp::array2d<float, cusp::host_memory>& D,
+                        const size_t block_rows, const size_t block_cols)
+{
+    cusp::bsr_matrix<int, float, Space> A(D, block_rows, block_cols);
+
+    // SpMV
+    cusp::array1d<float, cusp::host_memory> x(D.num_cols);
+    cusp::array1d<float, cusp::host_memory> y(D.num_rows);
+
+    for(size_t i = 0; i < x.size(); i++)
+        x[i] = int(i % 7) - 3;
+
+    cusp::multiply(D, x, y);
+
+    cusp::array1d<float, Space> x_bsr(x);
+    cusp::array1d<float, Space> y_bsr(D.num_rows, 10);
+    cusp::multiply(A, x_bsr, y_bsr);
+
+    ASSERT_EQUAL(y_bsr, y);
+
+    // SpMM, only implemented on the host
+    cusp::bsr_matrix<int, float, cusp::host_memory> A_h(A);
+
+    cusp::array2d<float, cusp::host_memory> X;
+    cusp::gallery::random(X, D.num_cols, 5, 3 * D.num_cols);
+    cusp::array2d<float, cusp::host_memory> Y;
+    cusp::multiply(D, X, Y);
+
+    cusp::array2d<float, cusp::host_memory> Y_bsr(D.num_rows, 5, 10);
+    cusp::multiply(A_h, X, Y_bsr);
+
+    ASSERT_EQUAL(Y == Y_bsr, true);
+}
+
+template <class Space>
+void TestBsrMatrixMultiply(void)
+{
+    cusp::array2d<float, cusp::host_memory> D;
+    cusp::gallery::random(D, 60, 60, 400);
+
+    // unrolled square block sizes
+    CompareBsrMultiply<Space>(D, 1, 1);
+    CompareBsrMultiply<Space>(D, 2, 2);
+    CompareBsrMultiply<Space>(D, 3, 3);
+    CompareBsrMultiply<Space>(D, 4, 4);
+    CompareBsrMultiply<Space>(D, 6, 6);
+
+    // block sizes only known at runtime
+    CompareBsrMultiply<Space>(D, 5, 5);
+    CompareBsrMultiply<Space>(D, 2, 3);
+
+    cusp::array2d<float, cusp::host_memory> E;
+    cusp::gallery::random(E, 12, 30, 80);
+
+    CompareBsrMultiply<Space>(E, 3, 5);
+    CompareBsrMultiply<Space>(E, 2, 2);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixMultiply);
+
+template <class Space>
+void TestBsrMatrixTranspose(void)
+{
+    cusp::array2d<float, cusp::host_memory> D;
+    cusp::gallery::random(D, 12, 30, 80);
+
+    cusp::array2d<float, cusp::host_memory> Dt;
+    cusp::transpose(D, Dt);
+
+    cusp::bsr_matrix<int, float, Space> A(D, 3, 5);
+    cusp::bsr_matrix<int, float, Space> At;
+    cusp::transpose(A, At);
+
+    ASSERT_EQUAL(At.num_rows,   30);
+    ASSERT_EQUAL(At.num_cols,   12);
+    ASSERT_EQUAL(At.block_rows, 5);
+    ASSERT_EQUAL(At.block_cols, 3);
+    ASSERT_EQUAL(cusp::is_valid_matrix(At), true);
+    ASSERT_EQUAL(Dt == cusp::array2d<float, cusp::host_memory>(At), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixTranspose);
+
+template <typename MatrixType>
+bool IsCsrMatrix(const MatrixType&)
+{
+    return cusp::detail::is_csr<MatrixType>::value;
+}
+
+template <class Space>
+void TestBsrMatrixSmoothedAggregation(void)
+{
+    typedef cusp::bsr_matrix<int, float, Space> BsrMatrix;
+
+    // two coupled unknowns per grid point, A = L (x) K with K = [2 1; 1 2]
+    cusp::coo_matrix<int, float, cusp::host_memory> L;
+    cusp::gallery::poisson5pt(L, 30, 30);
+
+    const float K[2][2] = {{2, 1}, {1, 2}};
+
+    cusp::coo_matrix<int, float, cusp::host_memory> B(2 * L.num_rows, 2 * L.num_cols, 4 * L.num_entries);
+
+    for(size_t n = 0; n < L.num_entries; n++)
+    {
+        for(int k = 0; k < 4; k++)
+        {
+            B.row_indices[4 * n + k]    = 2 * L.row_indices[n] + k / 2;
+            B.column_indices[4 * n + k] = 2 * L.column_indices[n] + k % 2;
+            B.values[4 * n + k]         = L.values[n] * K[k / 2][k % 2];
+        }
+    }
+
+    B.sort_by_row_and_column();
+
+    BsrMatrix A(B, 2, 2);
+
+    cusp::precond::aggregation::smoothed_aggregation<int, float, Space,
+        thrust::use_default, thrust::use_default, cusp::bsr_format> M(A);
+
+    // the finest level keeps the 2x2 blocks and the coarse levels are CSR
+    ASSERT_EQUAL(M.A_ptr->block_rows, 2);
+    ASSERT_EQUAL(M.A_ptr->block_cols, 2);
+    ASSERT_EQUAL(M.levels.size() > 1, true);
+    ASSERT_EQUAL(IsCsrMatrix(M.levels[1].A), true);
+
+    cusp::array1d<float, Space> b = unittest::random_samples<float>(A.num_rows);
+    cusp::array1d<float, Space> x(A.num_rows, 0);
+
+    // set stopping criteria (iteration_limit = 50, relative_tolerance = 1e-4)
+    cusp::monitor<float> monitor(b, 50, 1e-4);
+    cusp::krylov::cg(A, x, b, monitor, M);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixSmoothedAggregation);
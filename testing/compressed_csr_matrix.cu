@@ -0,0 +1,329 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array2d.h>
+#include <cusp/compressed_csr_matrix.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/format_utils.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
+#include <cusp/verify.h>
+
+#include <cusp/gallery/poisson.h>
+
+#include <thrust/fill.h>
+
+// banded matrix with empty rows and a few rows reaching far from the diagonal
+template <typename MatrixType>
+void initialize_banded_matrix(MatrixType& A, const size_t num_rows, const size_t num_cols)
+{
+    cusp::array2d<float, cusp::host_memory> D(num_rows, num_cols, 0);
+
+    for(size_t i = 0; i < num_rows; i++)
+    {
+        if(i % 13 == 7)
+            continue;
+
+        for(size_t j = (i < 3 ? 0 : i - 3); j < std::min(i + 4, num_cols); j++)
+            if((i + j) % 3 != 1 || i == j)
+                D(i,j) = int((i + 2 * j) % 9) - 4 + (i == j ? 10 : 0);
+
+        if(i % 17 == 5)
+            for(size_t j = 0; j < num_cols; j += 97)
+                D(i,j) = int(j % 5) + 1;
+    }
+
+    A = D;
+}
+
+// every row spans more than 255 columns and row 7 more than 65535 columns
+template <typename MatrixType>
+void initialize_wide_matrix(MatrixType& A)
+{
+    cusp::coo_matrix<int, float, cusp::host_memory> B(50, 70000, 103);
+
+    for(int i = 0, n = 0; i < 50; i++)
+    {
+        B.row_indices[n] = i; B.column_indices[n] = i;       B.values[n++] = i + 1;
+        B.row_indices[n] = i; B.column_indices[n] = i + 300; B.values[n++] = i - 20;
+
+        if(i == 7)
+        {
+            B.row_indices[n] = i; B.column_indices[n] = 69999; B.values[n++] = 3;
+        }
+        if(i == 31)
+        {
+            B.row_indices[n] = i; B.column_indices[n] = 400;   B.values[n++] = -2;
+            B.row_indices[n] = i; B.column_indices[n] = 401;   B.values[n++] = 5;
+        }
+    }
+
+    A = B;
+}
+
+template <class Space>
+void TestCompressedCsrMatrixBasicConstructor(void)
+{
+    cusp::compressed_csr_matrix<int, float, Space> matrix(3, 2, 6, 2);
+
+    ASSERT_EQUAL(matrix.num_rows,              3);
+    ASSERT_EQUAL(matrix.num_cols,              2);
+    ASSERT_EQUAL(matrix.num_entries,           6);
+    ASSERT_EQUAL(matrix.delta_width,           1);
+    ASSERT_EQUAL(matrix.row_offsets.size(),    4);
+    ASSERT_EQUAL(matrix.column_bases.size(),   3);
+    ASSERT_EQUAL(matrix.column_indices.size(), 2);
+    ASSERT_EQUAL(matrix.column_deltas.size(),  6);
+    ASSERT_EQUAL(matrix.values.size(),         6);
+
+    cusp::compressed_csr_matrix<int, float, Space> wide(3, 2, 6, 0, 2);
+
+    ASSERT_EQUAL(wide.delta_width,          2);
+    ASSERT_EQUAL(wide.column_deltas.size(), 12);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCompressedCsrMatrixBasicConstructor);
+
+template <class Space>
+void TestCompressedCsrMatrixSwap(void)
+{
+    cusp::compressed_csr_matrix<int, float, Space> A(1, 2, 3, 0, 2);
+    cusp::compressed_csr_matrix<int, float, Space> B(4, 5, 6, 1, 1);
+
+    A.swap(B);
+
+    ASSERT_EQUAL(A.num_rows,              4);
+    ASSERT_EQUAL(A.num_cols,              5);
+    ASSERT_EQUAL(A.num_entries,           6);
+    ASSERT_EQUAL(A.delta_width,           1);
+    ASSERT_EQUAL(A.row_offsets.size(),    5);
+    ASSERT_EQUAL(A.column_indices.size(), 1);
+    ASSERT_EQUAL(A.column_deltas.size(),  6);
+    ASSERT_EQUAL(B.num_rows,              1);
+    ASSERT_EQUAL(B.num_cols,              2);
+    ASSERT_EQUAL(B.num_entries,           3);
+    ASSERT_EQUAL(B.delta_width,           2);
+    ASSERT_EQUAL(B.row_offsets.size(),    2);
+    ASSERT_EQUAL(B.column_indices.size(), 0);
+    ASSERT_EQUAL(B.column_deltas.size(),  6);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCompressedCsrMatrixSwap);
+
+template <class Space>
+void TestCompressedCsrMatrixConvert(void)
+{
+    typedef cusp::compressed_csr_matrix<int, float, Space> CompressedMatrix;
+
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    initialize_banded_matrix(A, 300, 280);
+
+    cusp::array2d<float, cusp::host_memory> D(A);
+
+    // csr -> compressed_csr, the rows reaching far from the diagonal keep
+    // their full column indices
+    CompressedMatrix B(A);
+
+    size_t num_indices = 0;
+    for(size_t i = 0; i < A.num_rows; i++)
+        if(A.row_offsets[i + 1] > A.row_offsets[i] &&
+           A.column_indices[A.row_offsets[i + 1] - 1] - A.column_indices[A.row_offsets[i]] > 255)
+            num_indices += A.row_offsets[i + 1] - A.row_offsets[i];
+
+    ASSERT_EQUAL(num_indices > 0, true);
+
+    ASSERT_EQUAL(B.num_entries,           A.num_entries);
+    ASSERT_EQUAL(B.delta_width,           1);
+    ASSERT_EQUAL(B.column_deltas.size(),  A.num_entries);
+    ASSERT_EQUAL(B.column_indices.size(), num_indices);
+    ASSERT_EQUAL(cusp::is_valid_matrix(B), true);
+
+    // compressed_csr -> array2d
+    ASSERT_EQUAL(D == cusp::array2d<float, cusp::host_memory>(B), true);
+
+    // compressed_csr -> csr
+    cusp::csr_matrix<int, float, cusp::host_memory> C(B);
+    ASSERT_EQUAL(C.row_offsets,    A.row_offsets);
+    ASSERT_EQUAL(C.column_indices, A.column_indices);
+    ASSERT_EQUAL(C.values,         A.values);
+
+    // compressed_csr -> coo
+    cusp::coo_matrix<int, float, cusp::host_memory> E(A);
+    cusp::coo_matrix<int, float, cusp::host_memory> F(B);
+    ASSERT_EQUAL(F.row_indices,    E.row_indices);
+    ASSERT_EQUAL(F.column_indices, E.column_indices);
+    ASSERT_EQUAL(F.values,         E.values);
+
+    // coo -> compressed_csr
+    CompressedMatrix G(E);
+    ASSERT_EQUAL(G.row_offsets,    B.row_offsets);
+    ASSERT_EQUAL(G.column_bases,   B.column_bases);
+    ASSERT_EQUAL(G.column_indices, B.column_indices);
+    ASSERT_EQUAL(G.column_deltas,  B.column_deltas);
+    ASSERT_EQUAL(G.values,         B.values);
+
+    // array2d -> compressed_csr
+    CompressedMatrix K;
+    K = D;
+    ASSERT_EQUAL(K.column_bases,   B.column_bases);
+    ASSERT_EQUAL(K.column_indices, B.column_indices);
+    ASSERT_EQUAL(K.column_deltas,  B.column_deltas);
+
+    // empty matrix
+    cusp::csr_matrix<int, float, cusp::host_memory> Z(4, 3, 0);
+    thrust::fill(Z.row_offsets.begin(), Z.row_offsets.end(), 0);
+
+    CompressedMatrix L(Z);
+    ASSERT_EQUAL(L.num_entries, 0);
+    ASSERT_EQUAL(L.row_offsets, cusp::array1d<int, Space>(5, 0));
+    ASSERT_EQUAL(cusp::is_valid_matrix(L), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCompressedCsrMatrixConvert);
+
+template <class Space>
+void TestCompressedCsrMatrixDeltaWidth(void)
+{
+    // the columns of the rows of a 5-point stencil on a 100x100 grid span
+    // 200 columns, a single byte per entry is stored
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 100, 100);
+
+    cusp::compressed_csr_matrix<int, float, Space> B(A);
+
+    ASSERT_EQUAL(B.delta_width,           1);
+    ASSERT_EQUAL(B.column_indices.size(), 0);
+    ASSERT_EQUAL(B.column_deltas.size(),  A.num_entries);
+
+    // on a 300x300 grid they span 600 columns and need 16 bit deltas
+    cusp::gallery::poisson5pt(A, 300, 300);
+
+    cusp::compressed_csr_matrix<int, float, Space> C(A);
+
+    ASSERT_EQUAL(C.delta_width,           2);
+    ASSERT_EQUAL(C.column_indices.size(), 0);
+    ASSERT_EQUAL(C.column_deltas.size(),  2 * A.num_entries);
+
+    // rows spanning more than 65535 columns keep their full column indices
+    cusp::csr_matrix<int, float, cusp::host_memory> W;
+    initialize_wide_matrix(W);
+
+    cusp::compressed_csr_matrix<int, float, Space> E(W);
+
+    ASSERT_EQUAL(E.delta_width,           2);
+    ASSERT_EQUAL(E.column_indices.size(), 3);
+    ASSERT_EQUAL(cusp::is_valid_matrix(E), true);
+
+    cusp::csr_matrix<int, float, cusp::host_memory> F(E);
+    ASSERT_EQUAL(F.row_offsets,    W.row_offsets);
+    ASSERT_EQUAL(F.column_indices, W.column_indices);
+    ASSERT_EQUAL(F.values,         W.values);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCompressedCsrMatrixDeltaWidth);
+
+template <class Space>
+void TestCompressedCsrMatrixView(void)
+{
+    typedef cusp::compressed_csr_matrix<int, float, Space> CompressedMatrix;
+    typedef typename CompressedMatrix::view                View;
+
+    CompressedMatrix A;
+    initialize_banded_matrix(A, 40, 30);
+
+    View V = cusp::make_compressed_csr_matrix_view(A);
+
+    ASSERT_EQUAL(V.num_rows,    A.num_rows);
+    ASSERT_EQUAL(V.num_cols,    A.num_cols);
+    ASSERT_EQUAL(V.num_entries, A.num_entries);
+    ASSERT_EQUAL(V.delta_width, A.delta_width);
+
+    V.values[0] = 17;
+    ASSERT_EQUAL(A.values[0], 17);
+
+    cusp::array1d<float, Space> x = unittest::random_samples<float>(A.num_cols);
+    cusp::array1d<float, Space> y1(A.num_rows);
+    cusp::array1d<float, Space> y2(A.num_rows);
+
+    cusp::multiply(A, x, y1);
+    cusp::multiply(V, x, y2);
+
+    ASSERT_EQUAL(y1, y2);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCompressedCsrMatrixView);
+
+template <class Space>
+void TestCompressedCsrMatrixMultiply(void)
+{
+    const size_t sizes[4][2] = {{1, 1}, {7, 30}, {300, 280}, {523, 611}};
+
+    for(size_t n = 0; n < 5; n++)
+    {
+        cusp::csr_matrix<int, float, cusp::host_memory> A;
+
+        if(n < 4)
+            initialize_banded_matrix(A, sizes[n][0], sizes[n][1]);
+        else
+            initialize_wide_matrix(A);
+
+        cusp::compressed_csr_matrix<int, float, Space> B(A);
+
+        cusp::array1d<float, cusp::host_memory> x(A.num_cols);
+        cusp::array1d<float, cusp::host_memory> y(A.num_rows);
+
+        for(size_t i = 0; i < x.size(); i++)
+            x[i] = int(i % 7) - 3;
+
+        cusp::multiply(A, x, y);
+
+        cusp::array1d<float, Space> x_compressed(x);
+        cusp::array1d<float, Space> y_compressed(A.num_rows, 10);
+        cusp::multiply(B, x_compressed, y_compressed);
+
+        ASSERT_EQUAL(y_compressed, y);
+    }
+
+    // empty matrix
+    cusp::compressed_csr_matrix<int, float, Space> E(20, 10, 0, 0);
+    thrust::fill(E.row_offsets.begin(), E.row_offsets.end(), 0);
+    thrust::fill(E.column_bases.begin(), E.column_bases.end(), 0);
+
+    cusp::array1d<float, Space> x(10, 1);
+    cusp::array1d<float, Space> y(20, 10);
+    cusp::multiply(E, x, y);
+
+    ASSERT_EQUAL(y, cusp::array1d<float, Space>(20, 0));
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCompressedCsrMatrixMultiply);
+
+template <class Space>
+void TestCompressedCsrMatrixExtractDiagonal(void)
+{
+    cusp::csr_matrix<int, float, Space> A;
+    initialize_banded_matrix(A, 40, 30);
+
+    cusp::compressed_csr_matrix<int, float, Space> B(A);
+
+    cusp::array1d<float, Space> expected(30);
+    cusp::array1d<float, Space> diagonal(30);
+
+    cusp::extract_diagonal(A, expected);
+    cusp::extract_diagonal(B, diagonal);
+
+    ASSERT_EQUAL(diagonal, expected);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCompressedCsrMatrixExtractDiagonal);
+
+template <class Space>
+void TestCompressedCsrMatrixTranspose(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    initialize_banded_matrix(A, 35, 120);
+
+    cusp::array2d<float, cusp::host_memory> Dt;
+    cusp::transpose(cusp::array2d<float, cusp::host_memory>(A), Dt);
+
+    cusp::compressed_csr_matrix<int, float, Space> B(A);
+    cusp::compressed_csr_matrix<int, float, Space> Bt;
+    cusp::transpose(B, Bt);
+
+    ASSERT_EQUAL(cusp::is_valid_matrix(Bt), true);
+    ASSERT_EQUAL(Dt == cusp::array2d<float, cusp::host_memory>(Bt), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCompressedCsrMatrixTranspose);
@@ -2,8 +2,59 @@
 
 #include <cusp/graph/connected_components.h>
 
+#include <cusp/array1d.h>
+#include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+template <typename Space>
+void TestConnectedComponentsLabels(void)
+{
+    // chains of BLOCK vertices whose ids are scattered across the graph
+    const int N = 30000;
+    const int BLOCK = 1000;
+    const int num_blocks = N / BLOCK;
+
+    cusp::coo_matrix<int, float, cusp::host_memory> h_G(N, N, 2 * (N - num_blocks));
+
+    for(int i = 0, n = 0; i < N - 1; i++)
+    {
+        if((i + 1) % BLOCK == 0) continue;
+
+        const int u = (i * 7919) % N;
+        const int v = ((i + 1) * 7919) % N;
+
+        h_G.row_indices[n] = u; h_G.column_indices[n] = v; h_G.values[n++] = 1;
+        h_G.row_indices[n] = v; h_G.column_indices[n] = u; h_G.values[n++] = 1;
+    }
+    h_G.sort_by_row_and_column();
+
+    // components are numbered in the order of their smallest vertex
+    std::vector<int> smallest(num_blocks, N);
+    for(int i = 0; i < N; i++)
+        smallest[i / BLOCK] = std::min(smallest[i / BLOCK], (i * 7919) % N);
+
+    cusp::array1d<int, cusp::host_memory> reference(N);
+    for(int i = 0; i < N; i++)
+    {
+        const int b = i / BLOCK;
+        reference[(i * 7919) % N] = std::count_if(smallest.begin(), smallest.end(),
+                                                  std::bind2nd(std::less<int>(), smallest[b]));
+    }
+
+    cusp::csr_matrix<int, float, Space> G(h_G);
+    cusp::array1d<int, Space> components(N);
+
+    size_t num_components = cusp::graph::connected_components(G, components);
+
+    ASSERT_EQUAL(num_components, size_t(num_blocks));
+    ASSERT_EQUAL(components, reference);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestConnectedComponentsLabels);
+
 template <typename MatrixType, typename ArrayType>
 size_t connected_components(my_system& system,
                             const MatrixType& G,
@@ -9,6 +9,9 @@
 #include <cusp/ell_matrix.h>
 #include <cusp/hyb_matrix.h>
 
+#include <cusp/gallery/poisson.h>
+#include <cusp/gallery/random.h>
+
 #include <cusp/verify.h>
 
 
@@ -494,6 +497,49 @@ void TestConvertCsrToEllMatrixHost(void)
 }
 DECLARE_UNITTEST(TestConvertCsrToEllMatrixHost);
 
+template <typename SourceType, typename HostMatrix>
+void verify_round_trip_conversion(const HostMatrix& A)
+{
+    typedef typename SourceType::memory_space MemorySpace;
+
+    cusp::csr_matrix<int, float, MemorySpace> B(A);
+
+    SourceType C;
+    cusp::convert(B, C);
+    cusp::assert_is_valid_matrix(C);
+
+    cusp::coo_matrix<int, float, MemorySpace> D;
+    cusp::convert(C, D);
+
+    cusp::csr_matrix<int, float, MemorySpace> E;
+    cusp::convert(D, E);
+
+    cusp::csr_matrix<int, float, cusp::host_memory> F(E);
+
+    ASSERT_EQUAL(F.num_entries,    A.num_entries);
+    ASSERT_EQUAL(F.row_offsets,    A.row_offsets);
+    ASSERT_EQUAL(F.column_indices, A.column_indices);
+    ASSERT_EQUAL(F.values,         A.values);
+}
+
+template <class Space>
+void TestConvertLargeMatrix(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    cusp::gallery::random(A, 1000, 800, 20000);
+
+    verify_round_trip_conversion< cusp::coo_matrix<int, float, Space> >(A);
+    verify_round_trip_conversion< cusp::ell_matrix<int, float, Space> >(A);
+    verify_round_trip_conversion< cusp::hyb_matrix<int, float, Space> >(A);
+
+    cusp::csr_matrix<int, float, cusp::host_memory> P;
+    cusp::gallery::poisson5pt(P, 40, 50);
+
+    verify_round_trip_conversion< cusp::dia_matrix<int, float, Space> >(P);
+    verify_round_trip_conversion< cusp::hyb_matrix<int, float, Space> >(P);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestConvertLargeMatrix);
+
 template <class Matrix>
 void TestConversionFromArray1dTo(void)
 {
@@ -689,3 +735,35 @@ void TestConvertDispatch()
 }
 DECLARE_UNITTEST(TestConvertDispatch);
 
+
+class my_format_system : public thrust::device_execution_policy<my_format_system>
+{
+public:
+    my_format_system(void)
+        : dispatched(false)
+    {}
+
+    bool dispatched;
+};
+
+template <typename MatrixType1, typename MatrixType2>
+void convert(my_format_system& system, const MatrixType1& A, MatrixType2& B,
+             cusp::csr_format&, cusp::hyb_format&)
+{
+    system.dispatched = true;
+}
+
+void TestConvertFormatDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::hyb_matrix<int, float, cusp::device_memory> B;
+
+    my_format_system sys;
+
+    // the generic convert must forward to the format overload of the derived policy
+    cusp::convert(sys, A, B);
+
+    ASSERT_EQUAL(true, sys.dispatched);
+}
+DECLARE_UNITTEST(TestConvertFormatDispatch);
@@ -0,0 +1,280 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array2d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csc_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/format_utils.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
+#include <cusp/verify.h>
+
+#include <thrust/fill.h>
+
+// matrix with empty rows, empty columns and a few dense columns
+template <typename MatrixType>
+void initialize_column_matrix(MatrixType& A, const size_t num_rows, const size_t num_cols)
+{
+    cusp::array2d<float, cusp::host_memory> D(num_rows, num_cols, 0);
+
+    for(size_t j = 0; j < num_cols; j++)
+    {
+        if(j % 5 == 3)
+            continue;
+
+        for(size_t i = 0; i < num_rows; i++)
+        {
+            if(i % 13 == 7)
+                continue;
+
+            if(j % 11 == 0 || (i + 3 * j) % 7 == 0 || i == j)
+                D(i,j) = int((i + 2 * j) % 9) - 4 + (i == j ? 10 : 0);
+        }
+    }
+
+    A = D;
+}
+
+template <class Space>
+void TestCscMatrixBasicConstructor(void)
+{
+    cusp::csc_matrix<int, float, Space> matrix(3, 2, 6);
+
+    ASSERT_EQUAL(matrix.num_rows,              3);
+    ASSERT_EQUAL(matrix.num_cols,              2);
+    ASSERT_EQUAL(matrix.num_entries,           6);
+    ASSERT_EQUAL(matrix.column_offsets.size(), 3);
+    ASSERT_EQUAL(matrix.row_indices.size(),    6);
+    ASSERT_EQUAL(matrix.values.size(),         6);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCscMatrixBasicConstructor);
+
+template <class Space>
+void TestCscMatrixSwap(void)
+{
+    cusp::csc_matrix<int, float, Space> A(1, 2, 3);
+    cusp::csc_matrix<int, float, Space> B(4, 5, 6);
+
+    A.swap(B);
+
+    ASSERT_EQUAL(A.num_rows,              4);
+    ASSERT_EQUAL(A.num_cols,              5);
+    ASSERT_EQUAL(A.num_entries,           6);
+    ASSERT_EQUAL(A.column_offsets.size(), 6);
+    ASSERT_EQUAL(A.row_indices.size(),    6);
+    ASSERT_EQUAL(B.num_rows,              1);
+    ASSERT_EQUAL(B.num_cols,              2);
+    ASSERT_EQUAL(B.num_entries,           3);
+    ASSERT_EQUAL(B.column_offsets.size(), 3);
+    ASSERT_EQUAL(B.row_indices.size(),    3);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCscMatrixSwap);
+
+template <class Space>
+void TestCscMatrixConvert(void)
+{
+    typedef cusp::csc_matrix<int, float, Space> CscMatrix;
+
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    initialize_column_matrix(A, 60, 45);
+
+    cusp::array2d<float, cusp::host_memory> D(A);
+
+    // csr -> csc
+    CscMatrix B(A);
+
+    ASSERT_EQUAL(B.num_entries, A.num_entries);
+    ASSERT_EQUAL(cusp::is_valid_matrix(B), true);
+
+    // the rows of every column are sorted
+    cusp::csc_matrix<int, float, cusp::host_memory> H(B);
+    for(size_t j = 0; j < H.num_cols; j++)
+        for(int jj = H.column_offsets[j] + 1; jj < H.column_offsets[j + 1]; jj++)
+            ASSERT_EQUAL(H.row_indices[jj - 1] < H.row_indices[jj], true);
+
+    // csc -> array2d
+    ASSERT_EQUAL(D == cusp::array2d<float, cusp::host_memory>(B), true);
+
+    // csc -> csr
+    cusp::csr_matrix<int, float, cusp::host_memory> C(B);
+    ASSERT_EQUAL(C.row_offsets,    A.row_offsets);
+    ASSERT_EQUAL(C.column_indices, A.column_indices);
+    ASSERT_EQUAL(C.values,         A.values);
+
+    // csc -> coo
+    cusp::coo_matrix<int, float, cusp::host_memory> E(A);
+    cusp::coo_matrix<int, float, cusp::host_memory> F(B);
+    ASSERT_EQUAL(F.row_indices,    E.row_indices);
+    ASSERT_EQUAL(F.column_indices, E.column_indices);
+    ASSERT_EQUAL(F.values,         E.values);
+
+    // coo -> csc
+    CscMatrix G(E);
+    ASSERT_EQUAL(G.column_offsets, B.column_offsets);
+    ASSERT_EQUAL(G.row_indices,    B.row_indices);
+    ASSERT_EQUAL(G.values,         B.values);
+
+    // array2d -> csc
+    CscMatrix K;
+    K = D;
+    ASSERT_EQUAL(K.column_offsets, B.column_offsets);
+    ASSERT_EQUAL(K.row_indices,    B.row_indices);
+    ASSERT_EQUAL(K.values,         B.values);
+
+    // empty matrix
+    cusp::csr_matrix<int, float, cusp::host_memory> Z(4, 3, 0);
+    thrust::fill(Z.row_offsets.begin(), Z.row_offsets.end(), 0);
+
+    CscMatrix L(Z);
+    ASSERT_EQUAL(L.column_offsets, cusp::array1d<int, Space>(4, 0));
+    ASSERT_EQUAL(cusp::is_valid_matrix(L), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCscMatrixConvert);
+
+template <class Space>
+void TestCscMatrixView(void)
+{
+    typedef cusp::csc_matrix<int, float, Space> CscMatrix;
+    typedef typename CscMatrix::view            View;
+
+    CscMatrix A;
+    initialize_column_matrix(A, 30, 20);
+
+    View V = cusp::make_csc_matrix_view(A);
+
+    ASSERT_EQUAL(V.num_rows,    A.num_rows);
+    ASSERT_EQUAL(V.num_cols,    A.num_cols);
+    ASSERT_EQUAL(V.num_entries, A.num_entries);
+
+    V.values[0] = 17;
+    ASSERT_EQUAL(A.values[0], 17);
+
+    cusp::array1d<float, Space> x = unittest::random_samples<float>(A.num_cols);
+    cusp::array1d<float, Space> y1(A.num_rows);
+    cusp::array1d<float, Space> y2(A.num_rows);
+
+    cusp::multiply(A, x, y1);
+    cusp::multiply(V, x, y2);
+
+    ASSERT_EQUAL(y1, y2);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCscMatrixView);
+
+template <class Space>
+void TestCscMatrixTransposeView(void)
+{
+    cusp::csr_matrix<int, float, Space> A;
+    initialize_column_matrix(A, 40, 25);
+
+    cusp::csr_matrix<int, float, Space> At;
+    cusp::transpose(A, At);
+
+    // the arrays of A are the CSC arrays of its transpose
+    typename cusp::csc_matrix<int, float, Space>::view V = cusp::make_transpose_view(A);
+
+    ASSERT_EQUAL(V.num_rows,    A.num_cols);
+    ASSERT_EQUAL(V.num_cols,    A.num_rows);
+    ASSERT_EQUAL(V.num_entries, A.num_entries);
+    ASSERT_EQUAL(cusp::is_valid_matrix(V), true);
+    ASSERT_EQUAL(cusp::array2d<float, cusp::host_memory>(V) == cusp::array2d<float, cusp::host_memory>(At), true);
+
+    cusp::array1d<float, cusp::host_memory> x(A.num_rows);
+    for(size_t i = 0; i < x.size(); i++)
+        x[i] = int(i % 5) - 2;
+
+    cusp::array1d<float, Space> x_space(x);
+    cusp::array1d<float, Space> y1(A.num_cols);
+    cusp::array1d<float, Space> y2(A.num_cols, 10);
+
+    cusp::multiply(At, x_space, y1);
+    cusp::multiply(V,  x_space, y2);
+
+    ASSERT_EQUAL(y1, y2);
+
+    // and the arrays of a csc_matrix are the CSR arrays of its transpose
+    cusp::csc_matrix<int, float, Space> B(A);
+
+    typename cusp::csr_matrix<int, float, Space>::view W = cusp::make_transpose_view(B);
+
+    ASSERT_EQUAL(W.num_rows, A.num_cols);
+    ASSERT_EQUAL(W.num_cols, A.num_rows);
+    ASSERT_EQUAL(cusp::array1d<int,   Space>(W.row_offsets),    At.row_offsets);
+    ASSERT_EQUAL(cusp::array1d<int,   Space>(W.column_indices), At.column_indices);
+    ASSERT_EQUAL(cusp::array1d<float, Space>(W.values),         At.values);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCscMatrixTransposeView);
+
+template <class Space>
+void TestCscMatrixMultiply(void)
+{
+    const size_t sizes[4][2] = {{1, 1}, {7, 30}, {100, 60}, {523, 611}};
+
+    for(size_t n = 0; n < 4; n++)
+    {
+        cusp::csr_matrix<int, float, cusp::host_memory> A;
+        initialize_column_matrix(A, sizes[n][0], sizes[n][1]);
+
+        cusp::csc_matrix<int, float, Space> B(A);
+
+        cusp::array1d<float, cusp::host_memory> x(A.num_cols);
+        cusp::array1d<float, cusp::host_memory> y(A.num_rows);
+
+        for(size_t i = 0; i < x.size(); i++)
+            x[i] = int(i % 7) - 3;
+
+        cusp::multiply(A, x, y);
+
+        cusp::array1d<float, Space> x_csc(x);
+        cusp::array1d<float, Space> y_csc(A.num_rows, 10);
+        cusp::multiply(B, x_csc, y_csc);
+
+        ASSERT_EQUAL(y_csc, y);
+    }
+
+    // empty matrix
+    cusp::csc_matrix<int, float, Space> E(20, 10, 0);
+    thrust::fill(E.column_offsets.begin(), E.column_offsets.end(), 0);
+
+    cusp::array1d<float, Space> x(10, 1);
+    cusp::array1d<float, Space> y(20, 10);
+    cusp::multiply(E, x, y);
+
+    ASSERT_EQUAL(y, cusp::array1d<float, Space>(20, 0));
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCscMatrixMultiply);
+
+template <class Space>
+void TestCscMatrixExtractDiagonal(void)
+{
+    cusp::csr_matrix<int, float, Space> A;
+    initialize_column_matrix(A, 40, 30);
+
+    cusp::csc_matrix<int, float, Space> B(A);
+
+    cusp::array1d<float, Space> expected(30);
+    cusp::array1d<float, Space> diagonal(30);
+
+    cusp::extract_diagonal(A, expected);
+    cusp::extract_diagonal(B, diagonal);
+
+    ASSERT_EQUAL(diagonal, expected);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCscMatrixExtractDiagonal);
+
+template <class Space>
+void TestCscMatrixTranspose(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    initialize_column_matrix(A, 35, 20);
+
+    cusp::array2d<float, cusp::host_memory> Dt;
+    cusp::transpose(cusp::array2d<float, cusp::host_memory>(A), Dt);
+
+    cusp::csc_matrix<int, float, Space> B(A);
+    cusp::csc_matrix<int, float, Space> Bt;
+    cusp::transpose(B, Bt);
+
+    ASSERT_EQUAL(cusp::is_valid_matrix(Bt), true);
+    ASSERT_EQUAL(Dt == cusp::array2d<float, cusp::host_memory>(Bt), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCscMatrixTranspose);
@@ -2,19 +2,29 @@
 
 #include <cusp/detail/format.h>
 
+#include <cusp/bsr_matrix.h>
+#include <cusp/compressed_csr_matrix.h>
 #include <cusp/coo_matrix.h>
+#include <cusp/csc_matrix.h>
 #include <cusp/csr_matrix.h>
 #include <cusp/dia_matrix.h>
 #include <cusp/ell_matrix.h>
 #include <cusp/hyb_matrix.h>
+#include <cusp/sell_matrix.h>
+#include <cusp/symmetric_csr_matrix.h>
 
 typedef cusp::array1d<float, cusp::host_memory> A1D;
 typedef cusp::array2d<float, cusp::host_memory> A2D;
+typedef cusp::bsr_matrix<int, float, cusp::host_memory> BSR;
+typedef cusp::compressed_csr_matrix<int, float, cusp::host_memory> CCSR;
 typedef cusp::coo_matrix<int, float, cusp::host_memory> COO;
+typedef cusp::csc_matrix<int, float, cusp::host_memory> CSC;
 typedef cusp::csr_matrix<int, float, cusp::host_memory> CSR;
 typedef cusp::dia_matrix<int, float, cusp::host_memory> DIA;
 typedef cusp::ell_matrix<int, float, cusp::host_memory> ELL;
 typedef cusp::hyb_matrix<int, float, cusp::host_memory> HYB;
+typedef cusp::sell_matrix<int, float, cusp::host_memory> SELL;
+typedef cusp::symmetric_csr_matrix<int, float, cusp::host_memory> SYM;
 
 void TestMatrixFormatArray1d(void)
 {
@@ -36,6 +46,16 @@ void TestMatrixFormatArray2d(void)
 }
 DECLARE_UNITTEST(TestMatrixFormatArray2d);
 
+void TestMatrixFormatBsrMatrix(void)
+{
+    typedef BSR::format format;
+    ASSERT_EQUAL((bool) (thrust::detail::is_same<format,cusp::bsr_format>::value), true);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::sparse_format>::value), true);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::dense_format>::value), false);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::known_format>::value), true);
+}
+DECLARE_UNITTEST(TestMatrixFormatBsrMatrix);
+
 void TestMatrixFormatCooMatrix(void)
 {
     typedef COO::format format;
@@ -46,6 +66,17 @@ void TestMatrixFormatCooMatrix(void)
 }
 DECLARE_UNITTEST(TestMatrixFormatCooMatrix);
 
+void TestMatrixFormatCscMatrix(void)
+{
+    typedef CSC::format format;
+    ASSERT_EQUAL((bool) (thrust::detail::is_same<format,cusp::csc_format>::value), true);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::csr_format>::value), false);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::sparse_format>::value), true);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::dense_format>::value), false);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::known_format>::value), true);
+}
+DECLARE_UNITTEST(TestMatrixFormatCscMatrix);
+
 void TestMatrixFormatCsrMatrix(void)
 {
     typedef CSR::format format;
@@ -86,3 +117,34 @@ void TestMatrixFormatHybMatrix(void)
 }
 DECLARE_UNITTEST(TestMatrixFormatHybMatrix);
 
+void TestMatrixFormatSellMatrix(void)
+{
+    typedef SELL::format format;
+    ASSERT_EQUAL((bool) (thrust::detail::is_same<format,cusp::sell_format>::value), true);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::sparse_format>::value), true);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::dense_format>::value), false);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::known_format>::value), true);
+}
+DECLARE_UNITTEST(TestMatrixFormatSellMatrix);
+
+void TestMatrixFormatSymmetricCsrMatrix(void)
+{
+    typedef SYM::format format;
+    ASSERT_EQUAL((bool) (thrust::detail::is_same<format,cusp::symmetric_csr_format>::value), true);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::csr_format>::value), false);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::sparse_format>::value), true);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::dense_format>::value), false);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::known_format>::value), true);
+}
+DECLARE_UNITTEST(TestMatrixFormatSymmetricCsrMatrix);
+
+void TestMatrixFormatCompressedCsrMatrix(void)
+{
+    typedef CCSR::format format;
+    ASSERT_EQUAL((bool) (thrust::detail::is_same<format,cusp::compressed_csr_format>::value), true);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::csr_format>::value), false);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::sparse_format>::value), true);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::dense_format>::value), false);
+    ASSERT_EQUAL((bool) (thrust::detail::is_convertible<format,cusp::known_format>::value), true);
+}
+DECLARE_UNITTEST(TestMatrixFormatCompressedCsrMatrix);
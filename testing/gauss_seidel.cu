@@ -1,6 +1,7 @@
 #include <unittest/unittest.h>
 
 #include <cusp/relaxation/gauss_seidel.h>
+#include <cusp/relaxation/sor.h>
 
 #include <cusp/array2d.h>
 #include <cusp/coo_matrix.h>
@@ -9,6 +10,8 @@
 #include <cusp/ell_matrix.h>
 #include <cusp/hyb_matrix.h>
 
+#include <cusp/gallery/poisson.h>
+
 template <typename Space>
 void TestGaussSeidelRelaxation(void)
 {
@@ -96,3 +99,62 @@ void TestGaussSeidelRelaxationSweeps(void)
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestGaussSeidelRelaxationSweeps);
 
+
+template <typename Space>
+void TestGaussSeidelRelaxationReordered(void)
+{
+    cusp::csr_matrix<int, float, Space> A;
+    cusp::gallery::poisson5pt(A, 20, 30);
+
+    cusp::array1d<float, Space> b(A.num_rows, 1.0);
+
+    // symmetric sweeps
+    {
+        cusp::array1d<float, Space> x(A.num_rows, 0.0);
+        cusp::array1d<float, Space> y(A.num_rows, 0.0);
+
+        cusp::relaxation::gauss_seidel<float, Space> relax1(A);
+        cusp::relaxation::gauss_seidel<float, Space> relax2(A, cusp::relaxation::SYMMETRIC, true);
+
+        ASSERT_EQUAL(relax2.reordered_matrix.num_entries, A.num_entries);
+
+        for(int i = 0; i < 3; i++)
+        {
+            relax1(A, b, x);
+            relax2(A, b, y);
+        }
+
+        ASSERT_ALMOST_EQUAL(x, y);
+    }
+
+    // SOR with a backward sweep
+    {
+        cusp::array1d<float, Space> x(A.num_rows, 0.0);
+        cusp::array1d<float, Space> y(A.num_rows, 0.0);
+
+        cusp::relaxation::sor<float, Space> relax1(A, 1.25, cusp::relaxation::BACKWARD);
+        cusp::relaxation::sor<float, Space> relax2(A, 1.25, cusp::relaxation::BACKWARD, true);
+
+        for(int i = 0; i < 3; i++)
+        {
+            relax1(A, b, x);
+            relax2(A, b, y);
+        }
+
+        ASSERT_ALMOST_EQUAL(x, y);
+    }
+
+    // the stored copy must match the matrix passed to the sweep
+    {
+        cusp::csr_matrix<int, float, Space> B;
+        cusp::gallery::poisson5pt(B, 10, 10);
+
+        cusp::array1d<float, Space> x(B.num_rows, 0.0);
+        cusp::array1d<float, Space> c(B.num_rows, 1.0);
+
+        cusp::relaxation::gauss_seidel<float, Space> relax(A, cusp::relaxation::FORWARD, true);
+
+        ASSERT_THROWS(relax(B, c, x), cusp::invalid_input_exception);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestGaussSeidelRelaxationReordered);
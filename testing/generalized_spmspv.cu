@@ -0,0 +1,273 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array1d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csc_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+#include <cusp/sparse_vector.h>
+#include <cusp/transpose.h>
+#include <cusp/gallery/poisson.h>
+#include <cusp/gallery/random.h>
+
+#include <thrust/functional.h>
+
+template <typename ValueType>
+struct spmspv_min
+{
+    __host__ __device__
+    ValueType operator()(const ValueType a, const ValueType b) const
+    {
+        return a < b ? a : b;
+    }
+};
+
+template <typename SparseVector, typename ValueType>
+cusp::array1d<ValueType, cusp::host_memory>
+spmspv_to_dense(const SparseVector& v, const ValueType initial)
+{
+    cusp::sparse_vector<int, ValueType, cusp::host_memory> h(v);
+    cusp::array1d<ValueType, cusp::host_memory> dense(h.length, initial);
+
+    for(size_t i = 0; i < h.num_entries; i++)
+        dense[h.indices[i]] = h.values[i];
+
+    return dense;
+}
+
+template <typename HostMatrix>
+void spmspv_test_matrices(std::vector<HostMatrix>& matrices)
+{
+    {
+        HostMatrix M;
+        cusp::gallery::poisson5pt(M,  10,  10);
+        matrices.push_back(M);
+    }
+    {
+        HostMatrix M;
+        cusp::gallery::poisson5pt(M, 117, 113);
+        matrices.push_back(M);
+    }
+    {
+        HostMatrix M;
+        cusp::gallery::random(M,  21,  23,   5);
+        matrices.push_back(M);
+    }
+    {
+        HostMatrix M;
+        cusp::gallery::random(M, 355, 378, 234);
+        matrices.push_back(M);
+    }
+    {
+        HostMatrix M(40, 30, 0);
+        matrices.push_back(M);
+    }
+}
+
+template <typename MemorySpace, typename Accumulator>
+void TestGeneralizedSpMSpV(Accumulator accumulator)
+{
+    typedef int   IndexType;
+    typedef float ValueType;
+
+    typedef cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> HostMatrix;
+    typedef cusp::csr_matrix<IndexType, ValueType, MemorySpace>       TestMatrix;
+    typedef cusp::sparse_vector<IndexType, ValueType, MemorySpace>    SparseVector;
+
+    std::vector<HostMatrix> matrices;
+    spmspv_test_matrices(matrices);
+
+    thrust::multiplies<ValueType> combine;
+    thrust::plus<ValueType>       reduce;
+
+    for(size_t i = 0; i < matrices.size(); i++)
+    {
+        TestMatrix A = matrices[i];
+        TestMatrix At;
+        cusp::transpose(A, At);
+
+        // sparse input vectors with roughly one nonzero in three entries
+        cusp::array1d<ValueType, cusp::host_memory> u = unittest::random_integers<char>(A.num_cols);
+        cusp::array1d<ValueType, cusp::host_memory> v = unittest::random_integers<char>(A.num_rows);
+
+        for(size_t k = 0; k < u.size(); k++) if(k % 3) u[k] = 0;
+        for(size_t k = 0; k < v.size(); k++) if(k % 3) v[k] = 0;
+
+        SparseVector x(u);
+        SparseVector w(v);
+        SparseVector y;
+
+        // y = A * x
+        cusp::generalized_spmspv(A, x, y, combine, reduce, accumulator);
+
+        cusp::array1d<ValueType, cusp::host_memory> reference(A.num_rows, ValueType(0));
+        cusp::multiply(matrices[i], u, reference);
+
+        ASSERT_EQUAL(y.length, A.num_rows);
+        ASSERT_EQUAL(spmspv_to_dense(y, ValueType(0)), reference);
+
+        // y = w * A
+        cusp::generalized_spmspv(w, A, y, combine, reduce, accumulator);
+
+        HostMatrix Bt = At;
+        reference.resize(A.num_cols);
+        cusp::multiply(Bt, v, reference);
+
+        ASSERT_EQUAL(y.length, A.num_cols);
+        ASSERT_EQUAL(spmspv_to_dense(y, ValueType(0)), reference);
+
+        // the same products with A in CSC
+        cusp::csc_matrix<IndexType, ValueType, MemorySpace> C(A);
+
+        cusp::generalized_spmspv(w, C, y, combine, reduce, accumulator);
+
+        ASSERT_EQUAL(y.length, A.num_cols);
+        ASSERT_EQUAL(spmspv_to_dense(y, ValueType(0)), reference);
+
+        cusp::generalized_spmspv(C, x, y, combine, reduce, accumulator);
+
+        reference.resize(A.num_rows);
+        cusp::multiply(matrices[i], u, reference);
+
+        ASSERT_EQUAL(y.length, A.num_rows);
+        ASSERT_EQUAL(spmspv_to_dense(y, ValueType(0)), reference);
+    }
+}
+
+template <typename MemorySpace>
+void TestGeneralizedSpMSpVDefault(void)
+{
+    TestGeneralizedSpMSpV<MemorySpace>(cusp::default_accumulator());
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestGeneralizedSpMSpVDefault);
+
+template <typename MemorySpace>
+void TestGeneralizedSpMSpVSort(void)
+{
+    TestGeneralizedSpMSpV<MemorySpace>(cusp::sort_accumulator());
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestGeneralizedSpMSpVSort);
+
+template <typename MemorySpace>
+void TestGeneralizedSpMSpVBucket(void)
+{
+    TestGeneralizedSpMSpV<MemorySpace>(cusp::bucket_accumulator());
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestGeneralizedSpMSpVBucket);
+
+template <typename MemorySpace>
+void TestGeneralizedSpMSpVDense(void)
+{
+    TestGeneralizedSpMSpV<MemorySpace>(cusp::dense_accumulator());
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestGeneralizedSpMSpVDense);
+
+template <typename MemorySpace>
+void TestGeneralizedSpMSpVMinPlus(void)
+{
+    typedef int   IndexType;
+    typedef float ValueType;
+
+    // 0 --1--> 1 --2--> 2
+    //  \               ^
+    //   -------5-------
+    cusp::coo_matrix<IndexType, ValueType, MemorySpace> A(3, 3, 3);
+    A.row_indices[0] = 0; A.column_indices[0] = 1; A.values[0] = 1;
+    A.row_indices[1] = 0; A.column_indices[1] = 2; A.values[1] = 5;
+    A.row_indices[2] = 1; A.column_indices[2] = 2; A.values[2] = 2;
+
+    cusp::sparse_vector<IndexType, ValueType, MemorySpace> x(3, 2);
+    x.indices[0] = 0; x.values[0] = 0;
+    x.indices[1] = 1; x.values[1] = 1;
+
+    cusp::sparse_vector<IndexType, ValueType, MemorySpace> y;
+
+    // relax the out edges of vertices 0 and 1
+    cusp::generalized_spmspv(x, A, y, thrust::plus<ValueType>(), spmspv_min<ValueType>());
+
+    ASSERT_EQUAL(y.length,      3);
+    ASSERT_EQUAL(y.num_entries, 2);
+    ASSERT_EQUAL(y.indices[0],  1);
+    ASSERT_EQUAL(y.indices[1],  2);
+    ASSERT_EQUAL(y.values[0],   1);
+    ASSERT_EQUAL(y.values[1],   3);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestGeneralizedSpMSpVMinPlus);
+
+template <typename MemorySpace>
+void TestMultiplySparseVector(void)
+{
+    typedef int   IndexType;
+    typedef float ValueType;
+
+    cusp::coo_matrix<IndexType, ValueType, cusp::host_memory> H;
+    cusp::gallery::poisson5pt(H, 5, 5);
+
+    cusp::coo_matrix<IndexType, ValueType, MemorySpace> A(H);
+
+    cusp::array1d<ValueType, cusp::host_memory> u(A.num_cols, ValueType(0));
+    u[3]  = 1;
+    u[12] = 2;
+
+    cusp::sparse_vector<IndexType, ValueType, MemorySpace> x(u);
+    cusp::sparse_vector<IndexType, ValueType, MemorySpace> y;
+
+    cusp::multiply(A, x, y);
+
+    cusp::array1d<ValueType, cusp::host_memory> reference(A.num_rows);
+    cusp::multiply(H, u, reference);
+
+    ASSERT_EQUAL(spmspv_to_dense(y, ValueType(0)), reference);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestMultiplySparseVector);
+
+template <typename MemorySpace>
+void TestGeneralizedSpMSpVDimensions(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A(4, 3, 0);
+    cusp::sparse_vector<int, float, MemorySpace> x(4, 0);
+    cusp::sparse_vector<int, float, MemorySpace> y;
+
+    ASSERT_THROWS(cusp::generalized_spmspv(A, x, y, thrust::multiplies<float>(), thrust::plus<float>()),
+                  cusp::invalid_input_exception);
+
+    cusp::sparse_vector<int, float, MemorySpace> w(3, 0);
+
+    ASSERT_THROWS(cusp::generalized_spmspv(w, A, y, thrust::multiplies<float>(), thrust::plus<float>()),
+                  cusp::invalid_input_exception);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestGeneralizedSpMSpVDimensions);
+
+template <typename LinearOperator,
+         typename Vector1,
+         typename Vector2,
+         typename BinaryFunction1,
+         typename BinaryFunction2,
+         typename Accumulator>
+void generalized_spmspv(my_system &system,
+                        const LinearOperator&  A,
+                        const Vector1& x,
+                        Vector2& y,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce,
+                        Accumulator accumulator)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestGeneralizedSpMSpVDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::sparse_vector<int, float, cusp::device_memory> x;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::generalized_spmspv(sys, A, x, x, thrust::multiplies<float>(), thrust::plus<float>());
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestGeneralizedSpMSpVDispatch);
@@ -2,7 +2,77 @@
 
 #include <cusp/graph/hilbert_curve.h>
 
+#include <cusp/array1d.h>
 #include <cusp/array2d.h>
+#include <cusp/permutation_matrix.h>
+
+#include <algorithm>
+#include <cmath>
+
+template <class Space>
+void TestHilbertCurve(void)
+{
+    for(int dims = 2; dims <= 3; dims++)
+    {
+        const int N          = dims == 2 ? 64 : 16;
+        const int num_points = dims == 2 ? N * N : N * N * N;
+        const int num_parts  = 5;
+
+        // points of a uniform grid in [0,1]
+        cusp::array2d<float, cusp::host_memory> h_coords(num_points, dims);
+        for(int i = 0; i < num_points; i++)
+        {
+            h_coords(i, 0) = ((i % N) + 0.5f) / N;
+            h_coords(i, 1) = (((i / N) % N) + 0.5f) / N;
+            if(dims == 3) h_coords(i, 2) = ((i / (N * N)) + 0.5f) / N;
+        }
+
+        cusp::array2d<float, Space> coords(h_coords);
+        cusp::array1d<int, Space> parts(num_points);
+        cusp::permutation_matrix<int, Space> P;
+
+        cusp::graph::hilbert_curve(coords, num_parts, parts, P);
+
+        cusp::array1d<int, cusp::host_memory> h_parts(parts);
+        cusp::array1d<int, cusp::host_memory> permutation(P.permutation);
+
+        ASSERT_EQUAL(P.num_rows, size_t(num_points));
+
+        // the permutation is valid and every part is a contiguous piece of
+        // the curve
+        cusp::array1d<int, cusp::host_memory> sorted(permutation);
+        std::sort(sorted.begin(), sorted.end());
+
+        cusp::array1d<int, cusp::host_memory> reference(num_points);
+        for(int i = 0; i < num_points; i++)
+            reference[i] = i;
+
+        ASSERT_EQUAL(sorted, reference);
+
+        for(int i = 0; i < num_points; i++)
+            reference[i] = permutation[i] * num_parts / num_points;
+
+        ASSERT_EQUAL(h_parts, reference);
+
+        // consecutive points on the curve are neighbors in the grid
+        cusp::array1d<int, cusp::host_memory> order(num_points);
+        for(int i = 0; i < num_points; i++)
+            order[permutation[i]] = i;
+
+        bool adjacent = true;
+        for(int k = 1; k < num_points; k++)
+        {
+            float distance = 0;
+            for(int d = 0; d < dims; d++)
+                distance += std::abs(h_coords(order[k], d) - h_coords(order[k - 1], d));
+
+            adjacent = adjacent && distance * N < 1.5f;
+        }
+
+        ASSERT_EQUAL(adjacent, true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestHilbertCurve);
 
 template <typename Array2dType, typename ArrayType>
 void hilbert_curve(my_system& system, const Array2dType& coord, const size_t num_parts, ArrayType& parts)
@@ -4,7 +4,9 @@
 
 #include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
+#include <cusp/symmetric_csr_matrix.h>
 #include <cusp/array2d.h>
+#include <cusp/verify.h>
 
 #include <stdio.h>
 
@@ -254,6 +256,22 @@ void TestReadMatrixMarketFileToCsrMatrix(void)
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestReadMatrixMarketFileToCsrMatrix);
 
+template <typename MemorySpace>
+void TestReadMatrixMarketFileToSymmetricCsrMatrix(void)
+{
+    cusp::coo_matrix<int, float, cusp::host_memory> coo;
+    cusp::io::read_matrix_market_file(coo, "../data/test/coordinate_pattern_symmetric.mtx");
+
+    // the stored triangle is not expanded
+    cusp::symmetric_csr_matrix<int, float, MemorySpace> A;
+    cusp::io::read_matrix_market_file(A, "../data/test/coordinate_pattern_symmetric.mtx");
+
+    ASSERT_EQUAL(A.num_entries, 7);
+    ASSERT_EQUAL(cusp::is_valid_matrix(A), true);
+    ASSERT_EQUAL(cusp::array2d<float, cusp::host_memory>(A) == cusp::array2d<float, cusp::host_memory>(coo), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestReadMatrixMarketFileToSymmetricCsrMatrix);
+
 template <typename MemorySpace>
 void TestWriteMatrixMarketFileCoordinateRealGeneral(void)
 {
@@ -324,3 +342,37 @@ void TestWriteMatrixMarketFileCoordinateComplexGeneral(void)
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestWriteMatrixMarketFileCoordinateComplexGeneral);
 
+template <typename MemorySpace>
+void TestWriteMatrixMarketFileCoordinateRealSymmetric(void)
+{
+    // initial matrix
+    cusp::array2d<float, cusp::host_memory> E(3, 3);
+    E(0,0) =  1.000e+00;
+    E(0,1) =  2.500e-01;
+    E(0,2) =  0.000e+00;
+    E(1,0) =  2.500e-01;
+    E(1,1) =  0.000e+00;
+    E(1,2) = -3.000e+00;
+    E(2,0) =  0.000e+00;
+    E(2,1) = -3.000e+00;
+    E(2,2) =  1.050e+01;
+
+    // write the upper triangle to file
+    cusp::symmetric_csr_matrix<int, float, MemorySpace> A(E);
+    cusp::io::write_matrix_market_file(A, random_file_name);
+
+    // read file back in both formats
+    cusp::symmetric_csr_matrix<int, float, MemorySpace> B;
+    cusp::io::read_matrix_market_file(B, random_file_name);
+
+    cusp::coo_matrix<int, float, MemorySpace> coo;
+    cusp::io::read_matrix_market_file(coo, random_file_name);
+
+    remove(random_file_name);
+
+    // compare to initial matrix
+    ASSERT_EQUAL(B.num_entries, 4);
+    ASSERT_EQUAL(cusp::array2d<float, cusp::host_memory>(B) == E, true);
+    ASSERT_EQUAL(cusp::array2d<float, cusp::host_memory>(coo) == E, true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestWriteMatrixMarketFileCoordinateRealSymmetric);
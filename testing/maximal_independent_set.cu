@@ -11,6 +11,10 @@
 #include <cusp/multiply.h>
 #include <cusp/gallery/poisson.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // check whether the MIS is valid
 template <typename MatrixType, typename ArrayType>
 bool is_valid_mis(MatrixType& A, ArrayType& stencil)
@@ -181,3 +185,56 @@ void TestMaximalIndependentSet(void)
 }
 DECLARE_SPARSE_MATRIX_UNITTEST(TestMaximalIndependentSet);
 
+template <typename Space>
+void TestMaximalIndependentSetDeterministic(void)
+{
+    // the parallel backends rank the vertices with fixed random values, so
+    // repeated runs must return the same set whatever the number of threads
+    cusp::csr_matrix<int, float, cusp::host_memory> h_G;
+    cusp::gallery::poisson5pt(h_G, 150, 160);
+    thrust::fill(h_G.values.begin(), h_G.values.end(), 1.0f);
+
+    cusp::csr_matrix<int, float, Space> G(h_G);
+
+    cusp::coo_matrix<int, float, Space> G2;
+    cusp::multiply(G, G, G2);
+
+#ifdef _OPENMP
+    const int max_threads = omp_get_max_threads();
+#endif
+
+    for(size_t k = 1; k <= 2; k++)
+    {
+        cusp::array1d<int, Space> reference(G.num_rows);
+        cusp::array1d<int, Space> stencil(G.num_rows);
+
+#ifdef _OPENMP
+        omp_set_num_threads(1);
+#endif
+        size_t reference_nodes = cusp::graph::maximal_independent_set(G, reference, k);
+
+#ifdef _OPENMP
+        omp_set_num_threads(max_threads > 1 ? max_threads : 4);
+#endif
+        size_t num_nodes = cusp::graph::maximal_independent_set(G, stencil, k);
+
+#ifdef _OPENMP
+        omp_set_num_threads(max_threads);
+#endif
+
+        if(k == 1)
+        {
+            ASSERT_EQUAL(is_valid_mis(G, reference), true);
+            ASSERT_EQUAL(is_valid_mis(G, stencil), true);
+        }
+        else
+        {
+            ASSERT_EQUAL(is_valid_mis(G2, reference), true);
+            ASSERT_EQUAL(is_valid_mis(G2, stencil), true);
+        }
+
+        ASSERT_EQUAL(num_nodes, reference_nodes);
+        ASSERT_EQUAL(stencil, reference);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestMaximalIndependentSetDeterministic);
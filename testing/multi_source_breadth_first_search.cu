@@ -0,0 +1,78 @@
+#include <unittest/unittest.h>
+
+#include <cusp/graph/multi_source_breadth_first_search.h>
+#include <cusp/graph/breadth_first_search.h>
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/csr_matrix.h>
+
+#include <cusp/gallery/poisson.h>
+
+template <class MatrixType>
+void TestMultiSourceBreadthFirstSearch(void)
+{
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    MatrixType G;
+    cusp::gallery::poisson5pt(G, 20, 15);
+
+    // more sources than one batch, with a repeated source
+    const int num_sources = 70;
+
+    cusp::array1d<int, cusp::host_memory> h_sources(num_sources);
+    for(int s = 0; s < num_sources; s++)
+        h_sources[s] = (s * 37) % G.num_rows;
+    h_sources[6] = h_sources[5];
+
+    cusp::array1d<int, MemorySpace> sources(h_sources);
+    cusp::array2d<int, MemorySpace> levels;
+
+    cusp::graph::multi_source_breadth_first_search(G, sources, levels);
+
+    ASSERT_EQUAL(levels.num_rows, G.num_rows);
+    ASSERT_EQUAL(levels.num_cols, size_t(num_sources));
+
+    cusp::array2d<int, cusp::host_memory> h_levels(levels);
+
+    for(int s = 0; s < num_sources; s++)
+    {
+        cusp::array1d<int, MemorySpace> reference(G.num_rows);
+        cusp::graph::breadth_first_search(G, h_sources[s], reference);
+
+        cusp::array1d<int, cusp::host_memory> h_reference(reference);
+        cusp::array1d<int, cusp::host_memory> column(h_levels.column(s));
+
+        ASSERT_EQUAL(column, h_reference);
+    }
+
+    sources[0] = -1;
+    ASSERT_THROWS(cusp::graph::multi_source_breadth_first_search(G, sources, levels), cusp::invalid_input_exception);
+    sources[0] = G.num_rows;
+    ASSERT_THROWS(cusp::graph::multi_source_breadth_first_search(G, sources, levels), cusp::invalid_input_exception);
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestMultiSourceBreadthFirstSearch);
+
+template <typename MatrixType, typename ArrayType, typename Array2dType>
+void multi_source_breadth_first_search(my_system& system, const MatrixType& G, const ArrayType& sources, Array2dType& levels)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestMultiSourceBreadthFirstSearchDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> G;
+    cusp::array1d<int, cusp::device_memory> sources;
+    cusp::array2d<int, cusp::device_memory> levels;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::graph::multi_source_breadth_first_search(sys, G, sources, levels);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestMultiSourceBreadthFirstSearchDispatch);
@@ -0,0 +1,92 @@
+#include <unittest/unittest.h>
+
+#include <cusp/graph/multilevel_partition.h>
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/permutation_matrix.h>
+#include <cusp/gallery/poisson.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+template <class Space>
+void TestMultilevelPartition(void)
+{
+    const int N         = 32;
+    const int num_rows  = N * N;
+    const int num_parts = 4;
+
+    cusp::csr_matrix<int, float, Space> G;
+    cusp::gallery::poisson5pt(G, N, N);
+
+    cusp::array1d<int, Space> parts(num_rows);
+    cusp::permutation_matrix<int, Space> P;
+
+    size_t edge_cut = cusp::graph::multilevel_partition(G, num_parts, parts, P);
+
+    cusp::csr_matrix<int, float, cusp::host_memory> h_G(G);
+    cusp::array1d<int, cusp::host_memory> h_parts(parts);
+    cusp::array1d<int, cusp::host_memory> permutation(P.permutation);
+
+    // the parts have nearly equal sizes
+    cusp::array1d<int, cusp::host_memory> sizes(num_parts, 0);
+    for(int i = 0; i < num_rows; i++)
+    {
+        ASSERT_EQUAL(h_parts[i] >= 0 && h_parts[i] < num_parts, true);
+        sizes[h_parts[i]]++;
+    }
+
+    for(int p = 0; p < num_parts; p++)
+        ASSERT_EQUAL(std::abs(sizes[p] - num_rows / num_parts) <= num_rows / num_parts / 8, true);
+
+    // the returned cut matches the parts and is within a small factor of
+    // the cut of the grid into four squares
+    size_t reference_cut = 0;
+    for(int i = 0; i < num_rows; i++)
+        for(int jj = h_G.row_offsets[i]; jj < h_G.row_offsets[i + 1]; jj++)
+            if(h_parts[i] != h_parts[h_G.column_indices[jj]])
+                reference_cut++;
+
+    ASSERT_EQUAL(edge_cut, reference_cut);
+    ASSERT_EQUAL(edge_cut <= size_t(2 * 4 * N), true);
+
+    // the permutation is valid and numbers the vertices part by part
+    ASSERT_EQUAL(P.num_rows, size_t(num_rows));
+
+    cusp::array1d<int, cusp::host_memory> order(num_rows, -1);
+    for(int i = 0; i < num_rows; i++)
+    {
+        ASSERT_EQUAL(permutation[i] >= 0 && permutation[i] < num_rows, true);
+        order[permutation[i]] = i;
+    }
+
+    ASSERT_EQUAL(std::count(order.begin(), order.end(), -1), 0);
+
+    for(int k = 1; k < num_rows; k++)
+        ASSERT_EQUAL(h_parts[order[k - 1]] <= h_parts[order[k]], true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestMultilevelPartition);
+
+template <typename MatrixType, typename ArrayType>
+size_t multilevel_partition(my_system& system, const MatrixType& G, const size_t num_parts, ArrayType& parts)
+{
+    system.validate_dispatch();
+    return 0;
+}
+
+void TestMultilevelPartitionDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> G;
+    cusp::array1d<int, cusp::device_memory> parts;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::graph::multilevel_partition(sys, G, 0, parts);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestMultilevelPartitionDispatch);
@@ -97,6 +97,13 @@ void TestSparseMatrixMatrixMultiply(void)
     cusp::array2d<ValueType,cusp::host_memory> K;
     cusp::gallery::random(K, 24, 12, 20);
 
+    // wide operands whose rows of C are much shorter than num_cols
+    cusp::array2d<ValueType,cusp::host_memory> L;
+    cusp::gallery::random(L, 8, 40, 30);
+
+    cusp::array2d<ValueType,cusp::host_memory> M;
+    cusp::gallery::random(M, 40, 600, 60);
+
     //thrust::host_vector< cusp::array2d<float,cusp::host_memory> > matrices;
     std::vector< cusp::array2d<ValueType,cusp::host_memory> > matrices;
     matrices.push_back(A);
@@ -110,6 +117,8 @@ void TestSparseMatrixMatrixMultiply(void)
     matrices.push_back(I);
     matrices.push_back(J);
     matrices.push_back(K);
+    matrices.push_back(L);
+    matrices.push_back(M);
 
     // test matrix multiply for every pair of compatible matrices
     for(size_t i = 0; i < matrices.size(); i++)
@@ -127,6 +136,30 @@ void TestSparseMatrixMatrixMultiply(void)
 }
 DECLARE_SPARSE_MATRIX_UNITTEST(TestSparseMatrixMatrixMultiply);
 
+void TestCsrMatrixMatrixMultiplySortedColumns(void)
+{
+    cusp::csr_matrix<int,float,cusp::host_memory> A;
+    cusp::gallery::random(A, 50, 200, 400);
+
+    cusp::csr_matrix<int,float,cusp::host_memory> B;
+    cusp::gallery::random(B, 200, 5000, 800);
+
+    cusp::csr_matrix<int,float,cusp::device_memory> _A(A), _B(B), _C;
+    cusp::multiply(_A, _B, _C);
+
+    cusp::csr_matrix<int,float,cusp::host_memory> C(_C);
+
+    // column indices of every row of C are in strictly increasing order
+    bool sorted = true;
+
+    for(int i = 0; i < C.num_rows; i++)
+        for(int jj = C.row_offsets[i] + 1; jj < C.row_offsets[i + 1]; jj++)
+            sorted = sorted && C.column_indices[jj - 1] < C.column_indices[jj];
+
+    ASSERT_EQUAL(sorted, true);
+}
+DECLARE_UNITTEST(TestCsrMatrixMatrixMultiplySortedColumns);
+
 template <typename SparseMatrixType, typename DenseMatrixType>
 void CompareScaledSparseMatrixMatrixMultiply(DenseMatrixType A, DenseMatrixType B)
 {
@@ -375,6 +408,53 @@ void TestSparseMatrixDenseMatrixMultiply(void)
 }
 /* DECLARE_SPARSE_MATRIX_UNITTEST(TestSparseMatrixDenseMatrixMultiply); */
 
+template <typename MemorySpace, typename Orientation>
+void CompareCsrMatrixMultiVectorMultiply(size_t num_vectors)
+{
+    typedef cusp::array2d<float,cusp::host_memory,Orientation> HostVectors;
+    typedef cusp::array2d<float,MemorySpace,Orientation>       Vectors;
+
+    cusp::array2d<float,cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 6, 5);
+
+    HostVectors X(A.num_cols, num_vectors);
+    for(size_t i = 0; i < X.num_rows; i++)
+        for(size_t k = 0; k < X.num_cols; k++)
+            X(i,k) = (i + 3 * k) % 7;
+
+    HostVectors Y(A.num_rows, num_vectors);
+    cusp::multiply(A, X, Y);
+
+    cusp::csr_matrix<int,float,MemorySpace> _A(A);
+    Vectors _X(X);
+    Vectors _Y(A.num_rows, num_vectors, 1.0f);
+    cusp::multiply(_A, _X, _Y);
+
+    ASSERT_EQUAL(Y == HostVectors(_Y), true);
+}
+
+template <typename MemorySpace>
+void TestCsrMatrixMultiVectorMultiply(void)
+{
+    const size_t num_vectors[] = {1, 2, 3, 4, 5, 8, 16, 21, 32};
+
+    // the CUDA kernel only supports row-major vectors with a power of two columns
+    const bool general_layouts = THRUST_DEVICE_SYSTEM != THRUST_DEVICE_SYSTEM_CUDA ||
+                                 thrust::detail::is_same<MemorySpace, cusp::host_memory>::value;
+
+    for(size_t i = 0; i < sizeof(num_vectors) / sizeof(size_t); i++)
+    {
+        const bool power_of_two = (num_vectors[i] & (num_vectors[i] - 1)) == 0;
+
+        if(power_of_two || general_layouts)
+            CompareCsrMatrixMultiVectorMultiply<MemorySpace, cusp::row_major>(num_vectors[i]);
+
+        if(general_layouts)
+            CompareCsrMatrixMultiVectorMultiply<MemorySpace, cusp::column_major>(num_vectors[i]);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCsrMatrixMultiVectorMultiply);
+
 
 /////////////////////////////////////////
 // Sparse Matrix-Vector Multiplication //
@@ -500,6 +580,16 @@ void TestSparseMatrixVectorMultiply()
     cusp::array2d<ValueType,cusp::host_memory> H;
     cusp::gallery::poisson5pt(H, 8, 3);
 
+    // rows of very different lengths
+    cusp::array2d<ValueType,cusp::host_memory> I(64, 64, ValueType(0));
+    for(size_t i = 0; i < I.num_rows; i++)
+        I(i,i) = i % 7 + 1;
+    for(size_t j = 0; j < I.num_cols; j++)
+    {
+        I(5,j)  = j % 5 + 1;
+        I(40,j) = j % 3 + 2;
+    }
+
     CompareSparseMatrixVectorMultiply<TestMatrix>(A);
     CompareSparseMatrixVectorMultiply<TestMatrix>(B);
     CompareSparseMatrixVectorMultiply<TestMatrix>(C);
@@ -508,9 +598,61 @@ void TestSparseMatrixVectorMultiply()
     CompareSparseMatrixVectorMultiply<TestMatrix>(F);
     CompareSparseMatrixVectorMultiply<TestMatrix>(G);
     CompareSparseMatrixVectorMultiply<TestMatrix>(H);
+    CompareSparseMatrixVectorMultiply<TestMatrix>(I);
 }
 DECLARE_SPARSE_MATRIX_UNITTEST(TestSparseMatrixVectorMultiply);
 
+template <class MemorySpace>
+void TestRowMajorEllDiaMatrixVectorMultiply(void)
+{
+    // the CUDA kernels only support column-major ELL and DIA arrays
+    if(THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_CUDA &&
+       !thrust::detail::is_same<MemorySpace, cusp::host_memory>::value)
+        return;
+
+    cusp::array2d<float, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 6, 5);
+
+    cusp::array1d<float, cusp::host_memory> x(A.num_cols);
+    cusp::array1d<float, cusp::host_memory> y(A.num_rows);
+    for(size_t i = 0; i < x.size(); i++)
+        x[i] = i % 10;
+
+    cusp::multiply(A, x, y);
+
+    cusp::array1d<float, MemorySpace> _x(x);
+
+    // ELL matrix with row-major arrays
+    {
+        cusp::ell_matrix<int, float, MemorySpace> E(A);
+
+        cusp::array2d<int,   MemorySpace, cusp::row_major> J(E.column_indices);
+        cusp::array2d<float, MemorySpace, cusp::row_major> V(E.values);
+
+        cusp::array1d<float, MemorySpace> _y(A.num_rows, 10);
+        cusp::multiply(cusp::make_ell_matrix_view(E.num_rows, E.num_cols, E.num_entries,
+                                                  cusp::make_array2d_view(J), cusp::make_array2d_view(V)),
+                       _x, _y);
+
+        ASSERT_EQUAL(_y, y);
+    }
+
+    // DIA matrix with row-major values
+    {
+        cusp::dia_matrix<int, float, MemorySpace> D(A);
+
+        cusp::array2d<float, MemorySpace, cusp::row_major> V(D.values);
+
+        cusp::array1d<float, MemorySpace> _y(A.num_rows, 10);
+        cusp::multiply(cusp::make_dia_matrix_view(D.num_rows, D.num_cols, D.num_entries,
+                                                  cusp::make_array1d_view(D.diagonal_offsets), cusp::make_array2d_view(V)),
+                       _x, _y);
+
+        ASSERT_EQUAL(_y, y);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestRowMajorEllDiaMatrixVectorMultiply);
+
 template <typename SparseMatrixType, typename DenseMatrixType>
 void CompareScaledSparseMatrixVectorMultiply(DenseMatrixType A)
 {
@@ -633,6 +775,16 @@ void TestScaledSparseMatrixVectorMultiply()
     cusp::array2d<ValueType,cusp::host_memory> H;
     cusp::gallery::poisson5pt(H, 8, 3);
 
+    // rows of very different lengths
+    cusp::array2d<ValueType,cusp::host_memory> I(64, 64, ValueType(0));
+    for(size_t i = 0; i < I.num_rows; i++)
+        I(i,i) = i % 7 + 1;
+    for(size_t j = 0; j < I.num_cols; j++)
+    {
+        I(5,j)  = j % 5 + 1;
+        I(40,j) = j % 3 + 2;
+    }
+
     CompareScaledSparseMatrixVectorMultiply<TestMatrix>(A);
     CompareScaledSparseMatrixVectorMultiply<TestMatrix>(B);
     CompareScaledSparseMatrixVectorMultiply<TestMatrix>(C);
@@ -641,6 +793,7 @@ void TestScaledSparseMatrixVectorMultiply()
     CompareScaledSparseMatrixVectorMultiply<TestMatrix>(F);
     CompareScaledSparseMatrixVectorMultiply<TestMatrix>(G);
     CompareScaledSparseMatrixVectorMultiply<TestMatrix>(H);
+    CompareScaledSparseMatrixVectorMultiply<TestMatrix>(I);
 }
 DECLARE_SPARSE_MATRIX_UNITTEST(TestScaledSparseMatrixVectorMultiply);
 
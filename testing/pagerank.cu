@@ -0,0 +1,75 @@
+#include <unittest/unittest.h>
+
+#include <cusp/graph/pagerank.h>
+
+#include <cusp/array1d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+
+#include <cusp/gallery/grid.h>
+
+#include <thrust/reduce.h>
+
+template <class MemorySpace>
+void TestPageRank(void)
+{
+    // every vertex of a directed cycle has the same rank
+    const int N = 10;
+
+    cusp::coo_matrix<int, float, cusp::host_memory> A(N, N, N);
+    for(int i = 0; i < N; i++)
+    {
+        A.row_indices[i]    = i;
+        A.column_indices[i] = (i + 1) % N;
+        A.values[i]         = 1.0f;
+    }
+
+    cusp::csr_matrix<int, float, MemorySpace> G(A);
+    cusp::array1d<float, MemorySpace> ranks(N);
+
+    cusp::graph::pagerank(G, ranks);
+
+    cusp::array1d<float, cusp::host_memory> reference(N, 1.0f / N);
+    ASSERT_ALMOST_EQUAL(ranks, reference);
+
+    // ranks on a grid sum to one and are symmetric about its center
+    cusp::csr_matrix<int, float, MemorySpace> H;
+    cusp::gallery::grid2d(H, N, N);
+
+    cusp::array1d<float, MemorySpace> grid_ranks(N * N);
+    size_t iterations = cusp::graph::pagerank(H, grid_ranks, 0.85f, 1e-6f, 200);
+
+    cusp::array1d<float, cusp::host_memory> h_ranks(grid_ranks);
+
+    ASSERT_EQUAL(iterations < 200, true);
+    ASSERT_ALMOST_EQUAL(thrust::reduce(h_ranks.begin(), h_ranks.end()), 1.0f);
+    ASSERT_ALMOST_EQUAL(h_ranks[0], h_ranks[N * N - 1]);
+    ASSERT_EQUAL(h_ranks[0] < h_ranks[N + 1], true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestPageRank);
+
+template <typename MatrixType, typename ArrayType>
+size_t pagerank(my_system& system, const MatrixType& G, ArrayType& ranks,
+                const typename ArrayType::value_type damping,
+                const typename ArrayType::value_type tolerance,
+                const size_t max_iterations)
+{
+    system.validate_dispatch();
+    return 0;
+}
+
+void TestPageRankDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> G;
+    cusp::array1d<float, cusp::device_memory> ranks;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::graph::pagerank(sys, G, ranks);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestPageRankDispatch);
@@ -2,8 +2,50 @@
 
 #include <cusp/graph/pseudo_peripheral.h>
 
+#include <cusp/graph/breadth_first_search.h>
+
 #include <cusp/csr_matrix.h>
 
+#include <cusp/gallery/poisson.h>
+
+#include <thrust/extrema.h>
+
+template <typename Space>
+void TestPseudoPeripheralVertex(void)
+{
+    // the corners of a grid are its peripheral vertices
+    cusp::csr_matrix<int, float, Space> G;
+    cusp::gallery::poisson5pt(G, 13, 17);
+
+    cusp::array1d<int, Space> levels(G.num_rows);
+    int v = cusp::graph::pseudo_peripheral_vertex(G, levels);
+
+    cusp::array1d<int, Space> reference(G.num_rows);
+    cusp::graph::breadth_first_search(G, v, reference, true);
+
+    ASSERT_EQUAL(levels, reference);
+    ASSERT_EQUAL(*thrust::max_element(levels.begin(), levels.end()), 28);
+
+    // a path is searched from one of its endpoints
+    cusp::csr_matrix<int, float, Space> P;
+    cusp::gallery::poisson5pt(P, 50, 1);
+
+    cusp::array1d<int, Space> path_levels(P.num_rows);
+    int w = cusp::graph::pseudo_peripheral_vertex(P, path_levels, 4, 2);
+
+    ASSERT_EQUAL(w == 0 || w == 49, true);
+    ASSERT_EQUAL(*thrust::max_element(path_levels.begin(), path_levels.end()), 49);
+
+    // a single sweep still returns the level structure of its vertex
+    v = cusp::graph::pseudo_peripheral_vertex(G, levels, 1, 4);
+    cusp::graph::breadth_first_search(G, v, reference, true);
+
+    ASSERT_EQUAL(levels, reference);
+
+    ASSERT_THROWS(cusp::graph::pseudo_peripheral_vertex(G, levels, 1, 0), cusp::invalid_input_exception);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestPseudoPeripheralVertex);
+
 template <typename MatrixType>
 typename MatrixType::index_type
 pseudo_peripheral_vertex(my_system& system, const MatrixType& G)
@@ -0,0 +1,241 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array2d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+#include <cusp/sell_matrix.h>
+#include <cusp/transpose.h>
+#include <cusp/verify.h>
+
+#include <thrust/fill.h>
+
+// matrix with a few long rows, a long tail of short rows and empty rows
+template <typename MatrixType>
+void initialize_irregular_matrix(MatrixType& A, const size_t num_rows, const size_t num_cols)
+{
+    cusp::coo_matrix<int, float, cusp::host_memory> B;
+
+    size_t num_entries = 0;
+    for(size_t i = 0; i < num_rows; i++)
+        num_entries += (i % 17 == 0) ? num_cols / 2 : i % 4;
+
+    B.resize(num_rows, num_cols, num_entries);
+
+    for(size_t i = 0, n = 0; i < num_rows; i++)
+    {
+        const size_t row_length = (i % 17 == 0) ? num_cols / 2 : i % 4;
+
+        for(size_t k = 0; k < row_length; k++, n++)
+        {
+            B.row_indices[n]    = i;
+            B.column_indices[n] = (i + 7 * k) % num_cols;
+            B.values[n]         = int(k % 5) + 1;
+        }
+    }
+
+    B.sort_by_row_and_column();
+
+    A = B;
+}
+
+template <class Space>
+void TestSellMatrixBasicConstructor(void)
+{
+    cusp::sell_matrix<int, float, Space> matrix(10, 6, 12, 24, 4, 8);
+
+    ASSERT_EQUAL(matrix.num_rows,               10);
+    ASSERT_EQUAL(matrix.num_cols,               6);
+    ASSERT_EQUAL(matrix.num_entries,            12);
+    ASSERT_EQUAL(matrix.chunk_size,             4);
+    ASSERT_EQUAL(matrix.sort_window,            8);
+    ASSERT_EQUAL(matrix.num_chunks(),           3);
+    ASSERT_EQUAL(matrix.chunk_offsets.size(),   4);
+    ASSERT_EQUAL(matrix.row_permutation.size(), 10);
+    ASSERT_EQUAL(matrix.column_indices.size(),  24);
+    ASSERT_EQUAL(matrix.values.size(),          24);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixBasicConstructor);
+
+template <class Space>
+void TestSellMatrixSwap(void)
+{
+    cusp::sell_matrix<int, float, Space> A(10, 6, 12, 24, 4, 8);
+    cusp::sell_matrix<int, float, Space> B(3, 3, 2, 4, 2, 1);
+
+    A.swap(B);
+
+    ASSERT_EQUAL(A.num_rows,              3);
+    ASSERT_EQUAL(A.num_entries,           2);
+    ASSERT_EQUAL(A.chunk_size,            2);
+    ASSERT_EQUAL(A.sort_window,           1);
+    ASSERT_EQUAL(A.chunk_offsets.size(),  3);
+    ASSERT_EQUAL(A.column_indices.size(), 4);
+    ASSERT_EQUAL(B.num_rows,              10);
+    ASSERT_EQUAL(B.num_entries,           12);
+    ASSERT_EQUAL(B.chunk_size,            4);
+    ASSERT_EQUAL(B.sort_window,           8);
+    ASSERT_EQUAL(B.chunk_offsets.size(),  4);
+    ASSERT_EQUAL(B.column_indices.size(), 24);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixSwap);
+
+template <class Space>
+void TestSellMatrixConvert(void)
+{
+    typedef cusp::sell_matrix<int, float, Space> SellMatrix;
+
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    initialize_irregular_matrix(A, 100, 40);
+
+    cusp::array2d<float, cusp::host_memory> D(A);
+
+    const size_t parameters[7][2] = {{1,1}, {4,1}, {4,4}, {8,32}, {16,64}, {32,256}, {5,20}};
+
+    for(size_t n = 0; n < 7; n++)
+    {
+        SellMatrix B(A, parameters[n][0], parameters[n][1]);
+
+        ASSERT_EQUAL(B.chunk_size,  parameters[n][0]);
+        ASSERT_EQUAL(B.sort_window, parameters[n][1]);
+        ASSERT_EQUAL(B.num_entries, A.num_entries);
+        ASSERT_EQUAL(cusp::is_valid_matrix(B), true);
+
+        // rows only move within their sort window
+        cusp::array1d<int, cusp::host_memory> row_permutation(B.row_permutation);
+        for(size_t i = 0; i < row_permutation.size(); i++)
+            ASSERT_EQUAL(row_permutation[i] / parameters[n][1], i / parameters[n][1]);
+
+        // sell -> array2d
+        ASSERT_EQUAL(D == cusp::array2d<float, cusp::host_memory>(B), true);
+
+        // sell -> csr
+        cusp::csr_matrix<int, float, cusp::host_memory> C(B);
+        ASSERT_EQUAL(C.row_offsets,    A.row_offsets);
+        ASSERT_EQUAL(C.column_indices, A.column_indices);
+        ASSERT_EQUAL(C.values,         A.values);
+
+        // assignment keeps the chunk size and sort window of the destination
+        SellMatrix E(0, 0, 0, 0, parameters[n][0], parameters[n][1]);
+        E = D;
+        ASSERT_EQUAL(E.chunk_size,      parameters[n][0]);
+        ASSERT_EQUAL(E.chunk_offsets,   B.chunk_offsets);
+        ASSERT_EQUAL(E.row_permutation, B.row_permutation);
+        ASSERT_EQUAL(E.column_indices,  B.column_indices);
+        ASSERT_EQUAL(E.values,          B.values);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixConvert);
+
+void TestSellMatrixPadding(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    initialize_irregular_matrix(A, 136, 40);
+
+    // 8 rows of length 20 and a tail of rows with at most 3 entries
+    cusp::sell_matrix<int, float, cusp::host_memory> B(A, 8, 136);
+
+    // the long rows share a single chunk
+    ASSERT_EQUAL(B.chunk_offsets[1], 8 * 20);
+    ASSERT_EQUAL(B.chunk_offsets[2], 8 * 20 + 8 * 3);
+
+    // without sorting 8 chunks are padded to the long rows
+    cusp::sell_matrix<int, float, cusp::host_memory> C(A, 8, 1);
+    ASSERT_EQUAL(C.chunk_offsets[1], 8 * 20);
+    ASSERT_EQUAL(B.column_indices.size() < C.column_indices.size(), true);
+}
+DECLARE_UNITTEST(TestSellMatrixPadding);
+
+template <class Space>
+void TestSellMatrixView(void)
+{
+    typedef cusp::sell_matrix<int, float, Space> SellMatrix;
+    typedef typename SellMatrix::view            View;
+
+    SellMatrix A;
+    initialize_irregular_matrix(A, 50, 30);
+
+    View V = cusp::make_sell_matrix_view(A);
+
+    ASSERT_EQUAL(V.num_rows,     A.num_rows);
+    ASSERT_EQUAL(V.num_entries,  A.num_entries);
+    ASSERT_EQUAL(V.chunk_size,   A.chunk_size);
+    ASSERT_EQUAL(V.num_chunks(), A.num_chunks());
+
+    V.values[0] = 17;
+    ASSERT_EQUAL(A.values[0], 17);
+
+    cusp::array1d<float, Space> x = unittest::random_samples<float>(A.num_cols);
+    cusp::array1d<float, Space> y1(A.num_rows);
+    cusp::array1d<float, Space> y2(A.num_rows);
+
+    cusp::multiply(A, x, y1);
+    cusp::multiply(V, x, y2);
+
+    ASSERT_EQUAL(y1, y2);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixView);
+
+template <typename Space>
+void CompareSellMultiply(const cusp::csr_matrix<int, float, cusp::host_memory>& A,
+                         const size_t chunk_size, const size_t sort_window)
+{
+    cusp::sell_matrix<int, float, Space> B(A, chunk_size, sort_window);
+
+    cusp::array1d<float, cusp::host_memory> x(A.num_cols);
+    cusp::array1d<float, cusp::host_memory> y(A.num_rows);
+
+    for(size_t i = 0; i < x.size(); i++)
+        x[i] = int(i % 7) - 3;
+
+    cusp::multiply(A, x, y);
+
+    cusp::array1d<float, Space> x_sell(x);
+    cusp::array1d<float, Space> y_sell(A.num_rows, 10);
+    cusp::multiply(B, x_sell, y_sell);
+
+    ASSERT_EQUAL(y_sell, y);
+}
+
+template <class Space>
+void TestSellMatrixMultiply(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    initialize_irregular_matrix(A, 150, 50);
+
+    // unrolled chunk sizes
+    CompareSellMultiply<Space>(A,  4,   1);
+    CompareSellMultiply<Space>(A,  4,  32);
+    CompareSellMultiply<Space>(A,  8,  64);
+    CompareSellMultiply<Space>(A, 16, 128);
+    CompareSellMultiply<Space>(A, 32, 256);
+
+    // chunk sizes only known at runtime
+    CompareSellMultiply<Space>(A,  1,   1);
+    CompareSellMultiply<Space>(A,  3,  12);
+    CompareSellMultiply<Space>(A,  7, 700);
+
+    // empty matrix
+    cusp::csr_matrix<int, float, cusp::host_memory> E(20, 10, 0);
+    thrust::fill(E.row_offsets.begin(), E.row_offsets.end(), 0);
+    CompareSellMultiply<Space>(E, 8, 16);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixMultiply);
+
+template <class Space>
+void TestSellMatrixTranspose(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    initialize_irregular_matrix(A, 60, 30);
+
+    cusp::array2d<float, cusp::host_memory> Dt;
+    cusp::transpose(cusp::array2d<float, cusp::host_memory>(A), Dt);
+
+    cusp::sell_matrix<int, float, Space> B(A, 4, 16);
+    cusp::sell_matrix<int, float, Space> Bt;
+    cusp::transpose(B, Bt);
+
+    ASSERT_EQUAL(cusp::is_valid_matrix(Bt), true);
+    ASSERT_EQUAL(Dt == cusp::array2d<float, cusp::host_memory>(Bt), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixTranspose);
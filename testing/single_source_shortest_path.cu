@@ -0,0 +1,101 @@
+#include <unittest/unittest.h>
+
+#include <cusp/graph/single_source_shortest_path.h>
+
+#include <cusp/array1d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+
+#include <cusp/gallery/grid.h>
+
+#include <limits>
+
+template <class MatrixType>
+void TestSingleSourceShortestPath(void)
+{
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    const int N = 24;
+
+    // unit weights, so the distances are the grid distances from the corner
+    MatrixType G;
+    cusp::gallery::grid2d(G, N, N);
+
+    cusp::array1d<float, cusp::host_memory> reference(N * N);
+    for(int i = 0; i < N * N; i++)
+        reference[i] = (i % N) + (i / N);
+
+    for(int k = 0; k < 3; k++)
+    {
+        const float delta = k == 0 ? 0.0f : (k == 1 ? 1.0f : 5.0f);
+
+        cusp::array1d<float, MemorySpace> distances(N * N);
+        cusp::graph::single_source_shortest_path(G, 0, distances, delta);
+
+        cusp::array1d<float, cusp::host_memory> h_distances(distances);
+        ASSERT_EQUAL(h_distances, reference);
+    }
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestSingleSourceShortestPath);
+
+template <class MemorySpace>
+void TestSingleSourceShortestPathWeights(void)
+{
+    // a shortcut through a negative edge and an unreachable vertex
+    cusp::coo_matrix<int, float, cusp::host_memory> A(5, 5, 4);
+    A.row_indices[0] = 0; A.column_indices[0] = 1; A.values[0] =  4.0f;
+    A.row_indices[1] = 0; A.column_indices[1] = 2; A.values[1] =  1.0f;
+    A.row_indices[2] = 1; A.column_indices[2] = 3; A.values[2] =  1.0f;
+    A.row_indices[3] = 2; A.column_indices[3] = 1; A.values[3] = -2.0f;
+
+    cusp::csr_matrix<int, float, MemorySpace> G(A);
+    cusp::array1d<float, MemorySpace> distances(5);
+
+    cusp::graph::single_source_shortest_path(G, 0, distances);
+
+    ASSERT_EQUAL(distances[0],  0.0f);
+    ASSERT_EQUAL(distances[1], -1.0f);
+    ASSERT_EQUAL(distances[2],  1.0f);
+    ASSERT_EQUAL(distances[3],  0.0f);
+    ASSERT_EQUAL(distances[4], std::numeric_limits<float>::max());
+
+    // an edge 1 -> 0 closes the negative cycle 0 -> 2 -> 1 -> 0
+    cusp::coo_matrix<int, float, cusp::host_memory> B(5, 5, 5);
+    B.row_indices[0] = 0; B.column_indices[0] = 1; B.values[0] =  4.0f;
+    B.row_indices[1] = 0; B.column_indices[1] = 2; B.values[1] =  1.0f;
+    B.row_indices[2] = 1; B.column_indices[2] = 0; B.values[2] =  0.5f;
+    B.row_indices[3] = 1; B.column_indices[3] = 3; B.values[3] =  1.0f;
+    B.row_indices[4] = 2; B.column_indices[4] = 1; B.values[4] = -2.0f;
+
+    cusp::csr_matrix<int, float, MemorySpace> H(B);
+
+    ASSERT_THROWS(cusp::graph::single_source_shortest_path(H, 0, distances), cusp::runtime_exception);
+
+    // delta-stepping rejects negative weights instead of searching forever
+    ASSERT_THROWS(cusp::graph::single_source_shortest_path(G, 0, distances, 1.0f), cusp::invalid_input_exception);
+    ASSERT_THROWS(cusp::graph::single_source_shortest_path(H, 0, distances, 1.0f), cusp::invalid_input_exception);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSingleSourceShortestPathWeights);
+
+template <typename MatrixType, typename ArrayType>
+void single_source_shortest_path(my_system& system, const MatrixType& G, const typename MatrixType::index_type src, ArrayType& distances, const typename ArrayType::value_type delta)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestSingleSourceShortestPathDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> G;
+    cusp::array1d<float, cusp::device_memory> distances;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::graph::single_source_shortest_path(sys, G, 0, distances);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestSingleSourceShortestPathDispatch);
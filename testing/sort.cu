@@ -1,5 +1,6 @@
 #include <unittest/unittest.h>
 
+#include <cusp/array1d.h>
 #include <cusp/sort.h>
 
 template <class Array>
@@ -106,3 +107,59 @@ void TestCountingSortByKey(void)
 }
 DECLARE_VECTOR_UNITTEST(TestCountingSortByKey);
 
+
+template <typename MemorySpace>
+void TestSortByRowAndColumn(void)
+{
+    const size_t N = 20000;
+
+    const int ranges[3][2] = {{7, 5}, {1000, 3000}, {100000, 70000}};
+
+    for(int k = 0; k < 3; k++)
+    {
+        cusp::array1d<int,   cusp::host_memory> rows(N);
+        cusp::array1d<int,   cusp::host_memory> cols(N);
+        cusp::array1d<float, cusp::host_memory> vals(N);
+
+        srand(k);
+
+        for(size_t i = 0; i < N; i++)
+        {
+            rows[i] = rand() % ranges[k][0];
+            cols[i] = rand() % ranges[k][1];
+            vals[i] = i;
+        }
+
+        cusp::array1d<int,   MemorySpace> I(rows);
+        cusp::array1d<int,   MemorySpace> J(cols);
+        cusp::array1d<float, MemorySpace> V(vals);
+
+        cusp::sort_by_row_and_column(I, J, V);
+
+        cusp::array1d<int,   cusp::host_memory> h_I(I);
+        cusp::array1d<int,   cusp::host_memory> h_J(J);
+        cusp::array1d<float, cusp::host_memory> h_V(V);
+
+        // every entry moved with its value and equal entries kept their order
+        bool valid = true;
+
+        for(size_t i = 0; i < N; i++)
+        {
+            const size_t n = size_t(h_V[i]);
+
+            valid = valid && h_I[i] == rows[n] && h_J[i] == cols[n];
+
+            if(i > 0)
+            {
+                const bool ordered = h_I[i - 1] < h_I[i] ||
+                                     (h_I[i - 1] == h_I[i] && h_J[i - 1] < h_J[i]) ||
+                                     (h_I[i - 1] == h_I[i] && h_J[i - 1] == h_J[i] && h_V[i - 1] < h_V[i]);
+
+                valid = valid && ordered;
+            }
+        }
+
+        ASSERT_EQUAL(valid, true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSortByRowAndColumn);
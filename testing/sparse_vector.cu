@@ -0,0 +1,152 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array1d.h>
+#include <cusp/sparse_vector.h>
+
+template <typename MemorySpace>
+void TestSparseVectorBasicConstructor(void)
+{
+    cusp::sparse_vector<int, float, MemorySpace> x(10, 3);
+
+    ASSERT_EQUAL(x.length,          10);
+    ASSERT_EQUAL(x.num_entries,      3);
+    ASSERT_EQUAL(x.indices.size(),   3);
+    ASSERT_EQUAL(x.values.size(),    3);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSparseVectorBasicConstructor);
+
+template <typename MemorySpace>
+void TestSparseVectorFromDense(void)
+{
+    cusp::array1d<float, MemorySpace> v(6, 0.0f);
+    v[1] = 2.0f;
+    v[4] = 5.0f;
+    v[5] = 6.0f;
+
+    cusp::sparse_vector<int, float, MemorySpace> x(v);
+
+    ASSERT_EQUAL(x.length,      6);
+    ASSERT_EQUAL(x.num_entries, 3);
+    ASSERT_EQUAL(x.indices[0], 1);
+    ASSERT_EQUAL(x.indices[1], 4);
+    ASSERT_EQUAL(x.indices[2], 5);
+    ASSERT_EQUAL(x.values[0], 2.0f);
+    ASSERT_EQUAL(x.values[1], 5.0f);
+    ASSERT_EQUAL(x.values[2], 6.0f);
+
+    cusp::array1d<float, MemorySpace> z(4, 0.0f);
+
+    x = z;
+
+    ASSERT_EQUAL(x.length,         4);
+    ASSERT_EQUAL(x.num_entries,    0);
+    ASSERT_EQUAL(x.indices.size(), 0);
+    ASSERT_EQUAL(x.values.size(),  0);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSparseVectorFromDense);
+
+template <typename MemorySpace>
+void TestSparseVectorCopy(void)
+{
+    cusp::sparse_vector<int, float, cusp::host_memory> x(8, 2);
+    x.indices[0] = 3; x.values[0] = 1.0f;
+    x.indices[1] = 7; x.values[1] = 4.0f;
+
+    cusp::sparse_vector<int, float, MemorySpace> y(x);
+
+    ASSERT_EQUAL(y.length,      8);
+    ASSERT_EQUAL(y.num_entries, 2);
+    ASSERT_EQUAL(y.indices, x.indices);
+    ASSERT_EQUAL(y.values,  x.values);
+
+    cusp::sparse_vector<int, float, cusp::host_memory> z;
+    z = y;
+
+    ASSERT_EQUAL(z.length,      8);
+    ASSERT_EQUAL(z.num_entries, 2);
+    ASSERT_EQUAL(z.indices, x.indices);
+    ASSERT_EQUAL(z.values,  x.values);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSparseVectorCopy);
+
+template <typename MemorySpace>
+void TestSparseVectorResize(void)
+{
+    cusp::sparse_vector<int, float, MemorySpace> x;
+
+    x.resize(10, 4);
+
+    ASSERT_EQUAL(x.length,         10);
+    ASSERT_EQUAL(x.num_entries,     4);
+    ASSERT_EQUAL(x.indices.size(),  4);
+    ASSERT_EQUAL(x.values.size(),   4);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSparseVectorResize);
+
+template <typename MemorySpace>
+void TestSparseVectorSwap(void)
+{
+    cusp::sparse_vector<int, float, MemorySpace> x(10, 1);
+    cusp::sparse_vector<int, float, MemorySpace> y(20, 2);
+
+    x.indices[0] = 5; x.values[0] = 1.0f;
+    y.indices[0] = 2; y.values[0] = 2.0f;
+    y.indices[1] = 9; y.values[1] = 3.0f;
+
+    x.swap(y);
+
+    ASSERT_EQUAL(x.length,      20);
+    ASSERT_EQUAL(x.num_entries,  2);
+    ASSERT_EQUAL(x.indices[1],   9);
+    ASSERT_EQUAL(x.values[1], 3.0f);
+    ASSERT_EQUAL(y.length,      10);
+    ASSERT_EQUAL(y.num_entries,  1);
+    ASSERT_EQUAL(y.indices[0],   5);
+    ASSERT_EQUAL(y.values[0], 1.0f);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSparseVectorSwap);
+
+template <typename MemorySpace>
+void TestSparseVectorView(void)
+{
+    typedef cusp::sparse_vector<int, float, MemorySpace> Vector;
+    typedef typename Vector::view                        View;
+
+    Vector x(8, 2);
+    x.indices[0] = 1; x.values[0] = 1.0f;
+    x.indices[1] = 6; x.values[1] = 2.0f;
+
+    View V(x);
+
+    ASSERT_EQUAL(V.length,      8);
+    ASSERT_EQUAL(V.num_entries, 2);
+    ASSERT_EQUAL_QUIET(V.indices.begin(), x.indices.begin());
+    ASSERT_EQUAL_QUIET(V.values.begin(),  x.values.begin());
+
+    V.values[1] = 5.0f;
+    ASSERT_EQUAL(x.values[1], 5.0f);
+
+    View W = cusp::make_sparse_vector_view(x);
+
+    ASSERT_EQUAL(W.length,      8);
+    ASSERT_EQUAL(W.num_entries, 2);
+    ASSERT_EQUAL_QUIET(W.indices.begin(), x.indices.begin());
+    ASSERT_EQUAL_QUIET(W.values.end(),    x.values.end());
+
+    View U(8, 2,
+           cusp::make_array1d_view(x.indices),
+           cusp::make_array1d_view(x.values));
+
+    ASSERT_EQUAL(U.length,      8);
+    ASSERT_EQUAL(U.num_entries, 2);
+    ASSERT_EQUAL_QUIET(U.indices.begin(), x.indices.begin());
+
+    // copy from a view into a container
+    cusp::sparse_vector<int, float, cusp::host_memory> y(U);
+
+    ASSERT_EQUAL(y.length,      8);
+    ASSERT_EQUAL(y.num_entries, 2);
+    ASSERT_EQUAL(y.indices[1],  6);
+    ASSERT_EQUAL(y.values[1], 5.0f);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSparseVectorView);
@@ -0,0 +1,273 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array2d.h>
+#include <cusp/blas/blas.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/format_utils.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+#include <cusp/symmetric_csr_matrix.h>
+#include <cusp/transpose.h>
+#include <cusp/verify.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/cg.h>
+#include <cusp/precond/diagonal.h>
+#include <cusp/precond/aggregation/smoothed_aggregation.h>
+
+#include <thrust/fill.h>
+
+// symmetric matrix with empty rows, rows without a diagonal entry and
+// entries far from the diagonal
+template <typename MatrixType>
+void initialize_symmetric_matrix(MatrixType& A, const size_t N)
+{
+    cusp::array2d<float, cusp::host_memory> D(N, N, 0);
+
+    for(size_t i = 0; i < N; i++)
+    {
+        if(i % 11 == 5)
+            continue;
+
+        if(i % 3 != 0)
+            D(i,i) = 4 + int(i % 5);
+
+        for(size_t j = i + 1; j < N; j++)
+        {
+            if((i + 2 * j) % 7 == 0 || j == i + 1 || (i == 0 && j % 9 == 0))
+            {
+                D(i,j) = int((i + j) % 5) - 2;
+                D(j,i) = D(i,j);
+            }
+        }
+    }
+
+    A = D;
+}
+
+template <class Space>
+void TestSymmetricCsrMatrixBasicConstructor(void)
+{
+    cusp::symmetric_csr_matrix<int, float, Space> matrix(4, 4, 6);
+
+    ASSERT_EQUAL(matrix.num_rows,              4);
+    ASSERT_EQUAL(matrix.num_cols,              4);
+    ASSERT_EQUAL(matrix.num_entries,           6);
+    ASSERT_EQUAL(matrix.row_offsets.size(),    5);
+    ASSERT_EQUAL(matrix.column_indices.size(), 6);
+    ASSERT_EQUAL(matrix.values.size(),         6);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSymmetricCsrMatrixBasicConstructor);
+
+template <class Space>
+void TestSymmetricCsrMatrixSwap(void)
+{
+    cusp::symmetric_csr_matrix<int, float, Space> A(4, 4, 6);
+    cusp::symmetric_csr_matrix<int, float, Space> B(2, 2, 3);
+
+    A.swap(B);
+
+    ASSERT_EQUAL(A.num_rows,              2);
+    ASSERT_EQUAL(A.num_entries,           3);
+    ASSERT_EQUAL(A.row_offsets.size(),    3);
+    ASSERT_EQUAL(A.column_indices.size(), 3);
+    ASSERT_EQUAL(B.num_rows,              4);
+    ASSERT_EQUAL(B.num_entries,           6);
+    ASSERT_EQUAL(B.row_offsets.size(),    5);
+    ASSERT_EQUAL(B.column_indices.size(), 6);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSymmetricCsrMatrixSwap);
+
+template <class Space>
+void TestSymmetricCsrMatrixConvert(void)
+{
+    typedef cusp::symmetric_csr_matrix<int, float, Space> SymmetricMatrix;
+
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    initialize_symmetric_matrix(A, 60);
+
+    cusp::array2d<float, cusp::host_memory> D(A);
+
+    // csr -> symmetric_csr keeps the diagonal and the upper triangle
+    SymmetricMatrix B(A);
+
+    size_t num_diagonals = 0;
+    for(size_t i = 0; i < D.num_rows; i++)
+        num_diagonals += D(i,i) != 0;
+
+    ASSERT_EQUAL(B.num_entries, (A.num_entries + num_diagonals) / 2);
+    ASSERT_EQUAL(cusp::is_valid_matrix(B), true);
+
+    // symmetric_csr -> array2d
+    ASSERT_EQUAL(D == cusp::array2d<float, cusp::host_memory>(B), true);
+
+    // symmetric_csr -> csr
+    cusp::csr_matrix<int, float, cusp::host_memory> C(B);
+    ASSERT_EQUAL(C.row_offsets,    A.row_offsets);
+    ASSERT_EQUAL(C.column_indices, A.column_indices);
+    ASSERT_EQUAL(C.values,         A.values);
+
+    // array2d -> symmetric_csr
+    SymmetricMatrix E;
+    E = D;
+    ASSERT_EQUAL(E.row_offsets,    B.row_offsets);
+    ASSERT_EQUAL(E.column_indices, B.column_indices);
+    ASSERT_EQUAL(E.values,         B.values);
+
+    // only square matrices can be stored
+    cusp::csr_matrix<int, float, cusp::host_memory> F(3, 4, 0);
+    ASSERT_THROWS(SymmetricMatrix G(F), cusp::format_conversion_exception);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSymmetricCsrMatrixConvert);
+
+template <class Space>
+void TestSymmetricCsrMatrixView(void)
+{
+    typedef cusp::symmetric_csr_matrix<int, float, Space> SymmetricMatrix;
+    typedef typename SymmetricMatrix::view                View;
+
+    SymmetricMatrix A;
+    initialize_symmetric_matrix(A, 30);
+
+    View V = cusp::make_symmetric_csr_matrix_view(A);
+
+    ASSERT_EQUAL(V.num_rows,    A.num_rows);
+    ASSERT_EQUAL(V.num_entries, A.num_entries);
+
+    V.values[0] = 17;
+    ASSERT_EQUAL(A.values[0], 17);
+
+    cusp::array1d<float, Space> x = unittest::random_samples<float>(A.num_cols);
+    cusp::array1d<float, Space> y1(A.num_rows);
+    cusp::array1d<float, Space> y2(A.num_rows);
+
+    cusp::multiply(A, x, y1);
+    cusp::multiply(V, x, y2);
+
+    ASSERT_EQUAL(y1, y2);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSymmetricCsrMatrixView);
+
+template <class Space>
+void TestSymmetricCsrMatrixMultiply(void)
+{
+    const size_t sizes[4] = {1, 7, 100, 523};
+
+    for(size_t n = 0; n < 4; n++)
+    {
+        cusp::csr_matrix<int, float, cusp::host_memory> A;
+        initialize_symmetric_matrix(A, sizes[n]);
+
+        cusp::symmetric_csr_matrix<int, float, Space> B(A);
+
+        cusp::array1d<float, cusp::host_memory> x(A.num_cols);
+        cusp::array1d<float, cusp::host_memory> y(A.num_rows);
+
+        for(size_t i = 0; i < x.size(); i++)
+            x[i] = int(i % 7) - 3;
+
+        cusp::multiply(A, x, y);
+
+        cusp::array1d<float, Space> x_sym(x);
+        cusp::array1d<float, Space> y_sym(A.num_rows, 10);
+        cusp::multiply(B, x_sym, y_sym);
+
+        ASSERT_EQUAL(y_sym, y);
+    }
+
+    // empty matrix
+    cusp::symmetric_csr_matrix<int, float, Space> E(20, 20, 0);
+    thrust::fill(E.row_offsets.begin(), E.row_offsets.end(), 0);
+
+    cusp::array1d<float, Space> x(20, 1);
+    cusp::array1d<float, Space> y(20, 10);
+    cusp::multiply(E, x, y);
+
+    ASSERT_EQUAL(y, cusp::array1d<float, Space>(20, 0));
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSymmetricCsrMatrixMultiply);
+
+template <class Space>
+void TestSymmetricCsrMatrixExtractDiagonal(void)
+{
+    cusp::csr_matrix<int, float, Space> A;
+    initialize_symmetric_matrix(A, 40);
+
+    cusp::symmetric_csr_matrix<int, float, Space> B(A);
+
+    cusp::array1d<float, Space> expected(A.num_rows);
+    cusp::array1d<float, Space> diagonal(A.num_rows);
+
+    cusp::extract_diagonal(A, expected);
+    cusp::extract_diagonal(B, diagonal);
+
+    ASSERT_EQUAL(diagonal, expected);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSymmetricCsrMatrixExtractDiagonal);
+
+template <class Space>
+void TestSymmetricCsrMatrixTranspose(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    initialize_symmetric_matrix(A, 40);
+
+    cusp::symmetric_csr_matrix<int, float, Space> B(A);
+    cusp::symmetric_csr_matrix<int, float, Space> Bt;
+    cusp::transpose(B, Bt);
+
+    ASSERT_EQUAL(Bt.row_offsets,    B.row_offsets);
+    ASSERT_EQUAL(Bt.column_indices, B.column_indices);
+    ASSERT_EQUAL(Bt.values,         B.values);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSymmetricCsrMatrixTranspose);
+
+template <class Space>
+void TestSymmetricCsrMatrixConjugateGradient(void)
+{
+    cusp::csr_matrix<int, float, Space> B;
+    cusp::gallery::poisson5pt(B, 20, 20);
+
+    cusp::symmetric_csr_matrix<int, float, Space> A(B);
+
+    cusp::array1d<float, Space> b = unittest::random_samples<float>(A.num_rows);
+    cusp::array1d<float, Space> x(A.num_rows, 0);
+
+    cusp::precond::diagonal<float, Space> M(A);
+
+    cusp::monitor<float> monitor(b, 100, 1e-4);
+    cusp::krylov::cg(A, x, b, monitor, M);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+
+    // check residual norm with the full matrix
+    cusp::array1d<float, Space> residual(A.num_rows, 0);
+    cusp::multiply(B, x, residual);
+    cusp::blas::axpby(residual, b, residual, -1.0f, 1.0f);
+
+    ASSERT_EQUAL(cusp::blas::nrm2(residual) < 1e-3 * cusp::blas::nrm2(b), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSymmetricCsrMatrixConjugateGradient);
+
+template <class Space>
+void TestSymmetricCsrMatrixSmoothedAggregation(void)
+{
+    cusp::csr_matrix<int, float, Space> B;
+    cusp::gallery::poisson5pt(B, 40, 40);
+
+    cusp::symmetric_csr_matrix<int, float, Space> A(B);
+
+    // every level is stored in symmetric format
+    cusp::precond::aggregation::smoothed_aggregation<int, float, Space,
+        thrust::use_default, thrust::use_default, cusp::symmetric_csr_format> M(A);
+
+    cusp::array1d<float, Space> b = unittest::random_samples<float>(A.num_rows);
+    cusp::array1d<float, Space> x(A.num_rows, 0);
+
+    // set stopping criteria (iteration_limit = 20, relative_tolerance = 1e-4)
+    cusp::monitor<float> monitor(b, 20, 1e-4);
+    cusp::krylov::cg(A, x, b, monitor, M);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSymmetricCsrMatrixSmoothedAggregation);
@@ -2,9 +2,155 @@
 
 #include <cusp/graph/symmetric_rcm.h>
 
+#include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
 #include <cusp/permutation_matrix.h>
 
+#include <algorithm>
+#include <cstdlib>
+
+template <class Space>
+void TestSymmetricRCM(void)
+{
+    // two grids and a few isolated vertices whose ids are scattered across
+    // the graph
+    const int N = 1608;
+    const int grids[2][3] = {{20, 30, 0}, {25, 40, 600}};
+
+    cusp::coo_matrix<int, float, cusp::host_memory> h_G(N, N, 5 * 1600);
+
+    int n = 0;
+
+    for(int g = 0; g < 2; g++)
+    {
+        const int nx = grids[g][0];
+        const int ny = grids[g][1];
+
+        for(int x = 0; x < nx; x++)
+        {
+            for(int y = 0; y < ny; y++)
+            {
+                const int i = grids[g][2] + x * ny + y;
+                const int u = (i * 7919) % N;
+
+                h_G.row_indices[n] = u; h_G.column_indices[n] = u; h_G.values[n++] = 4;
+
+                if(x + 1 < nx)
+                {
+                    const int v = ((i + ny) * 7919) % N;
+                    h_G.row_indices[n] = u; h_G.column_indices[n] = v; h_G.values[n++] = -1;
+                    h_G.row_indices[n] = v; h_G.column_indices[n] = u; h_G.values[n++] = -1;
+                }
+
+                if(y + 1 < ny)
+                {
+                    const int v = ((i + 1) * 7919) % N;
+                    h_G.row_indices[n] = u; h_G.column_indices[n] = v; h_G.values[n++] = -1;
+                    h_G.row_indices[n] = v; h_G.column_indices[n] = u; h_G.values[n++] = -1;
+                }
+            }
+        }
+    }
+    h_G.resize(N, N, n);
+    h_G.sort_by_row_and_column();
+
+    cusp::csr_matrix<int, float, Space> G(h_G);
+    cusp::permutation_matrix<int, Space> P(N);
+
+    cusp::graph::symmetric_rcm(G, P);
+
+    cusp::array1d<int, cusp::host_memory> permutation(P.permutation);
+    cusp::array1d<int, cusp::host_memory> sorted(permutation);
+    std::sort(sorted.begin(), sorted.end());
+
+    cusp::array1d<int, cusp::host_memory> reference(N);
+    for(int i = 0; i < N; i++)
+        reference[i] = i;
+
+    ASSERT_EQUAL(sorted, reference);
+
+    // the bandwidth of each grid is close to its smaller dimension
+    int bandwidth = 0;
+    for(int k = 0; k < n; k++)
+        bandwidth = std::max(bandwidth, std::abs(permutation[h_G.row_indices[k]] -
+                                                 permutation[h_G.column_indices[k]]));
+
+    ASSERT_EQUAL(bandwidth <= 26, true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSymmetricRCM);
+
+template <class Space>
+void TestSymmetricRCMWithoutEdges(void)
+{
+    // a graph without vertices
+    {
+        cusp::csr_matrix<int, float, Space> G;
+        cusp::permutation_matrix<int, Space> P;
+
+        cusp::graph::symmetric_rcm(G, P);
+
+        ASSERT_EQUAL(P.permutation.size(), 0);
+    }
+
+    // isolated vertices are numbered in reverse order
+    {
+        cusp::csr_matrix<int, float, Space> G(4, 4, 0);
+        cusp::permutation_matrix<int, Space> P(4);
+
+        thrust::fill(G.row_offsets.begin(), G.row_offsets.end(), 0);
+
+        cusp::graph::symmetric_rcm(G, P);
+
+        cusp::array1d<int, cusp::host_memory> permutation(P.permutation);
+
+        ASSERT_EQUAL(permutation[0], 3);
+        ASSERT_EQUAL(permutation[1], 2);
+        ASSERT_EQUAL(permutation[2], 1);
+        ASSERT_EQUAL(permutation[3], 0);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSymmetricRCMWithoutEdges);
+
+template <class Space>
+void TestSymmetricRCMManyComponents(void)
+{
+    // many paths of three vertices, each one is numbered contiguously and
+    // from one of its endpoints
+    const int num_paths = 500;
+    const int N = 3 * num_paths;
+
+    cusp::coo_matrix<int, float, cusp::host_memory> h_G(N, N, 4 * num_paths);
+
+    for(int p = 0; p < num_paths; p++)
+    {
+        const int n = 4 * p;
+        const int v = 3 * p;
+
+        h_G.row_indices[n + 0] = v + 0; h_G.column_indices[n + 0] = v + 1; h_G.values[n + 0] = 1;
+        h_G.row_indices[n + 1] = v + 1; h_G.column_indices[n + 1] = v + 0; h_G.values[n + 1] = 1;
+        h_G.row_indices[n + 2] = v + 1; h_G.column_indices[n + 2] = v + 2; h_G.values[n + 2] = 1;
+        h_G.row_indices[n + 3] = v + 2; h_G.column_indices[n + 3] = v + 1; h_G.values[n + 3] = 1;
+    }
+    h_G.sort_by_row_and_column();
+
+    cusp::csr_matrix<int, float, Space> G(h_G);
+    cusp::permutation_matrix<int, Space> P(N);
+
+    cusp::graph::symmetric_rcm(G, P);
+
+    cusp::array1d<int, cusp::host_memory> permutation(P.permutation);
+
+    for(int p = 0; p < num_paths; p++)
+    {
+        const int first = std::min(permutation[3 * p], permutation[3 * p + 2]);
+        const int last  = std::max(permutation[3 * p], permutation[3 * p + 2]);
+
+        ASSERT_EQUAL(last - first, 2);
+        ASSERT_EQUAL(permutation[3 * p + 1], first + 1);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSymmetricRCMManyComponents);
+
 template <typename MatrixType, typename PermutationType>
 void symmetric_rcm(my_system& system, const MatrixType& G, PermutationType& P)
 {
@@ -9,6 +9,8 @@
 #include <cusp/ell_matrix.h>
 #include <cusp/hyb_matrix.h>
 
+#include <cusp/gallery/random.h>
+
 template <typename MatrixType>
 void initialize_matrix(MatrixType& matrix)
 {
@@ -201,6 +203,47 @@ void TestTranspose(void)
 }
 DECLARE_MATRIX_UNITTEST(TestTranspose);
 
+template <class MemorySpace>
+void TestTransposeLargeCsrMatrix(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    cusp::gallery::random(A, 1500, 900, 60000);
+
+    cusp::csr_matrix<int, float, cusp::host_memory> At;
+    cusp::transpose(A, At);
+
+    cusp::csr_matrix<int, float, MemorySpace> B(A), Bt;
+    cusp::transpose(B, Bt);
+
+    // the transpose must match the host result entry for entry
+    ASSERT_EQUAL(Bt.num_rows,       At.num_rows);
+    ASSERT_EQUAL(Bt.num_cols,       At.num_cols);
+    ASSERT_EQUAL(Bt.row_offsets,    At.row_offsets);
+    ASSERT_EQUAL(Bt.column_indices, At.column_indices);
+    ASSERT_EQUAL(Bt.values,         At.values);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestTransposeLargeCsrMatrix);
+
+template <class MemorySpace>
+void TestTransposeLargeCooMatrix(void)
+{
+    cusp::coo_matrix<int, float, cusp::host_memory> A;
+    cusp::gallery::random(A, 700, 2000, 50000);
+
+    cusp::coo_matrix<int, float, cusp::host_memory> At;
+    cusp::transpose(A, At);
+
+    cusp::coo_matrix<int, float, MemorySpace> B(A), Bt;
+    cusp::transpose(B, Bt);
+
+    ASSERT_EQUAL(Bt.num_rows,       At.num_rows);
+    ASSERT_EQUAL(Bt.num_cols,       At.num_cols);
+    ASSERT_EQUAL(Bt.row_indices,    At.row_indices);
+    ASSERT_EQUAL(Bt.column_indices, At.column_indices);
+    ASSERT_EQUAL(Bt.values,         At.values);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestTransposeLargeCooMatrix);
+
 template <typename MatrixType1, typename MatrixType2>
 void transpose(my_system& system, const MatrixType1& A, MatrixType2& At)
 {
@@ -3,6 +3,64 @@
 #include <cusp/graph/vertex_coloring.h>
 
 #include <cusp/csr_matrix.h>
+#include <cusp/gallery/poisson.h>
+
+#include <thrust/extrema.h>
+#include <thrust/reduce.h>
+
+template <typename Space>
+void TestVertexColoring(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> h_G;
+    cusp::gallery::poisson5pt(h_G, 50, 60);
+
+    cusp::csr_matrix<int, float, Space> G(h_G);
+
+    size_t unbalanced_colors = 0;
+    int unbalanced_max_size = 0;
+
+    for(int balance = 0; balance < 2; balance++)
+    {
+        cusp::array1d<int, Space> colors(G.num_rows);
+        size_t num_colors = balance ? cusp::graph::vertex_coloring(G, colors, true)
+                                    : cusp::graph::vertex_coloring(G, colors);
+
+        // no two neighbors share a color
+        cusp::array1d<int, cusp::host_memory> h_colors(colors);
+        bool is_valid = true;
+
+        for(size_t i = 0; i < h_G.num_rows; i++)
+            for(int jj = h_G.row_offsets[i]; jj < h_G.row_offsets[i + 1]; jj++)
+                if(size_t(h_G.column_indices[jj]) != i && h_colors[h_G.column_indices[jj]] == h_colors[i])
+                    is_valid = false;
+
+        ASSERT_EQUAL(is_valid, true);
+        ASSERT_EQUAL(*thrust::max_element(h_colors.begin(), h_colors.end()), int(num_colors) - 1);
+
+        cusp::array1d<int, Space> sizes;
+        cusp::graph::color_class_sizes(colors, num_colors, sizes);
+
+        cusp::array1d<int, cusp::host_memory> h_sizes(sizes);
+
+        ASSERT_EQUAL(h_sizes.size(), num_colors);
+        ASSERT_EQUAL(thrust::reduce(h_sizes.begin(), h_sizes.end()), int(G.num_rows));
+
+        const int max_size = *thrust::max_element(h_sizes.begin(), h_sizes.end());
+
+        if(balance == 0)
+        {
+            unbalanced_colors   = num_colors;
+            unbalanced_max_size = max_size;
+        }
+        else
+        {
+            // balancing neither adds colors nor grows the largest class
+            ASSERT_EQUAL(num_colors <= unbalanced_colors, true);
+            ASSERT_EQUAL(max_size <= unbalanced_max_size, true);
+        }
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestVertexColoring);
 
 template <typename MatrixType, typename ArrayType>
 size_t vertex_coloring(my_system& system, const MatrixType& G, ArrayType& colors)